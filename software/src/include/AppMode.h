@@ -16,10 +16,10 @@ class AppMode {
 protected:
     U8G2& _display;          
     Encoder& _encoder;
-    ChordInput& _buttons;
+    ChordRecognizer& _buttons;
 
 public:
-    AppMode(U8G2& display, Encoder& encoder, ChordInput& buttons) 
+    AppMode(U8G2& display, Encoder& encoder, ChordRecognizer& buttons) 
         : _display(display), _encoder(encoder), _buttons(buttons) {}
 
     virtual ~AppMode() {}
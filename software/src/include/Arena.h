@@ -0,0 +1,57 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+// Bump-Allocator über einen festen Puffer für kurzlebige Daten, die gemeinsam verfallen
+// (z.B. die Beschriftungen einer Menüseite, die immer komplett neu gebaut wird).
+// Einzeln freigeben geht nicht, reset() gibt alles auf einmal frei. Kein Heap, keine Fragmentierung.
+// Ist der Puffer voll, liefert allocate() nullptr.
+class Arena {
+public:
+    Arena(uint8_t* buffer, size_t size) : _buffer(buffer), _size(size), _used(0), _highWater(0) {}
+
+    void* allocate(size_t size, size_t align = alignof(max_align_t)) {
+        size_t start = (_used + align - 1) & ~(align - 1);
+        if (start > _size || size > _size - start) return nullptr;
+        _used = start + size;
+        if (_used > _highWater) _highWater = _used;
+        return _buffer + start;
+    }
+
+    // Kopie mit '\0'; nullptr, wenn kein Platz mehr ist
+    const char* copy(const char* text) {
+        size_t length = strlen(text);
+        char* out = (char*)allocate(length + 1, 1);
+        if (out) memcpy(out, text, length + 1);
+        return out;
+    }
+
+    // Alle Zeiger aus allocate()/copy() werden ungültig
+    void reset() { _used = 0; }
+
+    size_t used() const { return _used; }
+    size_t capacity() const { return _size; }
+    // Höchster Füllstand seit dem Start, zum Dimensionieren
+    size_t highWater() const { return _highWater; }
+
+private:
+    uint8_t* _buffer;
+    size_t _size;
+    size_t _used;
+    size_t _highWater;
+};
+
+// Arena samt Puffer, z.B. als Member
+template <size_t N>
+class StaticArena : public Arena {
+public:
+    StaticArena() : Arena(_storage, N) {}
+
+private:
+    alignas(max_align_t) uint8_t _storage[N];
+};
+
+#endif
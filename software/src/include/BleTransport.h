@@ -0,0 +1,65 @@
+#ifndef BLETRANSPORT_H
+#define BLETRANSPORT_H
+
+#include <Arduino.h>
+
+// Abstraktion des BLE-Stacks unter BleController.
+// Es wird genau ein Backend einkompiliert:
+//   - Bluedroid (Standard, BLEDevice/BLEServer aus dem Arduino-Core)
+//   - NimBLE (Build-Flag -DMAXFAN_BLE_NIMBLE, Library h2zero/NimBLE-Arduino)
+// Beide stellen denselben GATT-Service (gleiche UUIDs) mit statischem PIN, MITM und Bonding bereit.
+
+#define MAXFAN_SERVICE_UUID  "4fafc201-1fb5-459e-8fcc-c5c9c331914b"
+#define MAXFAN_COMMAND_UUID  "beb5483e-36e1-4688-b7f5-ea07361b26a8"
+#define MAXFAN_STATUS_UUID   "cba1d466-344c-4be3-ab3f-1890d5c0c0c0"
+#define MAXFAN_METRICS_UUID  "2d430c16-4ce0-461a-b6de-0c7babef7c9b"
+
+// Ereignisse aus dem Stack. Werden im Kontext des BLE-Tasks aufgerufen!
+// Verbindungsparameter in BLE-Einheiten (Intervall 1.25 ms, Timeout 10 ms).
+class BleTransportListener {
+public:
+    virtual ~BleTransportListener() {}
+    virtual void onClientConnected(uint16_t connId, uint16_t interval, uint16_t latency, uint16_t timeout) = 0;
+    virtual void onClientDisconnected(uint16_t connId) = 0;
+    virtual void onMtuChanged(uint16_t connId, uint16_t mtu) = 0;
+    virtual void onSubscribeChanged(uint16_t connId, bool subscribed) = 0;
+    virtual void onAuthenticationComplete(uint16_t connId, bool success) = 0;
+    virtual void onConnParamsUpdated(uint16_t connId, uint16_t interval, uint16_t latency, uint16_t timeout) = 0;
+    virtual void onCommand(uint16_t connId, const uint8_t* data, size_t len) = 0;
+};
+
+class BleTransport {
+public:
+    virtual ~BleTransport() {}
+
+    // Initialisiert Stack, Security (statischer PIN), Service und Characteristics.
+    // minInterval/maxInterval: bevorzugtes Verbindungsintervall, wird in der Scan Response angeboten
+    virtual void begin(const char* deviceName, uint32_t pin, uint16_t mtu,
+                       uint16_t minInterval, uint16_t maxInterval, BleTransportListener* listener) = 0;
+    // Für die Hintergrundarbeit des Backends, wird aus BleController::loop() aufgerufen
+    virtual void loop() {}
+
+    // Wert der Status-Characteristic (für Reads)
+    virtual void setStatusValue(const uint8_t* data, size_t len) = 0;
+    // Wert der Diagnostics-Characteristic (nur lesbar, keine Notifications)
+    virtual void setMetricsValue(const uint8_t* data, size_t len) = 0;
+    // Notification an genau eine Verbindung
+    virtual bool notify(uint16_t connId, const uint8_t* data, size_t len) = 0;
+
+    // Setzt die Manufacturer Specific Data im Advertising (inkl. Company ID); geht auch während des Advertisings
+    virtual void setManufacturerData(const uint8_t* data, size_t len) = 0;
+    virtual void startAdvertising() = 0;
+
+    virtual void disconnect(uint16_t connId) = 0;
+    virtual void updateConnParams(uint16_t connId, uint16_t minInterval, uint16_t maxInterval,
+                                  uint16_t latency, uint16_t timeout) = 0;
+
+    // Das einkompilierte Backend
+    static BleTransport& instance();
+    static const char* backendName();
+
+    // Löscht alle gespeicherten Bonds (initialisiert den Stack bei Bedarf)
+    static void clearAllBonds();
+};
+
+#endif
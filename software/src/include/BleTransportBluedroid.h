@@ -0,0 +1,95 @@
+#ifndef BLETRANSPORTBLUEDROID_H
+#define BLETRANSPORTBLUEDROID_H
+
+#ifndef MAXFAN_BLE_NIMBLE
+
+#include <Arduino.h>
+#include <BLEDevice.h>
+#include <BLEServer.h>
+#include <BLEUtils.h>
+#include <BLE2902.h>
+#include "BleTransport.h"
+#include "StaticSlot.h"
+
+// Bluedroid-Backend (BLEDevice/BLEServer aus dem Arduino-Core)
+class BleTransportBluedroid : public BleTransport {
+public:
+    BleTransportBluedroid();
+
+    void begin(const char* deviceName, uint32_t pin, uint16_t mtu,
+               uint16_t minInterval, uint16_t maxInterval, BleTransportListener* listener) override;
+    void setStatusValue(const uint8_t* data, size_t len) override;
+    void setMetricsValue(const uint8_t* data, size_t len) override;
+    bool notify(uint16_t connId, const uint8_t* data, size_t len) override;
+    void setManufacturerData(const uint8_t* data, size_t len) override;
+    void startAdvertising() override;
+    void disconnect(uint16_t connId) override;
+    void updateConnParams(uint16_t connId, uint16_t minInterval, uint16_t maxInterval,
+                          uint16_t latency, uint16_t timeout) override;
+
+private:
+    static constexpr int MAX_PEERS = 4;
+
+    // Bluedroid meldet Security- und GAP-Events nur mit Adresse, die GATT-Seite mit conn_id
+    struct Peer {
+        bool used;
+        uint16_t connId;
+        esp_bd_addr_t addr;
+    };
+
+    BLEServer* _pServer;
+    BLECharacteristic* _pCommandChar;
+    BLECharacteristic* _pStatusChar;
+    BLECharacteristic* _pMetricsChar;
+    BleTransportListener* _listener;
+    Peer _peers[MAX_PEERS];
+
+    Peer* findPeer(uint16_t connId);
+    Peer* findPeer(const esp_bd_addr_t addr);
+    void setupScanResponse(const char* deviceName, uint16_t minInterval, uint16_t maxInterval);
+
+    static void gapEventHandler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t* param);
+    static void gattsEventHandler(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf, esp_ble_gatts_cb_param_t* param);
+
+    // --- Interne Klassen ---
+    class MyServerCallbacks : public BLEServerCallbacks {
+        BleTransportBluedroid* _parent;
+    public:
+        MyServerCallbacks(BleTransportBluedroid* p) : _parent(p) {}
+        void onConnect(BLEServer* s, esp_ble_gatts_cb_param_t* param) override;
+        void onDisconnect(BLEServer* s, esp_ble_gatts_cb_param_t* param) override;
+        void onMtuChanged(BLEServer* s, esp_ble_gatts_cb_param_t* param) override;
+    };
+
+    class MyCharCallbacks : public BLECharacteristicCallbacks {
+        BleTransportBluedroid* _parent;
+    public:
+        MyCharCallbacks(BleTransportBluedroid* p) : _parent(p) {}
+        void onWrite(BLECharacteristic* pChar, esp_ble_gatts_cb_param_t* param) override;
+    };
+
+    // Security brauchen wir intern trotzdem, damit der PIN-Mechanismus greift,
+    // aber ohne Kommunikation nach außen.
+    class MySecurityCallbacks : public BLESecurityCallbacks {
+    public:
+        BleTransportBluedroid* _parent;
+        MySecurityCallbacks(BleTransportBluedroid* p) : _parent(p) {}
+        uint32_t onPassKeyRequest() override { return 0; }
+        void onPassKeyNotify(uint32_t pass_key) override {}
+        bool onConfirmPIN(uint32_t pass_key) override { return true; }
+        bool onSecurityRequest() override { return true; }
+        void onAuthenticationComplete(esp_ble_auth_cmpl_t cmpl) override;
+    };
+
+    // Callbacks und Security gehören dem Transport (statisch), die Library bekommt nur Zeiger.
+    // CCCD und Security erst in begin() bauen: ohne BLE kein Speicher für den Stack-Kram.
+    MyServerCallbacks _serverCallbacks;
+    MyCharCallbacks _charCallbacks;
+    MySecurityCallbacks _securityCallbacks;
+    StaticSlot<BLESecurity> _security;
+    StaticSlot<BLE2902> _statusCccd;
+};
+
+#endif // MAXFAN_BLE_NIMBLE
+
+#endif
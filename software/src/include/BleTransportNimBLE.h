@@ -0,0 +1,77 @@
+#ifndef BLETRANSPORTNIMBLE_H
+#define BLETRANSPORTNIMBLE_H
+
+#ifdef MAXFAN_BLE_NIMBLE
+
+#include <Arduino.h>
+#include <NimBLEDevice.h>
+#include "BleTransport.h"
+
+// NimBLE-Backend (h2zero/NimBLE-Arduino 1.4.x): deutlich weniger Heap und Flash als Bluedroid
+class BleTransportNimBLE : public BleTransport {
+public:
+    BleTransportNimBLE();
+
+    void begin(const char* deviceName, uint32_t pin, uint16_t mtu,
+               uint16_t minInterval, uint16_t maxInterval, BleTransportListener* listener) override;
+    void loop() override;
+    void setStatusValue(const uint8_t* data, size_t len) override;
+    void setMetricsValue(const uint8_t* data, size_t len) override;
+    bool notify(uint16_t connId, const uint8_t* data, size_t len) override;
+    void setManufacturerData(const uint8_t* data, size_t len) override;
+    void startAdvertising() override;
+    void disconnect(uint16_t connId) override;
+    void updateConnParams(uint16_t connId, uint16_t minInterval, uint16_t maxInterval,
+                          uint16_t latency, uint16_t timeout) override;
+
+private:
+    // NimBLE-Arduino 1.4 meldet ausgehandelte Verbindungsparameter nicht per Callback,
+    // darum fragen wir sie kurz nach der Anfrage ab.
+    static constexpr uint32_t CONN_PARAMS_QUERY_DELAY_MS = 1500;
+    static constexpr int MAX_PENDING_QUERIES = 4;
+
+    struct PendingQuery {
+        bool used;
+        uint16_t connId;
+        uint32_t dueMs;
+    };
+
+    NimBLEServer* _pServer;
+    NimBLECharacteristic* _pCommandChar;
+    NimBLECharacteristic* _pStatusChar;
+    NimBLECharacteristic* _pMetricsChar;
+    BleTransportListener* _listener;
+    uint32_t _pin;
+    PendingQuery _pending[MAX_PENDING_QUERIES];
+    portMUX_TYPE _pendingLock;
+
+    void setupScanResponse(const char* deviceName, uint16_t minInterval, uint16_t maxInterval);
+
+    // --- Interne Klassen ---
+    class MyServerCallbacks : public NimBLEServerCallbacks {
+        BleTransportNimBLE* _parent;
+    public:
+        MyServerCallbacks(BleTransportNimBLE* p) : _parent(p) {}
+        void onConnect(NimBLEServer* s, ble_gap_conn_desc* desc) override;
+        void onDisconnect(NimBLEServer* s, ble_gap_conn_desc* desc) override;
+        void onMTUChange(uint16_t mtu, ble_gap_conn_desc* desc) override;
+        uint32_t onPassKeyRequest() override { return _parent->_pin; }
+        bool onConfirmPIN(uint32_t pass_key) override { return true; }
+        void onAuthenticationComplete(ble_gap_conn_desc* desc) override;
+    };
+
+    class MyCharCallbacks : public NimBLECharacteristicCallbacks {
+        BleTransportNimBLE* _parent;
+    public:
+        MyCharCallbacks(BleTransportNimBLE* p) : _parent(p) {}
+        void onWrite(NimBLECharacteristic* pChar, ble_gap_conn_desc* desc) override;
+        void onSubscribe(NimBLECharacteristic* pChar, ble_gap_conn_desc* desc, uint16_t subValue) override;
+    };
+
+    MyServerCallbacks _serverCallbacks;
+    MyCharCallbacks _charCallbacks;
+};
+
+#endif // MAXFAN_BLE_NIMBLE
+
+#endif
@@ -1,53 +1,87 @@
 #ifndef CHORD_INPUT_H
 #define CHORD_INPUT_H
 
-#include <vector>
-#include <queue>
-#include <initializer_list>
 #include <cstdint>
-#include <Arduino.h> 
+#include <Arduino.h>
+#include "soc/gpio_struct.h"
+#include "RingBuffer.h"
+#include "EdgeDebouncer.h"
 
 // ---------------------------------------------------------
 // Das Event-Objekt (Ergebnis)
 // ---------------------------------------------------------
+enum class KeyEventType : uint8_t {
+    PRESS,          // Einzeltaste (nach dem Chord-Fenster, Chord-Tasten beim Loslassen) oder Chord
+    LONG_PRESS,     // Taste(n) länger als die Long-Press-Zeit gehalten
+    REPEAT,         // Wiederholung nach LONG_PRESS, solange gehalten
+    DOUBLE_PRESS    // Zweiter Druck derselben Taste kurz nach dem ersten (statt des zweiten PRESS, nur mit setDoublePress)
+};
+
+// Die Bitmaske ist direkt die GPIO-Maske (Bit n = GPIO n), ein Pin-Mapping braucht es daher nicht.
+// IsSingle(MODE_BUTTON) ist damit ein einziger Vergleich mit einer Konstanten.
 struct KeyEvent {
-    uint16_t mask;                  // Die Bitmaske der gedrückten Tasten
-    const std::vector<int>* pinMap; // Referenz auf die Pin-Konfiguration
+    uint32_t mask;                  // Die gedrückten Tasten (Bit = GPIO-Nummer)
+    KeyEventType type;
+    uint32_t pressTimeUs;           // Flanke, mit der der Druck begann (µs, 32 bit)
 
     // Konstruktoren
-    KeyEvent(uint16_t m, const std::vector<int>* pMap);
-    KeyEvent();
+    constexpr KeyEvent(uint32_t m, KeyEventType t = KeyEventType::PRESS, uint32_t pressUs = 0)
+        : mask(m), type(t), pressTimeUs(pressUs) {}
+    constexpr KeyEvent() : mask(0), type(KeyEventType::PRESS), pressTimeUs(0) {}
 
-    // API Methoden
-    bool IsSingle(int pinId) const;
-    bool IsChord(int pinIdA, int pinIdB) const;
+    static constexpr uint32_t pinBit(int pinId) { return 1UL << pinId; }
 
+    // API Methoden
+    // IsSingle/IsChord: nur normale Drücke (PRESS), wie bisher
+    constexpr bool IsSingle(int pinId) const { return is(KeyEventType::PRESS, pinBit(pinId)); }
+    constexpr bool IsChord(int pinIdA, int pinIdB) const {
+        // Prüfen ob GENAU diese zwei Bits gesetzt sind
+        return pinIdA != pinIdB && is(KeyEventType::PRESS, pinBit(pinIdA) | pinBit(pinIdB));
+    }
+    constexpr bool IsLongPress(int pinId) const { return is(KeyEventType::LONG_PRESS, pinBit(pinId)); }
+    constexpr bool IsRepeat(int pinId) const { return is(KeyEventType::REPEAT, pinBit(pinId)); }
+    constexpr bool IsDoublePress(int pinId) const { return is(KeyEventType::DOUBLE_PRESS, pinBit(pinId)); }
 
 private:
-    // Interne Hilfsmethode: Wandelt Pin-ID in Bit-Index um
-    int getBitIndex(int pinId) const;
+    constexpr bool is(KeyEventType t, uint32_t m) const { return type == t && mask == m; }
 };
 
 // ---------------------------------------------------------
-// Die Input-Manager Klasse (Logik)
+// Die Input-Manager Klasse (Logik, unabhängig von der Pin-Liste)
+// Wird von den Modes benutzt; die Hardware-Anbindung macht ChordInput<Pins...>.
 // ---------------------------------------------------------
-class ChordInput {
+class ChordRecognizer {
 public:
-    // Konstruktor: Erwartet eine Liste von Pins (z.B. {12, 14, 27})
-    ChordInput(std::initializer_list<int> pins);
+    virtual ~ChordRecognizer() {}
 
-    // Muss regelmäßig im Timer/Loop aufgerufen werden
+    // Verarbeitet die aufgelaufenen Flanken; einmal pro loop() aufrufen.
+    // Die Flanken kommen mit Zeitstempel aus der ISR, ein beschäftigter Loop verliert also nichts.
     void tick();
 
     // Prüfen ob Events da sind
     bool hasEvent();
 
     // bricht den gerade pendenten Tastendruck (Chord) ab.
-    // er wird dann beim Loslassen der Tasten nicht als Event ausgegeben
+    // Bis zum Loslassen aller Tasten kommen dafür keine Events mehr (auch kein LONG_PRESS/REPEAT).
     void CancelCurrentChord();
 
-    // Liefert true, wenn der Button momentan aktiv ist.
-    bool IsKeyDown(int pinId);
+    // Zeiten in ms. chordWindow: so lange wird nach dem ersten Druck auf eine zweite Taste gewartet.
+    void setTiming(uint16_t chordWindowMs, uint16_t longPressMs, uint16_t repeatMs, uint16_t doublePressMs);
+
+    // Für diese Taste kommt der PRESS erst beim Loslassen (wie früher).
+    // Nötig, wenn "Taste halten + Drehen" etwas anderes bedeuten soll (siehe ModeConfig).
+    void setReleaseTriggered(int pinId, bool releaseTriggered);
+
+    // Diese zwei Tasten bilden einen Chord. Ihr Einzel-PRESS wird zurückgehalten, bis der Chord
+    // ausgeschlossen ist (Loslassen ohne zweite Taste), sonst käme er vor dem Chord an.
+    void addChord(int pinIdA, int pinIdB);
+
+    // Für diese Taste wird ein zweiter Druck kurz nach dem ersten als DOUBLE_PRESS gemeldet,
+    // statt als zweiter PRESS. Ohne das kommen zwei PRESS.
+    void setDoublePress(int pinId, bool enabled);
+
+    // Liefert true, wenn der Button momentan (entprellt) gedrückt ist.
+    bool IsKeyDown(int pinId) const { return (_debouncer.stableMask() & KeyEvent::pinBit(pinId)) != 0; }
 
     // Das nächste Event holen
     KeyEvent popEvent();
@@ -55,16 +89,97 @@ public:
     // Gibt die Zeit des letzten erkannten Inputs zurück (in Mikrosekunden seit Boot)
     int64_t getLastInputTime() const;
 
+    // Anzahl verworfener Flanken (Puffer voll)
+    uint32_t getDroppedEdges() const { return _droppedEdges; }
+
+protected:
+    ChordRecognizer();
+
+    // Setzt den Ausgangszustand (aus begin() der Hardware-Klasse)
+    void start(uint32_t mask);
+    // Aus der ISR: aktueller Zustand aller Tasten (1 = gedrückt)
+    void IRAM_ATTR onEdge(uint32_t mask);
+    // Aktueller Zustand direkt von der Hardware (außerhalb der ISR, z.B. nach Pufferüberlauf)
+    virtual uint32_t readPins() const = 0;
+
 private:
-    std::vector<int> _pins;           // Speichert die Pin-IDs
-    std::queue<KeyEvent> _eventQueue; // Warteschlange
-    uint16_t _currentSequence;        // Aktuell gedrückte Tasten (Bitmaske)
+    static constexpr uint32_t DEBOUNCE_US = 10000;
+    static constexpr uint16_t DEFAULT_CHORD_WINDOW_MS = 60;
+    static constexpr uint16_t DEFAULT_LONG_PRESS_MS   = 600;
+    static constexpr uint16_t DEFAULT_REPEAT_MS       = 200;
+    static constexpr uint16_t DEFAULT_DOUBLE_PRESS_MS = 300;
+
+    // Eine Flanke aus der ISR: Zeitstempel (µs, 32 bit) und alle Tasten danach (Bitmaske, 1 = gedrückt)
+    struct Edge {
+        uint32_t timeUs;
+        uint32_t mask;
+    };
+
+    RingBuffer<Edge, 64> _edges;      // ISR -> tick()
+    RingBuffer<KeyEvent, 8> _events;  // Warteschlange (fest, ohne Heap)
+    volatile uint32_t _isrLastMask;   // letzter von der ISR gemeldeter Zustand
+    volatile uint32_t _droppedEdges;
+    volatile bool _overflow;
+    EdgeDebouncer _debouncer;
+    uint32_t _currentSequence;        // Aktuell gedrückte Tasten (Bitmaske)
     bool _isRecording;                // Status-Flag
     bool _currentChordIsCancelled;    // true, wenn der aktuell recordete Chrod gecancelled wurde
-    long lastButtonCheck =0;          // millis des letzten Checks
+    bool _emitted;                    // für die aktuelle Sequenz wurde schon ein Event erzeugt
+    uint32_t _emittedMask;            // ... und zwar für diese Tasten
+    bool _longPressFired;
+    uint32_t _pressStartUs;           // Beginn der Sequenz (bzw. des Chords)
+    uint32_t _nextRepeatUs;
+    uint32_t _lastSingleMask;         // für DOUBLE_PRESS: letzte Einzeltaste ...
+    uint32_t _lastSingleUs;           // ... und wann sie gedrückt wurde
+    uint32_t _releaseTriggeredMask;
+    uint32_t _chordKeysMask;          // Tasten, die zu einem Chord gehören
+    uint32_t _doublePressMask;
+    uint32_t _chordWindowUs;
+    uint32_t _longPressUs;
+    uint32_t _repeatUs;
+    uint32_t _doublePressUs;
     int64_t _lastInputTime = 0;       // Zeitstempel des letzten Inputs (esp_timer_get_time())
-    // Hilfsmethode zum Hardware-Lesen
-    uint16_t readHardware();
+
+    // Ein entprellter Zustandswechsel; atUs ist der Zeitpunkt der auslösenden Flanke
+    void applyStable(uint32_t mask, uint32_t atUs, int64_t nowUs, uint32_t nowUs32);
+    // Zeitgesteuerte Events (Chord-Fenster abgelaufen, Long-Press, Repeat) bis zum Zeitpunkt nowUs
+    void applyTime(uint32_t nowUs);
+    void emit(KeyEventType type, uint32_t mask);
+};
+
+// ---------------------------------------------------------
+// Hardware-Anbindung mit Pin-Liste zur Compile-Zeit, z.B. ChordInput<8, 10, 9>.
+// Tasten sind Active Low (INPUT_PULLUP); gelesen wird mit EINEM Zugriff auf GPIO.in.
+// ---------------------------------------------------------
+template <uint8_t... Pins>
+class ChordInput : public ChordRecognizer {
+    static_assert(sizeof...(Pins) > 0, "ChordInput: mindestens ein Pin");
+    static_assert(((Pins < 32) && ...), "ChordInput: nur GPIO 0..31 (GPIO.in)");
+
+public:
+    static constexpr uint32_t PIN_MASK = ((1UL << Pins) | ...);
+
+    ChordInput() {}
+
+    // Pins konfigurieren und die Flanken-Interrupts anhängen (in setup() aufrufen)
+    void begin() {
+        (pinMode(Pins, INPUT_PULLUP), ...);
+        start(readHardware());
+        (attachInterruptArg(digitalPinToInterrupt(Pins), isrHandler, this, CHANGE), ...);
+    }
+
+    static inline __attribute__((always_inline)) uint32_t readHardware() {
+        // Logik: Active LOW (Taste gedrückt = LOW)
+        return ~GPIO.in.val & PIN_MASK;
+    }
+
+protected:
+    uint32_t readPins() const override { return readHardware(); }
+
+private:
+    static void IRAM_ATTR isrHandler(void* arg) {
+        static_cast<ChordInput*>(arg)->onEdge(readHardware());
+    }
 };
 
-#endif
\ No newline at end of file
+#endif
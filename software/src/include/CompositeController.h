@@ -0,0 +1,74 @@
+#ifndef COMPOSITECONTROLLER_H
+#define COMPOSITECONTROLLER_H
+
+#include "FanController.h"
+
+// Mehrere Controller gleichzeitig (z.B. BLE fürs Handy, MQTT für den Server, HTTP fürs lokale Dashboard,
+// USB für einen Rechner im Fahrzeug, Timer als Rückfall).
+// Status geht an alle Mitglieder (das JSON wird über FanController::statusJson nur einmal gebaut),
+// ihre Kommandos laufen durch eine Arbitrierung:
+//   - Standard: das letzte Kommando gewinnt.
+//   - Hat ein höher priorisiertes Mitglied vor weniger als holdMs geschrieben, werden Kommandos
+//     niedriger priorisierter Mitglieder zurückgestellt (z.B. Timer darf das Handy nicht sofort überstimmen).
+//     Je Mitglied bleibt das letzte zurückgestellte Kommando stehen und wird nach Ablauf der Sperre
+//     aus loop() nachgeholt (mehrere in der Reihenfolge, in der sie kamen).
+// Die Mitglieder liefern ihre Kommandos aus ihrem loop() (BLE und HTTP puffern sie aus ihren Tasks),
+// der Callback läuft also im Loop. Die Arbitrierung läuft trotzdem unter _lock, der Callback außerhalb.
+// Die Mitglieder werden vorher einzeln mit begin() gestartet (unterschiedliche Parameter).
+class CompositeController : public FanController {
+public:
+    static constexpr int MAX_MEMBERS = 5;
+
+    CompositeController();
+
+    // priority: kleiner = wichtiger. false, wenn kein Platz mehr ist.
+    bool add(FanController& member, uint8_t priority);
+    void setHoldMs(uint32_t holdMs) { _holdMs = holdMs; }
+    int memberCount() const { return _count; }
+
+    void begin(const char* deviceName = nullptr) override;
+    void setCommandCallback(CommandCallback cb) override;
+    void notifyStatus(const MaxFanState& state) override;
+    void loop() override;
+    bool isConnected() override;
+    Icon getIcon() override;
+    char getIndicatorLetter() override;
+    int getIndicators(Indicator* out, int max) override;
+
+private:
+    // Messung des Mehraufwands pro Loop, geloggt alle STATS_INTERVAL_MS
+    static constexpr uint32_t STATS_INTERVAL_MS = 30000;
+
+    struct Member {
+        FanController* controller;
+        uint8_t priority;
+        // Zuletzt zurückgestelltes Kommando, deferredSeq = 0: keins
+        uint32_t deferredSeq;
+        char deferred[MAX_COMMAND + 1];
+    };
+
+    Member _members[MAX_MEMBERS];
+    int _count;
+    CommandCallback _cb;
+    uint32_t _holdMs;
+
+    // Schützt _lastWriter, _lastWriteMs, _dropped und die zurückgestellten Kommandos
+    portMUX_TYPE _lock;
+    int _lastWriter;          // Index des letzten angenommenen Kommandos, -1 = keins
+    uint32_t _lastWriteMs;
+    uint32_t _dropped;        // zählt auch die Reihenfolge der zurückgestellten Kommandos
+
+    uint32_t _statsStartMs;
+    uint32_t _statsLoops;
+    int64_t _statsTotalUs;
+    int64_t _statsMaxUs;
+
+    void onMemberCommand(int index, const char* json);
+    // Vorrang eines anderen Mitglieds sperrt dieses noch (nur unter _lock)
+    bool isHeldOff(int index, uint32_t now) const;
+    // Holt das älteste nicht mehr gesperrte zurückgestellte Kommando nach
+    void replayDeferred();
+    void accountLoop(int64_t elapsedUs);
+};
+
+#endif
@@ -0,0 +1,229 @@
+#ifndef CONFIG_JOBS_H
+#define CONFIG_JOBS_H
+
+#include <Arduino.h>
+#include <vector>
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+#include <HTTPClient.h>
+#include "MaxFanConfig.h"
+#include "ReleaseCache.h"
+#include "OtaWriter.h"
+#include "MqttOtaReceiver.h"
+#include "MaxFanMQTT.h"
+
+// ---------------------------------------------------------
+// Lange Aktionen des Config-Menüs als kooperative Zustandsautomaten.
+// ModeConfig ruft step() in jedem loop() auf; jeder Schritt macht nur ein kleines
+// Stück Arbeit und kehrt sofort zurück. So laufen IR, Controller, Encoder und Tasten weiter.
+// Noch blockierend (kurz): DNS-Auflösung und der TLS-Handshake samt GET-Header.
+// ---------------------------------------------------------
+class ConfigJob {
+public:
+    enum class Result { RUNNING, SUCCESS, FAILED, CANCELLED };
+
+    virtual ~ConfigJob() {}
+
+    virtual const char* title() const = 0;
+    virtual Result step() = 0;
+    // Bricht ab und räumt auf (Verbindungen, angefangenes Update)
+    virtual void cancel() = 0;
+    // 0..100, -1 = unbekannt (Spinner)
+    virtual int progress() const { return -1; }
+
+    // Aktuelle Phase, bzw. nach dem Ende Ergebnis oder Fehler
+    const char* message() const { return _message; }
+    const char* detail() const { return _detail; }
+
+protected:
+    enum class WiFiStep { START, CONNECTING, DONE };
+
+    char _message[32];
+    char _detail[48];
+    WiFiStep _wifiStep;
+
+    ConfigJob();
+    void setMessage(const char* message, const char* detail = "");
+    Result fail(const char* message, const char* detail = "");
+
+    // Setzt den WiFi-Schritt zurück, danach stepWiFi() aufrufen
+    void startWiFi() { _wifiStep = WiFiStep::START; }
+    // https:// über den TLS-Client (ohne Zertifikatsprüfung), http:// (lokale Server) über den einfachen
+    static bool beginHttp(HTTPClient& http, WiFiClientSecure& secureClient, WiFiClient& plainClient, const String& url);
+    // Baut bei Bedarf die WiFi-Verbindung mit den Daten aus cfg auf (nicht blockierend).
+    // reconnect = true trennt vorher (echter Verbindungstest).
+    Result stepWiFi(const ConfigData& cfg, bool reconnect = false);
+    void cancelWiFi();
+};
+
+// --- Wi-Fi Test ---
+class WifiTestJob : public ConfigJob {
+public:
+    void start(const ConfigData& cfg);
+    const char* title() const override { return "Wi-Fi Test"; }
+    Result step() override;
+    void cancel() override;
+
+private:
+    const ConfigData* _cfg = nullptr;
+};
+
+// --- MQTT Test (TCP-Connect zum Broker) ---
+class MqttTestJob : public ConfigJob {
+public:
+    void start(const ConfigData& cfg);
+    const char* title() const override { return "MQTT Test"; }
+    Result step() override;
+    void cancel() override;
+
+private:
+    static constexpr uint32_t CONNECT_TIMEOUT_MS = 5000;
+    enum class Step { WIFI, RESOLVE, CONNECT };
+
+    const ConfigData* _cfg = nullptr;
+    Step _step = Step::WIFI;
+    int _sock = -1;
+    uint32_t _connectStartMs = 0;
+
+    void closeSocket();
+};
+
+// --- Release-Liste von GitHub ---
+// Über -DMAXFAN_RELEASES_URL=... auf einen lokalen Testserver umstellbar (auch http://)
+#ifndef MAXFAN_RELEASES_URL
+#define MAXFAN_RELEASES_URL "https://api.github.com/repos/Matthias-Hess/MaxMan/releases"
+#endif
+
+// Die Antwort wird direkt aus dem HTTP-Stream geparst, ein Release pro step().
+// Im Speicher liegt nur das gefilterte Element, egal wie groß die Antwort ist.
+// Geblättert wird mit per_page/page, bis eine Seite nicht voll ist oder MAX_RELEASES erreicht sind.
+// Mit Cache fragt Seite 1 per If-None-Match; bei 304 gilt die gespeicherte Liste
+// (neue Releases landen immer auf Seite 1, deren ETag ändert sich also mit).
+class ReleaseFetchJob : public ConfigJob {
+public:
+    // Lädt auch den Cache, cachedReleases() ist danach sofort verfügbar
+    void start(const ConfigData& cfg);
+    const char* title() const override { return "Check for Updates"; }
+    Result step() override;
+    void cancel() override;
+
+    // Nach SUCCESS: aktuelle Liste (bei 304 die aus dem Cache)
+    const std::vector<ReleaseInfo>& releases() const { return _releases; }
+
+    bool hasCache() const { return !_cached.empty(); }
+    const std::vector<ReleaseInfo>& cachedReleases() const { return _cached; }
+    // Server hat mit 304 geantwortet, releases() == cachedReleases()
+    bool notModified() const { return _notModified; }
+
+    static constexpr size_t MAX_RELEASES = 20;
+
+private:
+    static constexpr uint32_t READ_TIMEOUT_MS = 10000;
+    static constexpr int PER_PAGE = 10;
+    // 2 KB für ein gefiltertes Release: tag_name + Assets (Name, URL). Pro Asset ca. 48 B Knoten
+    // und 120-140 B Text, also Platz für gut 10 Assets. Mehr endet in NoMemory ("JSON Error").
+    static constexpr size_t ELEMENT_DOC_SIZE = 2048;
+    enum class Step { WIFI, REQUEST, FIND_ARRAY, ELEMENT };
+
+    const ConfigData* _cfg = nullptr;
+    Step _step = Step::WIFI;
+    WiFiClientSecure _client;
+    WiFiClient _plainClient;
+    HTTPClient _http;
+    Stream* _stream = nullptr;
+    int _page = 1;
+    int _pageCount = 0;           // Elemente auf der aktuellen Seite
+    std::vector<ReleaseInfo> _releases;
+
+    std::vector<ReleaseInfo> _cached;
+    String _etag;                 // aus dem Cache, für If-None-Match
+    String _newEtag;              // aus der Antwort, wird mit der neuen Liste gespeichert
+    bool _notModified = false;
+
+    // Freier Heap beim Start und das Minimum während des Abrufs (Log)
+    uint32_t _startHeap = 0;
+    uint32_t _minHeap = 0;
+
+    Result requestPage();
+    Result parseElement();
+    Result finish();
+    void noteHeap();
+};
+
+// --- OTA-Update per HTTP(S) ---
+// Eigener Download, damit er abbrechbar ist und Fortschritt zeigt.
+// Mit Manifest (GitHub-Release oder lokaler Server): Version und SHA-256 werden geprüft,
+// ein gzip-Image wird beim Schreiben entpackt. Reicht der Heap dafür nicht, wird die rohe
+// Datei aus dem Manifest geladen. Ohne Manifest (alte Releases): rohe .bin, nur die Prüfung von Update.
+class OtaJob : public ConfigJob {
+public:
+    // tagName leer: jede Version aus dem Manifest wird akzeptiert (lokale Quelle)
+    void start(const ConfigData& cfg, const String& tagName, const String& binUrl, const String& manifestUrl);
+    const char* title() const override { return "Firmware Update"; }
+    Result step() override;
+    void cancel() override;
+    int progress() const override;
+
+private:
+    static constexpr uint32_t READ_TIMEOUT_MS = 15000;
+    static constexpr size_t CHUNK = 1024;
+    static constexpr int MAX_MANIFEST_SIZE = 1024;
+    enum class Step { WIFI, MANIFEST, REQUEST, WRITE, FINISH };
+
+    const ConfigData* _cfg = nullptr;
+    Step _step = Step::WIFI;
+    String _tagName;
+    String _url;
+    String _rawUrl;               // Fallback ohne Kompression (aus dem Manifest)
+    String _manifestUrl;
+    WiFiClientSecure _client;
+    WiFiClient _plainClient;
+    HTTPClient _http;
+
+    OtaManifest _manifest;
+    bool _hasManifest = false;
+    bool _compressed = false;
+    OtaWriter _writer;
+
+    int _total = 0;               // Download-Größe
+    int _downloaded = 0;
+    uint32_t _startMs = 0;
+    uint32_t _lastDataMs = 0;
+    uint8_t _buf[CHUNK];
+
+    Result fetchManifest();
+    Result request();
+    Result write();
+    Result finish();
+    Result abort(const char* message, const char* detail = "");
+};
+
+// --- OTA-Update per MQTT ---
+// Schaltet den Empfänger scharf und wartet, bis ein Host (tools/mqtt_ota.py) das Image schickt.
+// Nutzt die gespeicherten MQTT-Einstellungen; ist MQTT nicht der aktive Controller,
+// wird die Verbindung hier aufgebaut, bedient und am Ende (auch bei Fehler/Abbruch) getrennt.
+class MqttOtaJob : public ConfigJob {
+public:
+    void start(const ConfigData& cfg, MqttController& controller);
+    const char* title() const override { return "MQTT Update"; }
+    Result step() override;
+    void cancel() override;
+    int progress() const override { return _receiver.progress(); }
+
+private:
+    static constexpr uint32_t CONNECT_TIMEOUT_MS = 15000;
+    static constexpr uint32_t DATA_TIMEOUT_MS = 30000;
+    enum class Step { WIFI, CONNECT, RECEIVE };
+
+    const ConfigData* _cfg = nullptr;
+    MqttController* _controller = nullptr;
+    bool _ownsClient = false;       // Client erst für das Update gestartet: danach wieder trennen
+    MqttOtaReceiver _receiver;
+    Step _step = Step::WIFI;
+    uint32_t _stepStartMs = 0;
+    uint32_t _startMs = 0;
+
+    Result stop(Result result);
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef DISPLAYFLUSH_H
+#define DISPLAYFLUSH_H
+
+#include <Arduino.h>
+#include <U8g2lib.h>
+
+// Bild ans OLED schicken, ohne den Loop zu blockieren (statt sendBuffer()).
+//
+// submit() kopiert den U8g2-Puffer (1 KB) in einen Zwischenpuffer und weckt den Display-Task; der Loop
+// zeichnet sofort weiter. Der Task schickt nur die Pages (8-Pixel-Zeilen) und darin nur den Bereich,
+// der sich gegenüber dem zuletzt gesendeten Bild geändert hat. Kommt ein neues Bild, bevor das letzte
+// gesendet ist, wird das ältere verworfen (Metrik dispDrop): gesendet wird immer das neueste.
+//
+// Der Task läuft eine Stufe über dem Loop. Während der I2C-Übertragung wartet er auf den Treiber,
+// die CPU gehört dann dem Loop; er verdrängt ihn nur kurz, um das nächste Stück anzustoßen.
+//
+// Alles, was danach noch direkt mit dem Display spricht (Power-Save), geht auch über diese Klasse,
+// damit nur ein Task den I2C-Bus benutzt.
+//
+// Vergleich: -DMAXFAN_DISPLAY_SYNC=1 schickt wie früher synchron aus dem Loop. Gemessen wird in beiden
+// Fällen die längste Blockade des Loops durch submit()/setPowerSave() (Metrik dispStall, µs).
+class DisplayFlush {
+public:
+    static constexpr uint32_t TASK_STACK = 3072;
+    static constexpr size_t FRAME_BYTES = 1024;   // 128x64, 1 Bit pro Pixel
+
+    // Nach display.begin() und Wire.setClock(). Vorher (und ohne Task) schickt submit() synchron.
+    static void begin(U8G2& display);
+
+    // Statt display.sendBuffer()
+    static void submit(U8G2& display);
+    // Statt display.setPowerSave(); wird in Reihenfolge mit den Bildern ausgeführt
+    static void setPowerSave(U8G2& display, bool on);
+    // Wartet, bis alles gesendet ist (z.B. vor einem Neustart). false bei Zeitüberschreitung.
+    static bool waitIdle(uint32_t timeoutMs);
+
+    // Längste Blockade des Loops durch das Display seit dem Start
+    static uint32_t maxStallUs();
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef EDGE_DEBOUNCER_H
+#define EDGE_DEBOUNCER_H
+
+#include <cstdint>
+
+// Entprellt eine Tasten-Bitmaske (bis 32 Tasten) anhand von Flanken-Zeitstempeln (Mikrosekunden, 32 bit, Überlauf-fest).
+// Ein Rohzustand gilt als stabil, wenn er mindestens debounceUs lang anliegt.
+// Reine Logik ohne Hardware- oder Uhrzugriff: die Zeit kommt immer von außen
+// (ISR-Zeitstempel bzw. aktuelle Uhr), damit sich Flankenfolgen auch auf dem Host abspielen lassen.
+class EdgeDebouncer {
+public:
+    explicit EdgeDebouncer(uint32_t debounceUs = 10000)
+        : _debounceUs(debounceUs), _rawMask(0), _rawSince(0), _stableMask(0) {}
+
+    // Setzt Roh- und stabilen Zustand ohne Übergang (z.B. beim Start oder nach Überlauf des Flanken-Puffers)
+    void reset(uint32_t mask, uint32_t nowUs) {
+        _rawMask = mask;
+        _rawSince = nowUs;
+        _stableMask = mask;
+    }
+
+    // Neue Flanke (Rohzustand nach der Flanke). Hat der vorherige Rohzustand lange genug angelegt,
+    // wird er stabil: dann true, neuer stabiler Zustand in stableOut, Zeitpunkt in atUs.
+    bool feed(uint32_t edgeUs, uint32_t rawMask, uint32_t& stableOut, uint32_t& atUs) {
+        if (rawMask == _rawMask) return false;
+        bool committed = commit(edgeUs, stableOut, atUs);
+        _rawMask = rawMask;
+        _rawSince = edgeUs;
+        return committed;
+    }
+
+    // Ohne neue Flanke: ist der aktuelle Rohzustand inzwischen stabil?
+    bool poll(uint32_t nowUs, uint32_t& stableOut, uint32_t& atUs) {
+        return commit(nowUs, stableOut, atUs);
+    }
+
+    uint32_t stableMask() const { return _stableMask; }
+
+private:
+    uint32_t _debounceUs;
+    uint32_t _rawMask;
+    uint32_t _rawSince;
+    uint32_t _stableMask;
+
+    bool commit(uint32_t nowUs, uint32_t& stableOut, uint32_t& atUs) {
+        if (_rawMask == _stableMask) return false;
+        if ((uint32_t)(nowUs - _rawSince) < _debounceUs) return false;
+        _stableMask = _rawMask;
+        stableOut = _stableMask;
+        atUs = _rawSince;
+        return true;
+    }
+};
+
+#endif
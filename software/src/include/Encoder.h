@@ -1,6 +1,8 @@
 #pragma once
 
 #include <Arduino.h>
+#include <atomic>
+#include "QuadratureDecoder.h"
 
 class Encoder
 {
@@ -13,18 +15,44 @@ public:
     int getPosition();
     void reset();
 
-    // Gibt die Zeit des letzten erkannten Inputs zurück (in Mikrosekunden seit Boot)
+    // Gibt die Zeit des letzten erkannten Inputs zurück (in Mikrosekunden seit Boot).
+    // Auflösung: Aufrufintervall von getDelta()/getLastInputTime(), die ISR nimmt keine Zeit.
     int64_t getLastInputTime() const;
 
+    // Geschätzte Drehgeschwindigkeit in Rastungen pro Sekunde (0 nach kurzer Pause)
+    uint32_t getVelocity() const;
+    // Schrittweite für schnelles Drehen: 1, 2 oder 4
+    int getStepMultiplier() const;
+
+    // Verworfene Übergänge (beide Spuren gleichzeitig gewechselt, z.B. Prellen)
+    uint32_t getInvalidTransitions() const { return _decoder.invalidTransitions(); }
+
 private:
+    // Geschwindigkeit verfällt, wenn so lange keine Rastung kam
+    static constexpr int64_t  VELOCITY_TIMEOUT_US = 200000;
+    static constexpr uint32_t FAST_VELOCITY       = 8;    // Rastungen/s -> Schrittweite 2
+    static constexpr uint32_t VERY_FAST_VELOCITY  = 16;   // Rastungen/s -> Schrittweite 4
+
     static void IRAM_ATTR isrHandler(void* arg);
     void IRAM_ATTR handleISR();
 
     uint8_t pinA;
     uint8_t pinB;
 
-    volatile int delta;
-    volatile int position;
-    volatile uint8_t lastState;
-    volatile int64_t _lastInputTime;
+    // Nur die ISR schreibt _count (ein Schreiber -> Laden/Speichern genügt, keine Interrupt-Sperre).
+    // Die Leser merken sich, wie viel sie schon verbraucht haben.
+    QuadratureDecoder _decoder;
+    std::atomic<int32_t> _count;
+    int32_t _consumed;                // von getDelta() verbrauchte Viertelschritte
+    int32_t _positionBase;            // Zählerstand bei reset()
+
+    // Aktivität wird beim Lesen erkannt (Zähler hat sich geändert), nicht in der ISR
+    mutable int32_t _seenCount;
+    mutable int64_t _lastInputTime;
+
+    // Geschwindigkeit (Rastungen/s, geglättet)
+    int64_t _lastDetentTime;
+    uint32_t _velocity;
+
+    void noteActivity(int32_t count) const;
 };
@@ -7,7 +7,10 @@
 
 class FanController {
 public:
-    typedef std::function<void(const String&)> CommandCallback;
+    // JSON-Kommando, nullterminiert. Gilt nur während des Aufrufs (liegt meist auf dem Stack).
+    typedef std::function<void(const char* json)> CommandCallback;
+    // Längere Kommandos verwerfen die Controller
+    static constexpr size_t MAX_COMMAND = 256;
     virtual ~FanController() {}
     virtual void begin(const char* deviceName = nullptr) = 0;
     virtual void setCommandCallback(CommandCallback cb) = 0;
@@ -15,12 +18,29 @@ public:
     virtual void loop() = 0;
     virtual bool isConnected() = 0;
     // Icon type for display
-    enum Icon { ICON_NONE = 0, ICON_BLE = 1, ICON_MQTT = 2, ICON_TIMER = 3 };
+    enum Icon { ICON_NONE = 0, ICON_BLE = 1, ICON_MQTT = 2, ICON_TIMER = 3, ICON_HTTP = 4, ICON_SERIAL = 5 };
 
     // Returns the icon to use for display.
     virtual Icon getIcon() = 0;
     // Returns a single-character indicator when connection is partial (e.g. 'W','R','C','B'), or '\0' when none.
     virtual char getIndicatorLetter() = 0;
+
+    // Für die Anzeige: ein Eintrag je Verbindung (CompositeController: je Mitglied)
+    struct Indicator {
+        Icon icon;
+        bool connected;
+        char letter;
+    };
+    virtual int getIndicators(Indicator* out, int max) {
+        if (max < 1) return 0;
+        out[0] = { getIcon(), isConnected(), getIndicatorLetter() };
+        return 1;
+    }
+
+    // Status-JSON, nur bei Änderung neu serialisiert. Alle Controller teilen sich das Ergebnis,
+    // bei mehreren aktiven Controllern wird also nur einmal kodiert. Nur aus dem Loop-Task aufrufen.
+    // Fester Puffer: gültig bis zum nächsten Aufruf mit anderem Zustand.
+    static const char* statusJson(const MaxFanState& state);
 };
 
 #endif
@@ -0,0 +1,58 @@
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include <U8g2lib.h>
+#include <stdint.h>
+
+// Vorgerasterte Zeichen einer großen Schrift (z.B. helvB18 für die Anzeige von Drehzahl/Temperatur).
+//
+// build() zeichnet jedes Zeichen einmal mit U8g2 in den Bildpuffer und schneidet es dort aus, das
+// Ergebnis sieht also genau aus wie drawGlyph(). Danach kopiert drawGlyph() nur noch Spalten-Bytes
+// in den Puffer: kein Font-Decoder (Glyphensuche, RLE) und keine Strings pro Frame.
+//
+// Spalten werden im Format des SSD1306-Puffers abgelegt (vertikale Bytes, Bit 0 = oberste Zeile),
+// drawGlyph() setzt also einen Full-Buffer-Treiber mit diesem Layout voraus (U8G2_SSD1306_..._F_...).
+// Gezeichnet wird wie mit setFontMode(1) und DrawColor 1: gesetzte Pixel werden ODER-verknüpft.
+class GlyphAtlas {
+public:
+    static constexpr uint8_t MAX_GLYPHS = 20;
+    static constexpr uint16_t MAX_BYTES = 768;
+    // Zeichen höher als CAPTURE_HEIGHT oder breiter als CAPTURE_WIDTH werden abgeschnitten
+    static constexpr int CAPTURE_HEIGHT = 32;
+    static constexpr int CAPTURE_WIDTH = 48;
+
+    // Rastert die Zeichen codes (U8g2-Encoding, z.B. 0xB0 für °). Löscht den Bildpuffer.
+    // false: kein Platz mehr, ready() bleibt false.
+    bool build(U8G2& u8g2, const uint8_t* font, const uint16_t* codes, uint8_t count);
+    bool ready() const { return _ready; }
+
+    // Wie U8G2::drawGlyph: Grundlinie y, liefert den Vorschub; unbekannte Zeichen: 0
+    int drawGlyph(U8G2& u8g2, int x, int y, uint16_t code) const;
+    // Zeichenfolge (ASCII, 0xB0 = °), liefert das x hinter dem letzten Zeichen
+    int drawStr(U8G2& u8g2, int x, int y, const char* text) const;
+    // Ganze Zahl ohne Umweg über einen String
+    int drawNumber(U8G2& u8g2, int x, int y, int value) const;
+
+    uint16_t bytesUsed() const { return _used; }
+
+private:
+    struct Glyph {
+        uint16_t code;
+        uint16_t offset;    // in _bits
+        int8_t left;        // erste Spalte relativ zum Stift
+        int8_t top;         // oberste Zeile relativ zur Grundlinie (negativ = darüber)
+        uint8_t width;
+        uint8_t height;
+        uint8_t advance;
+    };
+
+    Glyph _glyphs[MAX_GLYPHS];
+    uint8_t _bits[MAX_BYTES];
+    uint8_t _count = 0;
+    uint16_t _used = 0;
+    bool _ready = false;
+
+    const Glyph* find(uint16_t code) const;
+};
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef GZIP_INFLATER_H
+#define GZIP_INFLATER_H
+
+#include <Arduino.h>
+#include "esp32c3/rom/miniz.h"
+
+// Entpackt einen gzip-Stream stückweise (tinfl aus dem ROM, kein Flash-Verbrauch).
+// Braucht während des Entpackens ~43 KB Heap (32 KB Fenster + Dekompressor),
+// begin() holt ihn, end() gibt ihn frei.
+// Die Prüfsumme im gzip-Trailer wird nicht geprüft, nur die Länge; die Integrität
+// sichert der SHA-256 aus dem Manifest.
+class GzipInflater {
+public:
+    // Bekommt die entpackten Daten; false bricht ab
+    typedef bool (*Sink)(void* context, const uint8_t* data, size_t length);
+
+    enum class Status { RUNNING, DONE, FAILED };
+
+    ~GzipInflater() { end(); }
+
+    bool begin();
+    void end();
+
+    // Beliebig große Stücke des komprimierten Streams
+    Status feed(const uint8_t* data, size_t length, Sink sink, void* context);
+
+    uint32_t outputSize() const { return _outputSize; }
+    const char* error() const { return _error; }
+
+private:
+    static constexpr size_t DICT_SIZE = TINFL_LZ_DICT_SIZE;
+
+    enum class State { HEADER, EXTRA_LENGTH, EXTRA, NAME, COMMENT, HEADER_CRC, DEFLATE, TRAILER, DONE, FAILED };
+
+    // gzip-Header-Flags (RFC 1952)
+    static constexpr uint8_t FLAG_HCRC = 0x02;
+    static constexpr uint8_t FLAG_EXTRA = 0x04;
+    static constexpr uint8_t FLAG_NAME = 0x08;
+    static constexpr uint8_t FLAG_COMMENT = 0x10;
+
+    tinfl_decompressor* _decompressor = nullptr;
+    uint8_t* _dict = nullptr;
+    size_t _dictPos = 0;
+
+    State _state = State::HEADER;
+    uint8_t _flags = 0;
+    uint8_t _buf[10];             // Header bzw. Trailer
+    size_t _bufCount = 0;
+    size_t _skip = 0;
+    uint32_t _outputSize = 0;
+    const char* _error = "";
+
+    bool headerByte(uint8_t b);
+    void afterHeaderField();
+    Status fail(const char* error);
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef HEAPGUARD_H
+#define HEAPGUARD_H
+
+#include <Arduino.h>
+
+// Heap im Dauerbetrieb: nach dem Boot soll der Loop-Task nichts mehr allokieren
+// (langlebige Objekte liegen statisch oder in Pools, kurzlebige auf dem Stack oder in einer Arena).
+//
+// Immer aktiv: Tiefststand des freien Heaps und größter freier Block werden geloggt, sobald
+// sie sinken (Fragmentierung zeigt sich am größten Block).
+//
+// Debug-Build (env seeed_xiao_esp32c3_heaptrap, -DMAXFAN_HEAP_TRAP und --wrap=malloc/calloc/realloc):
+//   MAXFAN_HEAP_TRAP=1  jede Allokation im Loop-Task nach bootComplete() wird gezählt und je
+//                       Aufrufer einmal mit Rücksprungadresse geloggt (addr2line -e firmware.elf)
+//   MAXFAN_HEAP_TRAP=2  abort() mit Backtrace bei der ersten Allokation
+// Andere Tasks (WiFi, lwIP, BLE, AsyncTCP) verwalten ihren Speicher selbst und werden nicht geprüft.
+// Das Config-Menü (WLAN-Tests, TLS, Updates) ist Wartung: dort ist der Wächter ausgesetzt.
+class HeapGuard {
+public:
+    static constexpr uint32_t CHECK_INTERVAL_MS = 10000;
+    static constexpr int MAX_REPORTED_CALLERS = 16;
+
+    // Am Ende von setup()
+    static void bootComplete();
+    // In jedem loop()
+    static void loop();
+
+    // Wartungsmodus an/aus (Config-Menü)
+    static void suspend();
+    static void resume();
+
+    // Allokationen im Loop-Task nach dem Boot (nur mit MAXFAN_HEAP_TRAP, sonst 0)
+    static uint32_t trapped();
+};
+
+#endif
@@ -0,0 +1,136 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <type_traits>
+
+// Verzögertes Logging mit Stufen.
+//
+//   LOG_E / LOG_W / LOG_I / LOG_D ("Format", args...)   printf-Format, Prüfung durch den Compiler
+//
+// Stufe über MAXFAN_LOG_LEVEL (platformio.ini) wählen, 0 = aus ... 4 = Debug. Abgeschaltete Stufen
+// werden zu nichts: weder Formatstring im Flash noch Argumentauswertung.
+// Aufrufer formatieren nicht: die Argumente werden nur kopiert (Strings bis ARG_BYTES) und in einen
+// lock-freien Ringpuffer gelegt. Ein Task niedriger Priorität formatiert und schreibt sie auf die Senke
+// (Serial oder den Log-Kanal der USB-Steuerung). Ist der Puffer voll, wird verworfen und gezählt.
+// Nutzbar aus allen Tasks, nicht aus ISRs. Der Formatstring muss ein Literal sein.
+
+#define MAXFAN_LOG_NONE  0
+#define MAXFAN_LOG_ERROR 1
+#define MAXFAN_LOG_WARN  2
+#define MAXFAN_LOG_INFO  3
+#define MAXFAN_LOG_DEBUG 4
+
+#ifndef MAXFAN_LOG_LEVEL
+#define MAXFAN_LOG_LEVEL MAXFAN_LOG_INFO
+#endif
+
+// "" format: nur String-Literale (der Zeiger wird erst später im Log-Task gelesen)
+#define LOG_AT(level, format, ...) do { \
+        if (false) Log::check("" format, ##__VA_ARGS__); \
+        Log::write(level, "" format, ##__VA_ARGS__); \
+    } while (0)
+
+#if MAXFAN_LOG_LEVEL >= MAXFAN_LOG_ERROR
+#define LOG_E(format, ...) LOG_AT(MAXFAN_LOG_ERROR, format, ##__VA_ARGS__)
+#else
+#define LOG_E(format, ...) do { } while (0)
+#endif
+
+#if MAXFAN_LOG_LEVEL >= MAXFAN_LOG_WARN
+#define LOG_W(format, ...) LOG_AT(MAXFAN_LOG_WARN, format, ##__VA_ARGS__)
+#else
+#define LOG_W(format, ...) do { } while (0)
+#endif
+
+#if MAXFAN_LOG_LEVEL >= MAXFAN_LOG_INFO
+#define LOG_I(format, ...) LOG_AT(MAXFAN_LOG_INFO, format, ##__VA_ARGS__)
+#else
+#define LOG_I(format, ...) do { } while (0)
+#endif
+
+#if MAXFAN_LOG_LEVEL >= MAXFAN_LOG_DEBUG
+#define LOG_D(format, ...) LOG_AT(MAXFAN_LOG_DEBUG, format, ##__VA_ARGS__)
+#else
+#define LOG_D(format, ...) do { } while (0)
+#endif
+
+class Log {
+public:
+    static constexpr size_t QUEUE_SIZE = 64;     // Meldungen im Ringpuffer
+    static constexpr size_t ARG_BYTES = 56;      // Argumente je Meldung, inkl. kopierter Strings
+    static constexpr size_t LINE_SIZE = 200;     // formatierte Zeile inkl. Zeitstempel
+
+    // Bekommt eine fertige Zeile ohne '\n'. Läuft im Log-Task (oder in flush()).
+    typedef void (*Sink)(uint8_t level, const char* line, size_t length);
+
+    struct Record {
+        uint32_t ms;
+        const char* format;
+        uint8_t level;
+        uint8_t used;
+        uint8_t args[ARG_BYTES];
+    };
+
+    // Startet den Log-Task; vorher geloggte Meldungen warten im Puffer
+    static void begin();
+    // nullptr = Serial
+    static void setSink(Sink sink);
+    // Puffer sofort im aufrufenden Task ausgeben, z.B. vor einem Neustart oder abort()
+    static void flush();
+    // Verworfene Meldungen seit dem Start
+    static uint32_t dropped();
+
+    template <typename... Args>
+    static void write(uint8_t level, const char* format, Args... args) {
+        Record record;
+        record.ms = timestamp();
+        record.format = format;
+        record.level = level;
+        record.used = 0;
+        (pack(record, args), ...);
+        push(record);
+    }
+
+    // Nie aufgerufen, nur für die Formatprüfung des Compilers
+    __attribute__((format(printf, 1, 2))) static void check(const char* format, ...) { (void)format; }
+
+    // Zeile aus einem Record bauen (ohne Zeitstempel); Bytes ohne '\0'
+    static size_t format(const Record& record, char* out, size_t size);
+
+    // Kodierung in Record::args: Typ-Byte, dann der Wert (ARG_STRING: Längen-Byte + Text ohne '\0')
+    enum ArgType : uint8_t { ARG_INT, ARG_UINT, ARG_INT64, ARG_UINT64, ARG_DOUBLE, ARG_STRING, ARG_POINTER };
+
+private:
+
+    static uint32_t timestamp();
+    static void push(const Record& record);
+    static void put(Record& record, ArgType type, const void* value, size_t size);
+
+    template <typename T>
+    static typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type
+    pack(Record& record, T value) {
+        if (sizeof(T) > 4) {
+            if (std::is_signed<T>::value) {
+                int64_t v = (int64_t)value;
+                put(record, ARG_INT64, &v, sizeof(v));
+            } else {
+                uint64_t v = (uint64_t)value;
+                put(record, ARG_UINT64, &v, sizeof(v));
+            }
+        } else if (std::is_signed<T>::value) {
+            int32_t v = (int32_t)value;
+            put(record, ARG_INT, &v, sizeof(v));
+        } else {
+            uint32_t v = (uint32_t)value;
+            put(record, ARG_UINT, &v, sizeof(v));
+        }
+    }
+    static void pack(Record& record, double value) { put(record, ARG_DOUBLE, &value, sizeof(value)); }
+    static void pack(Record& record, const char* value);
+    static void pack(Record& record, const void* value) { put(record, ARG_POINTER, &value, sizeof(value)); }
+};
+
+#endif
@@ -13,7 +13,9 @@ enum class MaxError {
     BLE_INVALID_COVER,
     BLE_INVALID_AIRFLOW,
     BLE_INVALID_SPEED,
-    BLE_INVALID_TEMP
+    BLE_INVALID_TEMP,
+    BLE_INVALID_SCHEDULE,
+    BLE_INVALID_CLOCK
 
          
 };
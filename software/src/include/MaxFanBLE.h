@@ -2,19 +2,24 @@
 #define MAXFANBLE_H
 
 #include <Arduino.h>
-#include <BLEDevice.h>
-#include <BLEServer.h>
-#include <BLEUtils.h>
-#include <BLE2902.h>
 #include <Preferences.h>
 #include <functional>
 #include "MaxFanState.h"
 #include "FanController.h"
+#include "BleTransport.h"
+#include "RingBuffer.h"
 
-class BleController : public FanController {
+// Der BLE-Stack selbst steckt hinter BleTransport (Bluedroid oder NimBLE, siehe platformio.ini).
+// Kommandos kommen im BLE-Task an und gehen über eine feste Warteschlange nach loop():
+// MaxFanState und das Display werden nur im Loop angefasst.
+class BleController : public FanController, private BleTransportListener {
 public:
+    // Obergrenze für gleichzeitige Verbindungen; die tatsächliche Grenze kommt aus GlobalConfig.bleMaxConnections
+    static constexpr int MAX_CLIENTS = 3;
+    static constexpr size_t QUEUE_SIZE = 4;        // 3 Kommandos unterwegs, weitere werden verworfen
+
     BleController();
-    
+
     void begin(const char* deviceName = "MaxxFan Controller");
     void setCommandCallback(FanController::CommandCallback callback) override;
     void notifyStatus(const MaxFanState& currentState) override;
@@ -25,44 +30,89 @@ public:
     char getIndicatorLetter() override;
 
 private:
-    BLEServer* _pServer;
-    BLECharacteristic* _pCommandChar;
-    BLECharacteristic* _pStatusChar;
-    MaxFanState _lastSentState; 
-    bool _forceUpdate;
-    FanController::CommandCallback _onCommandReceived;
-    bool _deviceConnected;
-    bool _bonded;
-    uint32_t _pinCode;
+    // Verbindungsparameter (Einheiten: Intervall 1.25 ms, Timeout 10 ms).
+    // Werte halten die Apple Accessory Design Guidelines ein.
+    static constexpr uint16_t FAST_MIN_INTERVAL = 12;    // 15 ms
+    static constexpr uint16_t FAST_MAX_INTERVAL = 24;    // 30 ms
+    static constexpr uint16_t FAST_LATENCY      = 0;
+    static constexpr uint16_t FAST_TIMEOUT      = 400;   // 4 s
+    static constexpr uint16_t IDLE_MIN_INTERVAL = 80;    // 100 ms
+    static constexpr uint16_t IDLE_MAX_INTERVAL = 96;    // 120 ms
+    static constexpr uint16_t IDLE_LATENCY      = 4;
+    static constexpr uint16_t IDLE_TIMEOUT      = 600;   // 6 s
+    // Nach so vielen ms ohne Kommando wird auf das sparsame Intervall gewechselt
+    static constexpr uint32_t IDLE_AFTER_MS     = 5000;
+    // Lokale MTU; ein kompletter Status-JSON passt damit in eine Notification
+    static constexpr uint16_t PREFERRED_MTU     = 185;
+    // Durchschnittliche Kosten einer Notification alle n Notifications ins Info-Log
+    static constexpr uint32_t NOTIFY_REPORT_EVERY = 100;
 
-    // --- Interne Klassen ---
-    class MyServerCallbacks : public BLEServerCallbacks {
-        BleController* _parent;
-    public:
-        MyServerCallbacks(BleController* p) : _parent(p) {}
-        void onConnect(BLEServer* s) override;
-        void onDisconnect(BLEServer* s) override;
-    };
+    // Status-Broadcast in den Manufacturer Specific Data (siehe BLE_CLIENT_SPEC.md)
+    static constexpr uint16_t ADV_COMPANY_ID    = 0xFFFF; // reserviert für Tests / nicht registrierte Firmen
+    static constexpr uint8_t  ADV_FORMAT        = 0x01;
 
-    class MyCharCallbacks : public BLECharacteristicCallbacks {
-        BleController* _parent;
-    public:
-        MyCharCallbacks(BleController* p) : _parent(p) {}
-        void onWrite(BLECharacteristic* pChar) override;
+    // Buchhaltung pro Verbindung (Schlüssel: conn_id)
+    struct ClientSlot {
+        bool used;
+        uint16_t connId;
+        bool subscribed;        // CCCD: Notifications aktiviert
+        bool bonded;
+        uint32_t sentVersion;   // zuletzt an diesen Client gesendete State-Version
+        uint16_t mtu;
+        bool mtuWarned;         // Status passte schon einmal nicht in MTU-3 (nur einmal loggen)
+        bool fastParams;
+        uint32_t lastCommandMs;
+        uint32_t connectedMs;   // Messung: Connect bis erste Notification
+        bool firstNotifyLogged;
     };
 
-    // Security brauchen wir intern trotzdem, damit der PIN-Mechanismus greift,
-    // aber ohne Kommunikation nach außen.
-    class MySecurityCallbacks : public BLESecurityCallbacks {
-    public:
-        BleController* _parent;
-        MySecurityCallbacks(BleController* p) : _parent(p) {}
-        uint32_t onPassKeyRequest() override { return 0; }
-        void onPassKeyNotify(uint32_t pass_key) override {}
-        bool onConfirmPIN(uint32_t pass_key) override { return true; }
-        bool onSecurityRequest() override { return true; }
-        void onAuthenticationComplete(esp_ble_auth_cmpl_t cmpl) override;
+    struct Command {
+        uint16_t length;
+        char json[FanController::MAX_COMMAND + 1];
     };
+
+    BleTransport& _transport;
+    bool _started;
+    FanController::CommandCallback _onCommandReceived;
+    uint32_t _pinCode;
+    int _maxConnections;
+
+    // Produzent: BLE-Task (onCommand), Konsument: loop()
+    RingBuffer<Command, QUEUE_SIZE> _commands;
+
+    ClientSlot _clients[MAX_CLIENTS];
+    portMUX_TYPE _clientsLock;
+
+    // Jede Zustandsänderung bekommt eine neue Version; Clients mit kleinerer Version sind "hinterher"
+    MaxFanState _lastState;
+    uint32_t _stateVersion;
+
+    // Messung: Kosten einer Notification pro Client
+    uint32_t _notifyCount;
+    int64_t _notifyTotalUs;
+    uint32_t _notifyReportAt;   // nächste Zusammenfassung im Info-Log
+
+    // Kennzahlen in der Diagnostics-Characteristic
+    uint32_t _lastMetricsMs;
+    void refreshMetrics();
+
+    // Nur unter _clientsLock aufrufen, der Zeiger gilt nur bis zum Verlassen des Locks
+    ClientSlot* findClient(uint16_t connId);
+    // Nur unter _clientsLock aufrufen
+    int connectedCount() const;
+    // count: verbundene Clients, unter dem Lock gezählt
+    void updateAdvertising(int count);
+    void updateAdvertisingData();
+    void requestConnParams(uint16_t connId, bool fast);
+
+    // --- BleTransportListener (Kontext: BLE-Task) ---
+    void onClientConnected(uint16_t connId, uint16_t interval, uint16_t latency, uint16_t timeout) override;
+    void onClientDisconnected(uint16_t connId) override;
+    void onMtuChanged(uint16_t connId, uint16_t mtu) override;
+    void onSubscribeChanged(uint16_t connId, bool subscribed) override;
+    void onAuthenticationComplete(uint16_t connId, bool success) override;
+    void onConnParamsUpdated(uint16_t connId, uint16_t interval, uint16_t latency, uint16_t timeout) override;
+    void onCommand(uint16_t connId, const uint8_t* data, size_t len) override;
 };
 
-#endif
\ No newline at end of file
+#endif
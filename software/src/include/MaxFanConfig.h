@@ -5,8 +5,16 @@
 
 // 1. Das dumme Daten-Objekt
 struct ConfigData {
-    int connection;          
+    // Controller: beliebig viele gleichzeitig (CompositeController)
+    bool controllerBle;
+    bool controllerMqtt;
+    bool controllerTimer;
+    bool controllerHttp;        // lokale HTTP/WebSocket-API (braucht WLAN)
+    bool controllerSerial;      // Binärprotokoll über USB-CDC
+    int controllerPriority;     // 0 = BLE vor MQTT, 1 = MQTT vor BLE; der Timer ist immer zuletzt
+    int controllerHoldSeconds;  // so lange hat ein Kommando Vorrang vor niedriger priorisierten, 0 = letztes gewinnt
     int blePin;
+    int bleMaxConnections;      // gleichzeitige BLE-Clients (1..3)
     char wifiPassword[64];
     int displayTimeoutSeconds;  
     char wifiSSID[64];
@@ -24,10 +32,21 @@ struct ConfigData {
     char timerAirflow[8];
     int timerPercent;
     int timerPauseForSeconds;
+    // POSIX-TZ für Zeitplan und SNTP, z.B. "CET-1CEST,M3.5.0,M10.5.0/3"
+    char timeZone[40];
+    // Lokale Update-Quelle (manifest.json auf einem Server im LAN), leer = aus
+    char updateUrl[64];
 
     bool operator==(const ConfigData& other) const {
-        return (connection == other.connection) &&
+        return (controllerBle == other.controllerBle) &&
+               (controllerMqtt == other.controllerMqtt) &&
+               (controllerTimer == other.controllerTimer) &&
+               (controllerHttp == other.controllerHttp) &&
+               (controllerSerial == other.controllerSerial) &&
+               (controllerPriority == other.controllerPriority) &&
+               (controllerHoldSeconds == other.controllerHoldSeconds) &&
                (blePin == other.blePin) &&
+               (bleMaxConnections == other.bleMaxConnections) &&
                (strncmp(wifiPassword, other.wifiPassword, 64) == 0) &&
                (displayTimeoutSeconds == other.displayTimeoutSeconds) &&
                (strncmp(wifiSSID, other.wifiSSID, 64) == 0) &&
@@ -42,7 +61,9 @@ struct ConfigData {
                (timerRunForSeconds == other.timerRunForSeconds) &&
                (strncmp(timerAirflow, other.timerAirflow, sizeof(timerAirflow)) == 0) &&
                (timerPercent == other.timerPercent) &&
-               (timerPauseForSeconds == other.timerPauseForSeconds);
+               (timerPauseForSeconds == other.timerPauseForSeconds) &&
+               (strncmp(timeZone, other.timeZone, sizeof(timeZone)) == 0) &&
+               (strncmp(updateUrl, other.updateUrl, 64) == 0);
     }
     
     bool operator!=(const ConfigData& other) const {
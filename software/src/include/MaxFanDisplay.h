@@ -6,6 +6,7 @@
 #include <Wire.h>
 #include <MaxFanState.h>
 #include "FanController.h"
+#include "GlyphAtlas.h"
 
 
 class MaxFanDisplay {
@@ -13,9 +14,13 @@ public:
     MaxFanDisplay(uint8_t sda, uint8_t scl);
     bool begin();
     
-    // Die Update-Methode zeichnet das komplette UI neu
-    void update(const MaxFanState& state, FanController::Icon icon, bool isConnected, char indicator, long encoderPos);
+    // Die Update-Methode zeichnet das komplette UI neu, aber nur, wenn sich Zustand, Icons oder
+    // Fehlermeldung seit dem letzten Bild geändert haben; sonst wird auch nichts gesendet.
+    // indicators: ein Eintrag je aktivem Controller (FanController::getIndicators)
+    void update(const MaxFanState& state, const FanController::Indicator* indicators, int indicatorCount, long encoderPos);
     void showError(MaxError error);
+    // Nächstes update() zeichnet auf jeden Fall, z.B. nachdem ein anderer Modus den Puffer benutzt hat
+    void invalidate() { _drawn = false; }
     
 private:
     // Wir nutzen den Hardware-I2C Treiber für SSD1306
@@ -24,6 +29,31 @@ private:
     MaxError _activeError = MaxError::NONE;
     int64_t _errorStartTime = 0;
     const int64_t _errorDuration = 10000000; // 10 Sekunden in Mikrosekunden (10 * 1.000.000)
+
+    // Große Anzeige (Drehzahl, Temperatur, OFF): Grundlinie und Glyphen aus dem Atlas
+    static constexpr int READOUT_X = 35;
+    static constexpr int READOUT_Y = 42;
+    GlyphAtlas _readout;
+
+    // Stand des zuletzt gesendeten Bildes
+    static constexpr int MAX_INDICATORS = 8;
+    bool _drawn = false;
+    MaxFanState _drawnState;
+    FanController::Indicator _drawnIndicators[MAX_INDICATORS];
+    int _drawnIndicatorCount = 0;
+    MaxError _drawnError = MaxError::NONE;
+
+    bool unchanged(const MaxFanState& state, const FanController::Indicator* indicators, int indicatorCount) const;
+    void remember(const MaxFanState& state, const FanController::Indicator* indicators, int indicatorCount);
+
+    void drawReadout(int value, const char* unit);
+    void drawOff();
+    void drawManual(const MaxFanState& state);
+    void drawAuto(const MaxFanState& state);
+
+    void drawIndicator(const FanController::Indicator& indicator, const unsigned char* bits,
+                       int iconX, int iconY, int iconW, int iconH, bool compact);
+    void drawIndicators(const FanController::Indicator* indicators, int count);
 };
 
 #endif
\ No newline at end of file
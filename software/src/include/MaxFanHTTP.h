@@ -0,0 +1,61 @@
+#ifndef MAXFANHTTP_H
+#define MAXFANHTTP_H
+
+#include "FanController.h"
+#include "RingBuffer.h"
+#include <ESPAsyncWebServer.h>
+
+// Lokale Steuerung ohne Broker: HTTP + WebSocket direkt auf dem Gerät (siehe HTTP_API.md).
+//   GET  /state     aktueller Status (JSON wie bei BLE/MQTT)
+//   POST /command   Kommando, gleiche Grammatik wie MaxFanState::SetJson; Antwort 202
+//   WS   /ws        Status bei jeder Änderung; Textnachrichten gelten als Kommando
+// Der Server läuft im AsyncTCP-Task, nicht im Loop. Kommandos gehen über eine feste Warteschlange
+// nach loop(), der Status liegt als Kopie unter Lock bereit: MaxFanState wird nur im Loop angefasst.
+class HttpController : public FanController {
+public:
+    static constexpr uint16_t PORT = 80;
+    static constexpr size_t MAX_BODY = 256;        // größere Kommandos -> 413
+    static constexpr size_t QUEUE_SIZE = 4;        // 3 Kommandos unterwegs, sonst 503
+    static constexpr size_t MAX_WS_CLIENTS = 4;    // weitere WebSockets werden geschlossen
+    static constexpr size_t STATE_SIZE = 160;
+
+    HttpController();
+    void begin(const char* deviceName = nullptr) override;
+    void setCommandCallback(FanController::CommandCallback callback) override;
+    void notifyStatus(const MaxFanState& currentState) override;
+    void loop() override;
+    bool isConnected() override;
+    char getIndicatorLetter() override;
+    FanController::Icon getIcon() override { return FanController::ICON_HTTP; }
+
+private:
+    struct Command {
+        uint16_t length;              // > MAX_BODY: zu groß, nicht kopiert
+        char json[MAX_BODY + 1];
+    };
+
+    AsyncWebServer _server;
+    AsyncWebSocket _ws;
+    FanController::CommandCallback _onCommandReceived;
+    bool _started;
+
+    // Produzent: AsyncTCP-Task (HTTP und WebSocket), Konsument: loop()
+    RingBuffer<Command, QUEUE_SIZE> _commands;
+    volatile uint32_t _rejected;
+
+    // Letzter Status für GET /state und neue WebSockets
+    portMUX_TYPE _stateLock;
+    char _stateJson[STATE_SIZE];
+    MaxFanState _lastState;
+    bool _hasState;
+
+    uint32_t _lastCleanupMs;
+
+    void startServer();
+    bool enqueue(const uint8_t* data, size_t length);
+    bool copyState(char* out, size_t size);
+    void onWsEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                   void* arg, uint8_t* data, size_t length);
+};
+
+#endif
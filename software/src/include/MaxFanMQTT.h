@@ -5,6 +5,8 @@
 #include <PubSubClient.h>
 #include <WiFi.h>
 
+class MqttOtaReceiver;
+
 class MqttController : public FanController {
 public:
     MqttController();
@@ -13,14 +15,28 @@ public:
     void notifyStatus(const MaxFanState& currentState) override;
     void loop() override;
     bool isConnected() override;
+    // begin() schon aufgerufen (nur mit aktivem MQTT-Controller oder durch das MQTT-Update)
+    bool isStarted() const { return _started; }
+    // Verbindung trennen und nicht mehr neu verbinden (nach einem MQTT-Update ohne MQTT-Controller)
+    void end();
     char getIndicatorLetter() override;
     FanController::Icon getIcon() override { return FanController::ICON_MQTT; }
 
+    // Firmware-Update über MQTT: abonniert <Cmd-Topic>/ota/+ und vergrößert den Puffer,
+    // solange ein Empfänger gesetzt ist (nullptr = wieder aus)
+    void setOtaReceiver(MqttOtaReceiver* receiver);
+    // Antwort an den Host auf <State-Topic>/ota
+    bool publishOta(const char* json);
+    // Während eines Updates: bis zu maxPackets bereits angekommene Pakete verarbeiten
+    void pump(uint8_t maxPackets);
+
 private:
     WiFiClient _wifiClient;
     PubSubClient _mqtt;
     FanController::CommandCallback _onCommandReceived;
     bool _connected;
+    bool _started;
+    MqttOtaReceiver* _otaReceiver;
 
     // State publish dedupe
     MaxFanState _lastSentState;
@@ -32,7 +48,13 @@ private:
     static constexpr uint32_t RECONNECT_BASE_MS = 1000;
     static constexpr uint32_t RECONNECT_MAX_MS = 60000;
 
+    // Kennzahlen auf <State-Topic>/diag
+    uint32_t _lastMetricsMs;
+    void publishMetrics();
+
     bool isValidTopic(const char* topic);
+    String otaTopic(const char* suffix) const;
+    void subscribeOta();
 
     void ensureConnected();
     static void mqttCallbackStatic(char* topic, byte* payload, unsigned int length);
@@ -0,0 +1,48 @@
+#ifndef MAXFANMETRICS_H
+#define MAXFANMETRICS_H
+
+#include "Metrics.h"
+
+// Die Kennzahlen der Firmware. Definiert in MaxFanMetrics.cpp, dort steht auch die Reihenfolge
+// im Snapshot. Veröffentlicht auf <State-Topic>/diag (MQTT) und in der Diagnostics-
+// Characteristic (BLE), Format in BLE_CLIENT_SPEC.md.
+namespace MaxFanMetrics {
+
+    static constexpr uint32_t PUBLISH_INTERVAL_MS = 60000;  // MQTT
+    static constexpr uint32_t REFRESH_INTERVAL_MS = 5000;   // Wert der BLE-Characteristic
+    static constexpr size_t SNAPSHOT_SIZE = 512;
+
+    // IR
+    extern Counter irSent;
+    extern Counter irReceived;
+    extern Counter irRejectStart;     // Startbit != 0
+    extern Counter irRejectStop;      // Stopbit != 1
+    extern Counter irRejectShort;     // zu wenig Bytes
+    extern Counter irRejectHeader;
+    extern Counter irRejectChecksum;
+
+    // BLE
+    extern Counter bleConnects;
+    extern Counter bleBonds;
+    extern Counter bleBondFailures;
+
+    // MQTT
+    extern Counter mqttConnects;
+    extern Counter mqttConnectFailures;
+    extern Counter mqttPublishFailures;
+
+    // Display
+    extern Counter displayFrames;     // gezeichnet und übergeben
+    extern Counter displayDropped;    // verworfen, weil schon ein neueres Bild kam
+    extern Gauge displayStall;        // µs, längste Blockade des Loops durch das Display
+
+    // System (Gauges, beim Snapshot gelesen)
+    extern Gauge uptime;              // s
+    extern Gauge freeHeap;
+    extern Gauge minFreeHeap;
+    extern Gauge largestBlock;        // größter freier Block (Fragmentierung)
+    extern Gauge wifiRssi;            // dBm, 0 = nicht verbunden
+    extern Gauge logDropped;
+}
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef MAXFANSERIAL_H
+#define MAXFANSERIAL_H
+
+#include "FanController.h"
+#include "SerialFrame.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Steuerung über USB-CDC für einen Rechner im Fahrzeug (z.B. Raspberry Pi), ohne Funk.
+// Binäre Rahmen mit COBS + CRC16 (SerialFrame), Protokoll in SERIAL_PROTOCOL.md:
+//   Kanal CONTROL: Kommandos (JSON wie BLE), Status, Diagnose, Ping
+//   Kanal LOG:     alle LOG_x-Meldungen, solange der Controller aktiv ist (Log-Senke)
+// Steuerung läuft im Loop-Task, die Log-Rahmen schreibt der Log-Task (oder Log::flush() im Aufrufer).
+// Beide senden nur unter _txLock, damit Platzprüfung und Schreiben zusammen bleiben und sich die
+// Rahmen nicht mischen. Gesendet wird nur, wenn der USB-Puffer Platz hat: liest der Host nicht,
+// werden Rahmen verworfen (gezählt), statt zu blockieren.
+class SerialController : public FanController {
+public:
+    static constexpr size_t RX_BUDGET = 512;           // Bytes pro loop(), damit der Loop nicht hängt
+    static constexpr uint32_t HOST_TIMEOUT_MS = 5000;  // ohne gültigen Rahmen gilt der Host als weg
+
+    explicit SerialController(Stream& port);
+    void begin(const char* deviceName = nullptr) override;
+    void setCommandCallback(FanController::CommandCallback callback) override;
+    void notifyStatus(const MaxFanState& currentState) override;
+    void loop() override;
+    bool isConnected() override;
+    char getIndicatorLetter() override { return '\0'; }
+    FanController::Icon getIcon() override { return FanController::ICON_SERIAL; }
+
+private:
+    static SerialController* instance;
+
+    Stream& _port;
+    FanController::CommandCallback _onCommandReceived;
+
+    uint8_t _rx[SerialFrame::MAX_ENCODED];
+    size_t _rxLength;
+    bool _rxOverflow;       // Rest bis zum nächsten Trenner verwerfen
+    uint8_t _tx[SerialFrame::MAX_ENCODED];
+    uint8_t _txSeq;         // für Rahmen, die das Gerät von sich aus sendet
+    SemaphoreHandle_t _txLock;
+    uint8_t _logSeq;        // Kanal LOG, nur unter _txLock
+
+    uint32_t _lastFrameMs;
+    bool _hostSeen;
+    MaxFanState _lastState;
+    bool _hasState;
+
+    // Diagnose
+    uint32_t _rxFrames;
+    uint32_t _rxErrors;
+    uint32_t _rxOverflows;
+    uint32_t _txFrames;
+    uint32_t _txDropped;
+    uint32_t _logDropped;            // zählt logSink() unter _txLock
+
+    void receive(uint8_t c);
+    void handleFrame(const SerialFrame::Frame& frame);
+    bool send(uint8_t channel, uint8_t type, uint8_t seq, const uint8_t* data, size_t length);
+    void sendAck(uint8_t seq, uint8_t status);
+    void sendStatus(uint8_t seq, const MaxFanState& state);
+    void sendDiag(uint8_t seq);
+    static void logSink(uint8_t level, const char* line, size_t length);
+};
+
+#endif
@@ -23,16 +23,20 @@ MaxFanDirection toMaxFanDirection(const std::string& str);
 // Core: 3 bytes (state, speed, temp) stored as 7-bit patterns
 class MaxFanState {
 public:
+  // Puffergröße für ToJson(), inkl. '\0'
+  static constexpr size_t JSON_SIZE = 128;
+
   MaxFanState();
   
   // Initialize from raw bytes (for IR reception)
   void SetBytes(uint8_t state, uint8_t speed, uint8_t temp);
   
 
-  MaxError SetJson(const String& jsonString);
+  MaxError SetJson(const char* json);
   
   // Convert to JSON string (for BLE transmission)
-  String ToJson() const;
+  // Bytes ohne '\0'; JSON_SIZE reicht immer
+  size_t ToJson(char* out, size_t size) const;
   
   // State mode accessors
   MaxFanMode GetMode() const;  
@@ -0,0 +1,39 @@
+#ifndef MAXFANWIFI_H
+#define MAXFANWIFI_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+
+// Schneller WiFi-Connect.
+// Merkt sich BSSID, Kanal und DHCP-Lease der letzten erfolgreichen Verbindung
+// (RTC-Speicher + NVS). Beim nächsten Mal wird direkt auf diesen AP/Kanal mit
+// statischer IP verbunden (kein Scan, kein DHCP). Schlägt das fehl, gibt es
+// den normalen Connect mit vollem Scan + DHCP als Fallback.
+// Der Lease altert: ab der halben Lease-Zeit (wenn die Uhr gestellt ist) und spätestens
+// nach 8 Warm-Connects seit dem Power-On wird wieder per DHCP verbunden, damit die IP nicht
+// inzwischen einem anderen Gerät gehört. In den NVS wird nur ein neuer Lease geschrieben.
+class WiFiConnector {
+public:
+    enum class Status { IDLE, CONNECTING_WARM, CONNECTING_COLD, CONNECTED, FAILED };
+
+    // Startet einen Verbindungsversuch (nicht blockierend).
+    static void begin(const char* ssid, const char* password, uint32_t timeoutMs = 10000);
+
+    // Muss regelmäßig aufgerufen werden, solange ein Versuch läuft.
+    static Status poll();
+
+    // Blockierende Variante: begin() + poll() bis verbunden oder Timeout.
+    static bool connect(const char* ssid, const char* password, uint32_t timeoutMs = 10000);
+
+    // Bricht einen laufenden Versuch ab (Status danach IDLE).
+    static void cancel();
+
+    // Verwirft den gecachten AP/Lease (RTC + NVS).
+    static void forget();
+
+private:
+    static void startCold();
+    static void storeLease();
+};
+
+#endif
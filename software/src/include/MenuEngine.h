@@ -0,0 +1,238 @@
+#ifndef MENU_ENGINE_H
+#define MENU_ENGINE_H
+
+#include <U8g2lib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+// Kleines Menü für das 128x64-Display (Ersatz für GEM).
+//
+// Seiten und Items sind constexpr-Tabellen und liegen damit im Flash (.rodata), nicht im RAM.
+// Die Werte hängen per Offset an einem Modell-Struct (z.B. ConfigData): ein Item speichert nur
+// offsetof(Modell, Feld), die Engine bekommt einen Zeiger auf das Modell.
+// Seiten werden über ihre Nummer (Index in der Seitentabelle) verknüpft, so gibt es keine
+// Zyklen zwischen den Tabellen.
+//
+// Zeichnen: eine Zeile ist genau eine Tile-Zeile des SSD1306 (8 px). Cursor bewegen und Werte
+// bearbeiten zeichnen nur die geänderten Zeilen neu, nur Seitenwechsel und Scrollen den ganzen
+// Puffer. Gesendet wird über DisplayFlush, das nur geänderte Tiles überträgt.
+//
+// Tasten: UP/DOWN = Drehen, LEFT/RIGHT = Taste halten + Drehen, OK, CANCEL.
+//   Seite:     UP/DOWN Cursor, OK öffnet/ändert/löst aus, CANCEL zur übergeordneten Seite
+//   Editor:    UP/DOWN ändert (Option, Ziffer, Zeichen), LEFT/RIGHT wechselt Ziffer/Zeichen,
+//              OK übernimmt, CANCEL verwirft
+
+typedef void (*MenuAction)();
+typedef void (*MenuListAction)(uint8_t index);
+
+enum class MenuKind : uint8_t {
+    LINK,       // öffnet eine Seite
+    BACK,       // zurück zur übergeordneten Seite
+    ACTION,     // ruft eine Funktion auf
+    INFO,       // nur Anzeige (fester Text oder char-Feld)
+    TOGGLE,     // bool
+    SELECT,     // int oder char[] aus einer Optionsliste
+    NUMBER,     // int, Ziffer für Ziffer
+    PIN,        // wie NUMBER, 6 Stellen ohne führende Null
+    TEXT        // char[], Zeichen für Zeichen
+};
+
+// Option für SELECT: bei char[]-Feldern wird text gespeichert, sonst value
+struct MenuOption {
+    const char* label;
+    int32_t value;
+    const char* text;
+
+    constexpr MenuOption(const char* label, int32_t value) : label(label), value(value), text(nullptr) {}
+    constexpr MenuOption(const char* label, const char* text) : label(label), value(0), text(text) {}
+};
+
+struct MenuSelect {
+    const MenuOption* options;
+    uint8_t count;
+    bool loop;          // nach der letzten Option wieder die erste
+};
+
+template <size_t N>
+constexpr MenuSelect menuOptions(const MenuOption (&options)[N], bool loop = false) {
+    return MenuSelect{ options, (uint8_t)N, loop };
+}
+
+struct MenuItem {
+    MenuKind kind;
+    uint8_t page;           // LINK: Zielseite
+    uint8_t size;           // char-Felder: sizeof(Feld), NUMBER/PIN: Stellen
+    uint16_t offset;        // Feld im Modell
+    int32_t min;
+    int32_t max;
+    const char* title;
+    const char* text;       // INFO mit festem Text
+    const MenuSelect* select;
+    MenuAction action;
+
+    static constexpr uint16_t NO_FIELD = 0xFFFF;
+
+    constexpr MenuItem(MenuKind kind, const char* title, uint8_t page, uint16_t offset, uint8_t size,
+                       int32_t min, int32_t max, const char* text, const MenuSelect* select, MenuAction action)
+        : kind(kind), page(page), size(size), offset(offset), min(min), max(max),
+          title(title), text(text), select(select), action(action) {}
+
+    static constexpr MenuItem link(const char* title, uint8_t page) {
+        return MenuItem(MenuKind::LINK, title, page, NO_FIELD, 0, 0, 0, nullptr, nullptr, nullptr);
+    }
+    static constexpr MenuItem back(const char* title = "Back") {
+        return MenuItem(MenuKind::BACK, title, 0, NO_FIELD, 0, 0, 0, nullptr, nullptr, nullptr);
+    }
+    static constexpr MenuItem button(const char* title, MenuAction action) {
+        return MenuItem(MenuKind::ACTION, title, 0, NO_FIELD, 0, 0, 0, nullptr, nullptr, action);
+    }
+    static constexpr MenuItem info(const char* title, const char* text) {
+        return MenuItem(MenuKind::INFO, title, 0, NO_FIELD, 0, 0, 0, text, nullptr, nullptr);
+    }
+};
+
+// Gebundene Items: MENU_FIELD(Modell, feld) liefert Typ und Offset, der Typ wird beim Übersetzen geprüft.
+//   menuToggle<MENU_FIELD(ConfigData, controllerBle)>("BLE")
+#define MENU_FIELD(Model, field) decltype(Model::field), offsetof(Model, field)
+
+template <typename T>
+struct MenuIsCharArray : std::integral_constant<bool,
+    std::is_array<T>::value && std::is_same<typename std::remove_extent<T>::type, char>::value &&
+    (std::extent<T>::value > 1) && (std::extent<T>::value < 256)> {};
+
+template <typename T, size_t Offset>
+constexpr MenuItem menuToggle(const char* title) {
+    static_assert(std::is_same<T, bool>::value, "menuToggle braucht ein bool-Feld");
+    return MenuItem(MenuKind::TOGGLE, title, 0, Offset, 0, 0, 1, nullptr, nullptr, nullptr);
+}
+
+template <typename T, size_t Offset>
+constexpr MenuItem menuSelect(const char* title, const MenuSelect& select) {
+    static_assert(std::is_same<T, int>::value || MenuIsCharArray<T>::value,
+                  "menuSelect braucht ein int- oder char[]-Feld");
+    return MenuItem(MenuKind::SELECT, title, 0, Offset, MenuIsCharArray<T>::value ? sizeof(T) : 0,
+                    0, 0, nullptr, &select, nullptr);
+}
+
+template <typename T, size_t Offset>
+constexpr MenuItem menuNumber(const char* title, uint8_t digits, int32_t min, int32_t max) {
+    static_assert(std::is_same<T, int>::value, "menuNumber braucht ein int-Feld");
+    return MenuItem(MenuKind::NUMBER, title, 0, Offset, digits, min, max, nullptr, nullptr, nullptr);
+}
+
+template <typename T, size_t Offset>
+constexpr MenuItem menuPin(const char* title) {
+    static_assert(std::is_same<T, int>::value, "menuPin braucht ein int-Feld");
+    return MenuItem(MenuKind::PIN, title, 0, Offset, 6, 100000, 999999, nullptr, nullptr, nullptr);
+}
+
+template <typename T, size_t Offset>
+constexpr MenuItem menuText(const char* title) {
+    static_assert(MenuIsCharArray<T>::value, "menuText braucht ein char[]-Feld (max. 255)");
+    return MenuItem(MenuKind::TEXT, title, 0, Offset, sizeof(T), 0, 0, nullptr, nullptr, nullptr);
+}
+
+template <typename T, size_t Offset>
+constexpr MenuItem menuLabel(const char* title) {
+    static_assert(MenuIsCharArray<T>::value, "menuLabel braucht ein char[]-Feld");
+    return MenuItem(MenuKind::INFO, title, 0, Offset, sizeof(T), 0, 0, nullptr, nullptr, nullptr);
+}
+
+struct MenuPage {
+    const char* title;
+    const MenuItem* items;
+    uint8_t count;
+    uint8_t parent;         // für BACK und CANCEL, NO_PAGE = keine
+};
+
+template <size_t N>
+constexpr MenuPage menuPage(const char* title, const MenuItem (&items)[N], uint8_t parent) {
+    return MenuPage{ title, items, (uint8_t)N, parent };
+}
+
+class MenuEngine {
+public:
+    enum class Key : uint8_t { UP, DOWN, LEFT, RIGHT, OK, CANCEL };
+
+    static constexpr uint8_t NO_PAGE = 0xFF;
+    static constexpr uint8_t MAX_PAGES = 16;
+    static constexpr uint8_t ROW_HEIGHT = 8;            // = eine Tile-Zeile
+    static constexpr uint8_t VISIBLE_ROWS = 7;          // Zeile 0 ist der Titel
+    static constexpr uint8_t MAX_TEXT = 64;             // längstes char-Feld ohne '\0'
+
+    // pages und model müssen so lange leben wie die Engine
+    MenuEngine(U8G2& display, const MenuPage* pages, uint8_t pageCount, void* model);
+
+    // Seite wechseln; der Cursor jeder Seite bleibt erhalten (wie bei GEM)
+    void setPage(uint8_t page);
+    void setPage(uint8_t page, uint8_t cursor);
+    uint8_t page() const { return _page; }
+    uint8_t cursor() const { return _cursor[_page]; }
+    bool editing() const { return _editing; }
+
+    // Dynamische Einträge vor den festen Items einer Seite (z.B. Versionsliste).
+    // labels muss bis zum nächsten setList()/clearList() gültig bleiben.
+    void setList(uint8_t page, const char* title, const char* const* labels, uint8_t count, MenuListAction action);
+    void clearList();
+
+    // Taste verarbeiten; gezeichnet wird erst mit render()
+    void press(Key key);
+    // Alles neu zeichnen lassen (z.B. nach einer Aktion, die Werte geändert hat)
+    void invalidate() { _dirtyAll = true; }
+    // Zeichnet, was sich geändert hat. Liefert die Anzahl neu gezeichneter Zeilen (8 = ganzer Puffer).
+    uint8_t render();
+    // Ganzer Bildschirm, z.B. nach einer Meldung, die das Display übernommen hatte
+    void draw() { _dirtyAll = true; render(); }
+
+private:
+    U8G2& _display;
+    const MenuPage* _pages;
+    uint8_t _pageCount;
+    uint8_t* _model;
+
+    uint8_t _page;
+    uint8_t _cursor[MAX_PAGES];
+    uint8_t _top[MAX_PAGES];
+
+    uint8_t _listPage;
+    const char* _listTitle;
+    const char* const* _listLabels;
+    uint8_t _listCount;
+    MenuListAction _listAction;
+
+    // Editor: Kopie des Werts, übernommen wird erst mit OK
+    bool _editing;
+    uint8_t _editPos;           // Ziffer/Zeichen unter dem Cursor
+    uint8_t _editOption;        // SELECT
+    char _editText[MAX_TEXT + 1];   // TEXT/NUMBER/PIN als Zeichen
+
+    bool _dirtyAll;
+    uint8_t _dirtyRows;         // Bit n = Bildschirmzeile n
+
+    uint8_t itemCount() const;
+    // nullptr für Listeneinträge
+    const MenuItem* item(uint8_t index) const;
+    const char* itemTitle(uint8_t index) const;
+    const char* pageTitle() const;
+
+    void* field(const MenuItem& item) const { return _model + item.offset; }
+    int& intField(const MenuItem& item) const { return *(int*)field(item); }
+    char* charField(const MenuItem& item) const { return (char*)field(item); }
+
+    void moveCursor(int step);
+    void activate();
+    void beginEdit(const MenuItem& item);
+    void editKey(const MenuItem& item, Key key);
+    void commitEdit(const MenuItem& item);
+    void markRow(uint8_t index);
+
+    int findOption(const MenuItem& item) const;
+    const char* valueText(const MenuItem& item, char* buffer, size_t size) const;
+
+    void drawTitle();
+    void drawRow(uint8_t row);
+    void drawEditValue(const MenuItem& item, int y, int width);
+};
+
+#endif
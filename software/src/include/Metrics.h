@@ -0,0 +1,72 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+// Laufzeit-Kennzahlen für die Diagnose im Feld.
+//
+//   static Counter irSent("irTx");             // zählt nur hoch, inc() aus jedem Task
+//   static Gauge heap("heap", readFreeHeap);   // Momentwert, wird erst beim Snapshot gelesen
+//
+// Registrierung passiert im Konstruktor (statische Objekte, also vor setup()): jede Kennzahl
+// hängt sich an eine verkettete Liste. Kein Heap, keine Obergrenze, die Reihenfolge im Snapshot
+// ist die Definitionsreihenfolge (innerhalb einer Übersetzungseinheit).
+// Ohne Arduino-Abhängigkeit, läuft auch auf dem Host.
+class Metric {
+public:
+    enum Kind : uint8_t { COUNTER, GAUGE };
+    typedef int32_t (*Reader)();
+
+    Metric(const char* name, Kind kind, Reader reader);
+    Metric(const Metric&) = delete;
+    Metric& operator=(const Metric&) = delete;
+
+    const char* name() const { return _name; }
+    Kind kind() const { return _kind; }
+    // Zähler ohne Vorzeichen, Gauges mit Vorzeichen (z.B. RSSI)
+    uint32_t raw() const;
+    const Metric* next() const { return _next; }
+
+    // Liste aller registrierten Kennzahlen
+    static const Metric* first() { return _first; }
+
+protected:
+    std::atomic<uint32_t> _value;
+
+private:
+    const char* _name;
+    Kind _kind;
+    Reader _reader;
+    Metric* _next;
+
+    // Null-initialisiert vor allen Konstruktoren, darum ist die Registrierung reihenfolgesicher
+    static Metric* _first;
+    static Metric* _last;
+};
+
+class Counter : public Metric {
+public:
+    explicit Counter(const char* name) : Metric(name, COUNTER, nullptr) {}
+    void inc(uint32_t n = 1) { _value.fetch_add(n, std::memory_order_relaxed); }
+    uint32_t value() const { return raw(); }
+};
+
+class Gauge : public Metric {
+public:
+    // Mit reader wird der Wert beim Snapshot abgefragt, sonst gilt der zuletzt gesetzte
+    explicit Gauge(const char* name, Reader reader = nullptr) : Metric(name, GAUGE, reader) {}
+    void set(int32_t v) { _value.store((uint32_t)v, std::memory_order_relaxed); }
+    int32_t value() const { return (int32_t)raw(); }
+};
+
+class Metrics {
+public:
+    // Alle Kennzahlen als eine Zeile JSON: {"name":wert,...}
+    // Liefert die Länge ohne '\0', 0 wenn der Puffer nicht reicht.
+    static size_t snapshot(char* out, size_t size);
+    static size_t count();
+};
+
+#endif
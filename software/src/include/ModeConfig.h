@@ -2,24 +2,38 @@
 #define MODE_CONFIG_H
 
 #include <U8g2lib.h>
-#include <GEM_u8g2.h>
 #include "AppMode.h"
 #include "Encoder.h"
 #include "ChordInput.h"
+#include "MenuEngine.h"
 #include "MaxFanConstants.h"
 #include "MaxFanConfig.h"
+#include "ConfigJobs.h"
+#include <MaxFanState.h>
+#include <MaxRemote.h>
+#include <MaxReceiver.h>
+#include "FanController.h"
+#include "TimerVentilationController.h"
+#include "Arena.h"
 #include <vector> 
 #include <esp_heap_caps.h> // Für Heap Checks
 
-struct ReleaseEntry {
-    String tagName;
-    String downloadUrl;
-    GEMItem* menuPtr; 
+// Was das Menü bearbeitet; die Items binden per Offset an diese Felder.
+// Die Uhr ist keine Einstellung und wird sofort gestellt ("Set Clock").
+struct ConfigMenuModel {
+    ConfigData config;
+    char clockLabel[16];
+    int clockDay;
+    int clockHour;
+    int clockMinute;
 };
 
 class ModeConfig : public AppMode {
 public:
-    ModeConfig(U8G2* display, Encoder* encoder, ChordInput* input);
+    ModeConfig(U8G2* display, Encoder* encoder, ChordRecognizer* input,
+               MaxFanState& state, MaxRemote& remote, MaxReceiver& irReceiver, FanController& remoteAccess,
+               MqttController& mqtt);
+    ~ModeConfig() override;
 
     void enter() override;
     ModeAction loop() override;
@@ -27,91 +41,96 @@ public:
 private:
     static ModeConfig* instance;
 
+    // Ergebnis-/Fehleranzeige und Neuzeichnen des Job-Bildschirms
+    static constexpr uint32_t RESULT_SCREEN_MS = 2500;
+    static constexpr uint32_t ERROR_SCREEN_MS  = 3000;
+    static constexpr uint32_t JOB_DRAW_MS      = 100;
+
+    // Lüfter wird auch im Menü weiter bedient (IR, Controller-Status)
+    MaxFanState& _state;
+    MaxRemote& _remote;
+    MaxReceiver& _irReceiver;
+    FanController& _remoteAccess;
+    MqttController& _mqtt;        // für Updates per MQTT, auch wenn ein anderer Controller aktiv ist
+
     bool _mustExit;
-    GEM_u8g2 _menu;
-    ConfigData _editConfig; 
-
-    // --- SEITEN (PAGES) ---
-    GEMPage _pageMain;          
-    GEMPage _pageRemote;        
-    GEMPage _pageTimer;         
-    GEMPage _pageWifi;          
-    GEMPage _pageBle;           
-    GEMPage _pageMqtt;         
-    GEMPage _pageDisplay;       
-    GEMPage _pageVersionInfo;   
-    GEMPage _pageExit;          
-
-    // WICHTIG: Das hier ist jetzt ein Pointer (*), damit wir die Seite neu bauen können!
-    GEMPage* _pageVersionsSelect; 
-
-    // --- NAVIGATION ITEMS ---
-    GEMItem _itemNavRemote;
-    GEMItem _itemNavTimer;
-    GEMItem _itemNavWifi;
-    GEMItem _itemNavMqtt;
-    GEMItem _itemNavBle;
-    GEMItem _itemNavDisplay;
-    GEMItem _itemNavVersion;
-    GEMItem _itemNavExit;       
-
-    // --- BACK BUTTONS ---
-    GEMItem _itemBackRemote;
-    GEMItem _itemBackTimer;
-    GEMItem _itemBackWifi;
-    GEMItem _itemBackMqtt;
-    GEMItem _itemBackBle;
-    GEMItem _itemBackDisplay;
-    GEMItem _itemBackVersion;
-    GEMItem _itemBackFromExit;  
-
-    // --- PAGE ITEMS ---
-    GEMItem _itemConnection;    
-    GEMItem _itemSsid;
-    GEMItem _itemPassword;
-    GEMItem _itemMqttHost;
-    GEMItem _itemMqttPort;
-    GEMItem _itemMqttClientId;
-    GEMItem _itemMqttUser;
-    GEMItem _itemMqttPassword;
-    GEMItem _itemMqttCommandTopic;
-    GEMItem _itemMqttStateTopic;
-    GEMItem _itemTestWifi;      
-    GEMItem _itemTestMqtt;
-    GEMItem _itemBlePin;
-    GEMItem _itemGenerateNewPIN;
-    GEMItem _itemTimerRunFor;
-    GEMItem _itemTimerAirflow;
-    GEMItem _itemTimerPercent;
-    GEMItem _itemTimerPauseFor;
-    GEMItem _itemDisplayTimeoutSeconds;
-    GEMItem _itemCurrentVersion; 
-    GEMItem _itemCheckUpdates;   
-    GEMItem _itemSave;
-    GEMItem _itemDiscard;
+    ConfigMenuModel _edit;
+    MenuEngine _menu;
+
+    // --- SEITEN ---
+    // Die Tabellen (Seiten, Items, Optionen) stehen constexpr in ModeConfig.cpp und liegen im Flash
+    struct Menu;
+    enum Page : uint8_t {
+        PAGE_MAIN,
+        PAGE_WIFI,
+        PAGE_MQTT,
+        PAGE_BLE,
+        PAGE_REMOTE,
+        PAGE_TIMER,
+        PAGE_DISPLAY,
+        PAGE_VERSION_INFO,
+        PAGE_VERSIONS_SELECT,
+        PAGE_EXIT,
+        PAGE_COUNT
+    };
+
+    // Versionsauswahl: die Einträge kommen als Liste zur Seite PAGE_VERSIONS_SELECT und werden bei
+    // jeder Aktualisierung neu gebaut. Beschriftungen in einer Arena -> kein Heap.
+    static constexpr size_t MAX_VERSION_ITEMS = ReleaseFetchJob::MAX_RELEASES;
+    static constexpr size_t VERSION_LABEL_BYTES = 512;
+    const char* _versionLabels[MAX_VERSION_ITEMS];
+    StaticArena<VERSION_LABEL_BYTES> _versionLabelArena;
+    // Einträge zeigen in eine der Listen von _jobFetch (aktuell oder Cache)
+    const std::vector<ReleaseInfo>* _versionReleases;
+    size_t _versionCount;
 
     // --- INTERNE LOGIK ---
-    char versionLabel[32]; 
-    std::vector<ReleaseEntry> _releaseList; 
+    void clearVersionItems();
+    void updateClockItems();
+    void buildVersionPage(const std::vector<ReleaseInfo>& releases, const char* title, bool show = true);
+
+    // --- HINTERGRUND-JOBS ---
+    // Lange Aktionen laufen schrittweise in loop(); MODE_BUTTON bricht ab.
+    WifiTestJob _jobWifi;
+    MqttTestJob _jobMqtt;
+    ReleaseFetchJob _jobFetch;
+    OtaJob _jobOta;
+    MqttOtaJob _jobMqttOta;
+    ConfigJob* _activeJob;
+    bool _jobInBackground;        // Menü bleibt bedienbar, kein Job-Bildschirm
+    uint32_t _jobDrawMs;
+    uint8_t _spinner;
+
+    void startJob(ConfigJob& job, bool background = false);
+    void runJob();
+    void stepBackgroundJob();
+    void finishJob(ConfigJob::Result result);
+    void drawJob();
+
+    // Meldung ohne delay(): schließt nach Ablauf oder bei Tastendruck.
+    // returnPage == NO_PAGE -> aktuelle Seite bleibt.
+    bool _messageActive;
+    uint32_t _messageStartMs;
+    uint32_t _messageDurationMs;
+    uint8_t _messageReturnPage;
 
-    void clearDynamicItems();
-    bool connectToWiFi(bool useEditConfig); 
-    void fetchReleasesFromGitHub();
-    void showError(const char* line1, const char* line2 = ""); // Error Helper
-    static void performOTA(const char* url);
+    void showMessage(const char* title, const char* line1, const char* line2,
+                     uint32_t durationMs, uint8_t returnPage = MenuEngine::NO_PAGE);
+    void updateMessage();
 
     // --- CALLBACKS ---
     static void callbackCheckExit(); 
     static void callbackSaveAndRestart();
     static void callbackDiscardAndRestart();
-    static void callbackGoBackToMain();     
-    static void callbackGoBackToVersion();  
     static void callbackGenerateNewPIN();
+    static void callbackSetClock();
     static void callbackTestWifi(); 
     static void callbackTestMqtt();
     
     static void callbackCheckForUpdates();
-    static void callbackInstallUpdate(GEMCallbackData data);
+    static void callbackLocalUpdate();
+    static void callbackMqttUpdate();
+    static void callbackInstallUpdate(uint8_t index);
 };
 
 #endif
\ No newline at end of file
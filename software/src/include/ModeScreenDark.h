@@ -14,7 +14,7 @@ private:
     FanController& _remoteAccess;
 
 public:
-    ModeScreenDark(U8G2& u8g2, Encoder& enc, ChordInput& btns,
+    ModeScreenDark(U8G2& u8g2, Encoder& enc, ChordRecognizer& btns,
                    MaxFanState& state, MaxRemote& remote, 
                    MaxReceiver& irReceiver, FanController& remoteAccess);
 
@@ -22,7 +22,7 @@ private:
 
 public:
     // Der Konstruktor bekommt alles injiziert
-        ModeStandard(U8G2& u8g2, Encoder& enc, ChordInput& btns, 
+        ModeStandard(U8G2& u8g2, Encoder& enc, ChordRecognizer& btns, 
                  MaxFanState& state, MaxFanDisplay& display, 
                  MaxRemote& remote, MaxReceiver& irReceiver, FanController& remoteAccess)
         : AppMode(u8g2, enc, btns), // HIER: Wir reichen u8g2 an die Basisklasse weiter
@@ -0,0 +1,77 @@
+#ifndef MPMCRING_H
+#define MPMCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Ringpuffer fester Größe für BELIEBIG viele Produzenten und Konsumenten (Vyukov-Queue):
+// jede Zelle trägt eine Sequenznummer, Schreib- und Leseposition werden per CAS vergeben.
+// Kein Heap, keine Mutexe; ein voller Puffer verwirft (push() liefert false).
+// Der ESP32-C3 hat keine Atomic-Erweiterung: das CAS emuliert die IDF mit kurz gesperrten
+// Interrupts, bleibt also auch zwischen Tasks unterschiedlicher Priorität korrekt.
+// N muss eine Zweierpotenz sein; nutzbar sind alle N Plätze.
+template <typename T, size_t N>
+class MpmcRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "MpmcRing: N muss eine Zweierpotenz sein");
+
+public:
+    MpmcRing() : _enqueue(0), _dequeue(0) {
+        for (size_t i = 0; i < N; i++) _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    bool push(const T& item) {
+        size_t pos = _enqueue.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = _cells[pos & (N - 1)];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                // Zelle frei: Platz reservieren, dann schreiben und freigeben
+                if (_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.item = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // voll
+            } else {
+                pos = _enqueue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool pop(T& item) {
+        size_t pos = _dequeue.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = _cells[pos & (N - 1)];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+            if (diff == 0) {
+                if (_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    item = cell.item;
+                    cell.sequence.store(pos + N, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false; // leer (oder ein Produzent schreibt gerade)
+            } else {
+                pos = _dequeue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    static constexpr size_t capacity() { return N; }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T item;
+    };
+
+    Cell _cells[N];
+    std::atomic<size_t> _enqueue;
+    std::atomic<size_t> _dequeue;
+};
+
+#endif
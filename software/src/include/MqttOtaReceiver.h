@@ -0,0 +1,66 @@
+#ifndef MQTT_OTA_RECEIVER_H
+#define MQTT_OTA_RECEIVER_H
+
+#include <Arduino.h>
+#include "OtaWriter.h"
+
+class MqttController;
+
+// Firmware-Update über die bestehende MQTT-Verbindung (ohne Internet, z.B. Broker im LAN).
+//
+// Topics, abgeleitet von den konfigurierten:
+//   <Cmd-Topic>/ota/ctl   Host -> Gerät, JSON
+//                         {"op":"begin", <Manifest-Felder>, "length": Übertragungsgröße, "chunk": Bytes}
+//                         {"op":"abort"}
+//   <Cmd-Topic>/ota/data  Host -> Gerät, binär: Sequenznummer (uint32 LE) + Daten
+//   <State-Topic>/ota     Gerät -> Host, JSON
+//                         {"op":"ready","chunk":n,"window":n} / {"op":"ack","seq":n} /
+//                         {"op":"done"} / {"op":"error","msg":"..."}
+//
+// Fenster: Der Host darf WINDOW Chunks ohne Ack senden. Bestätigt wird kumulativ die höchste
+// lückenlos geschriebene Nummer. Passt ein Chunk nicht (verloren, doppelt), wird er verworfen und
+// das letzte Ack wiederholt; der Host sendet ab dort neu (Go-Back-N).
+// Angenommen wird nur, solange das Config-Menü den Empfänger scharf geschaltet hat.
+class MqttOtaReceiver {
+public:
+    enum class State { IDLE, ARMED, RECEIVING, DONE, FAILED };
+
+    static constexpr uint16_t WINDOW = 8;
+    static constexpr uint16_t MAX_CHUNK = 1024;
+    // PubSubClient-Puffer während des Updates: Chunk + Sequenznummer + Topic + MQTT-Header
+    static constexpr uint16_t BUFFER_SIZE = MAX_CHUNK + 256;
+
+    void arm(MqttController& controller);
+    // Bricht eine laufende Übertragung ab und meldet das dem Host
+    void disarm();
+
+    State state() const { return _state; }
+    const char* error() const { return _error; }
+    const String& version() const { return _manifest.version; }
+    int received() const { return _received; }
+    int length() const { return _length; }
+    int progress() const;
+    uint32_t lastActivityMs() const { return _lastActivityMs; }
+
+    // Vom MqttController für Nachrichten auf <Cmd-Topic>/ota/<subtopic>
+    void onMessage(const char* subtopic, const uint8_t* payload, unsigned int length);
+
+private:
+    MqttController* _controller = nullptr;
+    State _state = State::IDLE;
+    const char* _error = "";
+    OtaManifest _manifest;
+    OtaWriter _writer;
+    uint32_t _expectedSeq = 0;
+    int _received = 0;
+    int _length = 0;
+    uint32_t _lastActivityMs = 0;
+
+    void onControl(const uint8_t* payload, unsigned int length);
+    void onData(const uint8_t* payload, unsigned int length);
+    void reply(const char* json);
+    void sendAck();
+    void fail(const char* error);
+};
+
+#endif
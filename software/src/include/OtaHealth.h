@@ -0,0 +1,32 @@
+#ifndef OTA_HEALTH_H
+#define OTA_HEALTH_H
+
+#include <Arduino.h>
+
+// Rollback-Schutz nach einem OTA-Update.
+// Ein frisch geflashtes Image startet als PENDING_VERIFY. Erst wenn es HEALTH_WINDOW_MS
+// lang läuft (Loop dreht, genug Heap frei), wird es als gültig markiert. Startet der Chip
+// vorher neu (Absturz, Watchdog, Strom weg bei Hänger), bootet der Bootloader das alte Image.
+// Solange das Image ungeprüft ist, überwacht der Task-Watchdog den Loop: hängt er länger als
+// LOOP_WDT_S, gibt es einen Reset und damit den Rollback. Das setzt voraus, dass loop() in jedem
+// Durchlauf einen Tick abgibt (main.cpp), sonst schlägt der Watchdog beim Idle-Task an.
+class OtaHealth {
+public:
+    // Am Ende von setup()
+    static void begin();
+    // In jedem loop(). maintenance = Konfigurationsmenü offen: dessen Jobs (TLS-Abruf, Update)
+    // brauchen vorübergehend viel Heap, dann wird der Heap nicht geprüft.
+    static void loop(bool maintenance);
+
+    static bool pendingVerify();
+
+private:
+    static constexpr uint32_t HEALTH_WINDOW_MS = 30000;
+    static constexpr uint32_t MIN_FREE_HEAP = 10000;
+    // Länger als der längste blockierende Schritt im Menü (HTTP-Timeout 10 s plus TLS-Handshake)
+    static constexpr uint32_t LOOP_WDT_S = 30;
+
+    static void setLoopWatchdog(bool on);
+};
+
+#endif
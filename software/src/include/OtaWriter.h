@@ -0,0 +1,59 @@
+#ifndef OTA_WRITER_H
+#define OTA_WRITER_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include <mbedtls/sha256.h>
+#include "GzipInflater.h"
+
+// Beschreibung eines Images, wie in manifest.json (HTTP) bzw. der MQTT-Startnachricht:
+// {"version", "file", "raw", "compression": "gzip"|"none", "size", "sha256"}
+struct OtaManifest {
+    String version;
+    String file;              // Datei mit dem (ggf. komprimierten) Image
+    String raw;               // unkomprimierter Fallback, optional
+    bool compressed = false;
+    int size = 0;             // entpackt
+    uint8_t sha256[32];
+
+    // false + error bei fehlenden/ungültigen Feldern
+    bool parse(JsonVariantConst json, const char*& error);
+};
+
+// Schreibt ein Image in die OTA-Partition: entpackt bei Bedarf (gzip), rechnet den
+// SHA-256 über das entpackte Image mit und prüft ihn am Ende.
+// Gemeinsam für alle Update-Quellen (GitHub, lokaler HTTP-Server, MQTT).
+class OtaWriter {
+public:
+    ~OtaWriter() { abort(); }
+
+    // sha256 == nullptr: ohne Prüfung (alte Releases ohne Manifest)
+    bool begin(int imageSize, bool compressed, const uint8_t* sha256);
+    // Daten so wie übertragen (komprimiert oder roh)
+    bool write(const uint8_t* data, size_t length);
+    // Prüft Größe und SHA-256 und setzt die Boot-Partition
+    bool finish();
+    void abort();
+
+    bool isRunning() const { return _running; }
+    bool isCompressed() const { return _compressed; }
+    int imageSize() const { return _imageSize; }
+    int written() const { return _written; }
+    const char* error() const { return _error; }
+
+private:
+    bool _running = false;
+    bool _compressed = false;
+    bool _verify = false;
+    uint8_t _expectedSha[32];
+    mbedtls_sha256_context _sha;
+    GzipInflater _inflater;
+    int _imageSize = 0;
+    int _written = 0;
+    const char* _error = "";
+
+    bool fail(const char* error);
+    static bool writeImage(void* context, const uint8_t* data, size_t length);
+};
+
+#endif
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+namespace QuadratureTable {
+    static constexpr int8_t INVALID = 2;
+
+    // Index = (alter Zustand << 2) | neuer Zustand, Zustand = (A << 1) | B
+    //                                    neu: 00        01        10        11
+    static constexpr int8_t STEPS[16] = { /* 00 */  0,       +1,       -1,  INVALID,
+                                          /* 01 */ -1,        0,  INVALID,       +1,
+                                          /* 10 */ +1,  INVALID,        0,       -1,
+                                          /* 11 */ INVALID,  -1,       +1,        0 };
+
+    // Die Tabelle wird zur Compile-Zeit in 2 bit pro Eintrag gepackt (32 bit gesamt).
+    // So steckt sie als Konstante im Code und die ISR liest nichts aus dem Flash.
+    static constexpr uint8_t CODE_NONE = 0, CODE_UP = 1, CODE_INVALID = 2, CODE_DOWN = 3;
+
+    constexpr uint32_t code(int8_t d) {
+        return d == 1 ? CODE_UP : d == -1 ? CODE_DOWN : d == INVALID ? CODE_INVALID : CODE_NONE;
+    }
+    constexpr uint32_t pack(int i = 0) {
+        return i == 16 ? 0 : (code(STEPS[i]) << (2 * i)) | pack(i + 1);
+    }
+    static constexpr uint32_t PACKED = pack();
+}
+
+// Tabellengesteuerter Quadratur-Decoder (reine Logik, auch auf dem Host nutzbar).
+// Gültige Übergänge ändern genau ein Bit und zählen +1/-1. Ändern sich beide Bits auf einmal
+// (Kontaktprellen oder verpasste Flanke), ist die Richtung unbekannt: der Übergang wird verworfen
+// und gezählt, der neue Zustand aber übernommen, damit der nächste Schritt wieder passt.
+class QuadratureDecoder {
+public:
+    QuadratureDecoder() : _state(0), _invalid(0) {}
+
+    void reset(uint8_t state) { _state = state & 0x3; }
+
+    // Liefert +1, -1 oder 0 (kein Wechsel bzw. verworfen)
+    inline __attribute__((always_inline)) int8_t step(uint8_t newState) {
+        newState &= 0x3;
+        uint8_t c = (QuadratureTable::PACKED >> (((_state << 2) | newState) * 2)) & 0x3;
+        _state = newState;
+        if (c == QuadratureTable::CODE_INVALID) {
+            _invalid++;
+            return 0;
+        }
+        return c == QuadratureTable::CODE_UP ? 1 : (c == QuadratureTable::CODE_DOWN ? -1 : 0);
+    }
+
+    uint8_t state() const { return _state; }
+    uint32_t invalidTransitions() const { return _invalid; }
+
+private:
+    uint8_t _state;
+    uint32_t _invalid;
+};
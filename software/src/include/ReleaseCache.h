@@ -0,0 +1,27 @@
+#ifndef RELEASE_CACHE_H
+#define RELEASE_CACHE_H
+
+#include <Arduino.h>
+#include <vector>
+
+struct ReleaseInfo {
+    String tagName;
+    String downloadUrl;   // rohe .bin
+    String manifestUrl;   // manifest.json (komprimiertes Image + SHA-256), leer bei alten Releases
+};
+
+// Letzte Release-Liste samt ETag im NVS.
+// Damit kann die nächste Abfrage mit If-None-Match laufen (304 = nichts geändert)
+// und das Menü sofort aus dem Cache gebaut werden, während im Hintergrund aktualisiert wird.
+class ReleaseCache {
+public:
+    // false, wenn nichts (oder etwas für eine andere URL) gespeichert ist
+    static bool load(const char* url, std::vector<ReleaseInfo>& releases, String& etag);
+
+    // Schreibt nur, wenn sich das ETag geändert hat (NVS-Verschleiß)
+    static void store(const char* url, const std::vector<ReleaseInfo>& releases, const String& etag);
+
+    static void clear();
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Lock-freier Ringpuffer fester Größe für genau EINEN Produzenten und EINEN Konsumenten
+// (z.B. ISR -> loop()). Kein Heap, keine Locks.
+// N muss eine Zweierpotenz sein; nutzbar sind N-1 Plätze.
+// push()/pop() sind always_inline, damit sie aus IRAM-ISRs heraus im IRAM landen.
+template <typename T, size_t N>
+class RingBuffer {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "RingBuffer: N muss eine Zweierpotenz sein");
+
+public:
+    RingBuffer() : _head(0), _tail(0) {}
+
+    // Produzent. Liefert false, wenn der Puffer voll ist (Element wird verworfen).
+    inline __attribute__((always_inline)) bool push(const T& item) {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t next = (head + 1) & (N - 1);
+        if (next == _tail.load(std::memory_order_acquire)) return false;
+        _items[head] = item;
+        _head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Konsument. Liefert false, wenn der Puffer leer ist.
+    inline __attribute__((always_inline)) bool pop(T& item) {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        item = _items[tail];
+        _tail.store((tail + 1) & (N - 1), std::memory_order_release);
+        return true;
+    }
+
+    // Konsument: Blick auf das älteste Element ohne es zu entnehmen
+    bool peek(T& item) const {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        item = _items[tail];
+        return true;
+    }
+
+    bool empty() const {
+        return _tail.load(std::memory_order_acquire) == _head.load(std::memory_order_acquire);
+    }
+
+    // Nur aus Sicht des Konsumenten (oder bei stehendem Produzenten) verlässlich
+    void clear() {
+        _tail.store(_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    static constexpr size_t capacity() { return N - 1; }
+
+private:
+    T _items[N];
+    std::atomic<size_t> _head; // nächster Schreibplatz (gehört dem Produzenten)
+    std::atomic<size_t> _tail; // nächster Leseplatz (gehört dem Konsumenten)
+};
+
+#endif
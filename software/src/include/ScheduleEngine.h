@@ -0,0 +1,62 @@
+#ifndef SCHEDULE_ENGINE_H
+#define SCHEDULE_ENGINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Ein Eintrag im Wochenplan: ab minuteOfDay an den Tagen in weekdays gilt dieser Zustand,
+// bis der nächste Eintrag beginnt.
+struct ScheduleSlot {
+    uint8_t weekdays;      // Bit 0 = Montag ... Bit 6 = Sonntag
+    uint16_t minuteOfDay;  // 0..1439, Ortszeit
+    uint8_t mode;          // wie MaxFanMode: 0 OFF, 1 AUTO, 2 MANUAL
+    uint8_t speed;         // 0..100
+    uint8_t airflow;       // 0 IN, 1 OUT
+    uint8_t cover;         // 0 CLOSED, 1 OPEN
+};
+
+// Wochenplan für den Timer-Controller.
+// Bewusst ohne Arduino- und Zeit-Abhängigkeiten: die Zeit kommt als "Sekunde der Woche" herein,
+// damit sich der Plan auf dem PC mit einer virtuellen Uhr durchrechnen lässt.
+//
+// Blob-Format (für BLE/MQTT und NVS), Little Endian:
+//   [0] Format (1)   [1] Anzahl Einträge (0..MAX_SLOTS)
+//   je Eintrag 4 Bytes: weekdays, speed, uint16 (minuteOfDay | mode << 11 | airflow << 13 | cover << 14)
+class ScheduleEngine {
+public:
+    static constexpr size_t MAX_SLOTS = 16;
+    static constexpr uint8_t BLOB_FORMAT = 1;
+    static constexpr size_t BLOB_HEADER = 2;
+    static constexpr size_t BLOB_SLOT = 4;
+    static constexpr size_t MAX_BLOB = BLOB_HEADER + MAX_SLOTS * BLOB_SLOT;
+    static constexpr uint32_t SECONDS_PER_DAY = 24UL * 3600;
+    static constexpr uint32_t SECONDS_PER_WEEK = 7 * SECONDS_PER_DAY;
+
+    // Ungültiger Blob: false, der bisherige Plan bleibt
+    bool decode(const uint8_t* blob, size_t length);
+    // Bytes geschrieben, 0 wenn capacity nicht reicht
+    size_t encode(uint8_t* out, size_t capacity) const;
+
+    bool add(const ScheduleSlot& slot);
+    void clear() { _count = 0; }
+    size_t count() const { return _count; }
+    bool empty() const { return _count == 0; }
+    const ScheduleSlot& slot(size_t index) const { return _slots[index]; }
+
+    static bool isValid(const ScheduleSlot& slot);
+
+    // weekday 0 = Montag
+    static uint32_t weekSecond(int weekday, int hour, int minute, int second);
+
+    // Index des Eintrags, der zur Zeit now gilt (der zuletzt begonnene, notfalls aus der Vorwoche),
+    // -1 bei leerem Plan. Beginnen mehrere gleichzeitig, gewinnt der spätere im Plan.
+    int activeIndex(uint32_t now) const;
+    // Sekunden bis zum nächsten Beginn eines Eintrags (1..SECONDS_PER_WEEK), 0 bei leerem Plan
+    uint32_t secondsUntilNext(uint32_t now) const;
+
+private:
+    ScheduleSlot _slots[MAX_SLOTS];
+    size_t _count = 0;
+};
+
+#endif
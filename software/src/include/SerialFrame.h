@@ -0,0 +1,67 @@
+#ifndef SERIAL_FRAME_H
+#define SERIAL_FRAME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Rahmenformat der USB-Serial-Steuerung (siehe SERIAL_PROTOCOL.md).
+//
+// Paket:  [channel][type][seq][length][data: length Bytes][crc16 LE]
+//         CRC-16/CCITT-FALSE (Poly 0x1021, Start 0xFFFF) über alles vor der CRC.
+// Leitung: 0x00 COBS(Paket) 0x00
+//         Die führende 0x00 beendet unformatierte Debug-Ausgabe, die davor auf derselben
+//         Schnittstelle gelandet ist; der Empfänger verwirft sie als ungültigen Rahmen.
+//
+// Ohne Arduino-Abhängigkeiten, damit sich Kodierung und Prüfung auf dem PC testen lassen.
+class SerialFrame {
+public:
+    static constexpr uint8_t CHANNEL_CONTROL = 0;
+    static constexpr uint8_t CHANNEL_LOG = 1;
+
+    // Kanal CONTROL, Host -> Gerät
+    static constexpr uint8_t TYPE_COMMAND = 0x01;    // JSON wie MaxFanState::SetJson
+    static constexpr uint8_t TYPE_GET_STATUS = 0x02;
+    static constexpr uint8_t TYPE_GET_DIAG = 0x03;
+    static constexpr uint8_t TYPE_PING = 0x04;       // Daten kommen im PONG zurück
+    // Kanal CONTROL, Gerät -> Host
+    static constexpr uint8_t TYPE_ACK = 0x80;        // [ACK_*], seq wie im Kommando
+    static constexpr uint8_t TYPE_STATUS = 0x81;     // Status-JSON, bei Änderung und auf Anfrage
+    static constexpr uint8_t TYPE_DIAG = 0x82;       // Zähler als JSON
+    static constexpr uint8_t TYPE_PONG = 0x83;
+    // Kanal LOG, Gerät -> Host
+    static constexpr uint8_t TYPE_LOG_TEXT = 0x01;   // eine Zeile ohne '\n'
+
+    static constexpr uint8_t ACK_OK = 0;
+    static constexpr uint8_t ACK_UNKNOWN_TYPE = 1;
+    static constexpr uint8_t ACK_INVALID = 2;
+
+    static constexpr size_t HEADER = 4;
+    static constexpr size_t CRC = 2;
+    static constexpr size_t MAX_DATA = 240;
+    static constexpr size_t MAX_PACKET = HEADER + MAX_DATA + CRC;
+    // COBS: ein Overhead-Byte je angefangene 254 Bytes, dazu die beiden Trenner
+    static constexpr size_t MAX_ENCODED = MAX_PACKET + MAX_PACKET / 254 + 1 + 2;
+
+    struct Frame {
+        uint8_t channel;
+        uint8_t type;
+        uint8_t seq;
+        uint8_t length;
+        const uint8_t* data;
+    };
+
+    static uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+    // out braucht length + length / 254 + 1 Bytes
+    static size_t cobsEncode(const uint8_t* in, size_t length, uint8_t* out);
+    // Ohne Trenner. out darf gleich in sein. 0 bei ungültiger Kodierung.
+    static size_t cobsDecode(const uint8_t* in, size_t length, uint8_t* out);
+
+    // Kompletter Rahmen inkl. beider Trenner. 0, wenn length > MAX_DATA oder capacity nicht reicht.
+    static size_t encode(const Frame& frame, uint8_t* out, size_t capacity);
+    // Inhalt zwischen zwei Trennern; dekodiert in-place, frame.data zeigt danach in buffer.
+    // false bei COBS-, Längen- oder CRC-Fehler.
+    static bool decode(uint8_t* buffer, size_t length, Frame& frame);
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef STATICSLOT_H
+#define STATICSLOT_H
+
+#include <new>
+#include <stddef.h>
+#include <utility>
+
+// Platz für genau ein Objekt von T, ohne Heap. Wird erst mit emplace() gebaut (z.B. in setup(),
+// wenn die Konstruktor-Argumente feststehen) und kann mit reset() abgebaut und neu gebaut werden.
+// Als globale Variable oder Member liegt der Speicher fest im RAM, es bleibt nichts zum Fragmentieren.
+template <typename T>
+class StaticSlot {
+public:
+    StaticSlot() : _object(nullptr) {}
+    ~StaticSlot() { reset(); }
+    StaticSlot(const StaticSlot&) = delete;
+    StaticSlot& operator=(const StaticSlot&) = delete;
+
+    // Baut das Objekt (ein vorhandenes wird vorher abgebaut)
+    template <typename... Args>
+    T& emplace(Args&&... args) {
+        reset();
+        _object = new (_storage) T(std::forward<Args>(args)...);
+        return *_object;
+    }
+
+    void reset() {
+        if (!_object) return;
+        _object->~T();
+        _object = nullptr;
+    }
+
+    T* get() const { return _object; }
+    T* operator->() const { return _object; }
+    T& operator*() const { return *_object; }
+    explicit operator bool() const { return _object != nullptr; }
+
+private:
+    alignas(T) unsigned char _storage[sizeof(T)];
+    T* _object;
+};
+
+#endif
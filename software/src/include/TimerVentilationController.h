@@ -2,9 +2,17 @@
 #define TIMERVENTILATIONCONTROLLER_H
 
 #include <Arduino.h>
+#include <esp_timer.h>
 #include "FanController.h"
 #include "MaxFanState.h"
+#include "ScheduleEngine.h"
 
+struct timeval;
+
+// Lokale Steuerung ohne Gegenstelle: Wochenplan (ScheduleEngine), solange einer geladen ist
+// und die Uhr stimmt, sonst der alte Lauf/Pause-Zyklus aus der Config.
+// Der nächste Schaltzeitpunkt wird einmal berechnet und per esp_timer abgewartet;
+// loop() prüft nur ein Flag (kein Polling der Uhr, verträgt Light Sleep).
 class TimerVentilationController : public FanController {
 public:
     TimerVentilationController();
@@ -14,14 +22,53 @@ public:
     void loop() override;
     bool isConnected() override;
     Icon getIcon() override { return ICON_TIMER; }
-    char getIndicatorLetter() override { return '\0'; }
+    char getIndicatorLetter() override;
+
+    // Zeitplan und Uhr kommen über den normalen Kommandokanal (BLE, MQTT):
+    //   {"schedule":"<Base64-Blob>"}   Blob siehe ScheduleEngine, leerer String löscht den Plan
+    //   {"clock":<Unix-Zeit UTC>}      stellt die Uhr (ohne WLAN/SNTP)
+    // true, wenn es ein solches Kommando war (error dann gesetzt), sonst false
+    bool handleCommand(const char* json, MaxError& error);
+
+    // Nächster Schaltzeitpunkt als esp_timer-Zeit (µs), -1 = keiner
+    int64_t nextDeadlineUs() const { return _deadlineUs; }
+
+    // Uhr gestellt (SNTP oder von Hand)? Vorher gilt der Lauf/Pause-Zyklus.
+    static bool clockValid();
+    // Manuelle Uhr ohne Datum: Wochentag (0 = Montag) und Uhrzeit in der Ortszeit
+    static void setManualClock(int weekday, int hour, int minute);
 
 private:
-    int64_t _lastToggleUs;
-    bool _isRunning; // true = MANUAL running, false = OFF pause
+    // Alles vor 2023 gilt als "Uhr nicht gestellt" (die manuelle Uhr liegt in 2024)
+    static constexpr time_t CLOCK_VALID_AFTER = 1672531200;
+
+    static volatile bool _clockChanged;   // SNTP-Sync oder Uhr von Hand gestellt
+
+    ScheduleEngine _schedule;
+    esp_timer_handle_t _timer;
+    volatile bool _due;
+    int64_t _deadlineUs;
+    bool _started;
+    bool _syncing;          // WLAN nur für SNTP aufgebaut
+
+    // -1 = Lauf/Pause-Zyklus, sonst Index im Plan
+    int _activeSlot;
+    bool _isRunning;        // im Zyklus: true = MANUAL läuft, false = Pause (OFF)
+    int64_t _runForUs;
+    int64_t _pauseForUs;
     MaxFanState _runningState;
     MaxFanState _pausedState;
     CommandCallback _cb;
+
+    void evaluate();
+    void armTimer(int64_t delayUs);
+    void apply(const MaxFanState& state);
+    MaxFanState stateFor(const ScheduleSlot& slot) const;
+    void loadSchedule();
+    bool storeSchedule(const uint8_t* blob, size_t length);
+
+    static void onTimer(void* arg);
+    static void onTimeSync(struct timeval* tv);
 };
 
 #endif
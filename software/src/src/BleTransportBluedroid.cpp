@@ -0,0 +1,227 @@
+#include "BleTransportBluedroid.h"
+#include "Log.h"
+
+#ifndef MAXFAN_BLE_NIMBLE
+
+#include <esp_gatts_api.h>
+#include "esp_gap_ble_api.h"
+
+// Für GAP/GATTS-Handler (statische Funktionen ohne Kontext)
+static BleTransportBluedroid* handlerInstance = nullptr;
+
+static BleTransportBluedroid bluedroidTransport;
+
+BleTransport& BleTransport::instance() {
+    return bluedroidTransport;
+}
+
+const char* BleTransport::backendName() {
+    return "Bluedroid";
+}
+
+void BleTransport::clearAllBonds() {
+    // Wir müssen BLE kurz initieren, falls es aus ist, um Bonds zu löschen
+    if (!BLEDevice::getInitialized()) {
+        BLEDevice::init("TEMP_CLEAR");
+    }
+
+    int dev_num = esp_ble_get_bond_device_num();
+    if (dev_num == 0) return;
+
+    LOG_I("BLE: Deleting bonds...");
+    esp_ble_bond_dev_t *dev_list = (esp_ble_bond_dev_t *)malloc(sizeof(esp_ble_bond_dev_t) * dev_num);
+    if (dev_list) {
+        esp_ble_get_bond_device_list(&dev_num, dev_list);
+        for (int i = 0; i < dev_num; i++) {
+            esp_ble_remove_bond_device(dev_list[i].bd_addr);
+        }
+        free(dev_list);
+    }
+}
+
+BleTransportBluedroid::BleTransportBluedroid()
+    : _pServer(nullptr), _pCommandChar(nullptr), _pStatusChar(nullptr), _pMetricsChar(nullptr),
+      _listener(nullptr), _serverCallbacks(this), _charCallbacks(this), _securityCallbacks(this)
+{
+    memset(_peers, 0, sizeof(_peers));
+}
+
+void BleTransportBluedroid::begin(const char* deviceName, uint32_t pin, uint16_t mtu,
+                              uint16_t minInterval, uint16_t maxInterval, BleTransportListener* listener) {
+    _listener = listener;
+
+    // 1. Initialisierung
+    BLEDevice::init(deviceName);
+    BLEDevice::setMTU(mtu);
+    handlerInstance = this;
+    BLEDevice::setCustomGapHandler(gapEventHandler);
+    BLEDevice::setCustomGattsHandler(gattsEventHandler);
+
+    // 2. Security Einstellungen (Still notwendig für PIN-Abfrage am Handy)
+    BLEDevice::setEncryptionLevel(ESP_BLE_SEC_ENCRYPT_MITM);
+    BLEDevice::setSecurityCallbacks(&_securityCallbacks);
+
+    BLESecurity* pSecurity = &_security.emplace();
+    pSecurity->setStaticPIN(pin);
+    pSecurity->setAuthenticationMode(ESP_LE_AUTH_REQ_SC_MITM_BOND);
+    // IO_CAP_OUT signalisiert dem Handy: "Ich zeige dir was an (den statischen PIN), tipp ihn ein."
+    pSecurity->setCapability(ESP_IO_CAP_OUT);
+    pSecurity->setInitEncryptionKey(ESP_BLE_ENC_KEY_MASK | ESP_BLE_ID_KEY_MASK);
+    pSecurity->setRespEncryptionKey(ESP_BLE_ENC_KEY_MASK | ESP_BLE_ID_KEY_MASK);
+
+    // 3. Server & Service
+    _pServer = BLEDevice::createServer();
+    _pServer->setCallbacks(&_serverCallbacks);
+
+    BLEService* pService = _pServer->createService(MAXFAN_SERVICE_UUID);
+
+    // 4. Characteristics (Verschlüsselt)
+    // WRITE_NR: Write Without Response für geringere Kommando-Latenz (bleibt verschlüsselt)
+    _pCommandChar = pService->createCharacteristic(MAXFAN_COMMAND_UUID,
+        BLECharacteristic::PROPERTY_WRITE | BLECharacteristic::PROPERTY_WRITE_NR);
+    _pCommandChar->setAccessPermissions(ESP_GATT_PERM_WRITE_ENC_MITM);
+    _pCommandChar->setCallbacks(&_charCallbacks);
+
+    _pStatusChar = pService->createCharacteristic(MAXFAN_STATUS_UUID, BLECharacteristic::PROPERTY_READ | BLECharacteristic::PROPERTY_NOTIFY);
+    _pStatusChar->setAccessPermissions(ESP_GATT_PERM_READ_ENC_MITM);
+    _pStatusChar->addDescriptor(&_statusCccd.emplace());
+
+    _pMetricsChar = pService->createCharacteristic(MAXFAN_METRICS_UUID, BLECharacteristic::PROPERTY_READ);
+    _pMetricsChar->setAccessPermissions(ESP_GATT_PERM_READ_ENC_MITM);
+
+    pService->start();
+
+    // 5. Scan Response; die Advertising-Daten setzt der BleController
+    setupScanResponse(deviceName, minInterval, maxInterval);
+}
+
+void BleTransportBluedroid::setStatusValue(const uint8_t* data, size_t len) {
+    _pStatusChar->setValue((uint8_t*)data, len);
+}
+
+void BleTransportBluedroid::setMetricsValue(const uint8_t* data, size_t len) {
+    _pMetricsChar->setValue((uint8_t*)data, len);
+}
+
+bool BleTransportBluedroid::notify(uint16_t connId, const uint8_t* data, size_t len) {
+    esp_err_t err = esp_ble_gatts_send_indicate(_pServer->getGattsIf(), connId, _pStatusChar->getHandle(),
+                                                len, (uint8_t*)data, false);
+    return err == ESP_OK;
+}
+
+void BleTransportBluedroid::setManufacturerData(const uint8_t* data, size_t len) {
+    BLEAdvertisementData advData;
+    advData.setFlags(ESP_BLE_ADV_FLAG_GEN_DISC | ESP_BLE_ADV_FLAG_BREDR_NOT_SPT);
+    advData.setCompleteServices(BLEUUID(MAXFAN_SERVICE_UUID));
+    advData.setManufacturerData(std::string((const char*)data, len));
+
+    // Darf auch während des Advertisings gesetzt werden, die Daten werden sofort übernommen
+    BLEDevice::getAdvertising()->setAdvertisementData(advData);
+}
+
+void BleTransportBluedroid::setupScanResponse(const char* deviceName, uint16_t minInterval, uint16_t maxInterval) {
+    BLEAdvertisementData scanData;
+    if (deviceName) scanData.setName(deviceName);
+
+    // Bevorzugtes Verbindungsintervall (AD Type 0x12, Slave Connection Interval Range, LE)
+    const char connInterval[6] = { 0x05, 0x12,
+                                   (char)(minInterval & 0xFF), (char)(minInterval >> 8),
+                                   (char)(maxInterval & 0xFF), (char)(maxInterval >> 8) };
+    scanData.addData(std::string(connInterval, sizeof(connInterval)));
+
+    BLEDevice::getAdvertising()->setScanResponseData(scanData);
+}
+
+void BleTransportBluedroid::startAdvertising() {
+    BLEDevice::startAdvertising();
+}
+
+void BleTransportBluedroid::disconnect(uint16_t connId) {
+    _pServer->disconnect(connId);
+}
+
+void BleTransportBluedroid::updateConnParams(uint16_t connId, uint16_t minInterval, uint16_t maxInterval,
+                                             uint16_t latency, uint16_t timeout) {
+    Peer* peer = findPeer(connId);
+    if (!peer) return;
+    _pServer->updateConnParams(peer->addr, minInterval, maxInterval, latency, timeout);
+}
+
+BleTransportBluedroid::Peer* BleTransportBluedroid::findPeer(uint16_t connId) {
+    for (int i = 0; i < MAX_PEERS; i++) {
+        if (_peers[i].used && _peers[i].connId == connId) return &_peers[i];
+    }
+    return nullptr;
+}
+
+BleTransportBluedroid::Peer* BleTransportBluedroid::findPeer(const esp_bd_addr_t addr) {
+    for (int i = 0; i < MAX_PEERS; i++) {
+        if (_peers[i].used && memcmp(_peers[i].addr, addr, sizeof(esp_bd_addr_t)) == 0) return &_peers[i];
+    }
+    return nullptr;
+}
+
+
+// --- Callbacks ---
+
+void BleTransportBluedroid::MyServerCallbacks::onConnect(BLEServer* s, esp_ble_gatts_cb_param_t* param) {
+    for (int i = 0; i < MAX_PEERS; i++) {
+        Peer& p = _parent->_peers[i];
+        if (p.used) continue;
+        p.used = true;
+        p.connId = param->connect.conn_id;
+        memcpy(p.addr, param->connect.remote_bda, sizeof(esp_bd_addr_t));
+        break;
+    }
+    _parent->_listener->onClientConnected(param->connect.conn_id,
+                                          param->connect.conn_params.interval,
+                                          param->connect.conn_params.latency,
+                                          param->connect.conn_params.timeout);
+}
+
+void BleTransportBluedroid::MyServerCallbacks::onDisconnect(BLEServer* s, esp_ble_gatts_cb_param_t* param) {
+    Peer* peer = _parent->findPeer(param->disconnect.conn_id);
+    if (peer) peer->used = false;
+    _parent->_listener->onClientDisconnected(param->disconnect.conn_id);
+}
+
+void BleTransportBluedroid::MyServerCallbacks::onMtuChanged(BLEServer* s, esp_ble_gatts_cb_param_t* param) {
+    _parent->_listener->onMtuChanged(param->mtu.conn_id, param->mtu.mtu);
+}
+
+void BleTransportBluedroid::MyCharCallbacks::onWrite(BLECharacteristic* pChar, esp_ble_gatts_cb_param_t* param) {
+    std::string rxValue = pChar->getValue();
+    _parent->_listener->onCommand(param->write.conn_id, (const uint8_t*)rxValue.data(), rxValue.length());
+}
+
+void BleTransportBluedroid::MySecurityCallbacks::onAuthenticationComplete(esp_ble_auth_cmpl_t cmpl) {
+    if (!_parent) return;
+    Peer* peer = _parent->findPeer(cmpl.bd_addr);
+    if (!peer) return;
+    _parent->_listener->onAuthenticationComplete(peer->connId, cmpl.success == 1);
+}
+
+void BleTransportBluedroid::gapEventHandler(esp_gap_ble_cb_event_t event, esp_ble_gap_cb_param_t* param) {
+    if (event != ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT || !handlerInstance) return;
+
+    if (param->update_conn_params.status != ESP_BT_STATUS_SUCCESS) {
+        LOG_W("BLE: Connection parameter update rejected (status %d)", param->update_conn_params.status);
+        return;
+    }
+    Peer* peer = handlerInstance->findPeer(param->update_conn_params.bda);
+    if (!peer) return;
+    handlerInstance->_listener->onConnParamsUpdated(peer->connId,
+                                                    param->update_conn_params.conn_int,
+                                                    param->update_conn_params.latency,
+                                                    param->update_conn_params.timeout);
+}
+
+void BleTransportBluedroid::gattsEventHandler(esp_gatts_cb_event_t event, esp_gatt_if_t gattsIf, esp_ble_gatts_cb_param_t* param) {
+    // Der BLE2902 selbst kennt nur einen Wert für alle Clients; die Abos pro Verbindung melden wir hier.
+    if (event != ESP_GATTS_WRITE_EVT || !handlerInstance || !handlerInstance->_statusCccd) return;
+    if (param->write.handle != handlerInstance->_statusCccd->getHandle() || param->write.len != 2) return;
+
+    handlerInstance->_listener->onSubscribeChanged(param->write.conn_id, (param->write.value[0] & 0x01) != 0);
+}
+
+#endif // MAXFAN_BLE_NIMBLE
@@ -0,0 +1,186 @@
+#include "BleTransportNimBLE.h"
+#include "Log.h"
+
+#ifdef MAXFAN_BLE_NIMBLE
+
+static BleTransportNimBLE nimbleTransport;
+
+BleTransport& BleTransport::instance() {
+    return nimbleTransport;
+}
+
+const char* BleTransport::backendName() {
+    return "NimBLE";
+}
+
+void BleTransport::clearAllBonds() {
+    // Der Stack muss laufen, damit der Bond-Speicher erreichbar ist
+    if (!NimBLEDevice::getInitialized()) {
+        NimBLEDevice::init("TEMP_CLEAR");
+    }
+    LOG_I("BLE: Deleting bonds...");
+    NimBLEDevice::deleteAllBonds();
+}
+
+BleTransportNimBLE::BleTransportNimBLE()
+    : _pServer(nullptr), _pCommandChar(nullptr), _pStatusChar(nullptr), _pMetricsChar(nullptr), _listener(nullptr), _pin(0),
+      _serverCallbacks(this), _charCallbacks(this)
+{
+    memset(_pending, 0, sizeof(_pending));
+    portMUX_INITIALIZE(&_pendingLock);
+}
+
+void BleTransportNimBLE::begin(const char* deviceName, uint32_t pin, uint16_t mtu,
+                              uint16_t minInterval, uint16_t maxInterval, BleTransportListener* listener) {
+    _listener = listener;
+    _pin = pin;
+
+    // 1. Initialisierung
+    NimBLEDevice::init(deviceName);
+    NimBLEDevice::setMTU(mtu);
+
+    // 2. Security: statischer PIN, MITM, Secure Connections, Bonding (wie beim Bluedroid-Backend)
+    NimBLEDevice::setSecurityAuth(true, true, true);
+    NimBLEDevice::setSecurityPasskey(pin);
+    NimBLEDevice::setSecurityIOCap(BLE_HS_IO_DISPLAY_ONLY);
+    NimBLEDevice::setSecurityInitKey(BLE_SM_PAIR_KEY_DIST_ENC | BLE_SM_PAIR_KEY_DIST_ID);
+    NimBLEDevice::setSecurityRespKey(BLE_SM_PAIR_KEY_DIST_ENC | BLE_SM_PAIR_KEY_DIST_ID);
+
+    // 3. Server & Service
+    _pServer = NimBLEDevice::createServer();
+    _pServer->setCallbacks(&_serverCallbacks, false);
+    // Advertising steuert der BleController (Verbindungs-Limit)
+    _pServer->advertiseOnDisconnect(false);
+
+    NimBLEService* pService = _pServer->createService(MAXFAN_SERVICE_UUID);
+
+    // 4. Characteristics (verschlüsselt + authentifiziert = MITM)
+    _pCommandChar = pService->createCharacteristic(MAXFAN_COMMAND_UUID,
+        NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_NR |
+        NIMBLE_PROPERTY::WRITE_ENC | NIMBLE_PROPERTY::WRITE_AUTHEN);
+    _pCommandChar->setCallbacks(&_charCallbacks);
+
+    // Den CCCD (0x2902) legt NimBLE wegen NOTIFY selbst an
+    _pStatusChar = pService->createCharacteristic(MAXFAN_STATUS_UUID,
+        NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::READ_ENC | NIMBLE_PROPERTY::READ_AUTHEN |
+        NIMBLE_PROPERTY::NOTIFY);
+    _pStatusChar->setCallbacks(&_charCallbacks);
+
+    _pMetricsChar = pService->createCharacteristic(MAXFAN_METRICS_UUID,
+        NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::READ_ENC | NIMBLE_PROPERTY::READ_AUTHEN);
+
+    pService->start();
+
+    // 5. Scan Response; die Advertising-Daten setzt der BleController
+    setupScanResponse(deviceName, minInterval, maxInterval);
+}
+
+void BleTransportNimBLE::loop() {
+    uint32_t now = millis();
+    for (int i = 0; i < MAX_PENDING_QUERIES; i++) {
+        uint16_t connId;
+        portENTER_CRITICAL(&_pendingLock);
+        bool due = _pending[i].used && (int32_t)(now - _pending[i].dueMs) >= 0;
+        if (due) {
+            _pending[i].used = false;
+            connId = _pending[i].connId;
+        }
+        portEXIT_CRITICAL(&_pendingLock);
+        if (!due) continue;
+
+        NimBLEConnInfo info = _pServer->getPeerIDInfo(connId);
+        if (info.getConnHandle() != connId) continue; // inzwischen getrennt
+        _listener->onConnParamsUpdated(connId, info.getConnInterval(), info.getConnLatency(), info.getConnTimeout());
+    }
+}
+
+void BleTransportNimBLE::setStatusValue(const uint8_t* data, size_t len) {
+    _pStatusChar->setValue(data, len);
+}
+
+void BleTransportNimBLE::setMetricsValue(const uint8_t* data, size_t len) {
+    _pMetricsChar->setValue(data, len);
+}
+
+bool BleTransportNimBLE::notify(uint16_t connId, const uint8_t* data, size_t len) {
+    os_mbuf* om = ble_hs_mbuf_from_flat(data, len);
+    if (!om) return false;
+    // ble_gattc_notify_custom gibt den mbuf in jedem Fall frei
+    return ble_gattc_notify_custom(connId, _pStatusChar->getHandle(), om) == 0;
+}
+
+void BleTransportNimBLE::setManufacturerData(const uint8_t* data, size_t len) {
+    NimBLEAdvertisementData advData;
+    advData.setFlags(BLE_HS_ADV_F_DISC_GEN | BLE_HS_ADV_F_BREDR_UNSUP);
+    advData.setCompleteServices(NimBLEUUID(MAXFAN_SERVICE_UUID));
+    advData.setManufacturerData(std::string((const char*)data, len));
+    NimBLEDevice::getAdvertising()->setAdvertisementData(advData);
+}
+
+void BleTransportNimBLE::setupScanResponse(const char* deviceName, uint16_t minInterval, uint16_t maxInterval) {
+    NimBLEAdvertisementData scanData;
+    if (deviceName) scanData.setName(deviceName);
+
+    // Bevorzugtes Verbindungsintervall (AD Type 0x12, Slave Connection Interval Range, LE)
+    const char connInterval[6] = { 0x05, 0x12,
+                                   (char)(minInterval & 0xFF), (char)(minInterval >> 8),
+                                   (char)(maxInterval & 0xFF), (char)(maxInterval >> 8) };
+    scanData.addData(std::string(connInterval, sizeof(connInterval)));
+
+    NimBLEDevice::getAdvertising()->setScanResponseData(scanData);
+}
+
+void BleTransportNimBLE::startAdvertising() {
+    NimBLEDevice::startAdvertising();
+}
+
+void BleTransportNimBLE::disconnect(uint16_t connId) {
+    _pServer->disconnect(connId);
+}
+
+void BleTransportNimBLE::updateConnParams(uint16_t connId, uint16_t minInterval, uint16_t maxInterval,
+                                          uint16_t latency, uint16_t timeout) {
+    _pServer->updateConnParams(connId, minInterval, maxInterval, latency, timeout);
+
+    portENTER_CRITICAL(&_pendingLock);
+    for (int i = 0; i < MAX_PENDING_QUERIES; i++) {
+        if (_pending[i].used && _pending[i].connId != connId) continue;
+        _pending[i].used = true;
+        _pending[i].connId = connId;
+        _pending[i].dueMs = millis() + CONN_PARAMS_QUERY_DELAY_MS;
+        break;
+    }
+    portEXIT_CRITICAL(&_pendingLock);
+}
+
+
+// --- Callbacks ---
+
+void BleTransportNimBLE::MyServerCallbacks::onConnect(NimBLEServer* s, ble_gap_conn_desc* desc) {
+    _parent->_listener->onClientConnected(desc->conn_handle, desc->conn_itvl, desc->conn_latency,
+                                          desc->supervision_timeout);
+}
+
+void BleTransportNimBLE::MyServerCallbacks::onDisconnect(NimBLEServer* s, ble_gap_conn_desc* desc) {
+    _parent->_listener->onClientDisconnected(desc->conn_handle);
+}
+
+void BleTransportNimBLE::MyServerCallbacks::onMTUChange(uint16_t mtu, ble_gap_conn_desc* desc) {
+    _parent->_listener->onMtuChanged(desc->conn_handle, mtu);
+}
+
+void BleTransportNimBLE::MyServerCallbacks::onAuthenticationComplete(ble_gap_conn_desc* desc) {
+    bool success = desc->sec_state.encrypted && desc->sec_state.authenticated;
+    _parent->_listener->onAuthenticationComplete(desc->conn_handle, success);
+}
+
+void BleTransportNimBLE::MyCharCallbacks::onWrite(NimBLECharacteristic* pChar, ble_gap_conn_desc* desc) {
+    std::string rxValue = pChar->getValue();
+    _parent->_listener->onCommand(desc->conn_handle, (const uint8_t*)rxValue.data(), rxValue.length());
+}
+
+void BleTransportNimBLE::MyCharCallbacks::onSubscribe(NimBLECharacteristic* pChar, ble_gap_conn_desc* desc, uint16_t subValue) {
+    _parent->_listener->onSubscribeChanged(desc->conn_handle, (subValue & 0x0001) != 0);
+}
+
+#endif // MAXFAN_BLE_NIMBLE
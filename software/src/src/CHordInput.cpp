@@ -1,114 +1,145 @@
 #include "ChordInput.h"
+#include "Log.h"
 #include <esp_timer.h>
 
 // =========================================================
-// Implementierung: KeyEvent Struct
+// Implementierung: ChordRecognizer Klasse
+// (KeyEvent und ChordInput<Pins...> sind komplett im Header)
 // =========================================================
 
-KeyEvent::KeyEvent(uint16_t m, const std::vector<int>* pMap) 
-    : mask(m), pinMap(pMap) {}
-
-KeyEvent::KeyEvent() 
-    : mask(0), pinMap(nullptr) {}
-
-int KeyEvent::getBitIndex(int pinId) const {
-    if (!pinMap) return -1;
-    // Suche den Pin im Vector
-    for (size_t i = 0; i < pinMap->size(); ++i) {
-        if ((*pinMap)[i] == pinId) return (int)i;
-    }
-    return -1; // Nicht gefunden
-}
-
-bool KeyEvent::IsSingle(int pinId) const {
-    int idx = getBitIndex(pinId);
-    if (idx < 0) return false;
-    // Prüfen ob NUR dieses eine Bit gesetzt ist
-    return mask == (uint16_t)(1 << idx);
-}
-
-bool KeyEvent::IsChord(int pinIdA, int pinIdB) const {
-    int idxA = getBitIndex(pinIdA);
-    int idxB = getBitIndex(pinIdB);
-    if (idxA < 0 || idxB < 0) return false;
-    
-    // Prüfen ob GENAU diese zwei Bits gesetzt sind
-    return mask == (uint16_t)((1 << idxA) | (1 << idxB));
-}
-
-
-// =========================================================
-// Implementierung: ChordInput Klasse
-// =========================================================
-
-ChordInput::ChordInput(std::initializer_list<int> pins) 
-    : _pins(pins) 
+ChordRecognizer::ChordRecognizer() 
+    : _isrLastMask(0), _droppedEdges(0), _overflow(false),
+      _debouncer(DEBOUNCE_US)
 {
     _currentSequence = 0;
     _isRecording = false;
+    _currentChordIsCancelled = false;
+    _emitted = false;
+    _emittedMask = 0;
+    _longPressFired = false;
+    _pressStartUs = 0;
+    _nextRepeatUs = 0;
+    _lastSingleMask = 0;
+    _lastSingleUs = 0;
+    _releaseTriggeredMask = 0;
+    _chordKeysMask = 0;
+    _doublePressMask = 0;
+    setTiming(DEFAULT_CHORD_WINDOW_MS, DEFAULT_LONG_PRESS_MS, DEFAULT_REPEAT_MS, DEFAULT_DOUBLE_PRESS_MS);
     _lastInputTime = esp_timer_get_time();
+}
 
-    // Hardware initialisieren (Active Low angenommen -> INPUT_PULLUP)
-    for (int pin : _pins) {
-        pinMode(pin, INPUT_PULLUP);
-    }
+void ChordRecognizer::start(uint32_t mask) {
+    _isrLastMask = mask;
+    _debouncer.reset(mask, (uint32_t)esp_timer_get_time());
 }
 
-uint16_t ChordInput::readHardware() {
-    uint16_t inputMask = 0;
-    
-    for (size_t i = 0; i < _pins.size(); ++i) {
-        // Logik: Active LOW (Taste gedrückt = LOW)
-        if (digitalRead(_pins[i]) == LOW) {
-            inputMask |= (1 << i);
-        }
+void IRAM_ATTR ChordRecognizer::onEdge(uint32_t mask) {
+    // Prellen liefert oft mehrere Interrupts mit gleichem Pegel -> nur echte Änderungen ablegen
+    if (mask == _isrLastMask) return;
+    _isrLastMask = mask;
+
+    Edge e = { (uint32_t)esp_timer_get_time(), mask };
+    if (!_edges.push(e)) {
+        _droppedEdges = _droppedEdges + 1;
+        _overflow = true;
     }
-    return inputMask;
 }
-void ChordInput::CancelCurrentChord() {
+
+void ChordRecognizer::CancelCurrentChord() {
     if(!_isRecording) return;
     
     _currentChordIsCancelled = true;
 
 }
 
-bool ChordInput::IsKeyDown(int pin)
-{
-    uint16_t currentState = readHardware();
-    if (currentState==0) return false;
-    for (size_t i = 0; i < _pins.size(); ++i) {
-        if ((_pins[i]) == pin) {
-            return (currentState & (1 << i)) != 0;
-        }
-    }
-    return false;
+void ChordRecognizer::setTiming(uint16_t chordWindowMs, uint16_t longPressMs, uint16_t repeatMs, uint16_t doublePressMs) {
+    _chordWindowUs = chordWindowMs * 1000UL;
+    _longPressUs = longPressMs * 1000UL;
+    _repeatUs = repeatMs * 1000UL;
+    _doublePressUs = doublePressMs * 1000UL;
+}
+
+void ChordRecognizer::setReleaseTriggered(int pinId, bool releaseTriggered) {
+    if (releaseTriggered) _releaseTriggeredMask |= KeyEvent::pinBit(pinId);
+    else                  _releaseTriggeredMask &= ~KeyEvent::pinBit(pinId);
+}
+
+void ChordRecognizer::addChord(int pinIdA, int pinIdB) {
+    _chordKeysMask |= KeyEvent::pinBit(pinIdA) | KeyEvent::pinBit(pinIdB);
+}
+
+void ChordRecognizer::setDoublePress(int pinId, bool enabled) {
+    if (enabled) _doublePressMask |= KeyEvent::pinBit(pinId);
+    else         _doublePressMask &= ~KeyEvent::pinBit(pinId);
 }
 
-void ChordInput::tick() {
-    if (millis() - lastButtonCheck < 20) {
-      return;
+void ChordRecognizer::tick() {
+    int64_t now = esp_timer_get_time();
+    uint32_t now32 = (uint32_t)now;
+    uint32_t stable;
+    uint32_t atUs;
+
+    Edge e;
+    while (_edges.pop(e)) {
+        if (_debouncer.feed(e.timeUs, e.mask, stable, atUs)) {
+            // Erst die Zeit bis zur Flanke nachholen (Chord-Fenster, Long-Press), dann die Flanke selbst
+            applyTime(atUs);
+            applyStable(stable, atUs, now, now32);
+        }
     }
 
-    lastButtonCheck = millis();
+    if (_overflow) {
+        // Flanken gingen verloren -> mit dem echten Pegel neu aufsetzen
+        _overflow = false;
+        LOG_W("ChordInput: Flanken-Puffer voll, %lu Flanken verworfen", (unsigned long)_droppedEdges);
+        uint32_t mask = readPins();
+        _isrLastMask = mask;
+        if (_debouncer.feed(now32, mask, stable, atUs)) {
+            applyTime(atUs);
+            applyStable(stable, atUs, now, now32);
+        }
+    }
 
+    if (_debouncer.poll(now32, stable, atUs)) {
+        applyTime(atUs);
+        applyStable(stable, atUs, now, now32);
+    }
+    applyTime(now32);
+}
 
-    uint16_t liveInput = readHardware();
+static int bitCount(uint32_t mask) {
+    int n = 0;
+    for (; mask; mask &= mask - 1) n++;
+    return n;
+}
 
-    if (liveInput > 0) {
+void ChordRecognizer::applyStable(uint32_t mask, uint32_t atUs, int64_t nowUs, uint32_t nowUs32) {
+    if (mask > 0) {
         // FALL: Tasten sind gedrückt -> Aufnehmen/Erweitern
-        _isRecording = true;
-        _currentSequence |= liveInput;
-        _lastInputTime = esp_timer_get_time(); // Zeitstempel aktualisieren
+        if (!_isRecording) {
+            _isRecording = true;
+            _currentSequence = 0;
+            _emitted = false;
+            _emittedMask = 0;
+            _longPressFired = false;
+            _pressStartUs = atUs;
+        }
+        _currentSequence |= mask;
+        // Zeitstempel der Flanke (kann weit zurückliegen, wenn der Loop blockiert war)
+        _lastInputTime = nowUs - (int64_t)(uint32_t)(nowUs32 - atUs);
+
+        // Zweite Taste dazu -> Chord sofort melden (auch wenn die erste schon als Einzeltaste kam)
+        if (!_currentChordIsCancelled && bitCount(_currentSequence) >= 2 && _currentSequence != _emittedMask) {
+            _pressStartUs = atUs; // Long-Press zählt für den Chord neu
+            _longPressFired = false;
+            emit(KeyEventType::PRESS, _currentSequence);
+        }
     } 
     else {
         // FALL: Alle Tasten losgelassen
-        if (_isRecording && ! _currentChordIsCancelled) {
-            // Sequenz ist beendet -> Speichern
-            if (_currentSequence > 0) {
-                // Event erstellen und Map-Pointer übergeben
-                KeyEvent evt(_currentSequence, &_pins);
-                _eventQueue.push(evt);
-            }
+        // Noch kein Event? (kurzer Tipp innerhalb des Chord-Fensters oder Taste mit Release-Trigger)
+        if (_isRecording && !_currentChordIsCancelled && !_emitted && _currentSequence > 0) {
+            emit(KeyEventType::PRESS, _currentSequence);
         }
         _currentChordIsCancelled = false;
         _currentSequence = 0;
@@ -116,20 +147,67 @@ void ChordInput::tick() {
     }
 }
 
-bool ChordInput::hasEvent() {
-    return !_eventQueue.empty();
+void ChordRecognizer::applyTime(uint32_t nowUs) {
+    if (!_isRecording || _currentChordIsCancelled) return;
+    uint32_t held = nowUs - _pressStartUs;
+
+    // Einzeltaste: kam im Chord-Fenster keine zweite dazu, ist es ein einfacher Druck.
+    // Tasten mit Release-Trigger und Chord-Tasten melden sich erst beim Loslassen: eine Chord-Taste kann
+    // jederzeit noch zum Chord werden, ein vorzeitiger PRESS würde z.B. erst den Modus weiterschalten.
+    uint32_t deferred = _releaseTriggeredMask | _chordKeysMask;
+    if (!_emitted && !(_currentSequence & deferred) && held >= _chordWindowUs) {
+        emit(KeyEventType::PRESS, _currentSequence);
+    }
+
+    if (!_longPressFired) {
+        if (held >= _longPressUs) {
+            _longPressFired = true;
+            _nextRepeatUs = nowUs + _repeatUs;
+            emit(KeyEventType::LONG_PRESS, _currentSequence);
+        }
+    } else if ((int32_t)(nowUs - _nextRepeatUs) >= 0) {
+        // Verpasste Wiederholungen (blockierter Loop) nicht nachholen
+        _nextRepeatUs = nowUs + _repeatUs;
+        emit(KeyEventType::REPEAT, _currentSequence);
+    }
+}
+
+void ChordRecognizer::emit(KeyEventType type, uint32_t mask) {
+    _emitted = true;
+    _emittedMask = mask;
+
+    // Doppelklick: zweiter Druck derselben Einzeltaste kurz nach dem ersten ersetzt den PRESS
+    if (type == KeyEventType::PRESS && bitCount(mask) == 1 && (mask & _doublePressMask)) {
+        if (mask == _lastSingleMask && (uint32_t)(_pressStartUs - _lastSingleUs) <= _doublePressUs) {
+            _lastSingleMask = 0;
+            type = KeyEventType::DOUBLE_PRESS;
+        } else {
+            _lastSingleMask = mask;
+            _lastSingleUs = _pressStartUs;
+        }
+    }
+
+    KeyEvent evt(mask, type, _pressStartUs);
+    if (!_events.push(evt)) {
+        LOG_W("ChordInput: Event-Queue voll, Event verworfen");
+    }
+}
+
+bool ChordRecognizer::hasEvent() {
+    return !_events.empty();
 }
 
-KeyEvent ChordInput::popEvent() {
-    if (_eventQueue.empty()) {
+KeyEvent ChordRecognizer::popEvent() {
+    KeyEvent evt;
+    if (!_events.pop(evt)) {
         return KeyEvent(); // Leeres Event
     }
-    
-    KeyEvent evt = _eventQueue.front();
-    _eventQueue.pop();
+    // Messung: Latenz vom Drücken bis zur Auslieferung des Events
+    LOG_D("ChordInput: Event Typ %u Maske 0x%lx, %lu ms nach dem Drücken", (unsigned)evt.type, (unsigned long)evt.mask,
+          (unsigned long)(((uint32_t)esp_timer_get_time() - evt.pressTimeUs) / 1000));
     return evt;
 }
 
-int64_t ChordInput::getLastInputTime() const {
+int64_t ChordRecognizer::getLastInputTime() const {
     return _lastInputTime;
-}
\ No newline at end of file
+}
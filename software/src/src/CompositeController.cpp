@@ -0,0 +1,157 @@
+#include "CompositeController.h"
+#include "Log.h"
+#include <esp_timer.h>
+
+CompositeController::CompositeController()
+    : _count(0), _cb(nullptr), _holdMs(0),
+      _lock(portMUX_INITIALIZER_UNLOCKED), _lastWriter(-1), _lastWriteMs(0), _dropped(0),
+      _statsStartMs(0), _statsLoops(0), _statsTotalUs(0), _statsMaxUs(0)
+{
+}
+
+bool CompositeController::add(FanController& member, uint8_t priority) {
+    if (_count >= MAX_MEMBERS) return false;
+    _members[_count].controller = &member;
+    _members[_count].priority = priority;
+    _members[_count].deferredSeq = 0;
+
+    // Kommandos des Mitglieds gehen erst durch die Arbitrierung
+    int index = _count;
+    member.setCommandCallback([this, index](const char* json) { onMemberCommand(index, json); });
+    _count++;
+    return true;
+}
+
+void CompositeController::begin(const char* deviceName) {
+    (void)deviceName;
+    portENTER_CRITICAL(&_lock);
+    _lastWriter = -1;
+    _dropped = 0;
+    for (int i = 0; i < _count; i++) _members[i].deferredSeq = 0;
+    portEXIT_CRITICAL(&_lock);
+    _statsStartMs = millis();
+    LOG_I("Controller: %d Mitglied(er), Vorrang %lu ms", _count, (unsigned long)_holdMs);
+}
+
+void CompositeController::setCommandCallback(CommandCallback cb) {
+    _cb = cb;
+}
+
+void CompositeController::onMemberCommand(int index, const char* json) {
+    uint32_t now = millis();
+    Member& member = _members[index];
+
+    portENTER_CRITICAL(&_lock);
+    int holder = _lastWriter;
+    uint32_t remainingMs = _holdMs - (now - _lastWriteMs);
+    bool deferred = isHeldOff(index, now);
+    if (deferred) {
+        member.deferredSeq = ++_dropped;
+        strlcpy(member.deferred, json, sizeof(member.deferred));
+    } else {
+        // Ein neues Kommando ersetzt ein zurückgestelltes desselben Mitglieds
+        member.deferredSeq = 0;
+        _lastWriter = index;
+        _lastWriteMs = now;
+    }
+    uint32_t dropped = _dropped;
+    portEXIT_CRITICAL(&_lock);
+
+    if (deferred) {
+        LOG_W("Controller: Kommando von Mitglied %d zurückgestellt (Vorrang für %d, noch %lu ms), %lu zurückgestellt",
+              index, holder, (unsigned long)remainingMs, (unsigned long)dropped);
+        return;
+    }
+    if (_cb) _cb(json);
+}
+
+bool CompositeController::isHeldOff(int index, uint32_t now) const {
+    return _lastWriter >= 0 && _lastWriter != index &&
+           _members[_lastWriter].priority < _members[index].priority &&
+           now - _lastWriteMs < _holdMs;
+}
+
+void CompositeController::replayDeferred() {
+    // Kopie, damit der Callback außerhalb des Locks läuft und ein neues Kommando den Platz belegen darf
+    char json[MAX_COMMAND + 1];
+    int index = -1;
+    uint32_t now = millis();
+
+    portENTER_CRITICAL(&_lock);
+    for (int i = 0; i < _count; i++) {
+        if (_members[i].deferredSeq == 0 || isHeldOff(i, now)) continue;
+        if (index < 0 || _members[i].deferredSeq < _members[index].deferredSeq) index = i;
+    }
+    if (index >= 0) {
+        memcpy(json, _members[index].deferred, sizeof(json));
+        _members[index].deferredSeq = 0;
+        _lastWriter = index;
+        _lastWriteMs = now;
+    }
+    portEXIT_CRITICAL(&_lock);
+
+    if (index < 0) return;
+    LOG_I("Controller: zurückgestelltes Kommando von Mitglied %d nachgeholt", index);
+    if (_cb) _cb(json);
+}
+
+void CompositeController::notifyStatus(const MaxFanState& state) {
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < _count; i++) {
+        _members[i].controller->notifyStatus(state);
+    }
+    accountLoop(esp_timer_get_time() - start);
+}
+
+void CompositeController::loop() {
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < _count; i++) {
+        _members[i].controller->loop();
+    }
+    replayDeferred();
+    accountLoop(esp_timer_get_time() - start);
+
+    // notifyStatus() und loop() laufen je einmal pro Hauptschleife: hier wird eine Runde gezählt
+    _statsLoops++;
+    uint32_t now = millis();
+    if (now - _statsStartMs >= STATS_INTERVAL_MS && _statsLoops > 0) {
+        LOG_I("Controller: %d Mitglied(er), pro Loop Ø %lld us, max %lld us (%lu Loops)",
+              _count, _statsTotalUs / _statsLoops, _statsMaxUs, (unsigned long)_statsLoops);
+        _statsStartMs = now;
+        _statsLoops = 0;
+        _statsTotalUs = 0;
+        _statsMaxUs = 0;
+    }
+}
+
+void CompositeController::accountLoop(int64_t elapsedUs) {
+    _statsTotalUs += elapsedUs;
+    if (elapsedUs > _statsMaxUs) _statsMaxUs = elapsedUs;
+}
+
+bool CompositeController::isConnected() {
+    for (int i = 0; i < _count; i++) {
+        if (_members[i].controller->isConnected()) return true;
+    }
+    return false;
+}
+
+FanController::Icon CompositeController::getIcon() {
+    return _count > 0 ? _members[0].controller->getIcon() : ICON_NONE;
+}
+
+char CompositeController::getIndicatorLetter() {
+    for (int i = 0; i < _count; i++) {
+        char letter = _members[i].controller->getIndicatorLetter();
+        if (letter != '\0') return letter;
+    }
+    return '\0';
+}
+
+int CompositeController::getIndicators(Indicator* out, int max) {
+    int n = 0;
+    for (int i = 0; i < _count && n < max; i++) {
+        n += _members[i].controller->getIndicators(out + n, max - n);
+    }
+    return n;
+}
@@ -0,0 +1,658 @@
+#include "ConfigJobs.h"
+#include "Log.h"
+#include "MaxFanWiFi.h"
+#include <WiFi.h>
+#include <Update.h>
+#include <ArduinoJson.h>
+#include <lwip/sockets.h>
+#include <errno.h>
+
+#ifndef APP_VERSION
+#define APP_VERSION "v0.0.0-dev"
+#endif
+
+// =========================================================
+// ConfigJob (Basis)
+// =========================================================
+
+ConfigJob::ConfigJob() : _wifiStep(WiFiStep::START) {
+    _message[0] = '\0';
+    _detail[0] = '\0';
+}
+
+void ConfigJob::setMessage(const char* message, const char* detail) {
+    strlcpy(_message, message, sizeof(_message));
+    strlcpy(_detail, detail ? detail : "", sizeof(_detail));
+}
+
+ConfigJob::Result ConfigJob::fail(const char* message, const char* detail) {
+    LOG_E("Job: %s %s", message, detail);
+    setMessage(message, detail);
+    return Result::FAILED;
+}
+
+ConfigJob::Result ConfigJob::stepWiFi(const ConfigData& cfg, bool reconnect) {
+    switch (_wifiStep) {
+        case WiFiStep::START:
+            if (!reconnect && WiFi.status() == WL_CONNECTED) {
+                _wifiStep = WiFiStep::DONE;
+                return Result::SUCCESS;
+            }
+            if (reconnect) WiFi.disconnect();
+            setMessage("Connecting Wi-Fi...", cfg.wifiSSID);
+            WiFiConnector::begin(cfg.wifiSSID, cfg.wifiPassword, 10000);
+            _wifiStep = WiFiStep::CONNECTING;
+            return Result::RUNNING;
+
+        case WiFiStep::CONNECTING:
+            switch (WiFiConnector::poll()) {
+                case WiFiConnector::Status::CONNECTED:
+                    _wifiStep = WiFiStep::DONE;
+                    return Result::SUCCESS;
+                case WiFiConnector::Status::FAILED:
+                case WiFiConnector::Status::IDLE:
+                    return fail("WiFi Failed", "Check Settings");
+                default:
+                    return Result::RUNNING;
+            }
+
+        case WiFiStep::DONE:
+        default:
+            return Result::SUCCESS;
+    }
+}
+
+bool ConfigJob::beginHttp(HTTPClient& http, WiFiClientSecure& secureClient, WiFiClient& plainClient, const String& url) {
+    if (url.startsWith("https://")) {
+        secureClient.setInsecure();
+        return http.begin(secureClient, url);
+    }
+    return http.begin(plainClient, url);
+}
+
+void ConfigJob::cancelWiFi() {
+    if (_wifiStep == WiFiStep::CONNECTING) {
+        WiFiConnector::cancel();
+    }
+    _wifiStep = WiFiStep::START;
+}
+
+// =========================================================
+// Wi-Fi Test
+// =========================================================
+
+void WifiTestJob::start(const ConfigData& cfg) {
+    _cfg = &cfg;
+    startWiFi();
+    setMessage("Testing Connection...");
+}
+
+ConfigJob::Result WifiTestJob::step() {
+    Result r = stepWiFi(*_cfg, true);
+    if (r == Result::SUCCESS) setMessage("Connection", "Successful!");
+    if (r == Result::FAILED)  setMessage("Connection", "Failed!");
+    return r;
+}
+
+void WifiTestJob::cancel() {
+    cancelWiFi();
+}
+
+// =========================================================
+// MQTT Test
+// =========================================================
+
+// Keine Leerzeichen/Zeilenumbrüche, nicht leer
+static bool isValidToken(const char* s) {
+    if (!s || !*s) return false;
+    for (const char* p = s; *p; ++p) {
+        if (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') return false;
+    }
+    return true;
+}
+
+void MqttTestJob::start(const ConfigData& cfg) {
+    _cfg = &cfg;
+    _step = Step::WIFI;
+    closeSocket();
+    startWiFi();
+    setMessage("Testing MQTT...");
+}
+
+ConfigJob::Result MqttTestJob::step() {
+    switch (_step) {
+        case Step::WIFI: {
+            Result r = stepWiFi(*_cfg);
+            if (r != Result::SUCCESS) return r;
+
+            if (!isValidToken(_cfg->mqttHost)) {
+                return fail("MQTT Host invalid", "No whitespace, e.g. test.mosquitto.org");
+            }
+            if (!isValidToken(_cfg->mqttCommandTopic) || !isValidToken(_cfg->mqttStateTopic)) {
+                return fail("MQTT Topic invalid", "No whitespace allowed in topics");
+            }
+            setMessage("Resolving...", _cfg->mqttHost);
+            _step = Step::RESOLVE;
+            return Result::RUNNING;
+        }
+
+        case Step::RESOLVE: {
+            // DNS blockiert kurz (meist < 100 ms, beim Router gecacht)
+            IPAddress ip;
+            if (!WiFi.hostByName(_cfg->mqttHost, ip)) {
+                return fail("Connection", "Failed! (DNS)");
+            }
+
+            // Nicht blockierender TCP-Connect, Fertigstellung wird in den nächsten Schritten abgefragt
+            _sock = lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+            if (_sock < 0) return fail("Connection", "Failed! (socket)");
+            lwip_fcntl(_sock, F_SETFL, lwip_fcntl(_sock, F_GETFL, 0) | O_NONBLOCK);
+
+            struct sockaddr_in addr;
+            memset(&addr, 0, sizeof(addr));
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(_cfg->mqttPort);
+            addr.sin_addr.s_addr = (uint32_t)ip;
+
+            int rc = lwip_connect(_sock, (struct sockaddr*)&addr, sizeof(addr));
+            if (rc != 0 && errno != EINPROGRESS) {
+                closeSocket();
+                return fail("Connection", "Failed!");
+            }
+            setMessage("Connecting...", _cfg->mqttHost);
+            _connectStartMs = millis();
+            _step = Step::CONNECT;
+            return Result::RUNNING;
+        }
+
+        case Step::CONNECT: {
+            fd_set writeSet;
+            FD_ZERO(&writeSet);
+            FD_SET(_sock, &writeSet);
+            struct timeval tv = { 0, 0 };
+            int ready = lwip_select(_sock + 1, nullptr, &writeSet, nullptr, &tv);
+
+            if (ready > 0) {
+                int err = 0;
+                socklen_t len = sizeof(err);
+                lwip_getsockopt(_sock, SOL_SOCKET, SO_ERROR, &err, &len);
+                closeSocket();
+                if (err != 0) return fail("Connection", "Failed!");
+                setMessage("Connection", "Successful!");
+                return Result::SUCCESS;
+            }
+            if (ready < 0 || millis() - _connectStartMs > CONNECT_TIMEOUT_MS) {
+                closeSocket();
+                return fail("Connection", "Failed! (timeout)");
+            }
+            return Result::RUNNING;
+        }
+    }
+    return Result::FAILED;
+}
+
+void MqttTestJob::closeSocket() {
+    if (_sock >= 0) {
+        lwip_close(_sock);
+        _sock = -1;
+    }
+}
+
+void MqttTestJob::cancel() {
+    closeSocket();
+    cancelWiFi();
+}
+
+// =========================================================
+// Release-Liste
+// =========================================================
+
+// Pro Element nur diese Felder behalten, der Rest wird beim Lesen verworfen
+static const JsonDocument& releaseFilter() {
+    static StaticJsonDocument<200> filter;
+    if (filter.isNull()) {
+        filter["tag_name"] = true;
+        filter["assets"][0]["name"] = true;
+        filter["assets"][0]["browser_download_url"] = true;
+    }
+    return filter;
+}
+
+void ReleaseFetchJob::start(const ConfigData& cfg) {
+    _http.end(); // falls noch eine Abfrage lief
+    _cfg = &cfg;
+    _step = Step::WIFI;
+    _stream = nullptr;
+    _page = 1;
+    _pageCount = 0;
+    _releases.clear();
+    _newEtag = "";
+    _notModified = false;
+    ReleaseCache::load(MAXFAN_RELEASES_URL, _cached, _etag);
+    _startHeap = ESP.getFreeHeap();
+    _minHeap = _startHeap;
+    startWiFi();
+    setMessage("Connecting Wi-Fi...");
+}
+
+void ReleaseFetchJob::noteHeap() {
+    uint32_t freeHeap = ESP.getFreeHeap();
+    if (freeHeap < _minHeap) _minHeap = freeHeap;
+}
+
+ConfigJob::Result ReleaseFetchJob::step() {
+    noteHeap();
+
+    switch (_step) {
+        case Step::WIFI: {
+            Result r = stepWiFi(*_cfg);
+            if (r != Result::SUCCESS) return r;
+            setMessage("Fetching GitHub...");
+            _step = Step::REQUEST;
+            return Result::RUNNING;
+        }
+
+        case Step::REQUEST:
+            return requestPage();
+
+        case Step::FIND_ARRAY:
+            // Alles vor dem Array überspringen (Whitespace, ggf. BOM)
+            if (!_stream->find("[")) {
+                _http.end();
+                return fail("JSON Error:", "no array");
+            }
+            _step = Step::ELEMENT;
+            return Result::RUNNING;
+
+        case Step::ELEMENT:
+            return parseElement();
+    }
+    return Result::FAILED;
+}
+
+ConfigJob::Result ReleaseFetchJob::requestPage() {
+    String url = String(MAXFAN_RELEASES_URL) + "?per_page=" + PER_PAGE + "&page=" + _page;
+    LOG_I("Releases: GitHub Fetch %s, Free Heap: %u bytes", url.c_str(), (unsigned)ESP.getFreeHeap());
+
+    _http.setTimeout(READ_TIMEOUT_MS);
+    // HTTP/1.0: kein Chunked-Encoding, der Body kann direkt vom Stream geparst werden
+    _http.useHTTP10(true);
+    _http.setFollowRedirects(HTTPC_FORCE_FOLLOW_REDIRECTS);
+
+    // http:// für einen lokalen Testserver (MAXFAN_RELEASES_URL überschrieben)
+    if (!beginHttp(_http, _client, _plainClient, url)) {
+        return fail("HTTP Begin", "Failed");
+    }
+    _http.addHeader("User-Agent", "ESP32-MaxMan");
+
+    static const char* headerKeys[] = { "ETag" };
+    _http.collectHeaders(headerKeys, 1);
+    bool conditional = (_page == 1 && hasCache() && !_etag.isEmpty());
+    if (conditional) {
+        _http.addHeader("If-None-Match", _etag);
+    }
+
+    // Blockiert für TLS-Handshake und Header
+    int httpCode = _http.GET();
+    if (conditional && httpCode == HTTP_CODE_NOT_MODIFIED) {
+        _http.end();
+        LOG_I("Releases: 304 Not Modified, using cache");
+        _releases = _cached;
+        _notModified = true;
+        setMessage("Up to date");
+        return Result::SUCCESS;
+    }
+    if (httpCode != HTTP_CODE_OK) {
+        _http.end();
+        return fail("HTTP Error", String(httpCode).c_str());
+    }
+    if (_page == 1) {
+        _newEtag = _http.header("ETag");
+    }
+
+    _stream = _http.getStreamPtr();
+    _pageCount = 0;
+    setMessage("Reading releases...");
+    _step = Step::FIND_ARRAY;
+    return Result::RUNNING;
+}
+
+ConfigJob::Result ReleaseFetchJob::parseElement() {
+    // Ein Release pro Schritt. Das Dokument hält nur die gefilterten Felder.
+    {
+        DynamicJsonDocument doc(ELEMENT_DOC_SIZE);
+        DeserializationError error = deserializeJson(doc, *_stream, DeserializationOption::Filter(releaseFilter()));
+        noteHeap();
+
+        if (error) {
+            _http.end();
+            // "[]": leere Seite, das Array ist zu Ende
+            if (_pageCount == 0 && error == DeserializationError::InvalidInput) {
+                return finish();
+            }
+            return fail("JSON Error:", error.c_str());
+        }
+        _pageCount++;
+
+        const char* tagName = doc["tag_name"];
+        if (tagName) {
+            ReleaseInfo release;
+            release.tagName = tagName;
+            for (JsonObject asset : doc["assets"].as<JsonArray>()) {
+                const char* name = asset["name"];
+                const char* dlUrl = asset["browser_download_url"];
+                if (!name || !dlUrl) continue;
+                String assetName(name);
+                if (assetName.endsWith(".bin") && release.downloadUrl.isEmpty()) {
+                    release.downloadUrl = dlUrl;
+                } else if (assetName.endsWith("manifest.json")) {
+                    release.manifestUrl = dlUrl;
+                }
+            }
+            if (!release.downloadUrl.isEmpty() || !release.manifestUrl.isEmpty()) {
+                _releases.push_back(release);
+            }
+        }
+    }
+    snprintf(_detail, sizeof(_detail), "%u found (page %d)", (unsigned)_releases.size(), _page);
+
+    if (_releases.size() >= MAX_RELEASES) {
+        _http.end();
+        return finish();
+    }
+
+    // Nach dem Objekt folgt "," (weiteres Element) oder "]" (Ende der Seite)
+    if (_stream->findUntil(",", "]")) {
+        return Result::RUNNING;
+    }
+    _http.end();
+
+    // Volle Seite -> es kann weitere geben
+    if (_pageCount >= PER_PAGE) {
+        _page++;
+        _step = Step::REQUEST;
+        return Result::RUNNING;
+    }
+    return finish();
+}
+
+ConfigJob::Result ReleaseFetchJob::finish() {
+    LOG_I("Releases: %u, free heap: start %u, minimum %u -> peak %u bytes",
+          (unsigned)_releases.size(), (unsigned)_startHeap, (unsigned)_minHeap,
+          (unsigned)(_startHeap - _minHeap));
+    if (_releases.empty()) {
+        return fail("No .bin files", "found");
+    }
+    ReleaseCache::store(MAXFAN_RELEASES_URL, _releases, _newEtag);
+    setMessage("Done");
+    return Result::SUCCESS;
+}
+
+void ReleaseFetchJob::cancel() {
+    _http.end();
+    _stream = nullptr;
+    cancelWiFi();
+}
+
+// =========================================================
+// OTA-Update
+// =========================================================
+
+void OtaJob::start(const ConfigData& cfg, const String& tagName, const String& binUrl, const String& manifestUrl) {
+    _cfg = &cfg;
+    _tagName = tagName;
+    _url = binUrl;
+    _rawUrl = binUrl;
+    _manifestUrl = manifestUrl;
+    _hasManifest = false;
+    _compressed = false;
+    _total = 0;
+    _downloaded = 0;
+    _startMs = millis();
+    _step = Step::WIFI;
+    startWiFi();
+    setMessage("Updating...", "Do not power off!");
+}
+
+int OtaJob::progress() const {
+    if (_step != Step::WRITE || _total <= 0) return -1;
+    return (int)((int64_t)_downloaded * 100 / _total);
+}
+
+ConfigJob::Result OtaJob::abort(const char* message, const char* detail) {
+    _writer.abort();
+    _http.end();
+    return fail(message, detail);
+}
+
+ConfigJob::Result OtaJob::step() {
+    switch (_step) {
+        case Step::WIFI: {
+            Result r = stepWiFi(*_cfg);
+            if (r != Result::SUCCESS) return r;
+            setMessage("Updating...", "Do not power off!");
+            _step = _manifestUrl.isEmpty() ? Step::REQUEST : Step::MANIFEST;
+            return Result::RUNNING;
+        }
+        case Step::MANIFEST: return fetchManifest();
+        case Step::REQUEST:  return request();
+        case Step::WRITE:    return write();
+        case Step::FINISH:   return finish();
+    }
+    return Result::FAILED;
+}
+
+ConfigJob::Result OtaJob::fetchManifest() {
+    setMessage("Updating...", "Reading manifest");
+    _http.setTimeout(10000);
+    _http.useHTTP10(true);
+    _http.setFollowRedirects(HTTPC_FORCE_FOLLOW_REDIRECTS);
+    if (!beginHttp(_http, _client, _plainClient, _manifestUrl)) {
+        return fail("Manifest Error", "HTTP begin");
+    }
+    _http.addHeader("User-Agent", "ESP32-MaxMan");
+
+    int httpCode = _http.GET();
+    if (httpCode != HTTP_CODE_OK) {
+        return abort("Manifest Error", String(httpCode).c_str());
+    }
+    if (_http.getSize() > MAX_MANIFEST_SIZE) {
+        return abort("Manifest Error", "Too big");
+    }
+    StaticJsonDocument<512> doc;
+    DeserializationError error = deserializeJson(doc, _http.getString());
+    _http.end();
+    if (error) {
+        return fail("Manifest Error", error.c_str());
+    }
+
+    const char* manifestError = "";
+    if (!_manifest.parse(doc.as<JsonVariantConst>(), manifestError) || _manifest.file.isEmpty()) {
+        return fail("Manifest Error", *manifestError ? manifestError : "No file");
+    }
+    if (!_tagName.isEmpty() && _tagName != _manifest.version) {
+        return fail("Manifest mismatch", _manifest.version.c_str());
+    }
+    LOG_I("OTA: manifest %s, %s, %d bytes", _manifest.version.c_str(),
+          _manifest.compressed ? "gzip" : "raw", _manifest.size);
+
+    // Die Dateien liegen neben dem Manifest
+    String base = _manifestUrl.substring(0, _manifestUrl.lastIndexOf('/') + 1);
+    _url = base + _manifest.file;
+    _rawUrl = !_manifest.raw.isEmpty() ? String(base + _manifest.raw) : (_manifest.compressed ? String("") : _url);
+    _hasManifest = true;
+    _compressed = _manifest.compressed;
+    _step = Step::REQUEST;
+    return Result::RUNNING;
+}
+
+ConfigJob::Result OtaJob::request() {
+    _http.setTimeout(10000);
+    _http.useHTTP10(true);
+    _http.setFollowRedirects(HTTPC_FORCE_FOLLOW_REDIRECTS);
+    if (!beginHttp(_http, _client, _plainClient, _url)) {
+        return abort("Update Failed!", "HTTP begin");
+    }
+    _http.addHeader("User-Agent", "ESP32-MaxMan");
+
+    // Blockiert für TLS-Handshake und Header (inkl. Redirect zum Asset-Server)
+    int httpCode = _http.GET();
+    if (httpCode != HTTP_CODE_OK) {
+        return abort("Update Failed!", String(httpCode).c_str());
+    }
+    _total = _http.getSize();
+    if (_total <= 0) {
+        return abort("Update Failed!", "No size");
+    }
+
+    bool ok;
+    if (!_hasManifest) {
+        ok = _writer.begin(_total, false, nullptr);
+    } else if (!_compressed && _total != _manifest.size) {
+        return abort("Update Failed!", "Size mismatch");
+    } else {
+        ok = _writer.begin(_manifest.size, _compressed, _manifest.sha256);
+    }
+
+    if (!ok && _compressed && !_rawUrl.isEmpty()) {
+        // ~43 KB fürs Entpacken nicht frei (z.B. BLE aktiv): rohe Datei laden
+        LOG_W("OTA: gzip not possible (%s, heap %u), loading raw image",
+              _writer.error(), (unsigned)ESP.getFreeHeap());
+        _http.end();
+        _compressed = false;
+        _url = _rawUrl;
+        return Result::RUNNING;
+    }
+    if (!ok) {
+        return abort("Update Failed!", _writer.error());
+    }
+
+    _lastDataMs = millis();
+    LOG_I("OTA: %s (%s), %d bytes", _url.c_str(), _compressed ? "gzip" : "raw", _total);
+    _step = Step::WRITE;
+    return Result::RUNNING;
+}
+
+ConfigJob::Result OtaJob::write() {
+    WiFiClient* stream = _http.getStreamPtr();
+    int avail = stream->available();
+    if (avail > 0) {
+        int n = stream->readBytes(_buf, min((size_t)avail, CHUNK));
+        _downloaded += n;
+        _lastDataMs = millis();
+        if (!_writer.write(_buf, n)) {
+            return abort("Update Failed!", _writer.error());
+        }
+        snprintf(_detail, sizeof(_detail), "%d / %d kB", _downloaded / 1024, _total / 1024);
+    }
+    if (_downloaded >= _total) {
+        _step = Step::FINISH;
+        return Result::RUNNING;
+    }
+    if (millis() - _lastDataMs > READ_TIMEOUT_MS) {
+        return abort("Update Failed!", "Timeout");
+    }
+    return Result::RUNNING;
+}
+
+ConfigJob::Result OtaJob::finish() {
+    _http.end();
+    if (!_writer.finish()) {
+        return fail("Update Failed!", _writer.error());
+    }
+    LOG_I("OTA: %s done, %d bytes downloaded (%s), image %d bytes, %lu ms",
+          _hasManifest ? _manifest.version.c_str() : _tagName.c_str(), _downloaded,
+          _compressed ? "gzip" : "raw", _writer.imageSize(), (unsigned long)(millis() - _startMs));
+    setMessage("Success!", "Rebooting...");
+    return Result::SUCCESS;
+}
+
+void OtaJob::cancel() {
+    _writer.abort();
+    _http.end();
+    cancelWiFi();
+}
+
+// =========================================================
+// OTA-Update per MQTT
+// =========================================================
+
+void MqttOtaJob::start(const ConfigData& cfg, MqttController& controller) {
+    _cfg = &cfg;
+    _controller = &controller;
+    // Ohne MQTT-Controller wurde der Client beim Booten nicht gestartet
+    _ownsClient = !controller.isStarted();
+    if (_ownsClient) controller.begin();
+    _step = Step::WIFI;
+    _startMs = millis();
+    startWiFi();
+    setMessage("Connecting Wi-Fi...");
+}
+
+ConfigJob::Result MqttOtaJob::stop(Result result) {
+    _receiver.disarm();
+    // Sonst bliebe die Verbindung offen, ohne dass sie jemand bedient (nicht in den Controllern)
+    if (_ownsClient) {
+        _controller->end();
+        _ownsClient = false;
+    }
+    return result;
+}
+
+ConfigJob::Result MqttOtaJob::step() {
+    switch (_step) {
+        case Step::WIFI: {
+            Result r = stepWiFi(*_cfg);
+            if (r == Result::FAILED) return stop(r);
+            if (r != Result::SUCCESS) return r;
+            setMessage("Connecting MQTT...", _cfg->mqttHost);
+            _stepStartMs = millis();
+            _step = Step::CONNECT;
+            return Result::RUNNING;
+        }
+
+        case Step::CONNECT:
+            _controller->loop();
+            if (_controller->isConnected()) {
+                _receiver.arm(*_controller);
+                setMessage("Waiting for upload", _cfg->mqttCommandTopic);
+                _step = Step::RECEIVE;
+                return Result::RUNNING;
+            }
+            if (millis() - _stepStartMs > CONNECT_TIMEOUT_MS) {
+                return stop(fail("MQTT Failed", "Check Settings"));
+            }
+            return Result::RUNNING;
+
+        case Step::RECEIVE:
+            _controller->loop();
+            _controller->pump(MqttOtaReceiver::WINDOW);
+
+            switch (_receiver.state()) {
+                case MqttOtaReceiver::State::RECEIVING:
+                    snprintf(_message, sizeof(_message), "Receiving %s", _receiver.version().c_str());
+                    snprintf(_detail, sizeof(_detail), "%d / %d kB", _receiver.received() / 1024, _receiver.length() / 1024);
+                    if (millis() - _receiver.lastActivityMs() > DATA_TIMEOUT_MS) {
+                        return stop(fail("Update Failed!", "Timeout"));
+                    }
+                    return Result::RUNNING;
+
+                case MqttOtaReceiver::State::DONE:
+                    LOG_I("MQTT-OTA: %lu ms", (unsigned long)(millis() - _startMs));
+                    setMessage("Success!", "Rebooting...");
+                    return stop(Result::SUCCESS);
+
+                case MqttOtaReceiver::State::FAILED:
+                    return stop(fail("Update Failed!", _receiver.error()));
+
+                default:
+                    return Result::RUNNING;
+            }
+    }
+    return Result::FAILED;
+}
+
+void MqttOtaJob::cancel() {
+    stop(Result::FAILED);
+    cancelWiFi();
+}
@@ -0,0 +1,155 @@
+#include "DisplayFlush.h"
+#include "Log.h"
+#include "MaxFanMetrics.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#ifndef MAXFAN_DISPLAY_SYNC
+#define MAXFAN_DISPLAY_SYNC 0
+#endif
+
+enum class PowerCommand : uint8_t { NONE, ON, OFF };
+
+static TaskHandle_t task = nullptr;
+static SemaphoreHandle_t lock = nullptr;
+static u8x8_t* u8x8 = nullptr;
+static uint8_t tileWidth = 0;
+static uint8_t tileHeight = 0;
+
+// pending: vom Loop befüllt, working: wird gerade gesendet, shown: was das Display zeigt.
+// pending und working werden nur unter lock getauscht.
+static uint8_t frameA[DisplayFlush::FRAME_BYTES];
+static uint8_t frameB[DisplayFlush::FRAME_BYTES];
+static uint8_t shown[DisplayFlush::FRAME_BYTES];
+static uint8_t* pending = frameA;
+static uint8_t* working = frameB;
+static bool hasPending = false;
+static bool busy = false;
+static PowerCommand powerCommand = PowerCommand::NONE;
+
+static uint32_t maxStall = 0;
+
+static void recordStall(uint32_t startUs) {
+    uint32_t stall = micros() - startUs;
+    if (stall <= maxStall) return;
+    maxStall = stall;
+    LOG_D("Display: Loop bis zu %lu us blockiert", (unsigned long)stall);
+}
+
+// Pro Page nur die Tiles vom ersten bis zum letzten geänderten
+static void sendChanged() {
+    size_t pageBytes = tileWidth * 8;
+    for (uint8_t page = 0; page < tileHeight; page++) {
+        uint8_t* now = working + page * pageBytes;
+        uint8_t* before = shown + page * pageBytes;
+        int first = -1, last = -1;
+        for (int tile = 0; tile < tileWidth; tile++) {
+            if (memcmp(now + tile * 8, before + tile * 8, 8) == 0) continue;
+            if (first < 0) first = tile;
+            last = tile;
+        }
+        if (first < 0) continue;
+        size_t count = last - first + 1;
+        u8x8_DrawTile(u8x8, first, page, count, now + first * 8);
+        memcpy(before + first * 8, now + first * 8, count * 8);
+    }
+    u8x8_RefreshDisplay(u8x8);
+}
+
+static void displayTask(void*) {
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        xSemaphoreTake(lock, portMAX_DELAY);
+        bool frame = hasPending;
+        if (frame) {
+            uint8_t* swap = working;
+            working = pending;
+            pending = swap;
+            hasPending = false;
+        }
+        PowerCommand power = powerCommand;
+        powerCommand = PowerCommand::NONE;
+        busy = true;
+        xSemaphoreGive(lock);
+
+        // Einschalten vor dem Bild, Ausschalten danach (erst das leere Bild, dann dunkel)
+        if (power == PowerCommand::ON) u8x8_SetPowerSave(u8x8, 0);
+        if (frame) sendChanged();
+        if (power == PowerCommand::OFF) u8x8_SetPowerSave(u8x8, 1);
+
+        xSemaphoreTake(lock, portMAX_DELAY);
+        busy = false;
+        xSemaphoreGive(lock);
+    }
+}
+
+void DisplayFlush::begin(U8G2& display) {
+#if MAXFAN_DISPLAY_SYNC
+    LOG_I("Display: synchrones Senden (MAXFAN_DISPLAY_SYNC)");
+    (void)display;
+#else
+    tileWidth = display.getBufferTileWidth();
+    tileHeight = display.getBufferTileHeight();
+    if ((size_t)tileWidth * tileHeight * 8 != FRAME_BYTES) {
+        LOG_W("Display: Puffergröße %u passt nicht, sende synchron", (unsigned)(tileWidth * tileHeight * 8));
+        return;
+    }
+    u8x8 = display.getU8x8();
+    // Das Display zeigt, was zuletzt synchron gesendet wurde
+    memcpy(shown, display.getBufferPtr(), FRAME_BYTES);
+    lock = xSemaphoreCreateMutex();
+    // Eine Stufe über dem Loop: nach jedem I2C-Stück sofort das nächste anstoßen
+    xTaskCreate(displayTask, "display", TASK_STACK, nullptr, uxTaskPriorityGet(nullptr) + 1, &task);
+#endif
+}
+
+void DisplayFlush::submit(U8G2& display) {
+    uint32_t start = micros();
+    if (!task) {
+        display.sendBuffer();
+        recordStall(start);
+        return;
+    }
+
+    xSemaphoreTake(lock, portMAX_DELAY);
+    if (hasPending) MaxFanMetrics::displayDropped.inc();
+    memcpy(pending, display.getBufferPtr(), FRAME_BYTES);
+    hasPending = true;
+    xSemaphoreGive(lock);
+    xTaskNotifyGive(task);
+    recordStall(start);
+}
+
+void DisplayFlush::setPowerSave(U8G2& display, bool on) {
+    uint32_t start = micros();
+    if (!task) {
+        display.setPowerSave(on ? 1 : 0);
+        recordStall(start);
+        return;
+    }
+
+    xSemaphoreTake(lock, portMAX_DELAY);
+    powerCommand = on ? PowerCommand::OFF : PowerCommand::ON;
+    xSemaphoreGive(lock);
+    xTaskNotifyGive(task);
+    recordStall(start);
+}
+
+bool DisplayFlush::waitIdle(uint32_t timeoutMs) {
+    if (!task) return true;
+    uint32_t start = millis();
+    for (;;) {
+        xSemaphoreTake(lock, portMAX_DELAY);
+        bool idle = !hasPending && !busy && powerCommand == PowerCommand::NONE;
+        xSemaphoreGive(lock);
+        if (idle) return true;
+        if (millis() - start >= timeoutMs) return false;
+        delay(1);
+    }
+}
+
+uint32_t DisplayFlush::maxStallUs() {
+    return maxStall;
+}
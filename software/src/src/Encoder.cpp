@@ -1,10 +1,10 @@
 #include "Encoder.h"
 #include "soc/gpio_struct.h"
-#include "hal/gpio_ll.h"
 #include <esp_timer.h>
 
 Encoder::Encoder(uint8_t a, uint8_t b)
-: pinA(a), pinB(b), delta(0), position(0), lastState(0), _lastInputTime(0)
+: pinA(a), pinB(b), _count(0), _consumed(0), _positionBase(0),
+  _seenCount(0), _lastInputTime(0), _lastDetentTime(0), _velocity(0)
 {
 }
 
@@ -13,9 +13,10 @@ void Encoder::begin()
     pinMode(pinA, INPUT_PULLUP);
     pinMode(pinB, INPUT_PULLUP);
 
-    uint8_t a = (GPIO.in.val >> pinA) & 1;
-    uint8_t b = (GPIO.in.val >> pinB) & 1;
-    lastState = (a << 1) | b;
+    uint32_t in = GPIO.in.val;
+    uint8_t a = (in >> pinA) & 1;
+    uint8_t b = (in >> pinB) & 1;
+    _decoder.reset((a << 1) | b);
 
     // Initialize last input time to current time
     _lastInputTime = esp_timer_get_time();
@@ -31,63 +32,68 @@ void IRAM_ATTR Encoder::isrHandler(void* arg)
 
 void IRAM_ATTR Encoder::handleISR()
 {
+    // Beide Spuren mit einem Registerzugriff lesen
+    uint32_t in = GPIO.in.val;
+    uint8_t state = (((in >> pinA) & 1) << 1) | ((in >> pinB) & 1);
 
-
-    uint8_t a = gpio_ll_get_level(&GPIO, (gpio_num_t)pinA);
-    uint8_t b = gpio_ll_get_level(&GPIO, (gpio_num_t)pinB);
-    uint8_t state = (a << 1) | b;
-
-    if ((lastState == 0b00 && state == 0b01) ||
-        (lastState == 0b01 && state == 0b11) ||
-        (lastState == 0b11 && state == 0b10) ||
-        (lastState == 0b10 && state == 0b00))
-    {
-        delta++;
-        position++;
-        _lastInputTime = esp_timer_get_time();
-    }
-    else if ((lastState == 0b00 && state == 0b10) ||
-             (lastState == 0b10 && state == 0b11) ||
-             (lastState == 0b11 && state == 0b01) ||
-             (lastState == 0b01 && state == 0b00))
-    {
-        delta--;
-        position--;
-        _lastInputTime = esp_timer_get_time();
+    int8_t step = _decoder.step(state);
+    if (step != 0) {
+        _count.store(_count.load(std::memory_order_relaxed) + step, std::memory_order_release);
     }
+}
 
-    lastState = state;
+void Encoder::noteActivity(int32_t count) const
+{
+    if (count == _seenCount) return;
+    _seenCount = count;
+    _lastInputTime = esp_timer_get_time();
 }
 
 int Encoder::getDelta()
 {
-    noInterrupts();
-    int d = delta/4;
-    delta = delta-4*d;
-    interrupts();
+    int32_t count = _count.load(std::memory_order_acquire);
+    noteActivity(count);
+
+    int d = (count - _consumed) / 4;
+    _consumed += 4 * d;
+    if (d == 0) return 0;
+
+    // Geschwindigkeit aus dem Abstand zur letzten Rastung; geglättet, damit einzelne Ausreißer nicht springen
+    int64_t now = esp_timer_get_time();
+    int64_t dt = now - _lastDetentTime;
+    _lastDetentTime = now;
+    uint32_t rate = (dt >= VELOCITY_TIMEOUT_US || dt <= 0) ? 0 : (uint32_t)(abs(d) * 1000000LL / dt);
+    _velocity = (_velocity + rate) / 2;
+
     return d;
 }
 
 int Encoder::getPosition()
 {
-    noInterrupts();
-    int p = position/4;
-    interrupts();
-    return p;
+    return (_count.load(std::memory_order_acquire) - _positionBase) / 4;
 }
 
 void Encoder::reset()
 {
-    noInterrupts();
-    delta = 0;
-    position = 0;
-    interrupts();
+    int32_t count = _count.load(std::memory_order_acquire);
+    _consumed = count;
+    _positionBase = count;
+    _velocity = 0;
 }
 
 int64_t Encoder::getLastInputTime() const {
-    // Protect read of 64-bit value from ISR writes
-    noInterrupts();
-    int64_t result = _lastInputTime;
-    interrupts();
-    return result;
+    noteActivity(_count.load(std::memory_order_acquire));
+    return _lastInputTime;
+}
+
+uint32_t Encoder::getVelocity() const {
+    if (esp_timer_get_time() - _lastDetentTime >= VELOCITY_TIMEOUT_US) return 0;
+    return _velocity;
+}
+
+int Encoder::getStepMultiplier() const {
+    uint32_t v = getVelocity();
+    if (v >= VERY_FAST_VELOCITY) return 4;
+    if (v >= FAST_VELOCITY) return 2;
+    return 1;
 }
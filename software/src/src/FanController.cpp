@@ -0,0 +1,11 @@
+#include "FanController.h"
+
+const char* FanController::statusJson(const MaxFanState& state) {
+    static MaxFanState cachedState;
+    static char cachedJson[MaxFanState::JSON_SIZE];
+    if (cachedJson[0] == '\0' || state != cachedState) {
+        cachedState = state;
+        state.ToJson(cachedJson, sizeof(cachedJson));
+    }
+    return cachedJson;
+}
@@ -0,0 +1,132 @@
+#include "GlyphAtlas.h"
+
+// Stift und Grundlinie beim Rastern: Platz für Unterlängen und Zeichen, die links vor dem Stift beginnen
+static constexpr int CAPTURE_X = 8;
+static constexpr int CAPTURE_BASELINE = 26;
+
+bool GlyphAtlas::build(U8G2& u8g2, const uint8_t* font, const uint16_t* codes, uint8_t count) {
+    _ready = false;
+    _count = 0;
+    _used = 0;
+
+    uint8_t* buffer = u8g2.getBufferPtr();
+    int bufferWidth = u8g2.getBufferTileWidth() * 8;
+    int scanWidth = CAPTURE_X + CAPTURE_WIDTH < bufferWidth ? CAPTURE_X + CAPTURE_WIDTH : bufferWidth;
+    auto pixel = [&](int x, int y) { return (buffer[(y >> 3) * bufferWidth + x] >> (y & 7)) & 1; };
+
+    u8g2.setFont(font);
+    u8g2.setFontMode(1);
+    u8g2.setDrawColor(1);
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (_count >= MAX_GLYPHS) break;
+        u8g2.clearBuffer();
+        int advance = u8g2.drawGlyph(CAPTURE_X, CAPTURE_BASELINE, codes[i]);
+
+        // Umriss der gesetzten Pixel
+        int minX = scanWidth, maxX = -1, minY = CAPTURE_HEIGHT, maxY = -1;
+        for (int x = 0; x < scanWidth; x++) {
+            for (int y = 0; y < CAPTURE_HEIGHT; y++) {
+                if (!pixel(x, y)) continue;
+                if (x < minX) minX = x;
+                if (x > maxX) maxX = x;
+                if (y < minY) minY = y;
+                if (y > maxY) maxY = y;
+            }
+        }
+
+        Glyph& glyph = _glyphs[_count];
+        glyph.code = codes[i];
+        glyph.offset = _used;
+        glyph.advance = advance;
+        if (maxX < 0) {
+            // Leerzeichen: nur Vorschub
+            glyph.left = glyph.top = 0;
+            glyph.width = glyph.height = 0;
+            _count++;
+            continue;
+        }
+        glyph.left = minX - CAPTURE_X;
+        glyph.top = minY - CAPTURE_BASELINE;
+        glyph.width = maxX - minX + 1;
+        glyph.height = maxY - minY + 1;
+
+        int bytesPerColumn = (glyph.height + 7) / 8;
+        if (_used + glyph.width * bytesPerColumn > MAX_BYTES) break;
+        for (int x = minX; x <= maxX; x++) {
+            uint32_t column = 0;
+            for (int y = minY; y <= maxY; y++) {
+                column |= (uint32_t)pixel(x, y) << (y - minY);
+            }
+            for (int b = 0; b < bytesPerColumn; b++) {
+                _bits[_used++] = column >> (8 * b);
+            }
+        }
+        _count++;
+    }
+
+    u8g2.clearBuffer();
+    _ready = (_count == count);
+    return _ready;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::find(uint16_t code) const {
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_glyphs[i].code == code) return &_glyphs[i];
+    }
+    return nullptr;
+}
+
+int GlyphAtlas::drawGlyph(U8G2& u8g2, int x, int y, uint16_t code) const {
+    const Glyph* glyph = find(code);
+    if (!glyph) return 0;
+
+    uint8_t* buffer = u8g2.getBufferPtr();
+    int bufferWidth = u8g2.getBufferTileWidth() * 8;
+    int pages = u8g2.getBufferTileHeight();
+    int bytesPerColumn = (glyph->height + 7) / 8;
+    const uint8_t* bits = _bits + glyph->offset;
+
+    for (int c = 0; c < glyph->width; c++, bits += bytesPerColumn) {
+        int px = x + glyph->left + c;
+        if (px < 0 || px >= bufferWidth) continue;
+
+        uint32_t column = 0;
+        for (int b = 0; b < bytesPerColumn; b++) column |= (uint32_t)bits[b] << (8 * b);
+        int top = y + glyph->top;
+        if (top < 0) {
+            if (-top >= CAPTURE_HEIGHT) continue;
+            column >>= -top;
+            top = 0;
+        }
+
+        // Spalte auf die Byte-Zeilen (Pages) des Puffers verteilen
+        uint64_t shifted = (uint64_t)column << (top & 7);
+        for (int page = top >> 3; shifted && page < pages; page++, shifted >>= 8) {
+            buffer[page * bufferWidth + px] |= (uint8_t)shifted;
+        }
+    }
+    return glyph->advance;
+}
+
+int GlyphAtlas::drawStr(U8G2& u8g2, int x, int y, const char* text) const {
+    for (; *text; text++) {
+        x += drawGlyph(u8g2, x, y, (uint8_t)*text);
+    }
+    return x;
+}
+
+int GlyphAtlas::drawNumber(U8G2& u8g2, int x, int y, int value) const {
+    char digits[12];
+    int count = 0;
+    unsigned magnitude = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    do {
+        digits[count++] = '0' + magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude);
+    if (value < 0) x += drawGlyph(u8g2, x, y, '-');
+    while (count > 0) {
+        x += drawGlyph(u8g2, x, y, digits[--count]);
+    }
+    return x;
+}
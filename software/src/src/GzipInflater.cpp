@@ -0,0 +1,140 @@
+#include "GzipInflater.h"
+
+bool GzipInflater::begin() {
+    end();
+    _decompressor = (tinfl_decompressor*)malloc(sizeof(tinfl_decompressor));
+    _dict = (uint8_t*)malloc(DICT_SIZE);
+    if (!_decompressor || !_dict) {
+        end();
+        _error = "No memory";
+        return false;
+    }
+    tinfl_init(_decompressor);
+
+    _dictPos = 0;
+    _state = State::HEADER;
+    _flags = 0;
+    _bufCount = 0;
+    _skip = 0;
+    _outputSize = 0;
+    _error = "";
+    return true;
+}
+
+void GzipInflater::end() {
+    free(_decompressor);
+    free(_dict);
+    _decompressor = nullptr;
+    _dict = nullptr;
+}
+
+GzipInflater::Status GzipInflater::fail(const char* error) {
+    _error = error;
+    _state = State::FAILED;
+    return Status::FAILED;
+}
+
+// Nach dem festen Header folgen (falls gesetzt) EXTRA, NAME, COMMENT, HCRC, dann die Daten
+void GzipInflater::afterHeaderField() {
+    _bufCount = 0;
+    if (_flags & FLAG_EXTRA) {
+        _flags &= ~FLAG_EXTRA;
+        _state = State::EXTRA_LENGTH;
+    } else if (_flags & FLAG_NAME) {
+        _flags &= ~FLAG_NAME;
+        _state = State::NAME;
+    } else if (_flags & FLAG_COMMENT) {
+        _flags &= ~FLAG_COMMENT;
+        _state = State::COMMENT;
+    } else if (_flags & FLAG_HCRC) {
+        _flags &= ~FLAG_HCRC;
+        _skip = 2;
+        _state = State::HEADER_CRC;
+    } else {
+        _state = State::DEFLATE;
+    }
+}
+
+bool GzipInflater::headerByte(uint8_t b) {
+    switch (_state) {
+        case State::HEADER:
+            _buf[_bufCount++] = b;
+            if (_bufCount < 10) return true;
+            // Magic 1f 8b, Methode 8 = deflate
+            if (_buf[0] != 0x1f || _buf[1] != 0x8b || _buf[2] != 8) return false;
+            _flags = _buf[3];
+            afterHeaderField();
+            return true;
+
+        case State::EXTRA_LENGTH:
+            _buf[_bufCount++] = b;
+            if (_bufCount < 2) return true;
+            _skip = _buf[0] | (_buf[1] << 8);
+            _state = State::EXTRA;
+            if (_skip == 0) afterHeaderField();
+            return true;
+
+        case State::EXTRA:
+        case State::HEADER_CRC:
+            if (--_skip == 0) afterHeaderField();
+            return true;
+
+        case State::NAME:
+        case State::COMMENT:
+            if (b == 0) afterHeaderField();
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+GzipInflater::Status GzipInflater::feed(const uint8_t* data, size_t length, Sink sink, void* context) {
+    if (_state == State::FAILED) return Status::FAILED;
+    if (_state == State::DONE) return Status::DONE;
+    if (!_decompressor) return fail("Not started");
+
+    while (length > 0) {
+        if (_state == State::DEFLATE) {
+            // Das Fenster ist gleichzeitig der Ausgabepuffer (Ringpuffer, 2er-Potenz)
+            tinfl_status status;
+            do {
+                size_t inBytes = length;
+                size_t outBytes = DICT_SIZE - _dictPos;
+                status = tinfl_decompress(_decompressor, data, &inBytes, _dict, _dict + _dictPos, &outBytes,
+                                          TINFL_FLAG_HAS_MORE_INPUT);
+                data += inBytes;
+                length -= inBytes;
+
+                if (outBytes > 0) {
+                    if (!sink(context, _dict + _dictPos, outBytes)) return fail("Write failed");
+                    _outputSize += outBytes;
+                    _dictPos = (_dictPos + outBytes) & (DICT_SIZE - 1);
+                }
+            } while (status == TINFL_STATUS_HAS_MORE_OUTPUT);
+
+            if (status < TINFL_STATUS_DONE) return fail("Corrupt data");
+            if (status == TINFL_STATUS_DONE) {
+                _state = State::TRAILER;
+                _bufCount = 0;
+            }
+            continue;
+        }
+
+        if (_state == State::TRAILER) {
+            // CRC32 (nicht geprüft) + Länge mod 2^32
+            _buf[_bufCount++] = *data++;
+            length--;
+            if (_bufCount < 8) continue;
+            uint32_t size = (uint32_t)_buf[4] | ((uint32_t)_buf[5] << 8) |
+                            ((uint32_t)_buf[6] << 16) | ((uint32_t)_buf[7] << 24);
+            if (size != _outputSize) return fail("Size mismatch");
+            _state = State::DONE;
+            return Status::DONE;
+        }
+
+        if (!headerByte(*data++)) return fail("No gzip header");
+        length--;
+    }
+    return _state == State::DONE ? Status::DONE : Status::RUNNING;
+}
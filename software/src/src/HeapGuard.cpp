@@ -0,0 +1,126 @@
+#include "HeapGuard.h"
+#include "Log.h"
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+#ifndef MAXFAN_HEAP_TRAP
+#define MAXFAN_HEAP_TRAP 0
+#endif
+
+static TaskHandle_t loopTask = nullptr;   // gesetzt = Boot fertig
+static volatile bool suspended = false;
+static uint32_t lastCheckMs = 0;
+static uint32_t reportedMinFree = UINT32_MAX;
+static uint32_t reportedLargest = UINT32_MAX;
+
+#if MAXFAN_HEAP_TRAP
+static std::atomic<uint32_t> trapCount(0);
+static void* reportedCallers[HeapGuard::MAX_REPORTED_CALLERS];
+static int reportedCount = 0;
+static bool inTrap = false;
+
+// Läuft in JEDER Allokation: billig bleiben, selbst nichts allokieren (Log::write tut das nicht)
+static void trap(const char* function, size_t size, void* caller) {
+    if (!loopTask || suspended || inTrap) return;
+    if (xPortInIsrContext() || xTaskGetCurrentTaskHandle() != loopTask) return;
+    inTrap = true;
+    trapCount.fetch_add(1, std::memory_order_relaxed);
+#if MAXFAN_HEAP_TRAP >= 2
+    loopTask = nullptr;
+    LOG_E("Heap: %s(%u) nach dem Boot, Aufrufer %p", function, (unsigned)size, caller);
+    Log::flush();
+    abort();
+#else
+    for (int i = 0; i < reportedCount; i++) {
+        if (reportedCallers[i] == caller) {
+            inTrap = false;
+            return;
+        }
+    }
+    if (reportedCount < HeapGuard::MAX_REPORTED_CALLERS) {
+        reportedCallers[reportedCount++] = caller;
+        LOG_W("Heap: %s(%u) nach dem Boot, Aufrufer %p", function, (unsigned)size, caller);
+    }
+#endif
+    inTrap = false;
+}
+
+// Per -Wl,--wrap umgeleitet; free() bleibt unverändert
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    trap("malloc", size, __builtin_return_address(0));
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    trap("calloc", count * size, __builtin_return_address(0));
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    if (size > 0) trap("realloc", size, __builtin_return_address(0));
+    return __real_realloc(ptr, size);
+}
+}
+
+// Eigenes operator new: sonst zeigt die Adresse nur in die libstdc++
+void* operator new(size_t size) {
+    trap("new", size, __builtin_return_address(0));
+    void* p = __real_malloc(size ? size : 1);
+    if (!p) abort();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    trap("new[]", size, __builtin_return_address(0));
+    void* p = __real_malloc(size ? size : 1);
+    if (!p) abort();
+    return p;
+}
+#endif
+
+void HeapGuard::bootComplete() {
+    reportedMinFree = ESP.getMinFreeHeap();
+    reportedLargest = ESP.getMaxAllocHeap();
+    lastCheckMs = millis();
+    LOG_I("Heap: Boot fertig, frei %lu, min. frei %lu, größter Block %lu Bytes%s",
+          (unsigned long)ESP.getFreeHeap(), (unsigned long)reportedMinFree, (unsigned long)reportedLargest,
+          MAXFAN_HEAP_TRAP ? ", Allokationen im Loop werden überwacht" : "");
+    loopTask = xTaskGetCurrentTaskHandle();
+}
+
+void HeapGuard::loop() {
+    uint32_t now = millis();
+    if (now - lastCheckMs < CHECK_INTERVAL_MS) return;
+    lastCheckMs = now;
+
+    uint32_t minFree = ESP.getMinFreeHeap();
+    uint32_t largest = ESP.getMaxAllocHeap();
+    if (minFree >= reportedMinFree && largest >= reportedLargest) return;
+    if (minFree < reportedMinFree) reportedMinFree = minFree;
+    if (largest < reportedLargest) reportedLargest = largest;
+    LOG_I("Heap: neuer Tiefststand, min. frei %lu, kleinster größter Block %lu (jetzt frei %lu), %lu Allokation(en) im Loop",
+          (unsigned long)reportedMinFree, (unsigned long)reportedLargest, (unsigned long)ESP.getFreeHeap(),
+          (unsigned long)trapped());
+}
+
+void HeapGuard::suspend() {
+    suspended = true;
+}
+
+void HeapGuard::resume() {
+    suspended = false;
+}
+
+uint32_t HeapGuard::trapped() {
+#if MAXFAN_HEAP_TRAP
+    return trapCount.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
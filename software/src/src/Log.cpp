@@ -0,0 +1,262 @@
+#include "Log.h"
+#include "MpmcRing.h"
+#include <stdio.h>
+#include <atomic>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Log-Task: unter dem Arduino-Loop (Priorität 1), damit Ausgabe nie die Steuerung verdrängt.
+// Er läuft in dem Tick, den der Loop am Ende jedes Durchlaufs abgibt (siehe main.cpp), egal ob
+// gerade geloggt wurde; vor Neustart oder Abbruch gibt Log::flush() den Rest im aufrufenden Task aus.
+static constexpr uint32_t TASK_STACK = 3072;
+static constexpr uint32_t TASK_PRIORITY = tskIDLE_PRIORITY;
+static constexpr uint32_t TASK_IDLE_MS = 10;
+#endif
+
+// Erst beim ersten Zugriff angelegt: auch Konstruktoren globaler Objekte dürfen schon loggen
+static MpmcRing<Log::Record, Log::QUEUE_SIZE>& queue() {
+    static MpmcRing<Log::Record, Log::QUEUE_SIZE> instance;
+    return instance;
+}
+static std::atomic<uint32_t> droppedCount(0);
+static uint32_t reportedDropped = 0;
+static Log::Sink currentSink = nullptr;
+
+// --- Aufrufer ---
+
+uint32_t Log::timestamp() {
+#ifdef ARDUINO
+    return millis();
+#else
+    return 0;
+#endif
+}
+
+void Log::put(Record& record, ArgType type, const void* value, size_t size) {
+    if ((size_t)record.used + 1 + size > ARG_BYTES) {
+        record.used = ARG_BYTES; // kein Platz: folgende Argumente fehlen in der Ausgabe
+        return;
+    }
+    record.args[record.used++] = type;
+    memcpy(record.args + record.used, value, size);
+    record.used += size;
+}
+
+void Log::pack(Record& record, const char* value) {
+    if (!value) value = "(null)";
+    // Typ + Länge + Text, bei Platzmangel gekürzt
+    if ((size_t)record.used + 2 > ARG_BYTES) {
+        record.used = ARG_BYTES;
+        return;
+    }
+    size_t room = ARG_BYTES - record.used - 2;
+    size_t length = strnlen(value, room);
+    record.args[record.used++] = ARG_STRING;
+    record.args[record.used++] = (uint8_t)length;
+    memcpy(record.args + record.used, value, length);
+    record.used += length;
+}
+
+void Log::push(const Record& record) {
+    if (!queue().push(record)) droppedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t Log::dropped() {
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+// --- Formatierung ---
+
+// Liest das nächste Argument; false, wenn keins mehr da ist
+struct ArgReader {
+    const Log::Record& record;
+    size_t pos;
+
+    bool next(uint8_t& type, const uint8_t*& value, size_t& length) {
+        if (pos >= record.used || pos >= Log::ARG_BYTES) return false;
+        type = record.args[pos++];
+        switch (type) {
+            case Log::ARG_INT: case Log::ARG_UINT: length = 4; break;
+            case Log::ARG_INT64: case Log::ARG_UINT64: case Log::ARG_DOUBLE: length = 8; break;
+            case Log::ARG_STRING: length = record.args[pos++]; break;
+            case Log::ARG_POINTER: length = sizeof(void*); break;
+            default: return false;
+        }
+        if (pos + length > record.used) return false;
+        value = record.args + pos;
+        pos += length;
+        return true;
+    }
+};
+
+template <typename T>
+static T readAs(const uint8_t* value) {
+    T v;
+    memcpy(&v, value, sizeof(v));
+    return v;
+}
+
+size_t Log::format(const Record& record, char* out, size_t size) {
+    if (size == 0) return 0;
+    size_t n = 0;
+    auto append = [&](const char* text, size_t length) {
+        size_t room = size - 1 - n;
+        if (length > room) length = room;
+        memcpy(out + n, text, length);
+        n += length;
+    };
+
+    ArgReader reader = { record, 0 };
+    const char* p = record.format;
+    while (*p && n < size - 1) {
+        if (*p != '%') {
+            const char* start = p;
+            while (*p && *p != '%') p++;
+            append(start, p - start);
+            continue;
+        }
+        if (p[1] == '%') {
+            append("%", 1);
+            p += 2;
+            continue;
+        }
+
+        // Spezifikation ohne Längenangabe übernehmen, die Länge ergibt sich aus dem Argumenttyp
+        char spec[16];
+        size_t specLength = 0;
+        spec[specLength++] = *p++;
+        while (*p && strchr("-+ #0123456789.", *p) && specLength < sizeof(spec) - 4) spec[specLength++] = *p++;
+        while (*p && strchr("hlLqjzt", *p)) p++;
+        char conversion = *p;
+        if (!conversion) break;
+        p++;
+
+        uint8_t type;
+        const uint8_t* value;
+        size_t length;
+        if (!reader.next(type, value, length)) {
+            append("?", 1);
+            continue;
+        }
+
+        char buffer[64];
+        int written = -1;
+        bool numeric = strchr("diuoxXc", conversion) != nullptr;
+        bool floating = strchr("fFeEgGaA", conversion) != nullptr;
+        if (type == ARG_STRING) {
+            // Text mit Breite/Genauigkeit der Spezifikation, egal was sie verlangt hat
+            char text[ARG_BYTES];
+            memcpy(text, value, length);
+            text[length] = '\0';
+            spec[specLength++] = 's';
+            spec[specLength] = '\0';
+            written = snprintf(buffer, sizeof(buffer), spec, text);
+        } else if (floating || type == ARG_DOUBLE) {
+            double v = type == ARG_DOUBLE ? readAs<double>(value)
+                     : type == ARG_INT ? readAs<int32_t>(value)
+                     : type == ARG_UINT ? readAs<uint32_t>(value)
+                     : type == ARG_INT64 ? (double)readAs<int64_t>(value)
+                     : (double)readAs<uint64_t>(value);
+            spec[specLength++] = floating ? conversion : 'g';
+            spec[specLength] = '\0';
+            written = snprintf(buffer, sizeof(buffer), spec, v);
+        } else if (conversion == 'p' || type == ARG_POINTER) {
+            spec[specLength++] = 'p';
+            spec[specLength] = '\0';
+            written = snprintf(buffer, sizeof(buffer), spec, readAs<void*>(value));
+        } else {
+            char c = numeric ? conversion : 'd';
+            if (type == ARG_INT64 || type == ARG_UINT64) {
+                spec[specLength++] = 'l';
+                spec[specLength++] = 'l';
+                spec[specLength++] = c;
+                spec[specLength] = '\0';
+                long long v = type == ARG_INT64 ? readAs<int64_t>(value) : (long long)readAs<uint64_t>(value);
+                written = snprintf(buffer, sizeof(buffer), spec, v);
+            } else {
+                spec[specLength++] = c;
+                spec[specLength] = '\0';
+                int v = type == ARG_INT ? readAs<int32_t>(value) : (int)readAs<uint32_t>(value);
+                written = snprintf(buffer, sizeof(buffer), spec, v);
+            }
+        }
+        if (written > 0) append(buffer, (size_t)written < sizeof(buffer) ? (size_t)written : sizeof(buffer) - 1);
+    }
+    out[n] = '\0';
+    return n;
+}
+
+// --- Ausgabe ---
+
+static void defaultSink(uint8_t level, const char* line, size_t length) {
+    (void)level;
+#ifdef ARDUINO
+    Serial.write((const uint8_t*)line, length);
+    Serial.write('\n');
+#else
+    fwrite(line, 1, length, stdout);
+    fputc('\n', stdout);
+#endif
+}
+
+static void emit(uint8_t level, const char* line, size_t length) {
+    Log::Sink sink = currentSink;
+    (sink ? sink : defaultSink)(level, line, length);
+}
+
+static void writeRecord(const Log::Record& record) {
+    static const char levelLetters[] = "?EWID";
+    char line[Log::LINE_SIZE];
+    int n = snprintf(line, sizeof(line), "%lu.%03lu %c ", (unsigned long)(record.ms / 1000),
+                     (unsigned long)(record.ms % 1000), record.level <= MAXFAN_LOG_DEBUG ? levelLetters[record.level] : '?');
+    if (n < 0) return;
+    n += Log::format(record, line + n, sizeof(line) - n);
+    emit(record.level, line, n);
+}
+
+static void drain() {
+    Log::Record record;
+    while (queue().pop(record)) writeRecord(record);
+
+    uint32_t dropped = droppedCount.load(std::memory_order_relaxed);
+    if (dropped != reportedDropped) {
+        char line[64];
+        int n = snprintf(line, sizeof(line), "Log: %lu Meldung(en) verworfen (gesamt %lu)",
+                         (unsigned long)(dropped - reportedDropped), (unsigned long)dropped);
+        reportedDropped = dropped;
+        if (n > 0) emit(MAXFAN_LOG_WARN, line, n);
+    }
+}
+
+void Log::flush() {
+    drain();
+#ifdef ARDUINO
+    // Vor einem Neustart: auch der Puffer der seriellen Schnittstelle soll noch raus
+    if (!currentSink) Serial.flush();
+#endif
+}
+
+void Log::setSink(Sink sink) {
+    currentSink = sink;
+}
+
+#ifdef ARDUINO
+static void logTask(void*) {
+    for (;;) {
+        drain();
+        vTaskDelay(pdMS_TO_TICKS(TASK_IDLE_MS));
+    }
+}
+
+void Log::begin() {
+    static bool started = false;
+    if (started) return;
+    started = true;
+    xTaskCreate(logTask, "log", TASK_STACK, nullptr, TASK_PRIORITY, nullptr);
+}
+#else
+void Log::begin() {}
+#endif
@@ -9,6 +9,8 @@ const char* getMaxErrorText(MaxError err) {
         case MaxError::BLE_INVALID_AIRFLOW:   return "Invalid Airflow";
         case MaxError::BLE_INVALID_SPEED:     return "Invalid Speed";
         case MaxError::BLE_INVALID_TEMP:      return "Invalid Temp";
+        case MaxError::BLE_INVALID_SCHEDULE:  return "Invalid Schedule";
+        case MaxError::BLE_INVALID_CLOCK:     return "Invalid Clock";
         
         
         
@@ -26,6 +28,8 @@ const char* getMaxErrorCaption(MaxError err) {
         case MaxError::BLE_INVALID_AIRFLOW:   return "JSON Error";
         case MaxError::BLE_INVALID_SPEED:     return "JSON Error";
         case MaxError::BLE_INVALID_TEMP:      return "JSON Error";
+        case MaxError::BLE_INVALID_SCHEDULE:  return "JSON Error";
+        case MaxError::BLE_INVALID_CLOCK:     return "JSON Error";
         
         
         
@@ -1,68 +1,44 @@
 #include "MaxFanBLE.h"
+#include "Log.h"
+#include "MaxFanMetrics.h"
 #include "MaxFanConfig.h"
-#define SERVICE_UUID        "4fafc201-1fb5-459e-8fcc-c5c9c331914b"
-#define COMMAND_UUID        "beb5483e-36e1-4688-b7f5-ea07361b26a8"
-#define STATUS_UUID         "cba1d466-344c-4be3-ab3f-1890d5c0c0c0"
-
-BleController::BleController() 
-    : _pServer(nullptr), _pCommandChar(nullptr), _pStatusChar(nullptr), 
-                _onCommandReceived(nullptr), _deviceConnected(false), _bonded(false), _pinCode(0),
-                _forceUpdate(true) // Starten mit erzwungenem Update
+#include <esp_timer.h>
+
+BleController::BleController()
+    : _transport(BleTransport::instance()), _started(false),
+      _onCommandReceived(nullptr), _pinCode(0), _maxConnections(1),
+      _stateVersion(1), // Neue Clients starten mit Version 0 und sind damit sofort "hinterher"
+      _notifyCount(0), _notifyTotalUs(0), _notifyReportAt(NOTIFY_REPORT_EVERY), _lastMetricsMs(0)
 {
+    memset(_clients, 0, sizeof(_clients));
+    portMUX_INITIALIZE(&_clientsLock);
 }
 
 void BleController::begin(const char* deviceName) {
-    // 1. Initialisierung
-    BLEDevice::init(deviceName);
-
-    // 2. PIN laden
+    // 1. PIN und Verbindungs-Limit laden
     _pinCode = GlobalConfig.blePin;
-    
-    Serial.printf("BLE: Security PIN ist %d\n", _pinCode);
-
-    // 3. Security Einstellungen (Still notwendig für PIN-Abfrage am Handy)
-    BLEDevice::setEncryptionLevel(ESP_BLE_SEC_ENCRYPT_MITM);
-    BLEDevice::setSecurityCallbacks(new MySecurityCallbacks(this));
-
-    BLESecurity *pSecurity = new BLESecurity();
-    pSecurity->setStaticPIN(_pinCode); 
-    pSecurity->setAuthenticationMode(ESP_LE_AUTH_REQ_SC_MITM_BOND);
-    // IO_CAP_OUT signalisiert dem Handy: "Ich zeige dir was an (den statischen PIN), tipp ihn ein."
-    pSecurity->setCapability(ESP_IO_CAP_OUT); 
-    pSecurity->setInitEncryptionKey(ESP_BLE_ENC_KEY_MASK | ESP_BLE_ID_KEY_MASK);
-    pSecurity->setRespEncryptionKey(ESP_BLE_ENC_KEY_MASK | ESP_BLE_ID_KEY_MASK);
-
-    // 4. Server & Service
-    _pServer = BLEDevice::createServer();
-    _pServer->setCallbacks(new MyServerCallbacks(this));
-    
-    BLEService* pService = _pServer->createService(SERVICE_UUID);
-    
-    // 5. Characteristics (Verschlüsselt)
-    _pCommandChar = pService->createCharacteristic(COMMAND_UUID, BLECharacteristic::PROPERTY_WRITE);
-    _pCommandChar->setAccessPermissions(ESP_GATT_PERM_WRITE_ENC_MITM); 
-    _pCommandChar->setCallbacks(new MyCharCallbacks(this));
-    
-    _pStatusChar = pService->createCharacteristic(STATUS_UUID, BLECharacteristic::PROPERTY_READ | BLECharacteristic::PROPERTY_NOTIFY);
-    _pStatusChar->setAccessPermissions(ESP_GATT_PERM_READ_ENC_MITM);
-    _pStatusChar->addDescriptor(new BLE2902());
-    
-    pService->start();
-    
-    // 6. Advertising
-    BLEAdvertising* pAdvertising = BLEDevice::getAdvertising();
-    pAdvertising->addServiceUUID(SERVICE_UUID);
-    pAdvertising->setScanResponse(true);
-    pAdvertising->setMinPreferred(0x06); 
-    pAdvertising->setMinPreferred(0x12);
-    BLEDevice::startAdvertising();
-
-    Serial.println("BLE bereit (Sicherer Modus).");
+    _maxConnections = constrain(GlobalConfig.bleMaxConnections, 1, MAX_CLIENTS);
+
+    LOG_I("BLE: Security PIN is %d", _pinCode);
+
+    // 2. Stack, Security, Service und Characteristics (Backend-spezifisch)
+    uint32_t freeBefore = ESP.getFreeHeap();
+    // Angeboten wird dasselbe Intervall, das später für aktive Clients angefordert wird
+    _transport.begin(deviceName, _pinCode, PREFERRED_MTU, FAST_MIN_INTERVAL, FAST_MAX_INTERVAL, this);
+    _started = true;
+
+    // 3. Advertising
+    // Eigene Advertising-Daten, damit der Status ohne Verbindung mitgelesen werden kann
+    updateAdvertisingData();
+    _transport.startAdvertising();
+
+    LOG_I("BLE ready (%s, secure mode, max. %d clients), heap used: %lu bytes.",
+          BleTransport::backendName(), _maxConnections,
+          (unsigned long)(freeBefore - ESP.getFreeHeap()));
     if (deviceName) {
-        Serial.print("BLE: Device name: ");
-        Serial.println(deviceName);
+        LOG_I("BLE: Device name: %s", deviceName);
     }
-    Serial.println("BLE: Advertising started");
+    LOG_I("BLE: Advertising started");
 }
 
 void BleController::setCommandCallback(FanController::CommandCallback callback) {
@@ -70,78 +46,322 @@ void BleController::setCommandCallback(FanController::CommandCallback callback)
 }
 
 void BleController::notifyStatus(const MaxFanState& currentState) {
-    // 1. Wenn keiner zuhört, sofort raus
-    if (!_deviceConnected || !_pStatusChar) {
-        return;
+    if (!_started) return;
+
+    // Neue Version nur bei echter Änderung (effizienter == Operator von MaxFanState)
+    bool changed = (currentState != _lastState);
+    if (changed) {
+        _lastState = currentState;
+        _stateVersion++;
+        updateAdvertisingData();
+    }
+
+    // Wer ist abonniert, gebondet und noch nicht auf dem aktuellen Stand?
+    uint16_t targets[MAX_CLIENTS];
+    uint32_t connectedMs[MAX_CLIENTS];
+    uint16_t mtus[MAX_CLIENTS];
+    bool mtuWarned[MAX_CLIENTS];
+    int targetCount = 0;
+    portENTER_CRITICAL(&_clientsLock);
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        ClientSlot& c = _clients[i];
+        if (c.used && c.subscribed && c.bonded && c.sentVersion != _stateVersion) {
+            targets[targetCount] = c.connId;
+            connectedMs[targetCount] = c.firstNotifyLogged ? 0 : c.connectedMs;
+            mtus[targetCount] = c.mtu;
+            mtuWarned[targetCount] = c.mtuWarned;
+            targetCount++;
+            c.sentVersion = _stateVersion;
+            c.firstNotifyLogged = true;
+        }
+    }
+    portEXIT_CRITICAL(&_clientsLock);
+
+    // STROMSPAR-CHECK: Niemand ist hinterher -> nicht einmal JSON bauen
+    if (targetCount == 0 && !changed) return;
+
+    // Erst JETZT den String bauen. Der Wert der Characteristic wird auch für Reads gebraucht.
+    const char* jsonStatus = FanController::statusJson(currentState);
+    size_t jsonLength = strlen(jsonStatus);
+    _transport.setStatusValue((const uint8_t*)jsonStatus, jsonLength);
+    if (targetCount == 0) return;
+
+    int64_t start = esp_timer_get_time();
+    for (int i = 0; i < targetCount; i++) {
+        // Eine Notification trägt höchstens MTU-3 Bytes; der Rest steht im Wert der Characteristic
+        // (siehe BLE_CLIENT_SPEC.md), also gekürzt senden statt den Stack entscheiden zu lassen
+        size_t payload = mtus[i] > 3 ? mtus[i] - 3 : 0;
+        size_t length = jsonLength < payload ? jsonLength : payload;
+        _transport.notify(targets[i], (const uint8_t*)jsonStatus, length);
+    }
+    int64_t elapsed = esp_timer_get_time() - start;
+
+    for (int i = 0; i < targetCount; i++) {
+        if (mtuWarned[i] || jsonLength + 3 <= mtus[i]) continue;
+        portENTER_CRITICAL(&_clientsLock);
+        ClientSlot* slot = findClient(targets[i]);
+        if (slot) slot->mtuWarned = true;
+        portEXIT_CRITICAL(&_clientsLock);
+        LOG_W("BLE: Client %u: status (%u bytes) does not fit MTU %u, notifications truncated to %u bytes",
+              targets[i], (unsigned)jsonLength, mtus[i], (unsigned)(mtus[i] - 3));
     }
 
-    // 2. STROMSPAR-CHECK:
-    // Nutzt den effizienten == Operator von MaxFanState.
-    // Wenn Zustand gleich wie vorher UND kein erzwungenes Update -> Raus!
-    if ((_lastSentState == currentState) && !_forceUpdate) {
-        return; 
+    _notifyCount += targetCount;
+    _notifyTotalUs += elapsed;
+    LOG_D("BLE: Notified %d client(s), v%lu, %lld us (%lld us/client, avg %lld us)",
+          targetCount, (unsigned long)_stateVersion, elapsed, elapsed / targetCount,
+          _notifyTotalUs / _notifyCount);
+    // Zusammenfassung auch ohne Debug-Log
+    if (_notifyCount >= _notifyReportAt) {
+        LOG_I("BLE: %lu notifications, avg %lld us/client", (unsigned long)_notifyCount,
+              _notifyTotalUs / _notifyCount);
+        _notifyReportAt = _notifyCount + NOTIFY_REPORT_EVERY;
     }
 
-    // 3. Es hat sich was geändert (oder neuer Client):
-    _lastSentState = currentState; // Zustand merken (Byte-Kopie)
-    _forceUpdate = false;          // Flag zurücksetzen
+    uint32_t now = millis();
+    for (int i = 0; i < targetCount; i++) {
+        if (connectedMs[i] == 0) continue;
+        LOG_I("BLE: Client %u connect-to-first-notify: %lu ms (%s)", targets[i],
+              (unsigned long)(now - connectedMs[i]), BleTransport::backendName());
+    }
+}
+
 
-    // Erst JETZT den String für das Handy bauen
-    String jsonStatus = currentState.ToJson(); 
-    
-    // Senden
-    _pStatusChar->setValue(jsonStatus.c_str());
-    _pStatusChar->notify();
-    Serial.println("Notified CLient");
+// --- Advertising ---
+
+void BleController::updateAdvertisingData() {
+    // Advertising-PDU (max. 31 Bytes):
+    //   Flags (3) + 128-bit Service UUID (18) + Manufacturer Data (10) = 31
+    // Manufacturer Data: Company ID (LE), Format, State-, Speed-, Temp-Byte, State-Version (LE, 16 bit)
+    uint16_t version = (uint16_t)_stateVersion;
+    uint8_t payload[8] = {
+        (uint8_t)(ADV_COMPANY_ID & 0xFF), (uint8_t)(ADV_COMPANY_ID >> 8),
+        ADV_FORMAT,
+        _lastState.GetStateByte(),
+        _lastState.GetSpeedByte(),
+        _lastState.GetTempByte(),
+        (uint8_t)(version & 0xFF), (uint8_t)(version >> 8)
+    };
+    _transport.setManufacturerData(payload, sizeof(payload));
+}
+
+
+// --- Client-Verwaltung ---
+
+BleController::ClientSlot* BleController::findClient(uint16_t connId) {
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (_clients[i].used && _clients[i].connId == connId) return &_clients[i];
+    }
+    return nullptr;
+}
+
+int BleController::connectedCount() const {
+    int count = 0;
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (_clients[i].used) count++;
+    }
+    return count;
+}
+
+void BleController::updateAdvertising(int count) {
+    // Beide Stacks stoppen das Advertising bei jedem Connect; weiter advertisen bis das Limit erreicht ist
+    if (count < _maxConnections) {
+        _transport.startAdvertising();
+    } else {
+        LOG_I("BLE: Connection limit reached, advertising paused");
+    }
 }
 
 
 // --- Callbacks ---
 
-void BleController::MyServerCallbacks::onConnect(BLEServer* s) {
-    _parent->_deviceConnected = true;
-    // WICHTIG: Wenn sich das Handy neu verbindet, kennt es den aktuellen Status nicht.
-    // Wir zwingen notifyStatus() dazu, beim nächsten Mal zu senden,
-    // auch wenn sich der State technisch nicht geändert hat.
-    _parent->_forceUpdate = true;
-    Serial.println("BLE: Client verbunden.");
+void BleController::onClientConnected(uint16_t connId, uint16_t interval, uint16_t latency, uint16_t timeout) {
+    portENTER_CRITICAL(&_clientsLock);
+    ClientSlot* slot = nullptr;
+    int count = connectedCount();
+    if (count < _maxConnections) {
+        for (int i = 0; i < MAX_CLIENTS; i++) {
+            if (!_clients[i].used) { slot = &_clients[i]; break; }
+        }
+    }
+    if (slot) {
+        memset(slot, 0, sizeof(ClientSlot));
+        slot->used = true;
+        slot->connId = connId;
+        slot->mtu = 23;
+        // sentVersion = 0: ein neuer Client kennt den Status nicht und bekommt ihn beim nächsten notifyStatus().
+        // Direkt nach dem Connect (Service Discovery, Pairing) wollen wir das schnelle Intervall.
+        slot->lastCommandMs = millis();
+        slot->connectedMs = slot->lastCommandMs | 1; // 0 heißt "schon gemessen"
+        count++;
+    }
+    portEXIT_CRITICAL(&_clientsLock);
+
+    if (!slot) {
+        LOG_W("BLE: Client %u rejected, connection limit %d reached", connId, _maxConnections);
+        _transport.disconnect(connId);
+        return;
+    }
+
+    MaxFanMetrics::bleConnects.inc();
+    LOG_I("BLE: Client %u connected (interval %.2f ms, latency %u, timeout %u ms), %d/%d.",
+          connId, interval * 1.25f, latency, timeout * 10,
+          count, _maxConnections);
+    updateAdvertising(count);
 }
 
-void BleController::MyServerCallbacks::onDisconnect(BLEServer* s) {
-    _parent->_deviceConnected = false;
-    Serial.println("BLE: Client getrennt.");
-    BLEDevice::startAdvertising(); 
+void BleController::onClientDisconnected(uint16_t connId) {
+    portENTER_CRITICAL(&_clientsLock);
+    ClientSlot* slot = findClient(connId);
+    if (slot) slot->used = false;
+    int count = connectedCount();
+    portEXIT_CRITICAL(&_clientsLock);
+
+    LOG_I("BLE: Client %u disconnected, %d/%d.", connId, count, _maxConnections);
+    updateAdvertising(count);
+}
+
+void BleController::onMtuChanged(uint16_t connId, uint16_t mtu) {
+    portENTER_CRITICAL(&_clientsLock);
+    ClientSlot* slot = findClient(connId);
+    if (slot) slot->mtu = mtu;
+    portEXIT_CRITICAL(&_clientsLock);
+    LOG_D("BLE: Client %u MTU negotiated: %u", connId, mtu);
 }
 
-void BleController::MyCharCallbacks::onWrite(BLECharacteristic* pChar) {
-    std::string rxValue = pChar->getValue();
-    if (rxValue.length() > 0 && _parent->_onCommandReceived) {
-        _parent->_onCommandReceived(String(rxValue.c_str()));
+void BleController::onSubscribeChanged(uint16_t connId, bool subscribed) {
+    portENTER_CRITICAL(&_clientsLock);
+    ClientSlot* slot = findClient(connId);
+    if (slot) {
+        slot->subscribed = subscribed;
+        // Frisch abonniert -> beim nächsten notifyStatus() den aktuellen Stand schicken
+        if (subscribed) slot->sentVersion = 0;
     }
+    portEXIT_CRITICAL(&_clientsLock);
+    if (!slot) return;
+    LOG_I("BLE: Client %u %s status notifications", connId,
+          subscribed ? "subscribed to" : "unsubscribed from");
 }
 
-void BleController::loop() {
-    // BLE server runs in background; nothing to do each loop for now
+void BleController::onAuthenticationComplete(uint16_t connId, bool success) {
+    portENTER_CRITICAL(&_clientsLock);
+    ClientSlot* slot = findClient(connId);
+    if (slot) slot->bonded = success;
+    portEXIT_CRITICAL(&_clientsLock);
+    if (success) {
+        MaxFanMetrics::bleBonds.inc();
+        LOG_I("BLE: Bonding complete");
+    } else {
+        MaxFanMetrics::bleBondFailures.inc();
+        LOG_W("BLE: Bonding failed or not completed");
+    }
+}
+
+void BleController::onConnParamsUpdated(uint16_t connId, uint16_t interval, uint16_t latency, uint16_t timeout) {
+    portENTER_CRITICAL(&_clientsLock);
+    ClientSlot* slot = findClient(connId);
+    uint16_t mtu = slot ? slot->mtu : 0;
+    portEXIT_CRITICAL(&_clientsLock);
+    LOG_D("BLE: Client %u connection parameters: interval %.2f ms, latency %u, timeout %u ms, MTU %u",
+          connId, interval * 1.25f, latency, timeout * 10, mtu);
 }
 
-void BleController::MySecurityCallbacks::onAuthenticationComplete(esp_ble_auth_cmpl_t cmpl) {
-    if (_parent) {
-        _parent->_bonded = (cmpl.success == 1);
-        if (_parent->_bonded) {
-            Serial.println("BLE: Bonding complete");
-        } else {
-            Serial.println("BLE: Bonding failed or not completed");
+void BleController::onCommand(uint16_t connId, const uint8_t* data, size_t len) {
+    portENTER_CRITICAL(&_clientsLock);
+    ClientSlot* slot = findClient(connId);
+    if (slot) slot->lastCommandMs = millis();
+    portEXIT_CRITICAL(&_clientsLock);
+
+    if (len == 0) return;
+    if (len > FanController::MAX_COMMAND) {
+        LOG_W("BLE: Client %u: command too long (%u bytes)", connId, (unsigned)len);
+        return;
+    }
+    Command command;
+    command.length = (uint16_t)len;
+    memcpy(command.json, data, len);
+    command.json[len] = '\0';
+    if (!_commands.push(command)) {
+        LOG_W("BLE: Client %u: command queue full, command dropped", connId);
+    }
+}
+
+void BleController::loop() {
+    // Der BLE-Server läuft im Hintergrund; hier die Kommandos ausführen und die Verbindungsintervalle
+    // anpassen. Beides bewusst nicht aus den BLE-Callbacks.
+    if (!_started) return;
+    _transport.loop();
+    refreshMetrics();
+
+    Command command;
+    while (_commands.pop(command)) {
+        if (_onCommandReceived) _onCommandReceived(command.json);
+    }
+
+    // Unter dem Lock nur entscheiden, angefragt wird danach (der Stack darf nicht im Lock laufen)
+    uint16_t connIds[MAX_CLIENTS];
+    bool fast[MAX_CLIENTS];
+    int count = 0;
+    uint32_t now = millis();
+    portENTER_CRITICAL(&_clientsLock);
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        ClientSlot& c = _clients[i];
+        if (!c.used) continue;
+        bool active = (now - c.lastCommandMs) < IDLE_AFTER_MS;
+        if (active != c.fastParams) {
+            c.fastParams = active;
+            connIds[count] = c.connId;
+            fast[count] = active;
+            count++;
         }
     }
+    portEXIT_CRITICAL(&_clientsLock);
+
+    for (int i = 0; i < count; i++) {
+        requestConnParams(connIds[i], fast[i]);
+    }
+}
+
+void BleController::refreshMetrics() {
+    uint32_t now = millis();
+    if (_lastMetricsMs != 0 && now - _lastMetricsMs < MaxFanMetrics::REFRESH_INTERVAL_MS) return;
+    _lastMetricsMs = now | 1;
+
+    char json[MaxFanMetrics::SNAPSHOT_SIZE];
+    size_t len = Metrics::snapshot(json, sizeof(json));
+    if (len > 0) _transport.setMetricsValue((const uint8_t*)json, len);
+}
+
+void BleController::requestConnParams(uint16_t connId, bool fast) {
+    if (fast) {
+        _transport.updateConnParams(connId, FAST_MIN_INTERVAL, FAST_MAX_INTERVAL, FAST_LATENCY, FAST_TIMEOUT);
+    } else {
+        _transport.updateConnParams(connId, IDLE_MIN_INTERVAL, IDLE_MAX_INTERVAL, IDLE_LATENCY, IDLE_TIMEOUT);
+    }
+    LOG_D("BLE: Client %u: requesting %s connection parameters", connId, fast ? "fast" : "idle");
 }
 
 char BleController::getIndicatorLetter() {
-    // If connected but not bonded -> indicate B
-    if (_deviceConnected && !_bonded) return 'B';
-    return '\0';
+    // Verbunden, aber noch niemand gebondet -> B
+    bool anyConnected = false;
+    bool anyBonded = false;
+    portENTER_CRITICAL(&_clientsLock);
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (!_clients[i].used) continue;
+        anyConnected = true;
+        if (_clients[i].bonded) anyBonded = true;
+    }
+    portEXIT_CRITICAL(&_clientsLock);
+    return anyConnected && !anyBonded ? 'B' : '\0';
 }
 
 bool BleController::isConnected() {
-    // Consider connected only if device connected AND bonded
-    return _deviceConnected && _bonded;
-}
\ No newline at end of file
+    // Verbunden zählt erst, wenn mindestens ein Client gebondet ist
+    bool bonded = false;
+    portENTER_CRITICAL(&_clientsLock);
+    for (int i = 0; i < MAX_CLIENTS; i++) {
+        if (_clients[i].used && _clients[i].bonded) bonded = true;
+    }
+    portEXIT_CRITICAL(&_clientsLock);
+    return bonded;
+}
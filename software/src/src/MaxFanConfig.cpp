@@ -1,35 +1,29 @@
 #include "MaxFanConfig.h"
+#include "Log.h"
 #include <Preferences.h>
-#include <BLEDevice.h>
-#include "esp_gap_ble_api.h"
+#include "BleTransport.h"
 
 // Die ECHTE Instanz
 ConfigData GlobalConfig;
 
-// --- Interne Hilfsfunktion (private) ---
-static void clearBondsInternal() {
-    int dev_num = esp_ble_get_bond_device_num();
-    if (dev_num == 0) return;
-    
-    Serial.println("ConfigManager: Lösche Bonds...");
-    esp_ble_bond_dev_t *dev_list = (esp_ble_bond_dev_t *)malloc(sizeof(esp_ble_bond_dev_t) * dev_num);
-    if (dev_list) {
-        esp_ble_get_bond_device_list(&dev_num, dev_list);
-        for (int i = 0; i < dev_num; i++) {
-            esp_ble_remove_bond_device(dev_list[i].bd_addr);
-        }
-        free(dev_list);
-    }
-}
-
 // --- Implementierung ConfigManager ---
 
 void ConfigManager::load() {
     Preferences prefs;
     prefs.begin("config", true); // ReadOnly
 
-    GlobalConfig.connection = prefs.getInt("connection", 0);
+    // Früher genau ein Controller ("connection": 1 BLE, 2 MQTT, 3 Timer) -> Vorgabe für die neuen Schalter.
+    // BLE lief damals immer mit (Kommandos vom Handy), daher standardmäßig an.
+    int legacyConnection = prefs.getInt("connection", 0);
+    GlobalConfig.controllerBle = prefs.getBool("ctrlBle", true);
+    GlobalConfig.controllerMqtt = prefs.getBool("ctrlMqtt", legacyConnection == 2);
+    GlobalConfig.controllerTimer = prefs.getBool("ctrlTimer", legacyConnection == 3);
+    GlobalConfig.controllerHttp = prefs.getBool("ctrlHttp", false);
+    GlobalConfig.controllerSerial = prefs.getBool("ctrlSerial", false);
+    GlobalConfig.controllerPriority = prefs.getInt("ctrlPriority", 0);
+    GlobalConfig.controllerHoldSeconds = prefs.getInt("ctrlHoldS", 600);
     GlobalConfig.blePin = prefs.getInt("blepin", 0);
+    GlobalConfig.bleMaxConnections = prefs.getInt("bleMaxConn", 2);
     GlobalConfig.displayTimeoutSeconds = prefs.getInt("displayTimeoutS", 20);
     // Erster Start? -> PIN generieren
     if (GlobalConfig.blePin == 0) {
@@ -38,7 +32,7 @@ void ConfigManager::load() {
         GlobalConfig.blePin = (esp_random() % 900000) + 100000;
         prefs.putInt("blepin", GlobalConfig.blePin);
         prefs.end(); // Schließen und neu ReadOnly öffnen oder so lassen
-        Serial.println("ConfigManager: Neuen PIN generiert.");
+        LOG_I("ConfigManager: Neuen PIN generiert.");
     }
 
     String pwd = prefs.getString("wifiPassword", "Start123");
@@ -87,19 +81,36 @@ void ConfigManager::load() {
     }
     GlobalConfig.timerPercent = prefs.getInt("timerPercent", 80);
     GlobalConfig.timerPauseForSeconds = prefs.getInt("timerPauseFor", 3600);
+    {
+        String tz = prefs.getString("timeZone", "CET-1CEST,M3.5.0,M10.5.0/3");
+        strncpy(GlobalConfig.timeZone, tz.c_str(), sizeof(GlobalConfig.timeZone));
+        GlobalConfig.timeZone[sizeof(GlobalConfig.timeZone)-1] = '\0';
+    }
+
+    String updateUrl = prefs.getString("updateUrl", "");
+    strncpy(GlobalConfig.updateUrl, updateUrl.c_str(), 64);
+    GlobalConfig.updateUrl[63] = '\0';
 
     prefs.end();
-    Serial.println("ConfigManager: Config geladen.");
+    LOG_I("ConfigManager: Config geladen.");
 }
 
 void ConfigManager::saveAndReboot(const ConfigData& newData) {
-    Serial.println("ConfigManager: Speichere...");
+    LOG_I("ConfigManager: Speichere...");
     
     Preferences prefs;
     prefs.begin("config", false); // Write
     
-    prefs.putInt("connection", newData.connection);
+    prefs.putBool("ctrlBle", newData.controllerBle);
+    prefs.putBool("ctrlMqtt", newData.controllerMqtt);
+    prefs.putBool("ctrlTimer", newData.controllerTimer);
+    prefs.putBool("ctrlHttp", newData.controllerHttp);
+    prefs.putBool("ctrlSerial", newData.controllerSerial);
+    prefs.putInt("ctrlPriority", newData.controllerPriority);
+    prefs.putInt("ctrlHoldS", newData.controllerHoldSeconds);
+    prefs.remove("connection");
     prefs.putInt("blepin", newData.blePin);
+    prefs.putInt("bleMaxConn", newData.bleMaxConnections);
     prefs.putInt("displayTimeoutS", newData.displayTimeoutSeconds);
     prefs.putString("wifiPassword", newData.wifiPassword);
     prefs.putString("wifiSSID", newData.wifiSSID);
@@ -117,17 +128,20 @@ void ConfigManager::saveAndReboot(const ConfigData& newData) {
     prefs.putString("timerAirflow", newData.timerAirflow);
     prefs.putInt("timerPercent", newData.timerPercent);
     prefs.putInt("timerPauseFor", newData.timerPauseForSeconds);
+    prefs.putString("timeZone", newData.timeZone);
+    // Update
+    prefs.putString("updateUrl", newData.updateUrl);
     prefs.end();
 
     // Der intelligente Check: Wurde der PIN geändert?
     if (newData.blePin != GlobalConfig.blePin) {
-        Serial.println("ConfigManager: PIN geändert -> Bonding Reset nötig.");
-        // Wir müssen BLE kurz initieren, falls es aus ist, um Bonds zu löschen
-        BLEDevice::init("TEMP_CLEAR"); 
-        clearBondsInternal();
+        LOG_I("ConfigManager: PIN geändert -> Bonding Reset nötig.");
+        // Initialisiert BLE bei Bedarf kurz (Bluedroid oder NimBLE, je nach Build)
+        BleTransport::clearAllBonds();
         delay(500); // Zeit für Flash
     }
 
-    Serial.println("ConfigManager: Rebooting...");
+    LOG_I("ConfigManager: Neustart...");
+    Log::flush();
     ESP.restart();
 }
\ No newline at end of file
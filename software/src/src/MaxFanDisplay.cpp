@@ -1,4 +1,7 @@
 #include "MaxFanDisplay.h"
+#include "MaxFanMetrics.h"
+#include "Log.h"
+#include "DisplayFlush.h"
 #include <cstring>
 
 static const unsigned char image_manual_bits[] U8X8_PROGMEM = {0x00,0x00,0xfe,0x0f,0xfe,0x0f,0xfe,0x0f,0xfe,0x0f,0x00,0x00,0x00,0x00,0xfe,0x01,0xfe,0x01,0xfe,0x01,0xfe,0x01,0x00,0x00,0x00,0x00,0x3e,0x00,0x3e,0x00,0x3e,0x00,0x3e,0x00,0x00,0x00,0x00,0x00,0x0e,0x00,0x0e,0x00,0x0e,0x00,0x0e,0x00,0x00,0x00,0x00,0x00,0x06,0x00,0x06,0x00,0x06,0x00,0x06,0x00,0x00,0x00,0x00,0x00};
@@ -13,44 +16,62 @@ static const unsigned char image_out_bits[] U8X8_PROGMEM = {0x00,0x00,0x40,0x00,
 
 static const unsigned char image_BTConnected_bits[] U8X8_PROGMEM = {0x10,0x31,0x52,0x94,0x58,0x38,0x54,0x92,0x51,0x30,0x10};
 static const unsigned char image_mqtt_bits[] U8X8_PROGMEM = {0x4f,0x10,0x27,0x48,0x53,0x57,0x57};
+static const unsigned char image_http_bits[] U8X8_PROGMEM = {0x1c,0x2a,0x7f,0x49,0x7f,0x2a,0x1c};
+static const unsigned char image_usb_bits[] U8X8_PROGMEM = {0x14,0x14,0x3e,0x3e,0x1c,0x08,0x08};
 static const unsigned char image_shock_bits[] U8X8_PROGMEM = {0x7c,0x00,0x7c,0x00,0x82,0x00,0x11,0x01,0x51,0x01,0x71,0x01,0x01,0x01,0x01,0x01,0x82,0x00,0x7c,0x00,0x7c,0x00};
 
+// Zeichen der großen Anzeige (helvB18), beim Start vorgerastert; 0xB0 = °
+static const uint16_t READOUT_GLYPHS[] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', ' ', '-', '%', 0xB0, 'C', 'O', 'F'
+};
+
 MaxFanDisplay::MaxFanDisplay(uint8_t sda, uint8_t scl) 
 : _u8g2(U8G2_R0, U8X8_PIN_NONE), _sda(sda), _scl(scl) {}
 bool MaxFanDisplay::begin() {
     Wire.begin(_sda, _scl);
     _u8g2.begin();
+    if (!_readout.build(_u8g2, u8g2_font_helvB18_tf, READOUT_GLYPHS, sizeof(READOUT_GLYPHS) / sizeof(READOUT_GLYPHS[0]))) {
+        LOG_W("Display: Glyphen-Atlas zu klein, große Anzeige über den Font-Decoder");
+    }
+    LOG_D("Display: Glyphen-Atlas %u Bytes", (unsigned)_readout.bytesUsed());
     _u8g2.clearBuffer();
     _u8g2.sendBuffer();
     return true;
 }
 
+// Große Anzeige: aus dem Atlas, falls der nicht gebaut werden konnte, wie früher über helvB18
+void MaxFanDisplay::drawReadout(int value, const char* unit) {
+    _u8g2.setDrawColor(1);
+    if (_readout.ready()) {
+        int x = _readout.drawNumber(_u8g2, READOUT_X, READOUT_Y, value);
+        _readout.drawStr(_u8g2, x, READOUT_Y, unit);
+        return;
+    }
+    char text[16];
+    snprintf(text, sizeof(text), "%d%s", value, unit);
+    _u8g2.setFont(u8g2_font_helvB18_tf);
+    _u8g2.drawStr(READOUT_X, READOUT_Y, text);
+}
 
-
-
-void drawOff(const MaxFanState& state, U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2){
-    u8g2.setFont(u8g2_font_t0_11_tr);
-    u8g2.setDrawColor(1);
-    u8g2.setFont(u8g2_font_helvB18_tf);
-    u8g2.drawStr(35, 42, "OFF");
+void MaxFanDisplay::drawOff() {
+    _u8g2.setDrawColor(1);
+    if (_readout.ready()) {
+        _readout.drawStr(_u8g2, READOUT_X, READOUT_Y, "OFF");
+        return;
+    }
+    _u8g2.setFont(u8g2_font_helvB18_tf);
+    _u8g2.drawStr(READOUT_X, READOUT_Y, "OFF");
 }
 
-void drawManual(const MaxFanState& state, U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2){
-    u8g2.drawXBMP(5, 18, 13, 31, image_manual_bits);
-    u8g2.setDrawColor(1);
-    u8g2.setFont(u8g2_font_helvB18_tf);
-    String speedStr;
-    speedStr = String(state.GetSpeed()) + " %";
-    u8g2.drawStr(35, 42, speedStr.c_str());
+void MaxFanDisplay::drawManual(const MaxFanState& state) {
+    _u8g2.drawXBMP(5, 18, 13, 31, image_manual_bits);
+    drawReadout(state.GetSpeed(), " %");
 }
 
-void drawAuto(const MaxFanState& state, U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2){
-    u8g2.drawXBMP(5, 17, 13, 31, image_auto_bits);
-    u8g2.setDrawColor(1);
-    u8g2.setFont(u8g2_font_helvB18_tf);
-    String tempStr;
-    tempStr = String(state.GetTempCelsius()) + " " "\xC2\xB0" "C"; 
-    u8g2.drawUTF8(35, 42, tempStr.c_str());
+void MaxFanDisplay::drawAuto(const MaxFanState& state) {
+    _u8g2.drawXBMP(5, 17, 13, 31, image_auto_bits);
+    // helvB18_tf hat ° als Code 0xB0; drawStr nimmt die Bytes direkt als Code
+    drawReadout(state.GetTempCelsius(), " \xB0" "C");
 }
 
 void MaxFanDisplay::showError(MaxError error) {
@@ -60,7 +81,97 @@ void MaxFanDisplay::showError(MaxError error) {
 
 
 
-void MaxFanDisplay::update(const MaxFanState& state, FanController::Icon icon, bool isConnected, char indicator, long encoderPos) {
+struct IndicatorBitmap {
+    int w, h;          // Größe
+    int x, y;          // Position, wenn es das einzige Icon ist
+    const unsigned char* bits;
+};
+
+static bool indicatorBitmap(FanController::Icon icon, IndicatorBitmap& out) {
+    switch (icon) {
+        case FanController::ICON_MQTT:  out = { 7, 7, 116, 20, image_mqtt_bits }; return true;
+        case FanController::ICON_BLE:   out = { 8, 11, 116, 18, image_BTConnected_bits }; return true;
+        case FanController::ICON_TIMER: out = { 16, 11, 108, 18, image_shock_bits }; return true;
+        case FanController::ICON_HTTP:  out = { 7, 7, 116, 20, image_http_bits }; return true;
+        case FanController::ICON_SERIAL: out = { 7, 7, 116, 20, image_usb_bits }; return true;
+        default: return false;
+    }
+}
+
+// Zeichnet ein Verbindungs-Icon: verbunden = invertiert, Teilverbindung = Buchstabe links daneben.
+// compact: kleinere Schrift und Rahmen, wenn mehrere Icons nebeneinander stehen.
+void MaxFanDisplay::drawIndicator(const FanController::Indicator& indicator, const unsigned char* bits,
+                                  int iconX, int iconY, int iconW, int iconH, bool compact) {
+    int pad = compact ? 1 : 2;
+    char letter[2] = { indicator.letter, '\0' };
+    if (indicator.letter != '\0') {
+        // If an indicator letter is present, render it left of the icon and do not draw the filled rectangle.
+        _u8g2.setFont(compact ? u8g2_font_4x6_tr : u8g2_font_t0_11_tr);
+        _u8g2.setDrawColor(1);
+        _u8g2.drawStr(iconX - (compact ? 5 : 10), iconY + (iconH / 2) + (compact ? 3 : 4), letter);
+        _u8g2.drawXBMP(iconX, iconY, iconW, iconH, bits);
+    } else if (indicator.connected) {
+        _u8g2.setDrawColor(1);
+        _u8g2.drawBox(iconX - pad, iconY - pad, iconW + 2 * pad, iconH + 2 * pad);
+        _u8g2.setDrawColor(2);
+        _u8g2.drawXBMP(iconX, iconY, iconW, iconH, bits);
+    } else {
+        _u8g2.setDrawColor(1);
+        _u8g2.drawXBMP(iconX, iconY, iconW, iconH, bits);
+    }
+    _u8g2.setDrawColor(1);
+}
+
+// Mehrere Icons (CompositeController): rechts oben von rechts nach links, dann nächste Zeile.
+// Der Bereich endet über dem Deckel-Icon; was nicht mehr passt, entfällt.
+void MaxFanDisplay::drawIndicators(const FanController::Indicator* indicators, int count) {
+    const int right = 124, left = 100, top = 15, bottom = 48;
+    int x = right, y = top, rowH = 0;
+    for (int i = 0; i < count; i++) {
+        IndicatorBitmap bmp;
+        if (!indicatorBitmap(indicators[i].icon, bmp)) continue;
+        int cellW = bmp.w + (indicators[i].letter != '\0' ? 5 : 0);
+        if (x != right && x - cellW < left) {
+            x = right;
+            y += rowH + 2;
+            rowH = 0;
+        }
+        if (y + bmp.h > bottom) break;
+        drawIndicator(indicators[i], bmp.bits, x - bmp.w, y, bmp.w, bmp.h, true);
+        x -= cellW + 3;
+        if (bmp.h > rowH) rowH = bmp.h;
+    }
+}
+
+bool MaxFanDisplay::unchanged(const MaxFanState& state, const FanController::Indicator* indicators, int indicatorCount) const {
+    if (!_drawn || state != _drawnState || _activeError != _drawnError || indicatorCount != _drawnIndicatorCount) {
+        return false;
+    }
+    for (int i = 0; i < indicatorCount && i < MAX_INDICATORS; i++) {
+        const FanController::Indicator& a = indicators[i];
+        const FanController::Indicator& b = _drawnIndicators[i];
+        if (a.icon != b.icon || a.connected != b.connected || a.letter != b.letter) return false;
+    }
+    return true;
+}
+
+void MaxFanDisplay::remember(const MaxFanState& state, const FanController::Indicator* indicators, int indicatorCount) {
+    _drawn = true;
+    _drawnState = state;
+    _drawnError = _activeError;
+    _drawnIndicatorCount = indicatorCount;
+    for (int i = 0; i < indicatorCount && i < MAX_INDICATORS; i++) _drawnIndicators[i] = indicators[i];
+}
+
+void MaxFanDisplay::update(const MaxFanState& state, const FanController::Indicator* indicators, int indicatorCount, long encoderPos) {
+    // Abgelaufene Fehlermeldung zählt als Änderung
+    if (_activeError != MaxError::NONE && esp_timer_get_time() - _errorStartTime > _errorDuration) {
+        _activeError = MaxError::NONE;
+    }
+    // Sonst zeichnet jeder Loop dasselbe Bild, kopiert 1 KB und weckt den Display-Task umsonst
+    if (unchanged(state, indicators, indicatorCount)) return;
+    remember(state, indicators, indicatorCount);
+
     _u8g2.clearBuffer();
     _u8g2.setFontMode(1);
     _u8g2.setBitmapMode(1);
@@ -116,85 +227,27 @@ void MaxFanDisplay::update(const MaxFanState& state, FanController::Icon icon, b
     switch (state.GetMode())
     {
       case MaxFanMode::OFF:
-        drawOff(state, _u8g2);
+        drawOff();
         break;
 
       case MaxFanMode::MANUAL:
-        drawManual(state, _u8g2);
+        drawManual(state);
         break;
 
       case MaxFanMode::AUTO:
-        drawAuto(state, _u8g2);
+        drawAuto(state);
         break;
         
       default:
         break;
     }
 
-    // Connection icon handling: `icon` selects icon, `isConnected` controls highlighted (filled box + XOR draw)
-    if (icon == FanController::ICON_MQTT) {
-        const int iconW = 7;
-        const int iconH = 7;
-        const int iconX = 116;
-        const int iconY = 20;
-        // If an indicator letter is present, render it left of the icon and do not draw the filled rectangle.
-        if (indicator != '\0') {
-            _u8g2.setFont(u8g2_font_t0_11_tr);
-            _u8g2.setDrawColor(1);
-            // draw letter slightly left and centered vertically to the icon
-            _u8g2.drawStr(iconX - 10, iconY + (iconH / 2) + 4, String(indicator).c_str());
-            _u8g2.setDrawColor(1);
-            _u8g2.drawXBMP(iconX, iconY, iconW, iconH, image_mqtt_bits);
-        } else if (isConnected) {
-            _u8g2.setDrawColor(1);
-            _u8g2.drawBox(iconX - 2, iconY - 2, iconW + 4, iconH + 4);
-            _u8g2.setDrawColor(2);
-            _u8g2.drawXBMP(iconX, iconY, iconW, iconH, image_mqtt_bits);
-        } else {
-            _u8g2.setDrawColor(1);
-            _u8g2.drawXBMP(iconX, iconY, iconW, iconH, image_mqtt_bits);
-        }
-    } else if (icon == FanController::ICON_BLE) {
-        const int iconW = 8;
-        const int iconH = 11;
-        const int iconX = 116;
-        const int iconY = 18;
-        if (indicator != '\0') {
-            _u8g2.setFont(u8g2_font_t0_11_tr);
-            _u8g2.setDrawColor(1);
-            _u8g2.drawStr(iconX - 10, iconY + (iconH / 2) + 4, String(indicator).c_str());
-            _u8g2.setDrawColor(1);
-            _u8g2.drawXBMP(iconX, iconY, iconW, iconH, image_BTConnected_bits);
-        } else if (isConnected) {
-            _u8g2.setDrawColor(1);
-            _u8g2.drawBox(iconX - 2, iconY - 2, iconW + 4, iconH + 4);
-            _u8g2.setDrawColor(2);
-            _u8g2.drawXBMP(iconX, iconY, iconW, iconH, image_BTConnected_bits);
-        } else {
-            _u8g2.setDrawColor(1);
-            _u8g2.drawXBMP(iconX, iconY, iconW, iconH, image_BTConnected_bits);
-        }
-    }
-    else if (icon == FanController::ICON_TIMER) {
-        const int iconW = 16;
-        const int iconH = 11;
-        const int iconX = 108;
-        const int iconY = 18;
-        if (indicator != '\0') {
-            _u8g2.setFont(u8g2_font_t0_11_tr);
-            _u8g2.setDrawColor(1);
-            _u8g2.drawStr(iconX - 10, iconY + (iconH / 2) + 4, String(indicator).c_str());
-            _u8g2.setDrawColor(1);
-            _u8g2.drawXBMP(iconX, iconY, iconW, iconH, image_shock_bits);
-        } else if (isConnected) {
-            _u8g2.setDrawColor(1);
-            _u8g2.drawBox(iconX - 2, iconY - 2, iconW + 4, iconH + 4);
-            _u8g2.setDrawColor(2);
-            _u8g2.drawXBMP(iconX, iconY, iconW, iconH, image_shock_bits);
-        } else {
-            _u8g2.setDrawColor(1);
-            _u8g2.drawXBMP(iconX, iconY, iconW, iconH, image_shock_bits);
-        }
+    // Verbindungs-Icons: eines wie gehabt, mehrere (CompositeController) kompakt
+    IndicatorBitmap bmp;
+    if (indicatorCount == 1 && indicatorBitmap(indicators[0].icon, bmp)) {
+        drawIndicator(indicators[0], bmp.bits, bmp.x, bmp.y, bmp.w, bmp.h, false);
+    } else if (indicatorCount > 1) {
+        drawIndicators(indicators, indicatorCount);
     }
 
     
@@ -212,31 +265,27 @@ void MaxFanDisplay::update(const MaxFanState& state, FanController::Icon icon, b
         
    
     if (_activeError != MaxError::NONE) {
-        // Zeit prüfen
-        if (esp_timer_get_time() - _errorStartTime > _errorDuration) {
-            _activeError = MaxError::NONE; // Fehlerzeit abgelaufen
-        } else {
-            _u8g2.clearBuffer();
-            _u8g2.setFontMode(1);
-            _u8g2.setBitmapMode(1);
-            
-            // outerBox
-            _u8g2.drawBox(4, 5, 119, 45);
-
-            // innerBox
-            _u8g2.setDrawColor(2);
-            _u8g2.drawBox(5, 19, 117, 30);
-
-            // Caption
-            _u8g2.setFont(u8g2_font_profont11_tr);
-            _u8g2.drawStr(10, 16, getMaxErrorCaption(_activeError));
-
-            // message
-            _u8g2.setFont(u8g2_font_profont12_tr);
-            _u8g2.drawStr(13, 37, getMaxErrorText(_activeError));
-        }
+        _u8g2.clearBuffer();
+        _u8g2.setFontMode(1);
+        _u8g2.setBitmapMode(1);
+        
+        // outerBox
+        _u8g2.drawBox(4, 5, 119, 45);
+
+        // innerBox
+        _u8g2.setDrawColor(2);
+        _u8g2.drawBox(5, 19, 117, 30);
+
+        // Caption
+        _u8g2.setFont(u8g2_font_profont11_tr);
+        _u8g2.drawStr(10, 16, getMaxErrorCaption(_activeError));
+
+        // message
+        _u8g2.setFont(u8g2_font_profont12_tr);
+        _u8g2.drawStr(13, 37, getMaxErrorText(_activeError));
     }
     
     
-    _u8g2.sendBuffer();
+    DisplayFlush::submit(_u8g2);
+    MaxFanMetrics::displayFrames.inc();
 }
@@ -0,0 +1,167 @@
+#include "MaxFanHTTP.h"
+#include "Log.h"
+#include <WiFi.h>
+
+HttpController::HttpController()
+    : _server(PORT), _ws("/ws"), _onCommandReceived(nullptr), _started(false), _rejected(0),
+      _hasState(false), _lastCleanupMs(0)
+{
+    portMUX_INITIALIZE(&_stateLock);
+    _stateJson[0] = '\0';
+}
+
+void HttpController::begin(const char* deviceName) {
+    (void)deviceName;
+    // Der Server startet erst, wenn WLAN da ist (siehe loop())
+    if (WiFi.status() == WL_CONNECTED) startServer();
+}
+
+void HttpController::setCommandCallback(FanController::CommandCallback callback) {
+    _onCommandReceived = callback;
+}
+
+void HttpController::startServer() {
+    uint32_t freeBefore = ESP.getFreeHeap();
+
+    _ws.onEvent([this](AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                       void* arg, uint8_t* data, size_t length) {
+        onWsEvent(server, client, type, arg, data, length);
+    });
+    _server.addHandler(&_ws);
+
+    _server.on("/state", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        char json[STATE_SIZE];
+        if (!copyState(json, sizeof(json))) {
+            request->send(503, "application/json", "{\"error\":\"no state yet\"}");
+            return;
+        }
+        request->send(200, "application/json", json);
+    });
+
+    _server.on("/command", HTTP_POST,
+        // Nach dem Body: das Kommando steht in _tempObject (gibt die Library mit free() frei)
+        [this](AsyncWebServerRequest* request) {
+            Command* command = (Command*)request->_tempObject;
+            if (!command || command->length == 0) {
+                request->send(400, "application/json", "{\"error\":\"empty body\"}");
+            } else if (command->length > MAX_BODY) {
+                request->send(413, "application/json", "{\"error\":\"too large\"}");
+            } else if (!_commands.push(*command)) {
+                _rejected++;
+                request->send(503, "application/json", "{\"error\":\"busy\"}");
+            } else {
+                request->send(202, "application/json", "{\"queued\":true}");
+            }
+        },
+        nullptr,
+        [](AsyncWebServerRequest* request, uint8_t* data, size_t length, size_t index, size_t total) {
+            if (index == 0) {
+                request->_tempObject = malloc(sizeof(Command));
+                if (!request->_tempObject) return;
+                ((Command*)request->_tempObject)->length = (uint16_t)min(total, (size_t)MAX_BODY + 1);
+            }
+            Command* command = (Command*)request->_tempObject;
+            if (!command || total > MAX_BODY) return;
+            memcpy(command->json + index, data, length);
+            command->json[index + length] = '\0';
+        });
+
+    // Für Dashboards von einer anderen Origin
+    DefaultHeaders::Instance().addHeader("Access-Control-Allow-Origin", "*");
+    DefaultHeaders::Instance().addHeader("Access-Control-Allow-Headers", "Content-Type");
+    _server.onNotFound([](AsyncWebServerRequest* request) {
+        if (request->method() == HTTP_OPTIONS) {
+            request->send(204);
+        } else {
+            request->send(404, "application/json", "{\"error\":\"not found\"}");
+        }
+    });
+
+    _server.begin();
+    _started = true;
+    LOG_I("HTTP: Server auf http://%s:%u/, Heap belegt: %lu Bytes",
+          WiFi.localIP().toString().c_str(), PORT, (unsigned long)(freeBefore - ESP.getFreeHeap()));
+}
+
+// --- AsyncTCP-Task ---
+
+bool HttpController::enqueue(const uint8_t* data, size_t length) {
+    if (length == 0 || length > MAX_BODY) return false;
+    Command command;
+    command.length = (uint16_t)length;
+    memcpy(command.json, data, length);
+    command.json[length] = '\0';
+    if (_commands.push(command)) return true;
+    _rejected++;
+    return false;
+}
+
+bool HttpController::copyState(char* out, size_t size) {
+    portENTER_CRITICAL(&_stateLock);
+    strlcpy(out, _stateJson, size);
+    portEXIT_CRITICAL(&_stateLock);
+    return out[0] != '\0';
+}
+
+void HttpController::onWsEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type,
+                               void* arg, uint8_t* data, size_t length) {
+    if (type == WS_EVT_CONNECT) {
+        if (server->count() > MAX_WS_CLIENTS) {
+            client->close(1013); // Try Again Later
+            return;
+        }
+        // Neuer Client bekommt sofort den aktuellen Stand
+        char json[STATE_SIZE];
+        if (copyState(json, sizeof(json))) client->text(json);
+    } else if (type == WS_EVT_DATA) {
+        // Nur Text-Frames, die in einem Stück angekommen sind (Kommandos sind klein)
+        AwsFrameInfo* info = (AwsFrameInfo*)arg;
+        if (!info->final || info->index != 0 || info->len != length || info->opcode != WS_TEXT) return;
+        if (!enqueue(data, length)) client->text("{\"error\":\"busy\"}");
+    }
+}
+
+// --- Loop ---
+
+void HttpController::notifyStatus(const MaxFanState& currentState) {
+    if (!_started) return;
+    if (_hasState && currentState == _lastState) return;
+
+    const char* json = FanController::statusJson(currentState);
+    portENTER_CRITICAL(&_stateLock);
+    strlcpy(_stateJson, json, sizeof(_stateJson));
+    portEXIT_CRITICAL(&_stateLock);
+    _lastState = currentState;
+    _hasState = true;
+
+    // Push sofort bei Änderung: Dashboards brauchen kein Polling
+    if (_ws.count() > 0) _ws.textAll(json);
+}
+
+void HttpController::loop() {
+    if (!_started) {
+        if (WiFi.status() == WL_CONNECTED) startServer();
+        return;
+    }
+
+    Command command;
+    while (_commands.pop(command)) {
+        if (_onCommandReceived) _onCommandReceived(command.json);
+    }
+
+    uint32_t now = millis();
+    if (now - _lastCleanupMs >= 1000) {
+        _lastCleanupMs = now;
+        // Gibt Speicher geschlossener WebSockets frei
+        _ws.cleanupClients(MAX_WS_CLIENTS);
+    }
+}
+
+bool HttpController::isConnected() {
+    return _started && _ws.count() > 0;
+}
+
+char HttpController::getIndicatorLetter() {
+    if (WiFi.status() != WL_CONNECTED) return 'W';
+    return '\0';
+}
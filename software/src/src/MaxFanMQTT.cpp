@@ -1,42 +1,55 @@
 #include "MaxFanMQTT.h"
 #include "MaxFanConfig.h"
+#include "MqttOtaReceiver.h"
+#include "Log.h"
+#include "MaxFanMetrics.h"
 #include <Arduino.h>
 
 // PubSubClient requires a client reference; we'll set callback to static function
 static MqttController* instanceForCallback = nullptr;
 
 MqttController::MqttController()
-    : _mqtt(_wifiClient), _onCommandReceived(nullptr), _connected(false),
-      _lastSentState(), _forceUpdate(true), _lastConnectAttemptMs(0), _reconnectIntervalMs(RECONNECT_BASE_MS)
+    : _mqtt(_wifiClient), _onCommandReceived(nullptr), _connected(false), _started(false), _otaReceiver(nullptr),
+      _lastSentState(), _forceUpdate(true), _lastConnectAttemptMs(0), _reconnectIntervalMs(RECONNECT_BASE_MS),
+      _lastMetricsMs(0)
 {
     instanceForCallback = this;
-    Serial.println("MqttController: constructed");
+    LOG_D("MqttController: constructed");
 }
 
 void MqttController::begin(const char* deviceName) {
-    Serial.println("MqttController: begin");
+    LOG_D("MqttController: begin");
 
     (void)deviceName;
+    _started = true;
     _mqtt.setCallback(MqttController::mqttCallbackStatic);
     _forceUpdate = true;
     ensureConnected();
 }
 
+void MqttController::end() {
+    LOG_D("MqttController: end");
+    _started = false;
+    if (_mqtt.connected()) _mqtt.disconnect();
+    _wifiClient.stop();
+    _connected = false;
+}
+
 void MqttController::setCommandCallback(FanController::CommandCallback callback) {
     _onCommandReceived = callback;
-    Serial.println("MqttController: command callback registered");
+    LOG_D("MqttController: command callback registered");
 }
 
 void MqttController::ensureConnected() {
     if (_mqtt.connected()) {
         _connected = true;
-        Serial.println("connected = true");
+        LOG_D("MQTT: connected = true");
         return;
     }
 
     if (WiFi.status() != WL_CONNECTED) {
         _connected = false;
-        Serial.println("connected = false (WiFi not connected)");
+        LOG_D("MQTT: connected = false (WiFi not connected)");
         return;
     }
 
@@ -44,7 +57,7 @@ void MqttController::ensureConnected() {
     int port = GlobalConfig.mqttPort;
     if (!host || strlen(host) == 0) {
         _connected = false;
-        Serial.println("connected = false (invalid host)");
+        LOG_D("MQTT: connected = false (invalid host)");
         return;
     }
 
@@ -52,7 +65,7 @@ void MqttController::ensureConnected() {
     // Backoff: only attempt if interval elapsed
     if (now - _lastConnectAttemptMs < _reconnectIntervalMs) {
         uint32_t remaining = _reconnectIntervalMs - (now - _lastConnectAttemptMs);
-        Serial.printf("MQTT: Skipping connect attempt (backoff), wait %u ms\n", remaining);
+        LOG_D("MQTT: Skipping connect attempt (backoff), wait %lu ms", (unsigned long)remaining);
         _connected = false;
         return;
     }
@@ -67,31 +80,39 @@ void MqttController::ensureConnected() {
         return;
     }
 
-    Serial.printf("MQTT: Connecting to %s:%d\n", host, port);
+    LOG_I("MQTT: Connecting to %s:%d", host, port);
     _mqtt.setServer(host, port);
 
-    String clientId = String(GlobalConfig.mqttClientId);
-    if (clientId.length() == 0) {
-        clientId = "MaxFan-" + WiFi.macAddress();
+    char clientId[sizeof(GlobalConfig.mqttClientId) + 20];
+    if (GlobalConfig.mqttClientId[0] != '\0') {
+        strlcpy(clientId, GlobalConfig.mqttClientId, sizeof(clientId));
+    } else {
+        uint8_t mac[6];
+        WiFi.macAddress(mac);
+        snprintf(clientId, sizeof(clientId), "MaxFan-%02X:%02X:%02X:%02X:%02X:%02X",
+                 mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
     }
 
     bool ok;
     if (strlen(GlobalConfig.mqttUsername) > 0) {
-        Serial.printf("MQTT: Using auth user='%s'\n", GlobalConfig.mqttUsername);
-        ok = _mqtt.connect(clientId.c_str(), GlobalConfig.mqttUsername, GlobalConfig.mqttPassword);
+        LOG_I("MQTT: Using auth user='%s'", GlobalConfig.mqttUsername);
+        ok = _mqtt.connect(clientId, GlobalConfig.mqttUsername, GlobalConfig.mqttPassword);
     } else {
-        ok = _mqtt.connect(clientId.c_str());
+        ok = _mqtt.connect(clientId);
     }
     if (ok) {
         _connected = true;
         _reconnectIntervalMs = RECONNECT_BASE_MS; // reset backoff
+        MaxFanMetrics::mqttConnects.inc();
         bool subOk = _mqtt.subscribe(GlobalConfig.mqttCommandTopic);
-        Serial.printf("MQTT: Connected (clientId=%s), subscribed=%d\n", clientId.c_str(), (int)subOk);
+        LOG_I("MQTT: Connected (clientId=%s), subscribed=%d", clientId, (int)subOk);
+        if (_otaReceiver) subscribeOta();
         _forceUpdate = true;
     } else {
         _connected = false;
         int state = _mqtt.state();
-        Serial.printf("MQTT: Connect failed, state=%d\n", state);
+        LOG_W("MQTT: Connect failed, state=%d", state);
+        MaxFanMetrics::mqttConnectFailures.inc();
         uint32_t next = _reconnectIntervalMs * 2;
         _reconnectIntervalMs = (next > RECONNECT_MAX_MS) ? RECONNECT_MAX_MS : next;
     }
@@ -104,22 +125,20 @@ void MqttController::notifyStatus(const MaxFanState& currentState) {
 
     if (!_forceUpdate && (currentState == _lastSentState)) return;
 
-    if (!_mqtt.connected()) {
-        Serial.println("MQTT: Not connected, cannot publish");
-        return;
-    }
+    // Nicht verbunden: still warten, nach dem Reconnect wird wegen _forceUpdate ohnehin publiziert
+    if (!_mqtt.connected()) return;
 
-    String payload = currentState.ToJson();
-    Serial.printf("MQTT: Publishing to %s payload=%s\n", GlobalConfig.mqttStateTopic, payload.c_str());
-    bool ok = _mqtt.publish(GlobalConfig.mqttStateTopic, payload.c_str());
+    const char* payload = FanController::statusJson(currentState);
+    LOG_D("MQTT: Publishing to %s payload=%s", GlobalConfig.mqttStateTopic, payload);
+    bool ok = _mqtt.publish(GlobalConfig.mqttStateTopic, payload);
     if (ok) {
         _lastSentState = currentState;
         _forceUpdate = false;
-        Serial.println("MQTT: Publish OK");
+        LOG_D("MQTT: Publish OK");
     } else {
         int st = _mqtt.state();
-        Serial.printf("MQTT: Publish FAILED, state=%d\n", st);
-        Serial.println("MQTT: Forcing disconnect and reconnect after publish failure");
+        LOG_W("MQTT: Publish FAILED, state=%d, forcing disconnect and reconnect", st);
+        MaxFanMetrics::mqttPublishFailures.inc();
         // Properly disconnect PubSubClient first
         _mqtt.disconnect();
         // Stop underlying client socket
@@ -136,6 +155,27 @@ void MqttController::loop() {
     ensureConnected();
     if (_mqtt.connected()) {
         _mqtt.loop();
+        publishMetrics();
+    }
+}
+
+void MqttController::publishMetrics() {
+    uint32_t now = millis();
+    if (_lastMetricsMs != 0 && now - _lastMetricsMs < MaxFanMetrics::PUBLISH_INTERVAL_MS) return;
+    _lastMetricsMs = now | 1;
+
+    char json[MaxFanMetrics::SNAPSHOT_SIZE];
+    size_t len = Metrics::snapshot(json, sizeof(json));
+    if (len == 0) return;
+    // Am Puffer von PubSubClient vorbei streamen: der Snapshot ist größer als MQTT_MAX_PACKET_SIZE
+    char topic[sizeof(GlobalConfig.mqttStateTopic) + 8];
+    snprintf(topic, sizeof(topic), "%s/diag", GlobalConfig.mqttStateTopic);
+    bool ok = _mqtt.beginPublish(topic, len, false)
+              && _mqtt.write((const uint8_t*)json, len) == len
+              && _mqtt.endPublish();
+    if (!ok) {
+        MaxFanMetrics::mqttPublishFailures.inc();
+        LOG_W("MQTT: Diagnostics publish failed");
     }
 }
 
@@ -168,15 +208,29 @@ void MqttController::mqttCallbackStatic(char* topic, byte* payload, unsigned int
 }
 
 void MqttController::mqttCallback(char* topic, byte* payload, unsigned int length) {
-    Serial.printf("MQTT: Message arrived topic=%s len=%u\n", topic, length);
-    String s;
-    for (unsigned int i = 0; i < length; i++) s += (char)payload[i];
-    Serial.printf("MQTT: Payload=%s\n", s.c_str());
+    // Firmware-Chunks sind binär und groß: nicht loggen, direkt weiter
+    if (_otaReceiver) {
+        String prefix = otaTopic("/");
+        if (strncmp(topic, prefix.c_str(), prefix.length()) == 0) {
+            _otaReceiver->onMessage(topic + prefix.length(), payload, length);
+            return;
+        }
+    }
+
+    LOG_D("MQTT: Message arrived topic=%s len=%u", topic, length);
+    if (length > FanController::MAX_COMMAND) {
+        LOG_W("MQTT: Command too long (%u bytes), ignored", length);
+        return;
+    }
+    char json[FanController::MAX_COMMAND + 1];
+    memcpy(json, payload, length);
+    json[length] = '\0';
+    LOG_D("MQTT: Payload=%s", json);
     if (_onCommandReceived == nullptr) {
-        Serial.println("MQTT: No command callback registered");
+        LOG_W("MQTT: No command callback registered");
         return;
     }
-    _onCommandReceived(s);
+    _onCommandReceived(json);
 }
 
 bool MqttController::isValidTopic(const char* topic) {
@@ -189,3 +243,38 @@ bool MqttController::isValidTopic(const char* topic) {
     }
     return true;
 }
+
+String MqttController::otaTopic(const char* suffix) const {
+    return String(GlobalConfig.mqttCommandTopic) + "/ota" + suffix;
+}
+
+void MqttController::subscribeOta() {
+    bool ok = _mqtt.subscribe(otaTopic("/+").c_str());
+    LOG_I("MQTT: OTA topics %s, subscribed=%d", otaTopic("/+").c_str(), (int)ok);
+}
+
+void MqttController::setOtaReceiver(MqttOtaReceiver* receiver) {
+    if (receiver == _otaReceiver) return;
+    _otaReceiver = receiver;
+
+    if (receiver) {
+        _mqtt.setBufferSize(MqttOtaReceiver::BUFFER_SIZE);
+        if (_mqtt.connected()) subscribeOta();
+    } else {
+        if (_mqtt.connected()) _mqtt.unsubscribe(otaTopic("/+").c_str());
+        _mqtt.setBufferSize(MQTT_MAX_PACKET_SIZE);
+    }
+}
+
+bool MqttController::publishOta(const char* json) {
+    if (!_mqtt.connected()) return false;
+    String topic = String(GlobalConfig.mqttStateTopic) + "/ota";
+    return _mqtt.publish(topic.c_str(), json);
+}
+
+void MqttController::pump(uint8_t maxPackets) {
+    for (uint8_t i = 0; i < maxPackets; i++) {
+        if (!_mqtt.connected() || !_wifiClient.available()) break;
+        _mqtt.loop();
+    }
+}
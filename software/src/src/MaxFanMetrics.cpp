@@ -0,0 +1,46 @@
+#include "MaxFanMetrics.h"
+#include "Log.h"
+#include "DisplayFlush.h"
+#include <Arduino.h>
+#include <WiFi.h>
+
+static int32_t readUptime() { return (int32_t)(millis() / 1000); }
+static int32_t readFreeHeap() { return (int32_t)ESP.getFreeHeap(); }
+static int32_t readMinFreeHeap() { return (int32_t)ESP.getMinFreeHeap(); }
+static int32_t readLargestBlock() { return (int32_t)ESP.getMaxAllocHeap(); }
+static int32_t readRssi() { return WiFi.status() == WL_CONNECTED ? WiFi.RSSI() : 0; }
+static int32_t readLogDropped() { return (int32_t)Log::dropped(); }
+static int32_t readDisplayStall() { return (int32_t)DisplayFlush::maxStallUs(); }
+
+// Reihenfolge = Reihenfolge im Snapshot. Namen kurz halten: der Snapshot muss in SNAPSHOT_SIZE
+// und in eine BLE-Characteristic (512 Bytes) passen.
+namespace MaxFanMetrics {
+
+    Gauge uptime("up", readUptime);
+    Gauge freeHeap("heap", readFreeHeap);
+    Gauge minFreeHeap("heapMin", readMinFreeHeap);
+    Gauge largestBlock("heapBlock", readLargestBlock);
+    Gauge wifiRssi("rssi", readRssi);
+
+    Counter irSent("irTx");
+    Counter irReceived("irRx");
+    Counter irRejectStart("irRejStart");
+    Counter irRejectStop("irRejStop");
+    Counter irRejectShort("irRejShort");
+    Counter irRejectHeader("irRejHdr");
+    Counter irRejectChecksum("irRejCrc");
+
+    Counter bleConnects("bleConn");
+    Counter bleBonds("bleBond");
+    Counter bleBondFailures("bleBondFail");
+
+    Counter mqttConnects("mqttConn");
+    Counter mqttConnectFailures("mqttConnFail");
+    Counter mqttPublishFailures("mqttPubFail");
+
+    Counter displayFrames("dispFrames");
+    Counter displayDropped("dispDrop");
+    Gauge displayStall("dispStall", readDisplayStall);
+
+    Gauge logDropped("logDrop", readLogDropped);
+}
@@ -0,0 +1,177 @@
+#include "MaxFanSerial.h"
+#include "Log.h"
+
+SerialController* SerialController::instance = nullptr;
+
+SerialController::SerialController(Stream& port)
+    : _port(port), _onCommandReceived(nullptr),
+      _rxLength(0), _rxOverflow(false), _txSeq(0), _txLock(nullptr), _logSeq(0),
+      _lastFrameMs(0), _hostSeen(false), _hasState(false),
+      _rxFrames(0), _rxErrors(0), _rxOverflows(0), _txFrames(0), _txDropped(0), _logDropped(0)
+{
+}
+
+void SerialController::begin(const char* deviceName) {
+    (void)deviceName;
+    // Der Port läuft schon (Serial.begin() in setup()); hier nur den Empfang zurücksetzen
+    _rxLength = 0;
+    _rxOverflow = false;
+    if (!_txLock) _txLock = xSemaphoreCreateMutex();
+    // Ab jetzt gehen alle Log-Meldungen als Rahmen auf Kanal LOG raus
+    instance = this;
+    Log::setSink(logSink);
+    LOG_I("Serial: Steuerung aktiv");
+}
+
+void SerialController::setCommandCallback(FanController::CommandCallback callback) {
+    _onCommandReceived = callback;
+}
+
+void SerialController::loop() {
+    for (size_t budget = RX_BUDGET; budget > 0 && _port.available() > 0; budget--) {
+        int c = _port.read();
+        if (c < 0) break;
+        receive((uint8_t)c);
+    }
+}
+
+void SerialController::receive(uint8_t c) {
+    if (c != 0) {
+        if (_rxLength < sizeof(_rx)) {
+            _rx[_rxLength++] = c;
+        } else if (!_rxOverflow) {
+            _rxOverflow = true;
+            _rxOverflows++;
+        }
+        return;
+    }
+
+    // Trenner: leere Rahmen (doppelte 0x00) ignorieren
+    if (_rxLength > 0 && !_rxOverflow) {
+        SerialFrame::Frame frame;
+        if (SerialFrame::decode(_rx, _rxLength, frame)) {
+            _rxFrames++;
+            _lastFrameMs = millis();
+            _hostSeen = true;
+            handleFrame(frame);
+        } else {
+            _rxErrors++;
+        }
+    }
+    _rxLength = 0;
+    _rxOverflow = false;
+}
+
+void SerialController::handleFrame(const SerialFrame::Frame& frame) {
+    if (frame.channel != SerialFrame::CHANNEL_CONTROL) {
+        sendAck(frame.seq, SerialFrame::ACK_UNKNOWN_TYPE);
+        return;
+    }
+
+    switch (frame.type) {
+        case SerialFrame::TYPE_COMMAND: {
+            if (frame.length == 0) {
+                sendAck(frame.seq, SerialFrame::ACK_INVALID);
+                return;
+            }
+            char json[SerialFrame::MAX_DATA + 1];
+            memcpy(json, frame.data, frame.length);
+            json[frame.length] = '\0';
+            // Der Status kommt mit dem nächsten notifyStatus(), wenn sich etwas geändert hat
+            sendAck(frame.seq, SerialFrame::ACK_OK);
+            if (_onCommandReceived) _onCommandReceived(json);
+            break;
+        }
+        case SerialFrame::TYPE_GET_STATUS:
+            if (_hasState) {
+                sendStatus(frame.seq, _lastState);
+            } else {
+                sendAck(frame.seq, SerialFrame::ACK_INVALID);
+            }
+            break;
+        case SerialFrame::TYPE_GET_DIAG:
+            sendDiag(frame.seq);
+            break;
+        case SerialFrame::TYPE_PING:
+            send(SerialFrame::CHANNEL_CONTROL, SerialFrame::TYPE_PONG, frame.seq, frame.data, frame.length);
+            break;
+        default:
+            sendAck(frame.seq, SerialFrame::ACK_UNKNOWN_TYPE);
+            break;
+    }
+}
+
+void SerialController::notifyStatus(const MaxFanState& currentState) {
+    if (_hasState && currentState == _lastState) return;
+    _lastState = currentState;
+    _hasState = true;
+    sendStatus(_txSeq++, currentState);
+}
+
+bool SerialController::isConnected() {
+    return _hostSeen && millis() - _lastFrameMs < HOST_TIMEOUT_MS;
+}
+
+bool SerialController::send(uint8_t channel, uint8_t type, uint8_t seq, const uint8_t* data, size_t length) {
+    if (length > SerialFrame::MAX_DATA) length = SerialFrame::MAX_DATA;
+    SerialFrame::Frame frame = { channel, type, seq, (uint8_t)length, data };
+    size_t n = SerialFrame::encode(frame, _tx, sizeof(_tx));
+    if (n == 0) {
+        _txDropped++;
+        return false;
+    }
+    // Nicht blockieren: ohne lesenden Host ist der USB-Puffer schnell voll
+    xSemaphoreTake(_txLock, portMAX_DELAY);
+    bool fits = _port.availableForWrite() >= (int)n;
+    if (fits) _port.write(_tx, n);
+    xSemaphoreGive(_txLock);
+    if (!fits) {
+        _txDropped++;
+        return false;
+    }
+    _txFrames++;
+    return true;
+}
+
+void SerialController::sendAck(uint8_t seq, uint8_t status) {
+    send(SerialFrame::CHANNEL_CONTROL, SerialFrame::TYPE_ACK, seq, &status, 1);
+}
+
+void SerialController::sendStatus(uint8_t seq, const MaxFanState& state) {
+    const char* json = FanController::statusJson(state);
+    send(SerialFrame::CHANNEL_CONTROL, SerialFrame::TYPE_STATUS, seq, (const uint8_t*)json, strlen(json));
+}
+
+void SerialController::sendDiag(uint8_t seq) {
+    char json[SerialFrame::MAX_DATA];
+    int n = snprintf(json, sizeof(json),
+                     "{\"uptimeMs\":%lu,\"freeHeap\":%lu,\"minFreeHeap\":%lu,\"rxFrames\":%lu,"
+                     "\"rxErrors\":%lu,\"rxOverflows\":%lu,\"txFrames\":%lu,\"txDropped\":%lu,"
+                     "\"logDropped\":%lu,\"logQueueDropped\":%lu}",
+                     (unsigned long)millis(), (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMinFreeHeap(),
+                     (unsigned long)_rxFrames, (unsigned long)_rxErrors, (unsigned long)_rxOverflows,
+                     (unsigned long)_txFrames, (unsigned long)_txDropped,
+                     (unsigned long)_logDropped, (unsigned long)Log::dropped());
+    if (n < 0) return;
+    send(SerialFrame::CHANNEL_CONTROL, SerialFrame::TYPE_DIAG, seq, (const uint8_t*)json, min((size_t)n, sizeof(json) - 1));
+}
+
+// --- Kanal LOG ---
+
+// Läuft im Log-Task oder in Log::flush(), also nicht nur in einem Task: eigener Puffer,
+// Sequenznummer und Schreiben unter _txLock
+void SerialController::logSink(uint8_t level, const char* line, size_t length) {
+    (void)level;
+    SerialController* self = instance;
+    uint8_t frame[SerialFrame::MAX_ENCODED];
+
+    xSemaphoreTake(self->_txLock, portMAX_DELAY);
+    SerialFrame::Frame f = { SerialFrame::CHANNEL_LOG, SerialFrame::TYPE_LOG_TEXT, self->_logSeq++,
+                             (uint8_t)(length > SerialFrame::MAX_DATA ? SerialFrame::MAX_DATA : length),
+                             (const uint8_t*)line };
+    size_t n = SerialFrame::encode(f, frame, sizeof(frame));
+    bool fits = n > 0 && self->_port.availableForWrite() >= (int)n;
+    if (fits) self->_port.write(frame, n);
+    else self->_logDropped++;
+    xSemaphoreGive(self->_txLock);
+}
@@ -1,5 +1,6 @@
 #include "MaxFanState.h"
 #include "MaxRemote.h"  // For pattern constants and temperature mappings
+#include "Log.h"
 #include <stdlib.h>  // for strtol
 
 #define MAXFAN_BIT_ON         0  // Lüfter an/aus
@@ -135,14 +136,13 @@ void MaxFanState::SetBytes(uint8_t state, uint8_t speed, uint8_t tempF) {
 }
 
 // Set from JSON string (for BLE reception)
-MaxError MaxFanState::SetJson(const String& jsonString) {
+MaxError MaxFanState::SetJson(const char* json) {
     // Reserviere Puffer (StaticJsonDocument auf Stack -> kein Heap-Stress)
     StaticJsonDocument<256> doc;
-    DeserializationError error = deserializeJson(doc, jsonString);
+    DeserializationError error = deserializeJson(doc, json);
   
     if (error) {
-        Serial.print("JSON Parse Error: ");
-        Serial.println(error.c_str());
+        LOG_W("JSON Parse Error: %s", error.c_str());
         return MaxError::BLE_PARSE_ERROR; // Fehlercode: Ungültiges JSON
     }
 
@@ -158,13 +158,13 @@ MaxError MaxFanState::SetJson(const String& jsonString) {
     if (doc.containsKey("mode")) {
         // 1. Typ-Check: Ist es ein String?
         if (!doc["mode"].is<const char*>()) {
-            Serial.println("Err: 'mode' must be string"); 
+            LOG_W("Err: 'mode' must be string");
             return MaxError::BLE_INVALID_MODE; 
         }
         // 2. Inhalt-Check: Ist der String gültig?
         const char* s = doc["mode"];
         if (!tryParseFanMode(s, newMode)) {
-            Serial.print("Err: Invalid mode value: "); Serial.println(s);
+            LOG_W("Err: Invalid mode value: %s", s);
             return MaxError::BLE_INVALID_MODE;
         }
         hasMode = true;
@@ -175,12 +175,12 @@ MaxError MaxFanState::SetJson(const String& jsonString) {
     bool hasCover = false;
     if (doc.containsKey("cover")) {
         if (!doc["cover"].is<const char*>()) {
-            Serial.println("Err: 'cover' must be string");
+            LOG_W("Err: 'cover' must be string");
             return MaxError::BLE_INVALID_COVER;
         }
         const char* s = doc["cover"];
         if (!tryParseCoverState(s, newCover)) {
-            Serial.print("Err: Invalid cover value: "); Serial.println(s);
+            LOG_W("Err: Invalid cover value: %s", s);
             return MaxError::BLE_INVALID_COVER;
         }
         hasCover = true;
@@ -238,16 +238,14 @@ MaxError MaxFanState::SetJson(const String& jsonString) {
     return MaxError::NONE;
 }
 // Convert to JSON string (for BLE transmission)
-String MaxFanState::ToJson() const {
+size_t MaxFanState::ToJson(char* out, size_t size) const {
   StaticJsonDocument<200> doc;
   doc["mode"] = toString(GetMode());
   doc["cover"] = toString(GetCover());
   doc["airflow"] = toString(GetAirFlow());
   doc["speed"] = GetSpeed();
   doc["temperature"] = GetTempCelsius();
-  String jsonString;
-  serializeJson(doc, jsonString);
-  return jsonString;
+  return serializeJson(doc, out, size);
 }
 
 
@@ -0,0 +1,241 @@
+#include "MaxFanWiFi.h"
+#include "Log.h"
+#include <Preferences.h>
+#include <esp_attr.h>
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+#include <time.h>
+
+// Zeit, die der direkte Connect (bekannter AP + statische IP) bekommt,
+// bevor auf den vollen Scan + DHCP zurückgefallen wird.
+static const uint32_t WARM_TIMEOUT_MS = 3000;
+static const uint32_t LEASE_MAGIC = 0x4D465732; // "MFW2"
+// Nach so vielen Warm-Connects in Folge wieder DHCP. Nach Power-On ist die Uhr nicht gestellt,
+// das Alter des Leases ist dann unbekannt; so wird er spätestens hier erneuert. Gezählt wird nur
+// im RTC-Speicher (ab Power-On von 0), ein NVS-Schreibvorgang pro Boot wäre teurer als der DHCP.
+static const uint8_t MAX_WARM_CONNECTS = 8;
+// Wenn der DHCP-Server keine Lease-Zeit liefert
+static const uint32_t DEFAULT_LEASE_S = 3600;
+// time() davor = Uhr nicht gestellt (wie TimerVentilationController)
+static const time_t CLOCK_VALID_AFTER = 1700000000;
+
+struct WiFiLease {
+    uint32_t magic;
+    uint32_t ssidHash;
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t ip;
+    uint32_t gateway;
+    uint32_t subnet;
+    uint32_t dns;
+    uint32_t obtainedAt;    // Unix-Zeit des DHCP-Leases, 0 = Uhr war nicht gestellt
+    uint32_t leaseSeconds;
+    uint8_t warmConnects;   // seit dem letzten DHCP, nur im RTC-Speicher aktuell (im NVS immer 0)
+};
+
+// Überlebt Soft-Resets und Deep-Sleep; nach Power-On kommt der Lease aus dem NVS.
+RTC_NOINIT_ATTR static WiFiLease rtcLease;
+
+static WiFiConnector::Status status = WiFiConnector::Status::IDLE;
+static const char* pendingSsid = nullptr;
+static const char* pendingPassword = nullptr;
+static uint32_t startMs = 0;
+static uint32_t phaseStartMs = 0;
+static uint32_t totalTimeoutMs = 0;
+
+// FNV-1a, reicht um zu erkennen, ob der Cache zur aktuellen SSID gehört
+static uint32_t hashSsid(const char* ssid) {
+    uint32_t h = 2166136261u;
+    for (const char* p = ssid; *p; ++p) {
+        h ^= (uint8_t)*p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static bool clockValid() {
+    return time(nullptr) > CLOCK_VALID_AFTER;
+}
+
+// Lease-Zeit aus dem DHCP-Client von lwIP (Arduino reicht sie nicht durch)
+static uint32_t dhcpLeaseSeconds() {
+    esp_netif_t* netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    if (!netif) return DEFAULT_LEASE_S;
+    struct netif* lwip = (struct netif*)esp_netif_get_netif_impl(netif);
+    struct dhcp* dhcp = lwip ? netif_dhcp_data(lwip) : nullptr;
+    if (!dhcp || dhcp->offered_t0_lease == 0) return DEFAULT_LEASE_S;
+    return dhcp->offered_t0_lease;
+}
+
+// Wie der DHCP-Client selbst: ab der halben Lease-Zeit (T1) neu holen
+static bool leaseExpired(const WiFiLease& lease) {
+    if (lease.warmConnects >= MAX_WARM_CONNECTS) {
+        LOG_I("WiFi: Lease used for %u warm connects, renewing via DHCP", lease.warmConnects);
+        return true;
+    }
+    if (lease.obtainedAt == 0 || !clockValid()) return false;
+    uint32_t age = (uint32_t)time(nullptr) - lease.obtainedAt;
+    if (age < lease.leaseSeconds / 2) return false;
+    LOG_I("WiFi: Lease is %lu s old (lease time %lu s), renewing via DHCP",
+          (unsigned long)age, (unsigned long)lease.leaseSeconds);
+    return true;
+}
+
+static void saveLease(const WiFiLease& lease) {
+    Preferences prefs;
+    prefs.begin("wifi", false);
+    prefs.putBytes("lease", &lease, sizeof(lease));
+    prefs.end();
+}
+
+static bool loadLease(const char* ssid) {
+    uint32_t hash = hashSsid(ssid);
+    if (rtcLease.magic == LEASE_MAGIC && rtcLease.ssidHash == hash) {
+        return true;
+    }
+
+    Preferences prefs;
+    prefs.begin("wifi", true);
+    WiFiLease stored;
+    size_t len = prefs.getBytes("lease", &stored, sizeof(stored));
+    prefs.end();
+
+    if (len != sizeof(stored) || stored.magic != LEASE_MAGIC || stored.ssidHash != hash) {
+        return false;
+    }
+    rtcLease = stored;
+    rtcLease.warmConnects = 0;  // ältere Firmware hat den Zähler mitgeschrieben
+    return true;
+}
+
+void WiFiConnector::begin(const char* ssid, const char* password, uint32_t timeoutMs) {
+    pendingSsid = ssid;
+    pendingPassword = password;
+    totalTimeoutMs = timeoutMs;
+    startMs = millis();
+    phaseStartMs = startMs;
+
+    // Die Credentials liegen in der ConfigData, das SDK muss sie nicht zusätzlich in den Flash schreiben
+    WiFi.persistent(false);
+    WiFi.mode(WIFI_STA);
+
+    if (!loadLease(ssid) || leaseExpired(rtcLease)) {
+        startCold();
+        return;
+    }
+
+    LOG_I("WiFi: Warm connect to %s (ch %u, %02X:%02X:%02X:%02X:%02X:%02X)",
+          ssid, rtcLease.channel,
+          rtcLease.bssid[0], rtcLease.bssid[1], rtcLease.bssid[2],
+          rtcLease.bssid[3], rtcLease.bssid[4], rtcLease.bssid[5]);
+
+    WiFi.config(IPAddress(rtcLease.ip), IPAddress(rtcLease.gateway),
+                IPAddress(rtcLease.subnet), IPAddress(rtcLease.dns));
+    WiFi.begin(ssid, password, rtcLease.channel, rtcLease.bssid, true);
+    status = Status::CONNECTING_WARM;
+}
+
+void WiFiConnector::startCold() {
+    LOG_I("WiFi: Cold connect to %s (scan + DHCP)", pendingSsid);
+
+    // Statische IP wieder aus -> DHCP
+    WiFi.config(IPAddress((uint32_t)0), IPAddress((uint32_t)0), IPAddress((uint32_t)0));
+    WiFi.begin(pendingSsid, pendingPassword);
+    phaseStartMs = millis();
+    status = Status::CONNECTING_COLD;
+}
+
+WiFiConnector::Status WiFiConnector::poll() {
+    if (status != Status::CONNECTING_WARM && status != Status::CONNECTING_COLD) {
+        return status;
+    }
+
+    uint32_t now = millis();
+
+    if (WiFi.status() == WL_CONNECTED) {
+        bool warm = (status == Status::CONNECTING_WARM);
+        LOG_I("WiFi: Connected (%s) in %lu ms, IP: %s",
+              warm ? "warm" : "cold",
+              (unsigned long)(now - startMs),
+              WiFi.localIP().toString().c_str());
+        if (warm) {
+            // Zählt bis zum nächsten DHCP; nur RTC, der Lease selbst ist unverändert
+            rtcLease.warmConnects++;
+        } else {
+            storeLease();
+        }
+        status = Status::CONNECTED;
+        return status;
+    }
+
+    if (status == Status::CONNECTING_WARM && now - phaseStartMs >= WARM_TIMEOUT_MS) {
+        LOG_W("WiFi: Warm connect failed, falling back to full scan");
+        WiFi.disconnect();
+        rtcLease.magic = 0;
+        startCold();
+        return status;
+    }
+
+    if (now - startMs >= totalTimeoutMs) {
+        LOG_W("WiFi: Connect failed after %lu ms", (unsigned long)(now - startMs));
+        WiFi.disconnect();
+        status = Status::FAILED;
+    }
+    return status;
+}
+
+bool WiFiConnector::connect(const char* ssid, const char* password, uint32_t timeoutMs) {
+    if (WiFi.status() == WL_CONNECTED) return true;
+
+    begin(ssid, password, timeoutMs);
+    Status st = poll();
+    while (st == Status::CONNECTING_WARM || st == Status::CONNECTING_COLD) {
+        delay(10);
+        st = poll();
+    }
+    return st == Status::CONNECTED;
+}
+
+void WiFiConnector::cancel() {
+    if (status == Status::CONNECTING_WARM || status == Status::CONNECTING_COLD) {
+        LOG_I("WiFi: Connect cancelled");
+        WiFi.disconnect();
+    }
+    status = Status::IDLE;
+}
+
+void WiFiConnector::storeLease() {
+    WiFiLease lease;
+    memset(&lease, 0, sizeof(lease));
+    lease.magic = LEASE_MAGIC;
+    lease.ssidHash = hashSsid(pendingSsid);
+    memcpy(lease.bssid, WiFi.BSSID(), sizeof(lease.bssid));
+    lease.channel = (uint8_t)WiFi.channel();
+    lease.ip = (uint32_t)WiFi.localIP();
+    lease.gateway = (uint32_t)WiFi.gatewayIP();
+    lease.subnet = (uint32_t)WiFi.subnetMask();
+    lease.dns = (uint32_t)WiFi.dnsIP(0);
+    lease.obtainedAt = clockValid() ? (uint32_t)time(nullptr) : 0;
+    lease.leaseSeconds = dhcpLeaseSeconds();
+    lease.warmConnects = 0;
+
+    // Der Zähler der Warm-Connects gehört nicht zum Lease
+    WiFiLease previous = rtcLease;
+    previous.warmConnects = 0;
+    bool unchanged = (memcmp(&lease, &previous, sizeof(lease)) == 0);
+    rtcLease = lease;
+    if (unchanged) return;
+
+    // Nur schreiben wenn sich was geändert hat, der NVS soll nicht bei jedem Boot verschleißen
+    saveLease(lease);
+    LOG_D("WiFi: Lease cached");
+}
+
+void WiFiConnector::forget() {
+    rtcLease.magic = 0;
+    Preferences prefs;
+    prefs.begin("wifi", false);
+    prefs.remove("lease");
+    prefs.end();
+}
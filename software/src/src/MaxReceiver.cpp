@@ -1,4 +1,6 @@
 #include "MaxReceiver.h"
+#include "Log.h"
+#include "MaxFanMetrics.h"
 using namespace MaxFan;
 
 
@@ -27,22 +29,18 @@ bool MaxReceiver::update(MaxFanState & maxFanState) {
     if (this->parseToBytes(data)) {
 
       maxFanState.SetBytes(data[10], data[11], data[12]);
-      Serial.print("OK");
+      MaxFanMetrics::irReceived.inc();
+      LOG_D("IR: OK");
       success = true;
     } else {
-      Serial.print("XX! Typ: ");
-      Serial.print(results.decode_type); 
-      Serial.print(" Bits: ");
-      Serial.println(results.bits);
+      LOG_D("IR: XX! type: %d bits: %u", (int)results.decode_type, (unsigned)results.bits);
       // Das ist entscheidend:
       if (results.bits == 0 && results.decode_type == -1) {
-        Serial.println("-> Geister-Trigger (Rauschen)");
+        LOG_D("IR: -> ghost trigger (noise)");
       }
 }
     resume();
   }
-  if(success)
-    Serial.print("-");
   return success;  
 }
 
@@ -77,7 +75,8 @@ bool MaxReceiver::parseToBytes(uint8_t* output16Bytes) {
     for (int j = 0; j < ticks; j++) {
 
       if (bitInFrame == 0 && currentBit) {
-        Serial.printf ("startbit != 0 on idx %d", byteCount);
+        LOG_D("IR: startbit != 0 on idx %d", byteCount);
+        MaxFanMetrics::irRejectStart.inc();
         return false; 
       }
       
@@ -90,7 +89,8 @@ bool MaxReceiver::parseToBytes(uint8_t* output16Bytes) {
 
       // 3. Stopbits (9-10)
       if ((bitInFrame == 9 || bitInFrame == 10) && !currentBit) {
-        Serial.printf("stopbit != 1 on idx %d", byteCount);
+        LOG_D("IR: stopbit != 1 on idx %d", byteCount);
+        MaxFanMetrics::irRejectStop.inc();
         return false;
       }
       bitInFrame++;
@@ -107,6 +107,7 @@ bool MaxReceiver::parseToBytes(uint8_t* output16Bytes) {
 
   // Daten gelesen
   if(byteCount<15){
+    MaxFanMetrics::irRejectShort.inc();
     return false; // zu wenig Daten erhalten
   }
    
@@ -122,7 +123,8 @@ bool MaxReceiver::parseToBytes(uint8_t* output16Bytes) {
   for (int idx=0; idx<10; idx++)
   {
     if(HEADER[idx] != output16Bytes[idx]){
-      Serial.println("header mismatch");
+      LOG_D("IR: header mismatch");
+      MaxFanMetrics::irRejectHeader.inc();
       return false;
     }
   }
@@ -131,36 +133,16 @@ bool MaxReceiver::parseToBytes(uint8_t* output16Bytes) {
   // Daten sollten jetzt korrigiert sein
   uint8_t xorVal = output16Bytes[10] ^ output16Bytes[11] ^ output16Bytes[12] ^ output16Bytes[13] ^ output16Bytes[14];
   if (output16Bytes[15] != xorVal){
-    Serial.println("--checksum--");
-    Serial.println(output16Bytes[10], BIN);
-    Serial.println(output16Bytes[11], BIN);
-    Serial.println(output16Bytes[12], BIN);
-    Serial.println(output16Bytes[13], BIN);
-    Serial.println(output16Bytes[14], BIN);
-    Serial.println("-----");
-    Serial.println(output16Bytes[15], BIN);
-    Serial.println(xorVal, BIN);
-    Serial.flush();
+    LOG_D("IR: checksum %02x %02x %02x %02x %02x -> %02x, expected %02x",
+          output16Bytes[10], output16Bytes[11], output16Bytes[12], output16Bytes[13], output16Bytes[14],
+          output16Bytes[15], xorVal);
+    MaxFanMetrics::irRejectChecksum.inc();
     return false;
   } else {
-    Serial.println();
-    Serial.print("STATE:");
-    Serial.print(output16Bytes[10], BIN);
-    Serial.printf(" SPEED:");
-    Serial.print(output16Bytes[11]);
-    Serial.printf(" TEMP:");
-    Serial.print(output16Bytes[12]);
-    Serial.printf(" F13:");
-    Serial.print(output16Bytes[13]);
-    Serial.printf(" F14:");
-    Serial.print(output16Bytes[14]);
-
-    
-
+    LOG_D("IR: STATE:%02x SPEED:%u TEMP:%u F13:%u F14:%u",
+          output16Bytes[10], output16Bytes[11], output16Bytes[12], output16Bytes[13], output16Bytes[14]);
     return true;
   }
-  Serial.print("fall out");
-  return false;
 
 }
 
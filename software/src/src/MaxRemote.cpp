@@ -1,5 +1,7 @@
 #include "MaxRemote.h"
 #include "MaxReceiver.h"
+#include "Log.h"
+#include "MaxFanMetrics.h"
 #include <stdlib.h>  // for strtol
 using namespace MaxFan;
 #include <vector>
@@ -40,7 +42,7 @@ void MaxRemote::send(MaxFanState& state) {
   // zustand merken, damit derselbe Zustand nicht x-fach übermittelt wird
   lastSentState.SetBytes(state.GetStateByte(), state.GetSpeedByte(), state.GetTempByte());
 
-  Serial.println("Changes detected, sending via IR...");
+  LOG_I("IR: Changes detected, sending...");
 
   // Daten zusammenstellen in einen Array
    uint8_t data[17];
@@ -93,18 +95,11 @@ void MaxRemote::send(MaxFanState& state) {
   unsigned long start = millis();
 
   irsend.sendRaw(durations.data(), durations.size(), FREQ / 1000);
+  MaxFanMetrics::irSent.inc();
   unsigned long end = millis();
 
-  Serial.print("\nsending durations: ");
-  for (int i=0; i<durations.size();i++) {
-      Serial.print(durations.at(i));
-      Serial.print(" ");
-  }
-  Serial.print("\nsent in ");
-  Serial.print(end-start);
-  Serial.println();
-
-  Serial.println(lastSentState.ToJson());
+  LOG_D("IR: sent %u durations in %lu ms, state %02x speed %u temp %u", (unsigned)durations.size(), end - start,
+        lastSentState.GetStateByte(), lastSentState.GetSpeedByte(), lastSentState.GetTempByte());
 }
 
 
@@ -0,0 +1,454 @@
+#include "MenuEngine.h"
+#include "DisplayFlush.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Monospace, 7 px hoch: passt mit Unterlänge in eine Tile-Zeile
+#define MENU_FONT u8g2_font_5x7_tf
+static constexpr int BASELINE = 6;
+static constexpr int MARGIN = 2;
+
+// Reihenfolge beim Durchdrehen eines Zeichens (wie GEMs "adjusted ASCII order"):
+// Leerzeichen zuerst, dann Buchstaben und Ziffern, Sonderzeichen zuletzt
+static const char CHARSET[] =
+    " abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789"
+    ".-_:/@#!?$%&*+=,;~^'\"()[]{}<>|\\`";
+
+MenuEngine::MenuEngine(U8G2& display, const MenuPage* pages, uint8_t pageCount, void* model)
+    : _display(display),
+      _pages(pages),
+      _pageCount(pageCount > MAX_PAGES ? MAX_PAGES : pageCount),
+      _model((uint8_t*)model),
+      _page(0),
+      _listPage(NO_PAGE),
+      _listTitle(nullptr),
+      _listLabels(nullptr),
+      _listCount(0),
+      _listAction(nullptr),
+      _editing(false),
+      _editPos(0),
+      _editOption(0),
+      _dirtyAll(true),
+      _dirtyRows(0)
+{
+    memset(_cursor, 0, sizeof(_cursor));
+    memset(_top, 0, sizeof(_top));
+    _editText[0] = '\0';
+}
+
+// -----------------------------------------------------------
+// SEITEN
+// -----------------------------------------------------------
+
+void MenuEngine::setPage(uint8_t page) {
+    if (page >= _pageCount) return;
+    _page = page;
+    _editing = false;
+
+    uint8_t count = itemCount();
+    uint8_t& cursor = _cursor[_page];
+    uint8_t& top = _top[_page];
+    if (cursor >= count) cursor = count ? count - 1 : 0;
+    if (cursor < top) top = cursor;
+    if (cursor >= top + VISIBLE_ROWS) top = cursor - VISIBLE_ROWS + 1;
+    _dirtyAll = true;
+}
+
+void MenuEngine::setPage(uint8_t page, uint8_t cursor) {
+    if (page >= _pageCount) return;
+    _cursor[page] = cursor;
+    setPage(page);
+}
+
+void MenuEngine::setList(uint8_t page, const char* title, const char* const* labels, uint8_t count,
+                         MenuListAction action) {
+    _listPage = page;
+    _listTitle = title;
+    _listLabels = labels;
+    _listCount = count;
+    _listAction = action;
+    if (page == _page) setPage(_page);
+}
+
+void MenuEngine::clearList() {
+    uint8_t page = _listPage;
+    _listPage = NO_PAGE;
+    _listTitle = nullptr;
+    _listLabels = nullptr;
+    _listCount = 0;
+    _listAction = nullptr;
+    if (page == _page) setPage(_page);
+}
+
+uint8_t MenuEngine::itemCount() const {
+    return _pages[_page].count + (_listPage == _page ? _listCount : 0);
+}
+
+const MenuItem* MenuEngine::item(uint8_t index) const {
+    uint8_t listCount = (_listPage == _page) ? _listCount : 0;
+    if (index < listCount) return nullptr;
+    return &_pages[_page].items[index - listCount];
+}
+
+const char* MenuEngine::itemTitle(uint8_t index) const {
+    const MenuItem* entry = item(index);
+    return entry ? entry->title : _listLabels[index];
+}
+
+const char* MenuEngine::pageTitle() const {
+    return (_listPage == _page && _listTitle) ? _listTitle : _pages[_page].title;
+}
+
+// -----------------------------------------------------------
+// TASTEN
+// -----------------------------------------------------------
+
+void MenuEngine::press(Key key) {
+    if (_editing) {
+        editKey(*item(_cursor[_page]), key);
+        return;
+    }
+    switch (key) {
+        case Key::UP:     moveCursor(-1); break;
+        case Key::DOWN:   moveCursor(1); break;
+        case Key::OK:     activate(); break;
+        case Key::CANCEL:
+            if (_pages[_page].parent != NO_PAGE) setPage(_pages[_page].parent);
+            break;
+        default: break;
+    }
+}
+
+void MenuEngine::moveCursor(int step) {
+    uint8_t count = itemCount();
+    if (count < 2) return;
+    uint8_t& cursor = _cursor[_page];
+    uint8_t& top = _top[_page];
+
+    uint8_t previous = cursor;
+    cursor = (cursor + count + step) % count;   // am Ende weiter zum Anfang, wie bei GEM
+
+    if (cursor < top || cursor >= top + VISIBLE_ROWS) {
+        top = cursor < top ? cursor : cursor - VISIBLE_ROWS + 1;
+        _dirtyAll = true;   // gescrollt
+        return;
+    }
+    markRow(previous);
+    markRow(cursor);
+}
+
+void MenuEngine::activate() {
+    uint8_t index = _cursor[_page];
+    const MenuItem* entry = item(index);
+    if (!entry) {
+        // Listeneintrag: die Aktion kann Seite oder Anzeige wechseln
+        _dirtyAll = true;
+        if (_listAction) _listAction(index);
+        return;
+    }
+
+    switch (entry->kind) {
+        case MenuKind::LINK:
+            setPage(entry->page);
+            break;
+        case MenuKind::BACK:
+            if (_pages[_page].parent != NO_PAGE) setPage(_pages[_page].parent);
+            break;
+        case MenuKind::ACTION:
+            // Aktionen ändern oft andere Werte (neue PIN, Uhrzeit): ganze Seite neu
+            _dirtyAll = true;
+            if (entry->action) entry->action();
+            break;
+        case MenuKind::TOGGLE: {
+            bool& value = *(bool*)field(*entry);
+            value = !value;
+            markRow(index);
+            break;
+        }
+        case MenuKind::SELECT:
+        case MenuKind::NUMBER:
+        case MenuKind::PIN:
+        case MenuKind::TEXT:
+            beginEdit(*entry);
+            markRow(index);
+            break;
+        case MenuKind::INFO:
+        default:
+            break;
+    }
+}
+
+void MenuEngine::markRow(uint8_t index) {
+    uint8_t top = _top[_page];
+    if (index < top || index >= top + VISIBLE_ROWS) return;
+    _dirtyRows |= 1 << (index - top + 1);
+}
+
+// -----------------------------------------------------------
+// EDITOREN
+// -----------------------------------------------------------
+
+void MenuEngine::beginEdit(const MenuItem& item) {
+    _editPos = 0;
+    switch (item.kind) {
+        case MenuKind::SELECT: {
+            int option = findOption(item);
+            _editOption = option < 0 ? 0 : option;
+            break;
+        }
+        case MenuKind::NUMBER:
+        case MenuKind::PIN: {
+            int value = intField(item);
+            if (value < item.min) value = item.min;
+            if (value > item.max) value = item.max;
+            snprintf(_editText, sizeof(_editText), "%0*d", (int)item.size, value);
+            break;
+        }
+        case MenuKind::TEXT: {
+            // Feste Länge, mit Leerzeichen aufgefüllt; beim Übernehmen wird hinten gekürzt
+            size_t length = item.size - 1 < MAX_TEXT ? item.size - 1 : MAX_TEXT;
+            size_t used = strnlen(charField(item), length);
+            memcpy(_editText, charField(item), used);
+            memset(_editText + used, ' ', length - used);
+            _editText[length] = '\0';
+            break;
+        }
+        default:
+            return;
+    }
+    _editing = true;
+}
+
+void MenuEngine::editKey(const MenuItem& item, Key key) {
+    int step = (key == Key::UP) ? 1 : (key == Key::DOWN) ? -1 : 0;
+    uint8_t length = (item.kind == MenuKind::TEXT || item.kind == MenuKind::NUMBER || item.kind == MenuKind::PIN)
+                     ? strlen(_editText) : 0;
+
+    switch (key) {
+        case Key::OK:
+            commitEdit(item);
+            _editing = false;
+            break;
+        case Key::CANCEL:
+            _editing = false;
+            break;
+        case Key::LEFT:
+            if (_editPos > 0) _editPos--;
+            break;
+        case Key::RIGHT:
+            if (_editPos + 1 < length) _editPos++;
+            break;
+        case Key::UP:
+        case Key::DOWN:
+            if (item.kind == MenuKind::SELECT) {
+                int count = item.select->count;
+                int option = _editOption + step;
+                if (option < 0) option = item.select->loop ? count - 1 : 0;
+                if (option >= count) option = item.select->loop ? 0 : count - 1;
+                _editOption = option;
+            } else if (item.kind == MenuKind::TEXT) {
+                const char* found = strchr(CHARSET, _editText[_editPos]);
+                int charsetSize = sizeof(CHARSET) - 1;
+                // Unbekannte Zeichen (z.B. UTF-8) springen auf das Leerzeichen
+                int index = (found && *found) ? (found - CHARSET + step + charsetSize) % charsetSize : 0;
+                _editText[_editPos] = CHARSET[index];
+            } else {
+                // Ziffer; die erste PIN-Ziffer läuft 1..9, damit die PIN 6 Stellen behält
+                int low = (item.kind == MenuKind::PIN && _editPos == 0) ? 1 : 0;
+                int span = 10 - low;
+                int digit = _editText[_editPos] - '0';
+                if (digit < low || digit > 9) digit = low;
+                _editText[_editPos] = '0' + low + (digit - low + step + span) % span;
+            }
+            break;
+    }
+    markRow(_cursor[_page]);
+}
+
+void MenuEngine::commitEdit(const MenuItem& item) {
+    switch (item.kind) {
+        case MenuKind::SELECT: {
+            const MenuOption& option = item.select->options[_editOption];
+            if (item.size) {
+                strncpy(charField(item), option.text, item.size - 1);
+                charField(item)[item.size - 1] = '\0';
+            } else {
+                intField(item) = option.value;
+            }
+            break;
+        }
+        case MenuKind::NUMBER:
+        case MenuKind::PIN: {
+            long value = strtol(_editText, nullptr, 10);
+            if (value < item.min) value = item.min;
+            if (value > item.max) value = item.max;
+            intField(item) = (int)value;
+            break;
+        }
+        case MenuKind::TEXT: {
+            size_t length = strlen(_editText);
+            while (length > 0 && _editText[length - 1] == ' ') length--;
+            memcpy(charField(item), _editText, length);
+            charField(item)[length] = '\0';
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+int MenuEngine::findOption(const MenuItem& item) const {
+    const MenuSelect& select = *item.select;
+    for (int i = 0; i < select.count; i++) {
+        bool match = item.size ? strncmp(select.options[i].text, charField(item), item.size) == 0
+                               : select.options[i].value == intField(item);
+        if (match) return i;
+    }
+    return -1;
+}
+
+// -----------------------------------------------------------
+// ZEICHNEN
+// -----------------------------------------------------------
+
+const char* MenuEngine::valueText(const MenuItem& item, char* buffer, size_t size) const {
+    switch (item.kind) {
+        case MenuKind::LINK:   return ">";
+        case MenuKind::TOGGLE: return *(const bool*)field(item) ? "[x]" : "[ ]";
+        case MenuKind::INFO:   return item.text ? item.text : charField(item);
+        case MenuKind::TEXT:   return charField(item);
+        case MenuKind::SELECT: {
+            int option = findOption(item);
+            if (option >= 0) return item.select->options[option].label;
+            // Wert außerhalb der Liste (z.B. per BLE gesetzt): roh anzeigen
+            if (item.size) return charField(item);
+            snprintf(buffer, size, "%d", intField(item));
+            return buffer;
+        }
+        case MenuKind::NUMBER:
+        case MenuKind::PIN:
+            snprintf(buffer, size, "%d", intField(item));
+            return buffer;
+        default:
+            return "";
+    }
+}
+
+uint8_t MenuEngine::render() {
+    if (!_dirtyAll && !_dirtyRows) return 0;
+
+    _display.setFont(MENU_FONT);
+    _display.setFontMode(1);
+    uint8_t sent = 0;
+
+    if (_dirtyAll) {
+        _display.clearBuffer();
+        drawTitle();
+        for (uint8_t row = 1; row <= VISIBLE_ROWS; row++) drawRow(row);
+        sent = VISIBLE_ROWS + 1;
+    } else {
+        for (uint8_t row = 1; row <= VISIBLE_ROWS; row++) {
+            if (!(_dirtyRows & (1 << row))) continue;
+            drawRow(row);
+            sent++;
+        }
+    }
+    // Der Display-Task schickt nur die geänderten Tiles
+    DisplayFlush::submit(_display);
+
+    _display.setDrawColor(1);
+    _display.setFontMode(0);
+    _dirtyAll = false;
+    _dirtyRows = 0;
+    return sent;
+}
+
+void MenuEngine::drawTitle() {
+    int width = _display.getDisplayWidth();
+    _display.setDrawColor(1);
+    _display.drawBox(0, 0, width, ROW_HEIGHT);
+    _display.setDrawColor(0);
+    _display.drawStr(MARGIN, BASELINE, pageTitle());
+    _display.setDrawColor(1);
+}
+
+void MenuEngine::drawRow(uint8_t row) {
+    int width = _display.getDisplayWidth();
+    int y = row * ROW_HEIGHT;
+    _display.setDrawColor(0);
+    _display.drawBox(0, y, width, ROW_HEIGHT);
+    _display.setDrawColor(1);
+
+    uint8_t index = _top[_page] + row - 1;
+    if (index >= itemCount()) return;
+    bool selected = (index == _cursor[_page]);
+    const MenuItem* entry = item(index);
+
+    if (selected && _editing) {
+        drawEditValue(*entry, y, width);
+        return;
+    }
+
+    if (selected) {
+        _display.drawBox(0, y, width, ROW_HEIGHT);
+        _display.setDrawColor(0);
+    }
+    const char* title = itemTitle(index);
+    _display.drawStr(MARGIN, y + BASELINE, title);
+
+    if (entry) {
+        char buffer[12];
+        const char* value = valueText(*entry, buffer, sizeof(buffer));
+        if (*value) {
+            // Rechtsbündig; reicht der Platz nicht, beginnt der Wert hinter dem Titel und wird abgeschnitten
+            int valueWidth = _display.getStrWidth(value);
+            int minX = MARGIN + _display.getStrWidth(title) + 2 * MARGIN;
+            int x = width - MARGIN - valueWidth;
+            if (x < minX) x = minX;
+            _display.setClipWindow(x, y, width - MARGIN, y + ROW_HEIGHT);
+            _display.drawStr(x, y + BASELINE, value);
+            _display.setMaxClipWindow();
+        }
+    }
+    _display.setDrawColor(1);
+}
+
+// Zeile im Editor: der bearbeitete Teil (Option, Ziffer, Zeichen) ist invertiert
+void MenuEngine::drawEditValue(const MenuItem& item, int y, int width) {
+    int charWidth = _display.getMaxCharWidth();
+
+    if (item.kind == MenuKind::TEXT) {
+        // Text nutzt die ganze Zeile und scrollt mit dem Cursor
+        int visible = (width - 2 * MARGIN) / charWidth;
+        int start = _editPos < visible ? 0 : _editPos - visible + 1;
+        char window[MAX_TEXT + 1];
+        snprintf(window, sizeof(window), "%.*s", visible, _editText + start);
+        int cursorX = MARGIN + (_editPos - start) * charWidth;
+        _display.drawStr(MARGIN, y + BASELINE, window);
+        _display.setDrawColor(2);
+        _display.drawBox(cursorX, y, charWidth, ROW_HEIGHT);
+        _display.setDrawColor(1);
+        return;
+    }
+
+    _display.drawStr(MARGIN, y + BASELINE, item.title);
+
+    if (item.kind == MenuKind::SELECT) {
+        const char* label = item.select->options[_editOption].label;
+        int labelWidth = _display.getStrWidth(label);
+        int x = width - MARGIN - labelWidth;
+        _display.drawBox(x - 1, y, labelWidth + 2, ROW_HEIGHT);
+        _display.setDrawColor(0);
+        _display.drawStr(x, y + BASELINE, label);
+        _display.setDrawColor(1);
+        return;
+    }
+
+    // NUMBER/PIN: Ziffern rechtsbündig, aktuelle Ziffer invertiert
+    int x = width - MARGIN - (int)strlen(_editText) * charWidth;
+    _display.drawStr(x, y + BASELINE, _editText);
+    _display.setDrawColor(2);
+    _display.drawBox(x + _editPos * charWidth, y, charWidth, ROW_HEIGHT);
+    _display.setDrawColor(1);
+}
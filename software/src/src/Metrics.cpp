@@ -0,0 +1,42 @@
+#include "Metrics.h"
+#include <stdio.h>
+
+Metric* Metric::_first = nullptr;
+Metric* Metric::_last = nullptr;
+
+Metric::Metric(const char* name, Kind kind, Reader reader)
+    : _value(0), _name(name), _kind(kind), _reader(reader), _next(nullptr) {
+    // Läuft während der statischen Initialisierung, also noch ohne weitere Tasks
+    if (_last) _last->_next = this;
+    else _first = this;
+    _last = this;
+}
+
+uint32_t Metric::raw() const {
+    if (_reader) return (uint32_t)_reader();
+    return _value.load(std::memory_order_relaxed);
+}
+
+size_t Metrics::count() {
+    size_t n = 0;
+    for (const Metric* m = Metric::first(); m; m = m->next()) n++;
+    return n;
+}
+
+size_t Metrics::snapshot(char* out, size_t size) {
+    if (size < 3) return 0;
+    size_t n = 0;
+    out[n++] = '{';
+    for (const Metric* m = Metric::first(); m; m = m->next()) {
+        uint32_t v = m->raw();
+        int written = m->kind() == Metric::GAUGE
+            ? snprintf(out + n, size - n, "%s\"%s\":%ld", n > 1 ? "," : "", m->name(), (long)(int32_t)v)
+            : snprintf(out + n, size - n, "%s\"%s\":%lu", n > 1 ? "," : "", m->name(), (unsigned long)v);
+        if (written < 0 || (size_t)written >= size - n) return 0;
+        n += written;
+    }
+    if (n + 2 > size) return 0;
+    out[n++] = '}';
+    out[n] = '\0';
+    return n;
+}
@@ -1,9 +1,7 @@
 #include "ModeConfig.h"
+#include "Log.h"
+#include "DisplayFlush.h"
 #include <WiFi.h>
-#include <HTTPClient.h>
-#include <WiFiClientSecure.h>
-#include <HTTPUpdate.h>
-#include <ArduinoJson.h>
 
 #ifndef APP_VERSION
 #define APP_VERSION "v0.0.0-dev"
@@ -11,601 +9,625 @@
 
 ModeConfig* ModeConfig::instance = nullptr;
 
-SelectOptionInt optionsConnection[] = {
-    {"None", 0},
-    {"BLE",  1},
-    {"MQTT", 2},
-    {"TIMER", 3}
-};
+// =========================================================
+// MENU STRUKTUR (constexpr -> Flash)
+// =========================================================
+#define CFG(field) MENU_FIELD(ConfigMenuModel, config.field)
+#define EDIT(field) MENU_FIELD(ConfigMenuModel, field)
 
-SelectOptionInt optionsTimeout[] = {
-    {"Never", 0},
-    {"10s",  10},
-    {"20s",  20},
-    {"30s",  30},
-    {"1min", 60},
-    {"5min", 300}
-};
+struct ModeConfig::Menu {
+    static constexpr MenuOption controllerPriority[] = {
+        {"BLE>MQTT", 0},
+        {"MQTT>BLE", 1}
+    };
 
-GEMSelect selectConnection(4, optionsConnection);
-GEMSelect selectTimeout(6, optionsTimeout);
-
-// Timer options
-SelectOptionInt optionsTimerRunFor[] = {
-    {"1min", 60},
-    {"2min", 120},
-    {"3min", 180},
-    {"4min", 240},
-    {"5min", 300},
-    {"10min", 600},
-    {"15min", 900},
-    {"20min", 1200},
-    {"30min", 1800}
-};
+    static constexpr MenuOption controllerHold[] = {
+        {"Off", 0},
+        {"1min", 60},
+        {"10min", 600},
+        {"30min", 1800},
+        {"1h", 3600}
+    };
 
-SelectOptionChar optionsTimerAirflow[] = {
-    {"IN", "IN"},
-    {"OUT", "OUT"}
-};
+    static constexpr MenuOption timeout[] = {
+        {"Never", 0},
+        {"10s",  10},
+        {"20s",  20},
+        {"30s",  30},
+        {"1min", 60},
+        {"5min", 300}
+    };
 
-SelectOptionInt optionsTimerPercent[] = {
-    {"10", 10}, {"20", 20}, {"30", 30}, {"40", 40}, {"50", 50},
-    {"60", 60}, {"70", 70}, {"80", 80}, {"90", 90}, {"100", 100}
-};
+    static constexpr MenuOption bleMaxConnections[] = {
+        {"1", 1},
+        {"2", 2},
+        {"3", 3}
+    };
 
-SelectOptionInt optionsTimerPauseFor[] = {
-    {"1min", 60}, {"5min", 300}, {"10min", 600}, {"15min", 900},
-    {"30min", 1800}, {"1h", 3600}, {"2h", 7200}, {"3h", 10800},
-    {"6h", 21600}, {"12h", 43200}, {"24h", 86400}
-};
+    // Timer options
+    static constexpr MenuOption timerRunFor[] = {
+        {"1min", 60},
+        {"2min", 120},
+        {"3min", 180},
+        {"4min", 240},
+        {"5min", 300},
+        {"10min", 600},
+        {"15min", 900},
+        {"20min", 1200},
+        {"30min", 1800}
+    };
+
+    static constexpr MenuOption timerAirflow[] = {
+        {"IN", "IN"},
+        {"OUT", "OUT"}
+    };
 
-GEMSelect selectTimerRunFor(sizeof(optionsTimerRunFor)/sizeof(optionsTimerRunFor[0]), optionsTimerRunFor, true);
-GEMSelect selectTimerAirflow(sizeof(optionsTimerAirflow)/sizeof(optionsTimerAirflow[0]), optionsTimerAirflow, true);
-GEMSelect selectTimerPercent(sizeof(optionsTimerPercent)/sizeof(optionsTimerPercent[0]), optionsTimerPercent, true);
-GEMSelect selectTimerPauseFor(sizeof(optionsTimerPauseFor)/sizeof(optionsTimerPauseFor[0]), optionsTimerPauseFor, true);
+    static constexpr MenuOption timerPercent[] = {
+        {"10", 10}, {"20", 20}, {"30", 30}, {"40", 40}, {"50", 50},
+        {"60", 60}, {"70", 70}, {"80", 80}, {"90", 90}, {"100", 100}
+    };
 
-// -----------------------------------------------------------
-// KONSTRUKTOR
-// -----------------------------------------------------------
-ModeConfig::ModeConfig(U8G2* display, Encoder* encoder, ChordInput* input)
-    : 
-     AppMode(*display, *encoder, *input), 
-    _menu(*display, GEM_POINTER_ROW, GEM_ITEMS_COUNT_AUTO),
-    _mustExit(false),
-    
-    // --- SEITEN (Statisch) ---
-    _pageMain("Settings"),
-    _pageTimer("Timer"),
-    _pageRemote("Controller"),
-    _pageWifi("Wi-Fi Settings"),
-    _pageMqtt("MQTT Settings"),
-    _pageBle("Bluetooth LE"),
-    _pageDisplay("Display"),
-    _pageVersionInfo("Firmware Version"),
-    _pageExit("Save Changes?"), 
-    // _pageVersionsSelect wird im Body initialisiert!
-
-    // --- NAVIGATION ITEMS ---
-    _itemNavWifi("Wi-Fi", _pageWifi),
-    _itemNavMqtt("MQTT", _pageMqtt),
-    _itemNavBle("Bluetooth LE", _pageBle),
-    _itemNavRemote("Controller", _pageRemote),
-    _itemNavTimer("Timer", _pageTimer),
-    _itemNavDisplay("Display", _pageDisplay),
-    _itemNavVersion("Version", _pageVersionInfo),
-    _itemNavExit("Exit", callbackCheckExit),
-
-    // --- BACK BUTTONS ---
-    _itemBackRemote("Back", callbackGoBackToMain),
-    _itemBackTimer("Back", callbackGoBackToMain),
-    _itemBackWifi("Back", callbackGoBackToMain),
-    _itemBackMqtt("Back", callbackGoBackToMain),
-    _itemBackBle("Back", callbackGoBackToMain),
-    _itemBackDisplay("Back", callbackGoBackToMain),
-    _itemBackVersion("Back", callbackGoBackToMain),
-    _itemBackFromExit("Back", callbackGoBackToMain),
-
-    // --- ITEMS ---
-    _itemConnection("Controller", _editConfig.connection, selectConnection),
-    _itemSsid("SSID:", _editConfig.wifiSSID),
-    _itemPassword("Password:", _editConfig.wifiPassword),
-    _itemMqttHost("Host:", _editConfig.mqttHost),
-    _itemMqttPort("Port:", _editConfig.mqttPort),
-    _itemMqttClientId("Client ID:", _editConfig.mqttClientId),
-    _itemMqttUser("User:", _editConfig.mqttUsername),
-    _itemMqttPassword("Password:", _editConfig.mqttPassword),
-    _itemMqttCommandTopic("Cmd topic:", _editConfig.mqttCommandTopic),
-    _itemMqttStateTopic("State topic:", _editConfig.mqttStateTopic),
-    _itemTestWifi("Test Connection", callbackTestWifi),
-    _itemTestMqtt("Test Connection", callbackTestMqtt),
-    _itemBlePin("PIN:", _editConfig.blePin),
-    _itemGenerateNewPIN("Generate new PIN", callbackGenerateNewPIN),
-    _itemTimerRunFor("Run For", _editConfig.timerRunForSeconds, selectTimerRunFor),
-    _itemTimerAirflow("Airflow", _editConfig.timerAirflow, selectTimerAirflow),
-    _itemTimerPercent("Percent", _editConfig.timerPercent, selectTimerPercent),
-    _itemTimerPauseFor("Pause for", _editConfig.timerPauseForSeconds, selectTimerPauseFor),
-    _itemDisplayTimeoutSeconds("Dim after", _editConfig.displayTimeoutSeconds, selectTimeout),
-    _itemCurrentVersion("Installed:", APP_VERSION, true), 
-    _itemCheckUpdates("Check for Updates", callbackCheckForUpdates),
-    _itemSave("Save Changes", callbackSaveAndRestart),
-    _itemDiscard("Discard Changes", callbackDiscardAndRestart)
-{
-    instance = this;
-    snprintf(versionLabel, sizeof(versionLabel), "v%s", APP_VERSION);
+    static constexpr MenuOption timerPauseFor[] = {
+        {"1min", 60}, {"5min", 300}, {"10min", 600}, {"15min", 900},
+        {"30min", 1800}, {"1h", 3600}, {"2h", 7200}, {"3h", 10800},
+        {"6h", 21600}, {"12h", 43200}, {"24h", 86400}
+    };
 
-    // WICHTIG: Dynamische Page initialisieren
-    _pageVersionsSelect = new GEMPage("Select Version");
+    // POSIX-TZ-Strings (Zeitplan und SNTP)
+    static constexpr MenuOption timeZone[] = {
+        {"CET", "CET-1CEST,M3.5.0,M10.5.0/3"},
+        {"UK", "GMT0BST,M3.5.0/1,M10.5.0"},
+        {"EET", "EET-2EEST,M3.5.0/3,M10.5.0/4"},
+        {"UTC", "UTC0"},
+        {"US East", "EST5EDT,M3.2.0,M11.1.0"},
+        {"US Pacific", "PST8PDT,M3.2.0,M11.1.0"}
+    };
+
+    static constexpr MenuOption weekday[] = {
+        {"Mon", 0}, {"Tue", 1}, {"Wed", 2}, {"Thu", 3}, {"Fri", 4}, {"Sat", 5}, {"Sun", 6}
+    };
 
-    // =========================================================
-    // MENU STRUKTUR AUFBAUEN
-    // =========================================================
+    static constexpr MenuSelect selectControllerPriority = menuOptions(controllerPriority);
+    static constexpr MenuSelect selectControllerHold = menuOptions(controllerHold);
+    static constexpr MenuSelect selectBleMaxConnections = menuOptions(bleMaxConnections);
+    static constexpr MenuSelect selectTimeout = menuOptions(timeout);
+    static constexpr MenuSelect selectTimerRunFor = menuOptions(timerRunFor, true);
+    static constexpr MenuSelect selectTimerAirflow = menuOptions(timerAirflow, true);
+    static constexpr MenuSelect selectTimerPercent = menuOptions(timerPercent, true);
+    static constexpr MenuSelect selectTimerPauseFor = menuOptions(timerPauseFor, true);
+    static constexpr MenuSelect selectTimeZone = menuOptions(timeZone, true);
+    static constexpr MenuSelect selectWeekday = menuOptions(weekday, true);
 
     // 1. Main Page
-    _pageMain.addMenuItem(_itemNavWifi);
-    _pageMain.addMenuItem(_itemNavMqtt);
-    _pageMain.addMenuItem(_itemNavBle);
-    _pageMain.addMenuItem(_itemNavRemote);
-    _pageMain.addMenuItem(_itemNavTimer);
-    _pageMain.addMenuItem(_itemNavDisplay);
-    _pageMain.addMenuItem(_itemNavVersion);
-    _pageMain.addMenuItem(_itemNavExit);
+    static constexpr MenuItem main[] = {
+        MenuItem::link("Wi-Fi", PAGE_WIFI),
+        MenuItem::link("MQTT", PAGE_MQTT),
+        MenuItem::link("Bluetooth LE", PAGE_BLE),
+        MenuItem::link("Controller", PAGE_REMOTE),
+        MenuItem::link("Timer", PAGE_TIMER),
+        MenuItem::link("Display", PAGE_DISPLAY),
+        MenuItem::link("Version", PAGE_VERSION_INFO),
+        MenuItem::button("Exit", callbackCheckExit)
+    };
 
     // 2. Controller Page
-    _pageRemote.addMenuItem(_itemConnection);
-    _pageRemote.addMenuItem(_itemBackRemote); 
+    static constexpr MenuItem remote[] = {
+        menuToggle<CFG(controllerBle)>("BLE"),
+        menuToggle<CFG(controllerMqtt)>("MQTT"),
+        menuToggle<CFG(controllerTimer)>("Timer"),
+        menuToggle<CFG(controllerHttp)>("HTTP"),
+        menuToggle<CFG(controllerSerial)>("USB"),
+        menuSelect<CFG(controllerPriority)>("Priority", selectControllerPriority),
+        menuSelect<CFG(controllerHoldSeconds)>("Hold", selectControllerHold),
+        MenuItem::back()
+    };
 
     // 2b. Timer Page
-    _pageTimer.addMenuItem(_itemTimerRunFor);
-    _pageTimer.addMenuItem(_itemTimerAirflow);
-    _pageTimer.addMenuItem(_itemTimerPercent);
-    _pageTimer.addMenuItem(_itemTimerPauseFor);
-    _pageTimer.addMenuItem(_itemBackTimer);
+    static constexpr MenuItem timer[] = {
+        menuSelect<CFG(timerRunForSeconds)>("Run For", selectTimerRunFor),
+        menuSelect<CFG(timerAirflow)>("Airflow", selectTimerAirflow),
+        menuSelect<CFG(timerPercent)>("Percent", selectTimerPercent),
+        menuSelect<CFG(timerPauseForSeconds)>("Pause for", selectTimerPauseFor),
+        menuSelect<CFG(timeZone)>("Time zone", selectTimeZone),
+        menuLabel<EDIT(clockLabel)>("Clock:"),
+        menuSelect<EDIT(clockDay)>("Day", selectWeekday),
+        menuNumber<EDIT(clockHour)>("Hour", 2, 0, 23),
+        menuNumber<EDIT(clockMinute)>("Minute", 2, 0, 59),
+        MenuItem::button("Set Clock", callbackSetClock),
+        MenuItem::back()
+    };
 
     // 3. Wi-Fi Page
-    _pageWifi.addMenuItem(_itemSsid);
-    _pageWifi.addMenuItem(_itemPassword);
-    _pageWifi.addMenuItem(_itemTestWifi);
-    _pageWifi.addMenuItem(_itemBackWifi);     
+    static constexpr MenuItem wifi[] = {
+        menuText<CFG(wifiSSID)>("SSID:"),
+        menuText<CFG(wifiPassword)>("Password:"),
+        MenuItem::button("Test Connection", callbackTestWifi),
+        MenuItem::back()
+    };
 
     // 3b. MQTT Page
-    _pageMqtt.addMenuItem(_itemMqttHost);
-    _pageMqtt.addMenuItem(_itemMqttPort);
-    _pageMqtt.addMenuItem(_itemMqttClientId);
-    _pageMqtt.addMenuItem(_itemMqttUser);
-    _pageMqtt.addMenuItem(_itemMqttPassword);
-    _pageMqtt.addMenuItem(_itemMqttCommandTopic);
-    _pageMqtt.addMenuItem(_itemMqttStateTopic);
-    _pageMqtt.addMenuItem(_itemTestMqtt);
-    _pageMqtt.addMenuItem(_itemBackMqtt);
+    static constexpr MenuItem mqtt[] = {
+        menuText<CFG(mqttHost)>("Host:"),
+        menuNumber<CFG(mqttPort)>("Port:", 5, 1, 65535),
+        menuText<CFG(mqttClientId)>("Client ID:"),
+        menuText<CFG(mqttUsername)>("User:"),
+        menuText<CFG(mqttPassword)>("Password:"),
+        menuText<CFG(mqttCommandTopic)>("Cmd topic:"),
+        menuText<CFG(mqttStateTopic)>("State topic:"),
+        MenuItem::button("Test Connection", callbackTestMqtt),
+        MenuItem::back()
+    };
 
     // 4. BLE Page
-    _pageBle.addMenuItem(_itemBlePin);
-    _pageBle.addMenuItem(_itemGenerateNewPIN);
-    _pageBle.addMenuItem(_itemBackBle);       
+    static constexpr MenuItem ble[] = {
+        menuPin<CFG(blePin)>("PIN:"),
+        MenuItem::button("Generate new PIN", callbackGenerateNewPIN),
+        menuSelect<CFG(bleMaxConnections)>("Max. clients", selectBleMaxConnections),
+        MenuItem::back()
+    };
 
     // 5. Display Page
-    _pageDisplay.addMenuItem(_itemDisplayTimeoutSeconds);
-    _pageDisplay.addMenuItem(_itemBackDisplay); 
+    static constexpr MenuItem display[] = {
+        menuSelect<CFG(displayTimeoutSeconds)>("Dim after", selectTimeout),
+        MenuItem::back()
+    };
 
     // 6. Version Page
-    _pageVersionInfo.addMenuItem(_itemCurrentVersion);
-    _pageVersionInfo.addMenuItem(_itemCheckUpdates);
-    _pageVersionInfo.addMenuItem(_itemBackVersion); 
+    static constexpr MenuItem versionInfo[] = {
+        MenuItem::info("Installed:", APP_VERSION),
+        MenuItem::button("Check for Updates", callbackCheckForUpdates),
+        MenuItem::button("Local Update", callbackLocalUpdate),
+        menuText<CFG(updateUrl)>("Local URL:"),
+        MenuItem::button("MQTT Update", callbackMqttUpdate),
+        MenuItem::back()
+    };
+
+    // 6b. Versionsauswahl: die Releases kommen per setList() davor
+    static constexpr MenuItem versionsSelect[] = {
+        MenuItem::back()
+    };
 
     // 7. Exit Page
-    _pageExit.addMenuItem(_itemSave);
-    _pageExit.addMenuItem(_itemDiscard);
-    _pageExit.addMenuItem(_itemBackFromExit); 
+    static constexpr MenuItem exit[] = {
+        MenuItem::button("Save Changes", callbackSaveAndRestart),
+        MenuItem::button("Discard Changes", callbackDiscardAndRestart),
+        MenuItem::back()
+    };
+
+    // Reihenfolge = enum Page
+    static constexpr MenuPage pages[PAGE_COUNT] = {
+        menuPage("Settings", main, MenuEngine::NO_PAGE),
+        menuPage("Wi-Fi Settings", wifi, PAGE_MAIN),
+        menuPage("MQTT Settings", mqtt, PAGE_MAIN),
+        menuPage("Bluetooth LE", ble, PAGE_MAIN),
+        menuPage("Controller", remote, PAGE_MAIN),
+        menuPage("Timer", timer, PAGE_MAIN),
+        menuPage("Display", display, PAGE_MAIN),
+        menuPage("Firmware Version", versionInfo, PAGE_MAIN),
+        menuPage("Select Version", versionsSelect, PAGE_VERSION_INFO),
+        menuPage("Save Changes?", exit, PAGE_MAIN)
+    };
+};
 
-    _itemPassword.setAdjustedASCIIOrder();
-    _itemSsid.setAdjustedASCIIOrder();
+#undef CFG
+#undef EDIT
 
-    _menu.setMenuPageCurrent(_pageMain);
+// -----------------------------------------------------------
+// KONSTRUKTOR
+// -----------------------------------------------------------
+ModeConfig::ModeConfig(U8G2* display, Encoder* encoder, ChordRecognizer* input,
+                       MaxFanState& state, MaxRemote& remote, MaxReceiver& irReceiver, FanController& remoteAccess,
+                       MqttController& mqtt)
+    : 
+     AppMode(*display, *encoder, *input), 
+    _state(state),
+    _remote(remote),
+    _irReceiver(irReceiver),
+    _remoteAccess(remoteAccess),
+    _mqtt(mqtt),
+    _mustExit(false),
+    _menu(*display, Menu::pages, PAGE_COUNT, &_edit),
+    _versionReleases(nullptr),
+    _versionCount(0),
+    _activeJob(nullptr),
+    _jobInBackground(false),
+    _jobDrawMs(0),
+    _spinner(0),
+    _messageActive(false),
+    _messageStartMs(0),
+    _messageDurationMs(0),
+    _messageReturnPage(MenuEngine::NO_PAGE)
+{
+    instance = this;
 }
 
 // -----------------------------------------------------------
 // LIFECYCLE
 // -----------------------------------------------------------
+ModeConfig::~ModeConfig() {
+    // Normal beendet loop() den Job schon beim Verlassen; ein MQTT-Update hängt sonst am Controller
+    if (_activeJob) _activeJob->cancel();
+    clearVersionItems();
+    _buttons.setReleaseTriggered(ENCODER_BUTTON, false);
+    instance = nullptr;
+}
+
 void ModeConfig::enter() {
-    _editConfig = GlobalConfig; 
+    _edit.config = GlobalConfig; 
+    updateClockItems();
     _mustExit = false;
+    _activeJob = nullptr;
+    _jobInBackground = false;
+    _messageActive = false;
+    // Encoder-Taste halten + Drehen = links/rechts; OK darf also erst beim Loslassen kommen
+    _buttons.setReleaseTriggered(ENCODER_BUTTON, true);
     
-    _menu.setMenuPageCurrent(_pageMain);
-    _pageMain.setCurrentMenuItemIndex(0);
-    
-    _menu.setSplashDelay(0);
-    _menu.init();
-    _menu.reInit();
-    _menu.drawMenu();
+    _menu.setPage(PAGE_MAIN, 0);
+    _menu.draw();
 }
 
 ModeAction ModeConfig::loop() {
-    bool actionDetected = false;
+    // Auch im Menü: Befehle der Fernbedienung/Controller per IR weitergeben und Status melden
+    _remoteAccess.notifyStatus(_state);
+    _remote.send(_state);
+    _irReceiver.update(_state);
+
+    if (_activeJob && !_jobInBackground) {
+        runJob();
+        return ModeAction::NONE;
+    }
+    if (_messageActive) {
+        updateMessage();
+        return ModeAction::NONE;
+    }
+    if (_activeJob) {
+        stepBackgroundJob();
+    }
 
-    while(_editConfig.blePin < 100000){
-        _editConfig.blePin += 100000;
-        _menu.drawMenu(); 
+    if(_mustExit) {
+        if (_activeJob) {
+            _activeJob->cancel();
+            _activeJob = nullptr;
+        }
+        _buttons.setReleaseTriggered(ENCODER_BUTTON, false);
+        return ModeAction::SWITCH_TO_STANDARD;
     }
-        
-    if(_mustExit) return ModeAction::SWITCH_TO_STANDARD;
 
-    if (_menu.readyForKey()) {
-        int delta = _encoder.getDelta();
-        if (delta != 0) {
-            actionDetected = true;
-            if(_buttons.IsKeyDown(ENCODER_BUTTON)){
-                 _buttons.CancelCurrentChord();
-                 if (delta > 0) _menu.registerKeyPress(GEM_KEY_LEFT);
-                 else           _menu.registerKeyPress(GEM_KEY_RIGHT);
-            } else {
-                if (delta > 0) _menu.registerKeyPress(GEM_KEY_UP);
-                else           _menu.registerKeyPress(GEM_KEY_DOWN);
-            }
+    bool actionDetected = false;
+    uint32_t startUs = micros();
+
+    int delta = _encoder.getDelta();
+    if (delta != 0) {
+        actionDetected = true;
+        if(_buttons.IsKeyDown(ENCODER_BUTTON)){
+             _buttons.CancelCurrentChord();
+             _menu.press(delta > 0 ? MenuEngine::Key::LEFT : MenuEngine::Key::RIGHT);
+        } else {
+            _menu.press(delta > 0 ? MenuEngine::Key::UP : MenuEngine::Key::DOWN);
         }
+    }
 
-        _buttons.tick();
-        if (_buttons.hasEvent()) {
-            KeyEvent evt = _buttons.popEvent();
-            
-            if (evt.IsSingle(ENCODER_BUTTON)) {
-                _menu.registerKeyPress(GEM_KEY_OK);
-                actionDetected = true;
-            }
-            if (evt.IsSingle(MODE_BUTTON)) {
-                _menu.registerKeyPress(GEM_KEY_CANCEL); 
-                actionDetected = true;
-            }
+    // tick() läuft bereits global in main.cpp
+    if (_buttons.hasEvent()) {
+        KeyEvent evt = _buttons.popEvent();
+
+        if (evt.IsSingle(ENCODER_BUTTON)) {
+            _menu.press(MenuEngine::Key::OK);
+            actionDetected = true;
+        }
+        if (evt.IsSingle(MODE_BUTTON)) {
+            _menu.press(MenuEngine::Key::CANCEL);
+            actionDetected = true;
         }
     }
 
-    if (actionDetected) {
-        _menu.drawMenu();
+    // Ein Callback kann gerade einen Job gestartet oder eine Meldung gezeigt haben, dann gehört das Display ihm
+    if (actionDetected && !(_activeJob && !_jobInBackground) && !_messageActive) {
+        uint8_t rows = _menu.render();
+        LOG_D("Menu: key -> %u row(s) in %lu us", rows, (unsigned long)(micros() - startUs));
     }
     return ModeAction::NONE;
 }
 
 // ------------------------------------------------
-// ERROR HELPER
-// ------------------------------------------------
-void ModeConfig::showError(const char* line1, const char* line2) {
-    Serial.printf("[ERROR] %s %s\n", line1, line2);
-    
-    instance->_display.clearBuffer();
-    instance->_display.setFont(u8g2_font_helvB08_tf);
-    instance->_display.drawStr(0, 20, "Error:");
-    instance->_display.drawStr(0, 35, line1);
-    instance->_display.drawStr(0, 50, line2);
-    instance->_display.sendBuffer();
-    
-    delay(3000); 
-    
-    // Zurück zur Version Info Seite
-    instance->_menu.setMenuPageCurrent(instance->_pageVersionInfo);
-    instance->_menu.drawMenu();
-}
-
-// ------------------------------------------------
-// NAVIGATION & SYSTEM CALLBACKS
+// JOB RUNNER
 // ------------------------------------------------
 
-void ModeConfig::callbackCheckExit() {
-    if (instance->_editConfig == GlobalConfig) {
-        instance->_mustExit = true; 
-    } else {
-        instance->_menu.setMenuPageCurrent(instance->_pageExit);
-        instance->_menu.drawMenu();
+void ModeConfig::startJob(ConfigJob& job, bool background) {
+    // Es läuft immer nur ein Job (z.B. Install während der Hintergrund-Aktualisierung)
+    if (_activeJob && _activeJob != &job) {
+        _activeJob->cancel();
     }
+    LOG_I("Job started: %s%s", job.title(), background ? " (background)" : "");
+    _activeJob = &job;
+    _jobInBackground = background;
+    if (background) return;
+
+    _spinner = 0;
+    _encoder.getDelta(); // angestaute Drehung verwerfen
+    drawJob();
 }
 
-void ModeConfig::callbackSaveAndRestart() {
-    instance->_display.clearBuffer();
-    instance->_display.drawStr(10, 30, "Saving...");
-    instance->_display.sendBuffer();
-    ConfigManager::saveAndReboot(instance->_editConfig);
-}
-
-void ModeConfig::callbackDiscardAndRestart() {
-    instance->_mustExit = true; 
-}
-
-void ModeConfig::callbackGoBackToMain() {
-    instance->_menu.setMenuPageCurrent(instance->_pageMain);
-    instance->_menu.drawMenu();
-}
-
-void ModeConfig::callbackGoBackToVersion() {
-    instance->_menu.setMenuPageCurrent(instance->_pageVersionInfo);
-    instance->_menu.drawMenu();
-}
-
-void ModeConfig::callbackGenerateNewPIN() {
-    instance->_editConfig.blePin = (esp_random() % 900000) + 100000;
-}
+void ModeConfig::runJob() {
+    ConfigJob::Result result = _activeJob->step();
 
-// ------------------------------------------------
-// WI-FI TEST
-// ------------------------------------------------
-
-void ModeConfig::callbackTestWifi() {
-    instance->_display.clearBuffer();
-    instance->_display.drawStr(0, 20, "Testing Connection...");
-    instance->_display.sendBuffer();
-
-    WiFi.disconnect();
-    delay(500);
-
-    bool success = instance->connectToWiFi(true);
+    // Eingaben während des Jobs: MODE bricht ab, alles andere wird verworfen
+    _encoder.getDelta();
+    while (_buttons.hasEvent()) {
+        KeyEvent evt = _buttons.popEvent();
+        if (evt.IsSingle(MODE_BUTTON) && result == ConfigJob::Result::RUNNING) {
+            _activeJob->cancel();
+            result = ConfigJob::Result::CANCELLED;
+        }
+    }
 
-    instance->_display.clearBuffer();
-    if (success) {
-        instance->_display.drawStr(0, 30, "Connection");
-        instance->_display.drawStr(0, 50, "Successful!");
-    } else {
-        instance->_display.drawStr(0, 30, "Connection");
-        instance->_display.drawStr(0, 50, "Failed!");
+    if (result == ConfigJob::Result::RUNNING) {
+        if (millis() - _jobDrawMs >= JOB_DRAW_MS) {
+            drawJob();
+        }
+        return;
     }
-    instance->_display.sendBuffer();
-    delay(2000);
-    instance->_menu.drawMenu();
+    finishJob(result);
 }
 
-void ModeConfig::callbackTestMqtt() {
-    instance->_display.clearBuffer();
-    instance->_display.drawStr(0, 20, "Testing MQTT...");
-    instance->_display.sendBuffer();
+void ModeConfig::finishJob(ConfigJob::Result result) {
+    ConfigJob* job = _activeJob;
+    _activeJob = nullptr;
+    bool isInstallJob = (job == &_jobOta || job == &_jobMqttOta);
+    bool isUpdateJob = (job == &_jobFetch || isInstallJob);
 
-    if (!instance->connectToWiFi(true)) {
-        instance->showError("WiFi Failed", "Check Settings");
-        return;
-    }
+    LOG_I("Job finished: %s (%d) %s %s", job->title(), (int)result, job->message(), job->detail());
 
-    const char* host = instance->_editConfig.mqttHost;
-    int port = instance->_editConfig.mqttPort;
-
-    // Basic host validation
-    auto isValidHost = [](const char* h)->bool{
-        if (!h) return false;
-        size_t l = strlen(h);
-        if (l == 0) return false;
-        for (size_t i = 0; i < l; ++i) {
-            char c = h[i];
-            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') return false;
-        }
-        return true;
-    };
+    switch (result) {
+        case ConfigJob::Result::SUCCESS:
+            if (job == &_jobFetch) {
+                buildVersionPage(_jobFetch.releases(), "Select Version");
+                return;
+            }
+            if (isInstallJob) {
+                showMessage(job->title(), job->message(), job->detail(), 0);
+                delay(500);
+                Log::flush();
+                ESP.restart();
+                return;
+            }
+            showMessage(job->title(), job->message(), job->detail(), RESULT_SCREEN_MS);
+            break;
 
-    auto isValidTopic = [](const char* t)->bool{
-        if (!t) return false;
-        size_t l = strlen(t);
-        if (l == 0) return false;
-        for (size_t i = 0; i < l; ++i) {
-            char c = t[i];
-            if (c == ' ' || c == '\t' || c == '\n' || c == '\r') return false;
-        }
-        return true;
-    };
+        case ConfigJob::Result::CANCELLED:
+            showMessage(job->title(), "Cancelled", "", RESULT_SCREEN_MS, isUpdateJob ? (uint8_t)PAGE_VERSION_INFO : MenuEngine::NO_PAGE);
+            break;
 
-    if (!isValidHost(host)) {
-        instance->showError("MQTT Host invalid", "No whitespace, e.g. test.mosquitto.org");
-        return;
+        case ConfigJob::Result::FAILED:
+        default:
+            showMessage(job->title(), job->message(), job->detail(), ERROR_SCREEN_MS, isUpdateJob ? (uint8_t)PAGE_VERSION_INFO : MenuEngine::NO_PAGE);
+            break;
     }
+}
 
-    if (!isValidTopic(instance->_editConfig.mqttCommandTopic) || !isValidTopic(instance->_editConfig.mqttStateTopic)) {
-        instance->showError("MQTT Topic invalid", "No whitespace allowed in topics");
-        return;
-    }
+void ModeConfig::stepBackgroundJob() {
+    ConfigJob::Result result = _activeJob->step();
+    if (result == ConfigJob::Result::RUNNING) return;
 
-    WiFiClient client;
-    bool success = false;
+    ConfigJob* job = _activeJob;
+    _activeJob = nullptr;
+    _jobInBackground = false;
+    LOG_I("Background job finished: %s (%d) %s %s", job->title(), (int)result, job->message(), job->detail());
 
-    if (client.connect(host, port)) {
-        success = true;
-        client.stop();
+    // Bei Fehlern bleibt die gecachte Liste einfach stehen
+    if (job == &_jobFetch && result == ConfigJob::Result::SUCCESS) {
+        bool visible = (_menu.page() == PAGE_VERSIONS_SELECT);
+        buildVersionPage(_jobFetch.releases(), "Select Version", visible);
     }
+}
 
-    instance->_display.clearBuffer();
-    if (success) {
-        instance->_display.drawStr(0, 30, "Connection");
-        instance->_display.drawStr(0, 50, "Successful!");
+void ModeConfig::drawJob() {
+    _jobDrawMs = millis();
+    int width = _display.getDisplayWidth();
+
+    _display.clearBuffer();
+    _display.setFont(u8g2_font_helvB08_tf);
+    _display.drawStr(0, 10, _activeJob->title());
+    _display.drawHLine(0, 13, width);
+    _display.drawStr(0, 26, _activeJob->message());
+    _display.drawStr(0, 38, _activeJob->detail());
+
+    // Fortschrittsbalken, bei unbekanntem Fortschritt ein wandernder Block
+    _display.drawFrame(0, 44, width, 8);
+    int progress = _activeJob->progress();
+    if (progress >= 0) {
+        _display.drawBox(2, 46, (width - 4) * constrain(progress, 0, 100) / 100, 4);
     } else {
-        instance->_display.drawStr(0, 30, "Connection");
-        instance->_display.drawStr(0, 50, "Failed!");
+        const int block = 16;
+        int span = width - 4 - block;
+        int pos = _spinner % (2 * span / 4);
+        pos = pos * 4 > span ? 2 * span - pos * 4 : pos * 4;
+        _display.drawBox(2 + pos, 46, block, 4);
+        _spinner++;
     }
-    instance->_display.sendBuffer();
-    delay(2000);
-    instance->_menu.drawMenu();
+
+    _display.drawStr(0, 63, "MODE: Cancel");
+    DisplayFlush::submit(_display);
 }
 
 // ------------------------------------------------
-// OTA / UPDATE LOGIK
+// MELDUNGEN
 // ------------------------------------------------
 
-void ModeConfig::clearDynamicItems() {
-    for (auto& entry : _releaseList) {
-        delete entry.menuPtr; 
-    }
-    _releaseList.clear();
+void ModeConfig::showMessage(const char* title, const char* line1, const char* line2,
+                             uint32_t durationMs, uint8_t returnPage) {
+    _display.clearBuffer();
+    _display.setFont(u8g2_font_helvB08_tf);
+    _display.drawStr(0, 20, title);
+    _display.drawStr(0, 35, line1);
+    _display.drawStr(0, 50, line2);
+    DisplayFlush::submit(_display);
+
+    _messageActive = true;
+    _messageStartMs = millis();
+    _messageDurationMs = durationMs;
+    _messageReturnPage = returnPage;
 }
 
-bool ModeConfig::connectToWiFi(bool useEditConfig) {
-    if (WiFi.status() == WL_CONNECTED) return true;
+void ModeConfig::updateMessage() {
+    bool close = millis() - _messageStartMs >= _messageDurationMs;
 
-    WiFi.begin(instance->_editConfig.wifiSSID, instance->_editConfig.wifiPassword); 
-    
-    int timeout = 0;
-    while (WiFi.status() != WL_CONNECTED && timeout < 20) { 
-        delay(500);
-        timeout++;
+    // Jede Taste oder Drehung schließt die Meldung vorzeitig
+    if (_encoder.getDelta() != 0) close = true;
+    while (_buttons.hasEvent()) {
+        _buttons.popEvent();
+        close = true;
+    }
+    if (!close) return;
+
+    _messageActive = false;
+    if (_messageReturnPage != MenuEngine::NO_PAGE) {
+        _menu.setPage(_messageReturnPage);
     }
-    return WiFi.status() == WL_CONNECTED;
+    _menu.draw();
 }
 
-void ModeConfig::callbackCheckForUpdates() {
-    if (!instance->connectToWiFi(true)) { 
-        instance->showError("WiFi Failed", "Check Settings");
-        return;
+// ------------------------------------------------
+// NAVIGATION & SYSTEM CALLBACKS
+// ------------------------------------------------
+
+void ModeConfig::callbackCheckExit() {
+    if (instance->_edit.config == GlobalConfig) {
+        instance->_mustExit = true; 
+    } else {
+        instance->_menu.setPage(PAGE_EXIT);
     }
+}
 
+void ModeConfig::callbackSaveAndRestart() {
     instance->_display.clearBuffer();
-    instance->_display.drawStr(10, 30, "Fetching GitHub...");
-    instance->_display.sendBuffer();
+    instance->_display.drawStr(10, 30, "Saving...");
+    DisplayFlush::submit(instance->_display);
+    // Meldung erst zu Ende senden, saveAndReboot() kommt nicht zurück
+    DisplayFlush::waitIdle(100);
+    ConfigManager::saveAndReboot(instance->_edit.config);
+}
 
-    instance->fetchReleasesFromGitHub();
+void ModeConfig::callbackDiscardAndRestart() {
+    instance->_mustExit = true; 
 }
 
-void ModeConfig::fetchReleasesFromGitHub() {
-    Serial.println("--- Starting GitHub Fetch ---");
-    Serial.printf("Free Heap: %d bytes\n", ESP.getFreeHeap());
+void ModeConfig::callbackGenerateNewPIN() {
+    instance->_edit.config.blePin = (esp_random() % 900000) + 100000;
+}
 
-    WiFiClientSecure client;
-    client.setInsecure(); 
-    HTTPClient http;
-    
-    String url = "https://api.github.com/repos/Matthias-Hess/MaxMan/releases"; 
-    
-    http.setTimeout(10000); 
+// ------------------------------------------------
+// UHR (für den Zeitplan, wenn kein SNTP)
+// ------------------------------------------------
 
-    if (!http.begin(client, url)) {
-        showError("HTTP Begin", "Failed");
+void ModeConfig::updateClockItems() {
+    static const char* const days[] = { "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun" };
+    if (!TimerVentilationController::clockValid()) {
+        snprintf(_edit.clockLabel, sizeof(_edit.clockLabel), "not set");
+        _edit.clockDay = 0;
+        _edit.clockHour = 12;
+        _edit.clockMinute = 0;
         return;
     }
+    time_t now = time(nullptr);
+    struct tm local;
+    localtime_r(&now, &local);
+    _edit.clockDay = (local.tm_wday + 6) % 7;
+    _edit.clockHour = local.tm_hour;
+    _edit.clockMinute = local.tm_min;
+    snprintf(_edit.clockLabel, sizeof(_edit.clockLabel), "%s %02d:%02d", days[_edit.clockDay], _edit.clockHour, _edit.clockMinute);
+}
 
-    http.addHeader("User-Agent", "ESP32-MaxMan"); 
-    http.setFollowRedirects(HTTPC_FORCE_FOLLOW_REDIRECTS);
+void ModeConfig::callbackSetClock() {
+    // Wirkt sofort (nicht erst mit "Save"), die Uhr ist keine Einstellung
+    TimerVentilationController::setManualClock(instance->_edit.clockDay,
+                                               constrain(instance->_edit.clockHour, 0, 23),
+                                               constrain(instance->_edit.clockMinute, 0, 59));
+    instance->updateClockItems();
+}
 
-    int httpCode = http.GET();
+// ------------------------------------------------
+// WI-FI / MQTT TEST
+// ------------------------------------------------
 
-    if (httpCode == HTTP_CODE_OK) {
-        int len = http.getSize();
-        if (len > 25000) {
-                showError("JSON too big", String(len).c_str());
-                http.end();
-                return;
-        }
+void ModeConfig::callbackTestWifi() {
+    instance->_jobWifi.start(instance->_edit.config);
+    instance->startJob(instance->_jobWifi);
+}
 
-        String payload = http.getString();
-        
-        StaticJsonDocument<200> filter;
-        filter[0]["tag_name"] = true;
-        filter[0]["assets"][0]["name"] = true;
-        filter[0]["assets"][0]["browser_download_url"] = true;
-        
-        DynamicJsonDocument doc(20480); 
-        DeserializationError error = deserializeJson(doc, payload, DeserializationOption::Filter(filter));
-
-        if (!error) {
-            // 1. Alles Alte löschen
-            instance->clearDynamicItems(); 
-            
-            // 2. Seite neu bauen
-            delete instance->_pageVersionsSelect; 
-            instance->_pageVersionsSelect = new GEMPage("Select Version");
-
-            JsonArray arr = doc.as<JsonArray>();
-            int count = 0;
-
-            for (JsonObject repo : arr) {
-                const char* tagName = repo["tag_name"];
-                if (!tagName) continue;
-
-                String label = String(tagName);
-                
-                if (label == String(APP_VERSION)) {
-                    label += " (curr)";
-                }
-
-                String binUrl = "";
-                JsonArray assets = repo["assets"];
-                for (JsonObject asset : assets) {
-                    const char* name = asset["name"];
-                    const char* dlUrl = asset["browser_download_url"];
-                    if (name && String(name).endsWith(".bin")) {
-                        binUrl = String(dlUrl);
-                        break; 
-                    }
-                }
-
-                if (binUrl != "") {
-                    char* labelCStr = strdup(label.c_str());
-                    GEMItem* newItem = new GEMItem(labelCStr, callbackInstallUpdate);
-                    
-                    ReleaseEntry entry;
-                    entry.tagName = label;
-                    entry.downloadUrl = binUrl;
-                    entry.menuPtr = newItem;
-                    
-                    instance->_releaseList.push_back(entry);
-                    instance->_pageVersionsSelect->addMenuItem(*newItem);
-                    count++;
-                }
-            }
+void ModeConfig::callbackTestMqtt() {
+    instance->_jobMqtt.start(instance->_edit.config);
+    instance->startJob(instance->_jobMqtt);
+}
 
-            if (count == 0) {
-                showError("No .bin files", "found");
-            } else {
-                // --- KORREKTUR HIER ---
-                // Den Back-Button auch dynamisch erstellen!
-                GEMItem* itemBack = new GEMItem("Back", callbackGoBackToVersion);
-                
-                // Zur Seite hinzufügen
-                instance->_pageVersionsSelect->addMenuItem(*itemBack);
-                
-                // WICHTIG: Zur Aufräum-Liste hinzufügen, damit er beim nächsten Mal gelöscht wird
-                ReleaseEntry entryBack;
-                entryBack.tagName = "BackBtn"; // Dummy Name
-                entryBack.menuPtr = itemBack;
-                instance->_releaseList.push_back(entryBack);
-                // ----------------------
-
-                instance->_menu.setMenuPageCurrent(*instance->_pageVersionsSelect);
-                instance->_menu.drawMenu();
-            }
+// ------------------------------------------------
+// OTA / UPDATE LOGIK
+// ------------------------------------------------
 
-        } else {
-            showError("JSON Error:", error.c_str());
-        }
-    } else {
-        showError("HTTP Error", String(httpCode).c_str());
-    }
-    http.end();
+void ModeConfig::clearVersionItems() {
+    _menu.clearList();
+    _versionLabelArena.reset();
+    _versionReleases = nullptr;
+    _versionCount = 0;
 }
 
-void ModeConfig::callbackInstallUpdate(GEMCallbackData data) {
-    for (const auto& entry : instance->_releaseList) {
-        if (entry.menuPtr == data.pMenuItem) {
-            performOTA(entry.downloadUrl.c_str());
-            return;
-        }
+void ModeConfig::callbackCheckForUpdates() {
+    instance->_jobFetch.start(instance->_edit.config);
+    if (instance->_jobFetch.hasCache()) {
+        // Gecachte Liste sofort zeigen, aktualisiert wird im Hintergrund
+        instance->buildVersionPage(instance->_jobFetch.cachedReleases(), "Versions (cached)");
+        instance->startJob(instance->_jobFetch, true);
+    } else {
+        instance->startJob(instance->_jobFetch);
     }
 }
 
-void ModeConfig::performOTA(const char* url) {
-    instance->_display.clearBuffer();
-    instance->_display.setFont(u8g2_font_helvB10_tf);
-    instance->_display.drawStr(0, 20, "Updating...");
-    instance->_display.drawStr(0, 40, "Do not power off!");
-    instance->_display.sendBuffer();
+// Baut die Versionsauswahl. show = false: nur neu aufbauen, die aktuelle Seite bleibt.
+void ModeConfig::buildVersionPage(const std::vector<ReleaseInfo>& releases, const char* title, bool show) {
+    // Beim Neuaufbau der sichtbaren Seite (Hintergrund-Aktualisierung) bleibt der Cursor stehen
+    bool visible = (_menu.page() == PAGE_VERSIONS_SELECT);
+
+    clearVersionItems();
+    _versionReleases = &releases;
+
+    for (const ReleaseInfo& release : releases) {
+        if (_versionCount >= MAX_VERSION_ITEMS) break;
+        char label[48];
+        snprintf(label, sizeof(label), "%s%s", release.tagName.c_str(),
+                 release.tagName == APP_VERSION ? " (curr)" : "");
+        const char* labelCopy = _versionLabelArena.copy(label);
+        if (!labelCopy) break; // Arena voll: die älteren Releases fehlen
+        _versionLabels[_versionCount++] = labelCopy;
+    }
+    _menu.setList(PAGE_VERSIONS_SELECT, title, _versionLabels, _versionCount, callbackInstallUpdate);
 
-    WiFiClientSecure client;
-    client.setInsecure(); 
-    httpUpdate.setFollowRedirects(HTTPC_FORCE_FOLLOW_REDIRECTS);
+    if (!show) return;
+    if (!visible) {
+        _menu.setPage(PAGE_VERSIONS_SELECT, 0);
+    }
+    _menu.draw();
+}
 
-    t_httpUpdate_return ret = httpUpdate.update(client, url);
+void ModeConfig::callbackInstallUpdate(uint8_t index) {
+    const std::vector<ReleaseInfo>* releases = instance->_versionReleases;
+    // Die Liste kann inzwischen neu geladen sein (erneuter Abruf): nur gültige Einträge
+    if (!releases || index >= instance->_versionCount || index >= releases->size()) return;
+    const ReleaseInfo& release = (*releases)[index];
+    instance->_jobOta.start(instance->_edit.config, release.tagName, release.downloadUrl, release.manifestUrl);
+    instance->startJob(instance->_jobOta);
+}
 
-    instance->_display.clearBuffer();
-    switch (ret) {
-        case HTTP_UPDATE_FAILED:
-            instance->_display.drawStr(0, 30, "Update Failed!");
-            Serial.printf("Error (%d): %s\n", httpUpdate.getLastError(), httpUpdate.getLastErrorString().c_str());
-            break;
-        case HTTP_UPDATE_NO_UPDATES:
-            instance->_display.drawStr(0, 30, "No Update?");
-            break;
-        case HTTP_UPDATE_OK:
-            instance->_display.drawStr(0, 30, "Success!"); 
-            break;
+// Gleiches Manifest-Format wie bei GitHub, nur von einem Server im LAN
+void ModeConfig::callbackLocalUpdate() {
+    if (instance->_edit.config.updateUrl[0] == '\0') {
+        instance->showMessage("Local Update", "No URL set", "e.g. http://pc:8000/manifest.json", ERROR_SCREEN_MS);
+        return;
     }
-    instance->_display.sendBuffer();
-    delay(3000);
-    instance->_menu.drawMenu();
-}
\ No newline at end of file
+    instance->_jobOta.start(instance->_edit.config, "", "", instance->_edit.config.updateUrl);
+    instance->startJob(instance->_jobOta);
+}
+
+void ModeConfig::callbackMqttUpdate() {
+    instance->_jobMqttOta.start(instance->_edit.config, instance->_mqtt);
+    instance->startJob(instance->_jobMqttOta);
+}
@@ -1,7 +1,9 @@
 #include "ModeScreenDark.h"
+#include "Log.h"
+#include "DisplayFlush.h"
 #include <U8g2lib.h>
 
-ModeScreenDark::ModeScreenDark(U8G2& u8g2, Encoder& enc, ChordInput& btns,
+ModeScreenDark::ModeScreenDark(U8G2& u8g2, Encoder& enc, ChordRecognizer& btns,
                                                              MaxFanState& state, MaxRemote& remote, 
                                                              MaxReceiver& irReceiver, FanController& remoteAccess)
         : AppMode(u8g2, enc, btns),
@@ -10,22 +12,19 @@ ModeScreenDark::ModeScreenDark(U8G2& u8g2, Encoder& enc, ChordInput& btns,
 }
 
 void ModeScreenDark::enter() {
-    Serial.println(F("Entering Screen Dark Mode"));
+    LOG_I("Entering Screen Dark Mode");
     
     // Blank the screen - clear buffer and send empty buffer
     _display.clearBuffer();
-    _display.sendBuffer();
+    DisplayFlush::submit(_display);
     
-    // Turn off display power (for OLED displays)
-    _display.setPowerSave(1);
+    // Turn off display power (for OLED displays), after the empty frame is out
+    DisplayFlush::setPowerSave(_display, true);
 }
 
 ModeAction ModeScreenDark::loop() {
-    bool isConnected = _remoteAccess.isConnected();
-
-    if(isConnected){
-        _remoteAccess.notifyStatus(_state);
-    }
+    // Immer aufrufen: die Controller prüfen selbst, ob jemand zuhört (BLE broadcastet den Status auch ohne Verbindung)
+    _remoteAccess.notifyStatus(_state);
 
     _remote.send(_state);
     _irReceiver.update(_state);
@@ -34,8 +33,8 @@ ModeAction ModeScreenDark::loop() {
     int delta = _encoder.getDelta();
     if (delta != 0) {
         // Consume the input and return to standard mode
-        Serial.println(F("ScreenDark: Encoder input detected, returning to Standard Mode"));
-        _display.setPowerSave(0); // Turn display back on
+        LOG_I("ScreenDark: Encoder input detected, returning to Standard Mode");
+        DisplayFlush::setPowerSave(_display, false); // Turn display back on
         return ModeAction::SWITCH_TO_STANDARD;
     }
     
@@ -43,8 +42,8 @@ ModeAction ModeScreenDark::loop() {
     if (_buttons.hasEvent()) {
         // Consume the event (pop it but don't process)
         _buttons.popEvent();
-        Serial.println(F("ScreenDark: Button input detected, returning to Standard Mode"));
-        _display.setPowerSave(0); // Turn display back on
+        LOG_I("ScreenDark: Button input detected, returning to Standard Mode");
+        DisplayFlush::setPowerSave(_display, false); // Turn display back on
         return ModeAction::SWITCH_TO_STANDARD;
     }
     
@@ -1,37 +1,42 @@
 #include "ModeStandard.h"
+#include "Log.h"
 #include "MaxFanConfig.h"
+#include "CompositeController.h"
 #include "MaxFanConstants.h"
 #include <esp_timer.h>
 
 void ModeStandard::enter() {
-    
-    
-    Serial.println(F("Entering Standard Mode"));
+    // Menü und Screen Dark zeichnen in denselben Puffer: beim nächsten update() neu aufbauen
+    _display.invalidate();
+    LOG_I("Entering Standard Mode");
 }
 
 ModeAction ModeStandard::loop() {
     
-    bool isConnected = _remoteAccess.isConnected();
+    FanController::Indicator indicators[CompositeController::MAX_MEMBERS];
+    int indicatorCount = _remoteAccess.getIndicators(indicators, CompositeController::MAX_MEMBERS);
 
-    if(isConnected){
-        _remoteAccess.notifyStatus(_state);
-    }
+    // Immer aufrufen: die Controller prüfen selbst, ob jemand zuhört (BLE broadcastet den Status auch ohne Verbindung)
+    _remoteAccess.notifyStatus(_state);
 
     _remote.send(_state);
     _irReceiver.update(_state);
-        _display.update(_state, _remoteAccess.getIcon(), isConnected, _remoteAccess.getIndicatorLetter(), _testValue);
+    _display.update(_state, indicators, indicatorCount, _testValue);
 
     int delta = _encoder.getDelta();
     
     if(delta != 0){
+        // Schnelles Drehen -> größere Schritte
+        int steps = delta * _encoder.getStepMultiplier();
         switch (_state.GetMode()) {
             case MaxFanMode::OFF: 
                 break;
             case MaxFanMode::MANUAL:
-                _state.SetSpeed(_state.GetSpeed() - 10 * delta);
+                // SetSpeed klemmt nur über uint8_t, negative Werte also vorher abfangen
+                _state.SetSpeed(constrain(_state.GetSpeed() - 10 * steps, 10, 100));
                 break;
             case MaxFanMode::AUTO:
-                _state.SetTempCelsius(_state.GetTempCelsius() - delta);
+                _state.SetTempCelsius(_state.GetTempCelsius() - steps);
                 break;
             default: 
                 break;
@@ -42,15 +47,15 @@ ModeAction ModeStandard::loop() {
         KeyEvent event = _buttons.popEvent();
 
         if (event.IsSingle(ENCODER_BUTTON)) {
-            Serial.println("EVENT: ENCODER_BUTTON");
+            LOG_D("EVENT: ENCODER_BUTTON");
             _state.SetAirFlow(_state.GetAirFlow() == MaxFanDirection::IN ? MaxFanDirection::OUT : MaxFanDirection::IN);
         }
         else if (event.IsSingle(COVER_BUTTON)) {
-            Serial.println("EVENT: COVER_BUTTON");
+            LOG_D("EVENT: COVER_BUTTON");
             _state.SetCover(_state.GetCover() == CoverState::CLOSED ? CoverState::OPEN : CoverState::CLOSED);
         }
         else if (event.IsSingle(MODE_BUTTON)) {
-            Serial.println("EVENT: MODE_BUTTON");
+            LOG_D("EVENT: MODE_BUTTON");
             switch (_state.GetMode()) {
                 case MaxFanMode::OFF:
                     _state.SetMode(MaxFanMode::MANUAL);
@@ -66,7 +71,7 @@ ModeAction ModeStandard::loop() {
         }
 
         else if (event.IsChord(MODE_BUTTON, COVER_BUTTON)) {
-            Serial.println("EVENT: CHORD -> Switching to Config");
+            LOG_D("EVENT: CHORD -> Switching to Config");
             return ModeAction::SWITCH_TO_CONFIG; 
         }
     }
@@ -86,7 +91,7 @@ ModeAction ModeStandard::loop() {
         
         // If no input for the timeout period, switch to screen dark mode
         if (now - lastInputTime > timeoutUs) {
-            Serial.println(F("Standard Mode: Timeout reached, switching to Screen Dark Mode"));
+            LOG_I("Standard Mode: Timeout reached, switching to Screen Dark Mode");
             return ModeAction::SWITCH_TO_SCREEN_DARK;
         }
     }
@@ -0,0 +1,147 @@
+#include "MqttOtaReceiver.h"
+#include "Log.h"
+#include "MaxFanMQTT.h"
+
+void MqttOtaReceiver::arm(MqttController& controller) {
+    _writer.abort();
+    _controller = &controller;
+    _state = State::ARMED;
+    _error = "";
+    _received = 0;
+    _length = 0;
+    _lastActivityMs = millis();
+    _controller->setOtaReceiver(this);
+}
+
+void MqttOtaReceiver::disarm() {
+    if (_state == State::RECEIVING) {
+        _writer.abort();
+        reply("{\"op\":\"error\",\"msg\":\"cancelled\"}");
+    }
+    if (_controller) {
+        _controller->setOtaReceiver(nullptr);
+        _controller = nullptr;
+    }
+    if (_state != State::DONE && _state != State::FAILED) {
+        _state = State::IDLE;
+    }
+}
+
+int MqttOtaReceiver::progress() const {
+    if (_state != State::RECEIVING || _length <= 0) return -1;
+    return (int)((int64_t)_received * 100 / _length);
+}
+
+void MqttOtaReceiver::onMessage(const char* subtopic, const uint8_t* payload, unsigned int length) {
+    if (_state == State::IDLE) return;
+    if (strcmp(subtopic, "ctl") == 0) {
+        onControl(payload, length);
+    } else if (strcmp(subtopic, "data") == 0) {
+        onData(payload, length);
+    }
+}
+
+void MqttOtaReceiver::reply(const char* json) {
+    if (_controller) _controller->publishOta(json);
+}
+
+void MqttOtaReceiver::sendAck() {
+    char json[40];
+    snprintf(json, sizeof(json), "{\"op\":\"ack\",\"seq\":%ld}", (long)_expectedSeq - 1);
+    reply(json);
+}
+
+void MqttOtaReceiver::fail(const char* error) {
+    LOG_E("MQTT-OTA: %s", error);
+    _writer.abort();
+    _error = error;
+    _state = State::FAILED;
+
+    char json[96];
+    snprintf(json, sizeof(json), "{\"op\":\"error\",\"msg\":\"%s\"}", error);
+    reply(json);
+}
+
+void MqttOtaReceiver::onControl(const uint8_t* payload, unsigned int length) {
+    StaticJsonDocument<512> doc;
+    if (deserializeJson(doc, payload, length)) {
+        reply("{\"op\":\"error\",\"msg\":\"bad json\"}");
+        return;
+    }
+    const char* op = doc["op"] | "";
+    _lastActivityMs = millis();
+
+    if (strcmp(op, "abort") == 0) {
+        if (_state == State::RECEIVING) fail("Aborted by host");
+        return;
+    }
+    if (strcmp(op, "begin") != 0) return;
+
+    // Neustart durch den Host ist erlaubt, solange das Menü offen ist
+    _writer.abort();
+    const char* error = "";
+    if (!_manifest.parse(doc.as<JsonVariantConst>(), error)) {
+        fail(error);
+        return;
+    }
+    _length = doc["length"] | 0;
+    int chunk = doc["chunk"] | (int)MAX_CHUNK;
+    if (_length <= 0 || (!_manifest.compressed && _length != _manifest.size)) {
+        fail("Bad length");
+        return;
+    }
+    if (chunk <= 0 || chunk > MAX_CHUNK) chunk = MAX_CHUNK;
+
+    if (!_writer.begin(_manifest.size, _manifest.compressed, _manifest.sha256)) {
+        // Meist: kein Heap zum Entpacken -> Host soll roh senden
+        fail(_writer.error());
+        return;
+    }
+
+    LOG_I("MQTT-OTA: begin %s, %d bytes (%s)", _manifest.version.c_str(), _length,
+          _manifest.compressed ? "gzip" : "raw");
+    _state = State::RECEIVING;
+    _error = "";
+    _expectedSeq = 0;
+    _received = 0;
+
+    char json[64];
+    snprintf(json, sizeof(json), "{\"op\":\"ready\",\"chunk\":%d,\"window\":%u}", chunk, (unsigned)WINDOW);
+    reply(json);
+}
+
+void MqttOtaReceiver::onData(const uint8_t* payload, unsigned int length) {
+    if (_state != State::RECEIVING || length < 4) return;
+    _lastActivityMs = millis();
+
+    uint32_t seq = (uint32_t)payload[0] | ((uint32_t)payload[1] << 8) |
+                   ((uint32_t)payload[2] << 16) | ((uint32_t)payload[3] << 24);
+    if (seq != _expectedSeq) {
+        // Lücke oder Wiederholung: verwerfen, letztes Ack erneut senden
+        sendAck();
+        return;
+    }
+
+    unsigned int dataLength = length - 4;
+    if (_received + (int)dataLength > _length) {
+        fail("Too much data");
+        return;
+    }
+    if (!_writer.write(payload + 4, dataLength)) {
+        fail(_writer.error());
+        return;
+    }
+    _received += dataLength;
+    _expectedSeq++;
+    sendAck();
+
+    if (_received < _length) return;
+    if (!_writer.finish()) {
+        fail(_writer.error());
+        return;
+    }
+    LOG_I("MQTT-OTA: %s done, %d bytes received, image %d bytes",
+          _manifest.version.c_str(), _received, _writer.imageSize());
+    _state = State::DONE;
+    reply("{\"op\":\"done\"}");
+}
@@ -0,0 +1,87 @@
+#include "OtaHealth.h"
+#include "Log.h"
+#include <esp_ota_ops.h>
+#include <esp_task_wdt.h>
+#include <esp_idf_version.h>
+
+static bool pending = false;
+static uint32_t bootMs = 0;
+
+// Der Arduino-Core markiert neue Images sonst schon vor setup() als gültig
+extern "C" bool verifyRollbackLater() {
+    return true;
+}
+
+// Timeout und Panic gelten für den ganzen Task-Watchdog, also auch für den Idle-Task. Der läuft in dem
+// Tick, den loop() am Ende jedes Durchlaufs fest abgibt (main.cpp); ohne den würde ein ruhiger Loop
+// den Idle-Task verhungern lassen, der Panic-Reset käme dann ohne Hänger und rollte zurück.
+static bool configureWatchdog(uint32_t timeoutS, bool panic) {
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_task_wdt_config_t config = {
+        .timeout_ms = timeoutS * 1000,
+        .idle_core_mask = (1 << portNUM_PROCESSORS) - 1,
+        .trigger_panic = panic,
+    };
+    esp_err_t err = esp_task_wdt_reconfigure(&config);
+#else
+    // IDF 4.x: ein zweiter Aufruf stellt den laufenden Watchdog um
+    esp_err_t err = esp_task_wdt_init(timeoutS, panic);
+#endif
+    if (err != ESP_OK) {
+        LOG_E("OTA: task watchdog (%lu s, panic %d) not configured: %s", (unsigned long)timeoutS, (int)panic,
+              esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
+
+// Der Arduino-Core setzt den Watchdog des Loop-Tasks nach jedem loop() zurück, solange er aktiv ist
+void OtaHealth::setLoopWatchdog(bool on) {
+    if (on) {
+        // Mit Panic, sonst meldet der Watchdog den Hänger nur. Ohne Panic-Konfiguration keine
+        // Loop-Überwachung: ein Watchdog, der nur meldet, bringt keinen Rollback.
+        if (configureWatchdog(LOOP_WDT_S, true)) enableLoopWDT();
+        return;
+    }
+    disableLoopWDT();
+#ifdef CONFIG_ESP_TASK_WDT_PANIC
+    configureWatchdog(CONFIG_ESP_TASK_WDT_TIMEOUT_S, true);
+#else
+    configureWatchdog(CONFIG_ESP_TASK_WDT_TIMEOUT_S, false);
+#endif
+}
+
+void OtaHealth::begin() {
+    const esp_partition_t* running = esp_ota_get_running_partition();
+    esp_ota_img_states_t state;
+    if (esp_ota_get_state_partition(running, &state) != ESP_OK) return;
+
+    pending = (state == ESP_OTA_IMG_PENDING_VERIFY);
+    if (!pending) return;
+
+    bootMs = millis();
+    setLoopWatchdog(true);
+    LOG_I("OTA: new image on %s, health check (%lu s, loop watchdog %lu s)",
+          running->label, (unsigned long)(HEALTH_WINDOW_MS / 1000), (unsigned long)LOOP_WDT_S);
+}
+
+void OtaHealth::loop(bool maintenance) {
+    if (!pending) return;
+
+    if (!maintenance && ESP.getFreeHeap() < MIN_FREE_HEAP) {
+        LOG_E("OTA: health check failed (heap %u), rolling back", (unsigned)ESP.getFreeHeap());
+        Log::flush();
+        esp_ota_mark_app_invalid_rollback_and_reboot();
+        return;
+    }
+    if (millis() - bootMs < HEALTH_WINDOW_MS) return;
+
+    esp_ota_mark_app_valid_cancel_rollback();
+    pending = false;
+    setLoopWatchdog(false);
+    LOG_I("OTA: image marked valid");
+}
+
+bool OtaHealth::pendingVerify() {
+    return pending;
+}
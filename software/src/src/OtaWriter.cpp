@@ -0,0 +1,118 @@
+#include "OtaWriter.h"
+#include <Update.h>
+
+static bool parseSha256(const char* hex, uint8_t* out) {
+    if (!hex || strlen(hex) != 64) return false;
+    for (int i = 0; i < 32; i++) {
+        char byteHex[3] = { hex[2 * i], hex[2 * i + 1], '\0' };
+        if (!isxdigit(byteHex[0]) || !isxdigit(byteHex[1])) return false;
+        out[i] = (uint8_t)strtoul(byteHex, nullptr, 16);
+    }
+    return true;
+}
+
+bool OtaManifest::parse(JsonVariantConst json, const char*& error) {
+    version = json["version"] | "";
+    file = json["file"] | "";
+    raw = json["raw"] | "";
+    size = json["size"] | 0;
+    const char* compression = json["compression"] | "none";
+
+    if (size <= 0 || !parseSha256(json["sha256"].as<const char*>(), sha256)) {
+        error = "Incomplete";
+        return false;
+    }
+    if (strcmp(compression, "gzip") == 0) {
+        compressed = true;
+    } else if (strcmp(compression, "none") == 0) {
+        compressed = false;
+    } else {
+        error = "Compression";
+        return false;
+    }
+    return true;
+}
+
+// =========================================================
+// OtaWriter
+// =========================================================
+
+bool OtaWriter::fail(const char* error) {
+    _error = error;
+    abort();
+    return false;
+}
+
+bool OtaWriter::begin(int imageSize, bool compressed, const uint8_t* sha256) {
+    abort();
+    _error = "";
+    _imageSize = imageSize;
+    _written = 0;
+    _compressed = compressed;
+    _verify = (sha256 != nullptr);
+    if (_verify) memcpy(_expectedSha, sha256, sizeof(_expectedSha));
+
+    // ~43 KB, vor Update.begin holen, damit ein Fehlschlag nichts angefangen hat
+    if (_compressed && !_inflater.begin()) {
+        _error = _inflater.error();
+        return false;
+    }
+    if (!Update.begin(_imageSize, U_FLASH)) {
+        _inflater.end();
+        _error = Update.errorString();
+        return false;
+    }
+    mbedtls_sha256_init(&_sha);
+    mbedtls_sha256_starts(&_sha, 0);
+    _running = true;
+    return true;
+}
+
+bool OtaWriter::writeImage(void* context, const uint8_t* data, size_t length) {
+    OtaWriter* self = static_cast<OtaWriter*>(context);
+    if (self->_written + (int)length > self->_imageSize) return false;
+    mbedtls_sha256_update(&self->_sha, data, length);
+    if (Update.write(const_cast<uint8_t*>(data), length) != length) return false;
+    self->_written += length;
+    return true;
+}
+
+bool OtaWriter::write(const uint8_t* data, size_t length) {
+    if (!_running) return false;
+    if (_compressed) {
+        if (_inflater.feed(data, length, writeImage, this) == GzipInflater::Status::FAILED) {
+            return fail(Update.hasError() ? Update.errorString() : _inflater.error());
+        }
+    } else if (!writeImage(this, data, length)) {
+        return fail(Update.hasError() ? Update.errorString() : "Too big");
+    }
+    return true;
+}
+
+bool OtaWriter::finish() {
+    if (!_running) return false;
+    if (_written != _imageSize) return fail("Truncated");
+
+    if (_verify) {
+        uint8_t sha[32];
+        mbedtls_sha256_finish(&_sha, sha);
+        if (memcmp(sha, _expectedSha, sizeof(sha)) != 0) return fail("SHA-256 mismatch");
+    }
+    _inflater.end();
+    mbedtls_sha256_free(&_sha);
+    _running = false;
+
+    if (!Update.end()) {
+        _error = Update.errorString();
+        return false;
+    }
+    return true;
+}
+
+void OtaWriter::abort() {
+    if (!_running) return;
+    if (Update.isRunning()) Update.abort();
+    _inflater.end();
+    mbedtls_sha256_free(&_sha);
+    _running = false;
+}
@@ -0,0 +1,75 @@
+#include "ReleaseCache.h"
+#include "Log.h"
+#include <Preferences.h>
+
+// NVS-Strings dürfen knapp 4000 Bytes lang sein
+static const size_t MAX_LIST_LENGTH = 3800;
+
+// Format der Liste: "tag\turl\tmanifest\n" pro Release (ältere Einträge ohne Manifest-Spalte)
+bool ReleaseCache::load(const char* url, std::vector<ReleaseInfo>& releases, String& etag) {
+    releases.clear();
+    etag = "";
+
+    Preferences prefs;
+    if (!prefs.begin("releases", true)) return false;
+    String source = prefs.getString("url", "");
+    String list = prefs.getString("list", "");
+    String storedEtag = prefs.getString("etag", "");
+    prefs.end();
+
+    if (source != url || list.isEmpty()) return false;
+
+    int pos = 0;
+    while (pos < (int)list.length()) {
+        int end = list.indexOf('\n', pos);
+        int tab = list.indexOf('\t', pos);
+        if (tab < 0 || end < 0 || tab > end) break;
+        int tab2 = list.indexOf('\t', tab + 1);
+        if (tab2 < 0 || tab2 > end) tab2 = end;
+
+        ReleaseInfo release;
+        release.tagName = list.substring(pos, tab);
+        release.downloadUrl = list.substring(tab + 1, tab2);
+        if (tab2 < end) release.manifestUrl = list.substring(tab2 + 1, end);
+        releases.push_back(release);
+        pos = end + 1;
+    }
+    if (releases.empty()) return false;
+
+    etag = storedEtag;
+    return true;
+}
+
+void ReleaseCache::store(const char* url, const std::vector<ReleaseInfo>& releases, const String& etag) {
+    String list;
+    list.reserve(releases.size() * 200);
+    for (const ReleaseInfo& release : releases) {
+        size_t entryLength = release.tagName.length() + release.downloadUrl.length() + release.manifestUrl.length() + 3;
+        if (list.length() + entryLength > MAX_LIST_LENGTH) break;
+        list += release.tagName;
+        list += '\t';
+        list += release.downloadUrl;
+        list += '\t';
+        list += release.manifestUrl;
+        list += '\n';
+    }
+
+    Preferences prefs;
+    prefs.begin("releases", false);
+    if (!etag.isEmpty() && prefs.getString("etag", "") == etag && prefs.getString("url", "") == url) {
+        prefs.end();
+        return;
+    }
+    prefs.putString("url", url);
+    prefs.putString("list", list);
+    prefs.putString("etag", etag);
+    prefs.end();
+    LOG_I("Release cache stored: %u releases, ETag %s", (unsigned)releases.size(), etag.c_str());
+}
+
+void ReleaseCache::clear() {
+    Preferences prefs;
+    prefs.begin("releases", false);
+    prefs.clear();
+    prefs.end();
+}
@@ -0,0 +1,98 @@
+#include "ScheduleEngine.h"
+
+bool ScheduleEngine::isValid(const ScheduleSlot& slot) {
+    return slot.weekdays != 0 && slot.weekdays < 0x80 &&
+           slot.minuteOfDay < 1440 &&
+           slot.mode <= 2 && slot.speed <= 100 &&
+           slot.airflow <= 1 && slot.cover <= 1;
+}
+
+bool ScheduleEngine::add(const ScheduleSlot& slot) {
+    if (_count >= MAX_SLOTS || !isValid(slot)) return false;
+    _slots[_count++] = slot;
+    return true;
+}
+
+bool ScheduleEngine::decode(const uint8_t* blob, size_t length) {
+    if (!blob || length < BLOB_HEADER || blob[0] != BLOB_FORMAT) return false;
+    size_t count = blob[1];
+    if (count > MAX_SLOTS || length != BLOB_HEADER + count * BLOB_SLOT) return false;
+
+    // Erst alles prüfen, dann übernehmen
+    ScheduleSlot slots[MAX_SLOTS];
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* p = blob + BLOB_HEADER + i * BLOB_SLOT;
+        uint16_t packed = (uint16_t)(p[2] | (p[3] << 8));
+        if (packed & 0x8000) return false;
+
+        ScheduleSlot& s = slots[i];
+        s.weekdays = p[0];
+        s.speed = p[1];
+        s.minuteOfDay = packed & 0x07FF;
+        s.mode = (packed >> 11) & 0x03;
+        s.airflow = (packed >> 13) & 0x01;
+        s.cover = (packed >> 14) & 0x01;
+        if (!isValid(s)) return false;
+    }
+
+    for (size_t i = 0; i < count; i++) _slots[i] = slots[i];
+    _count = count;
+    return true;
+}
+
+size_t ScheduleEngine::encode(uint8_t* out, size_t capacity) const {
+    size_t length = BLOB_HEADER + _count * BLOB_SLOT;
+    if (capacity < length) return 0;
+
+    out[0] = BLOB_FORMAT;
+    out[1] = (uint8_t)_count;
+    for (size_t i = 0; i < _count; i++) {
+        const ScheduleSlot& s = _slots[i];
+        uint8_t* p = out + BLOB_HEADER + i * BLOB_SLOT;
+        uint16_t packed = s.minuteOfDay | (s.mode << 11) | (s.airflow << 13) | (s.cover << 14);
+        p[0] = s.weekdays;
+        p[1] = s.speed;
+        p[2] = packed & 0xFF;
+        p[3] = packed >> 8;
+    }
+    return length;
+}
+
+uint32_t ScheduleEngine::weekSecond(int weekday, int hour, int minute, int second) {
+    return (uint32_t)weekday * SECONDS_PER_DAY + (uint32_t)hour * 3600 + (uint32_t)minute * 60 + (uint32_t)second;
+}
+
+// Höchstens 16 Einträge x 7 Tage: direkt durchrechnen ist billiger als eine sortierte Tabelle,
+// und es passiert nur an Schaltzeitpunkten.
+int ScheduleEngine::activeIndex(uint32_t now) const {
+    now %= SECONDS_PER_WEEK;
+    int best = -1;
+    uint32_t bestAge = SECONDS_PER_WEEK;
+    for (size_t i = 0; i < _count; i++) {
+        for (int day = 0; day < 7; day++) {
+            if (!(_slots[i].weekdays & (1 << day))) continue;
+            uint32_t start = weekSecond(day, 0, _slots[i].minuteOfDay, 0);
+            uint32_t age = (now + SECONDS_PER_WEEK - start) % SECONDS_PER_WEEK;
+            if (age <= bestAge) {
+                bestAge = age;
+                best = (int)i;
+            }
+        }
+    }
+    return best;
+}
+
+uint32_t ScheduleEngine::secondsUntilNext(uint32_t now) const {
+    now %= SECONDS_PER_WEEK;
+    uint32_t best = 0;
+    for (size_t i = 0; i < _count; i++) {
+        for (int day = 0; day < 7; day++) {
+            if (!(_slots[i].weekdays & (1 << day))) continue;
+            uint32_t start = weekSecond(day, 0, _slots[i].minuteOfDay, 0);
+            uint32_t delta = (start + SECONDS_PER_WEEK - now) % SECONDS_PER_WEEK;
+            if (delta == 0) delta = SECONDS_PER_WEEK;
+            if (best == 0 || delta < best) best = delta;
+        }
+    }
+    return best;
+}
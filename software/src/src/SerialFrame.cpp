@@ -0,0 +1,84 @@
+#include "SerialFrame.h"
+#include <string.h>
+
+uint16_t SerialFrame::crc16(const uint8_t* data, size_t length, uint16_t crc) {
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t SerialFrame::cobsEncode(const uint8_t* in, size_t length, uint8_t* out) {
+    size_t codeIndex = 0;
+    size_t write = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (in[i] == 0) {
+            out[codeIndex] = code;
+            codeIndex = write++;
+            code = 1;
+            continue;
+        }
+        out[write++] = in[i];
+        if (++code == 0xFF) {
+            out[codeIndex] = code;
+            codeIndex = write++;
+            code = 1;
+        }
+    }
+    out[codeIndex] = code;
+    return write;
+}
+
+size_t SerialFrame::cobsDecode(const uint8_t* in, size_t length, uint8_t* out) {
+    size_t read = 0;
+    size_t write = 0;
+    while (read < length) {
+        uint8_t code = in[read++];
+        if (code == 0 || read + code - 1 > length) return 0;
+        for (uint8_t i = 1; i < code; i++) {
+            if (in[read] == 0) return 0;
+            out[write++] = in[read++];
+        }
+        // 0xFF-Blöcke haben keine implizite Null, der letzte Block auch nicht
+        if (code != 0xFF && read < length) out[write++] = 0;
+    }
+    return write;
+}
+
+size_t SerialFrame::encode(const Frame& frame, uint8_t* out, size_t capacity) {
+    if (frame.length > MAX_DATA) return 0;
+    uint8_t packet[MAX_PACKET];
+    packet[0] = frame.channel;
+    packet[1] = frame.type;
+    packet[2] = frame.seq;
+    packet[3] = frame.length;
+    if (frame.length > 0) memcpy(packet + HEADER, frame.data, frame.length);
+    size_t length = HEADER + frame.length;
+    uint16_t crc = crc16(packet, length);
+    packet[length++] = (uint8_t)(crc & 0xFF);
+    packet[length++] = (uint8_t)(crc >> 8);
+
+    if (capacity < length + length / 254 + 1 + 2) return 0;
+    out[0] = 0;
+    size_t n = 1 + cobsEncode(packet, length, out + 1);
+    out[n++] = 0;
+    return n;
+}
+
+bool SerialFrame::decode(uint8_t* buffer, size_t length, Frame& frame) {
+    if (length == 0 || length > MAX_ENCODED) return false;
+    size_t n = cobsDecode(buffer, length, buffer);
+    if (n < HEADER + CRC || n != HEADER + buffer[3] + CRC) return false;
+    uint16_t crc = (uint16_t)buffer[n - 2] | ((uint16_t)buffer[n - 1] << 8);
+    if (crc16(buffer, n - CRC) != crc) return false;
+    frame.channel = buffer[0];
+    frame.type = buffer[1];
+    frame.seq = buffer[2];
+    frame.length = buffer[3];
+    frame.data = buffer + HEADER;
+    return true;
+}
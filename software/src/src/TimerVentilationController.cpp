@@ -1,19 +1,33 @@
 #include "TimerVentilationController.h"
+#include "Log.h"
 #include "MaxFanConfig.h"
 #include <string>
-#include <esp_timer.h>
+#include <time.h>
+#include <sys/time.h>
+#include <esp_sntp.h>
+#include <mbedtls/base64.h>
+#include <Preferences.h>
+#include <WiFi.h>
 #include <Arduino.h>
 #include "MaxFanState.h"
 
 // Access the global state object from main
 extern MaxFanState maxFanState;
 
+volatile bool TimerVentilationController::_clockChanged = false;
+
 TimerVentilationController::TimerVentilationController()
-: _lastToggleUs(0), _isRunning(true), _cb(nullptr) {}
+: _timer(nullptr), _due(false), _deadlineUs(-1), _started(false), _syncing(false),
+  _activeSlot(-1), _isRunning(true), _runForUs(0), _pauseForUs(0), _cb(nullptr) {}
 
 void TimerVentilationController::begin(const char* deviceName) {
-    _lastToggleUs = esp_timer_get_time(); // microseconds
-    _isRunning = true;
+    // Ortszeit für Zeitplan und manuelle Uhr, auch ohne SNTP
+    setenv("TZ", GlobalConfig.timeZone, 1);
+    tzset();
+
+    // Zyklus-Dauern einmal aus der Config (seconds -> microseconds)
+    _runForUs = (int64_t)GlobalConfig.timerRunForSeconds * 1000000LL;
+    _pauseForUs = (int64_t)GlobalConfig.timerPauseForSeconds * 1000000LL;
 
     // prepare running state
     {
@@ -22,17 +36,41 @@ void TimerVentilationController::begin(const char* deviceName) {
         _runningState.SetCover(CoverState::OPEN);
         _runningState.SetAirFlow(toMaxFanDirection(af));
         _runningState.SetSpeed(GlobalConfig.timerPercent);
-        _runningState.SetTempCelsius(maxFanState.GetTempCelsius());
     }
     // prepare paused (OFF) state
     {
         _pausedState.SetMode(MaxFanMode::OFF);
         _pausedState.SetCover(CoverState::CLOSED);
-        _pausedState.SetTempCelsius(maxFanState.GetTempCelsius());
     }
 
-    // Immediately apply the configured MANUAL state to global state
-    maxFanState.SetBytes(_runningState.GetStateByte(), _runningState.GetSpeedByte(), _runningState.GetTempByte());
+    loadSchedule();
+
+    if (!_timer) {
+        esp_timer_create_args_t args = {};
+        args.callback = onTimer;
+        args.arg = this;
+        args.dispatch_method = ESP_TIMER_TASK;
+        args.name = "schedule";
+        esp_timer_create(&args, &_timer);
+    }
+
+    // SNTP, wenn WLAN da ist; die Uhr läuft danach auch ohne WLAN weiter (und über Neustarts)
+    if (WiFi.status() == WL_CONNECTED) {
+        sntp_set_time_sync_notification_cb(onTimeSync);
+        configTzTime(GlobalConfig.timeZone, "pool.ntp.org", "time.nist.gov");
+        _syncing = !GlobalConfig.controllerMqtt && !GlobalConfig.controllerHttp;
+        LOG_I("Timer: SNTP gestartet");
+    }
+
+    // Erste Auswertung im ersten loop(): erst dann ist der Kommandoweg (CompositeController) verdrahtet
+    _started = true;
+    _activeSlot = -1;
+    _isRunning = true;
+    _deadlineUs = -1;
+    _due = true;
+
+    LOG_I("Timer: %u Einträge im Plan, Uhr %s", (unsigned)_schedule.count(),
+          clockValid() ? "gestellt" : "nicht gestellt");
 }
 
 void TimerVentilationController::setCommandCallback(CommandCallback cb) {
@@ -48,28 +86,210 @@ bool TimerVentilationController::isConnected() {
     return true;
 }
 
+char TimerVentilationController::getIndicatorLetter() {
+    // Plan vorhanden, aber keine Uhrzeit -> läuft im Zyklus
+    if (!_schedule.empty() && !clockValid()) return 'T';
+    return '\0';
+}
+
 void TimerVentilationController::loop() {
+    if (_clockChanged) {
+        _clockChanged = false;
+        LOG_I("Timer: Uhr gestellt, Plan neu berechnen");
+        if (_syncing) {
+            // WLAN wurde nur für die Uhrzeit gebraucht
+            _syncing = false;
+            WiFi.disconnect(true);
+            WiFi.mode(WIFI_OFF);
+        }
+        _due = true;
+    }
+    if (!_due) return;
+    evaluate();
+}
+
+// =========================================================
+// Auswertung
+// =========================================================
+
+void TimerVentilationController::evaluate() {
+    _due = false;
     int64_t nowUs = esp_timer_get_time();
+    bool expired = (_deadlineUs >= 0 && nowUs >= _deadlineUs);
 
-    // durations from config (seconds -> microseconds)
-    int64_t runForUs = (int64_t)GlobalConfig.timerRunForSeconds * 1000000LL;
-    int64_t pauseForUs = (int64_t)GlobalConfig.timerPauseForSeconds * 1000000LL;
-
-    if (_isRunning) {
-        // currently running MANUAL; wait until runFor elapsed
-        if (nowUs - _lastToggleUs >= runForUs) {
-            // copy paused state's core bytes into global state
-            maxFanState.SetBytes(_pausedState.GetStateByte(), _pausedState.GetSpeedByte(), _pausedState.GetTempByte());
-            _isRunning = false;
-            _lastToggleUs = nowUs;
+    if (_schedule.empty() || !clockValid()) {
+        if (_activeSlot == -1 && _deadlineUs >= 0 && !expired) {
+            // Zyklus läuft schon, nur neu geweckt (z.B. Uhr gestellt ohne Plan)
+            return;
         }
-    } else {
-        // currently paused (OFF); wait until pause elapsed then start MANUAL again
-        if (nowUs - _lastToggleUs >= pauseForUs) {
-            // copy running state's core bytes into global state
-            maxFanState.SetBytes(_runningState.GetStateByte(), _runningState.GetSpeedByte(), _runningState.GetTempByte());
+        if (_activeSlot == -1 && expired) {
+            _isRunning = !_isRunning;
+        } else {
             _isRunning = true;
-            _lastToggleUs = nowUs;
         }
+        _activeSlot = -1;
+        apply(_isRunning ? _runningState : _pausedState);
+        armTimer(_isRunning ? _runForUs : _pauseForUs);
+        return;
+    }
+
+    time_t now = time(nullptr);
+    struct tm local;
+    localtime_r(&now, &local);
+    uint32_t weekSecond = ScheduleEngine::weekSecond((local.tm_wday + 6) % 7, local.tm_hour, local.tm_min, local.tm_sec);
+
+    // Nur bei echtem Wechsel schalten; ein neuer Plan oder eine gestellte Uhr
+    // überschreibt sonst nicht, was der Nutzer inzwischen von Hand eingestellt hat
+    int index = _schedule.activeIndex(weekSecond);
+    if (expired || index != _activeSlot) {
+        const ScheduleSlot& slot = _schedule.slot(index);
+        LOG_I("Timer: Eintrag %d ab %02u:%02u aktiv", index,
+              slot.minuteOfDay / 60, slot.minuteOfDay % 60);
+        apply(stateFor(slot));
+        _activeSlot = index;
+    }
+
+    // Nächster Beginn als Ortszeit; mktime rechnet eine Sommerzeit-Umstellung dazwischen richtig um
+    struct tm target = local;
+    target.tm_sec += _schedule.secondsUntilNext(weekSecond);
+    target.tm_isdst = -1;
+    time_t next = mktime(&target);
+    armTimer((int64_t)max((time_t)1, next - now) * 1000000LL);
+}
+
+void TimerVentilationController::armTimer(int64_t delayUs) {
+    _deadlineUs = esp_timer_get_time() + delayUs;
+    if (!_timer) return;
+    esp_timer_stop(_timer);   // Fehler, wenn er nicht lief: egal
+    esp_timer_start_once(_timer, (uint64_t)delayUs);
+}
+
+void TimerVentilationController::onTimer(void* arg) {
+    // esp_timer-Task: nur markieren, ausgewertet wird in loop()
+    static_cast<TimerVentilationController*>(arg)->_due = true;
+}
+
+void TimerVentilationController::onTimeSync(struct timeval* tv) {
+    _clockChanged = true;
+}
+
+void TimerVentilationController::apply(const MaxFanState& state) {
+    if (!_cb) {
+        // Temperatur bleibt, wie sie ist
+        maxFanState.SetBytes(state.GetStateByte(), state.GetSpeedByte(), maxFanState.GetTempByte());
+        return;
+    }
+    // Über den Kommandokanal wie BLE/MQTT, damit der CompositeController arbitrieren kann
+    StaticJsonDocument<128> doc;
+    doc["mode"] = toString(state.GetMode());
+    doc["cover"] = toString(state.GetCover());
+    doc["airflow"] = toString(state.GetAirFlow());
+    doc["speed"] = state.GetSpeed();
+    char json[MaxFanState::JSON_SIZE];
+    serializeJson(doc, json, sizeof(json));
+    _cb(json);
+}
+
+MaxFanState TimerVentilationController::stateFor(const ScheduleSlot& slot) const {
+    MaxFanState state;
+    state.SetMode(slot.mode == 2 ? MaxFanMode::MANUAL : slot.mode == 1 ? MaxFanMode::AUTO : MaxFanMode::OFF);
+    state.SetCover(slot.cover ? CoverState::OPEN : CoverState::CLOSED);
+    state.SetAirFlow(slot.airflow ? MaxFanDirection::OUT : MaxFanDirection::IN);
+    state.SetSpeed(slot.speed);
+    return state;
+}
+
+// =========================================================
+// Uhr
+// =========================================================
+
+bool TimerVentilationController::clockValid() {
+    return time(nullptr) > CLOCK_VALID_AFTER;
+}
+
+void TimerVentilationController::setManualClock(int weekday, int hour, int minute) {
+    // Ohne Datum: Referenzwoche ab Montag, 1.1.2024 (Winterzeit)
+    struct tm t = {};
+    t.tm_year = 2024 - 1900;
+    t.tm_mon = 0;
+    t.tm_mday = 1 + constrain(weekday, 0, 6);
+    t.tm_hour = constrain(hour, 0, 23);
+    t.tm_min = constrain(minute, 0, 59);
+    t.tm_isdst = -1;
+
+    struct timeval tv = { mktime(&t), 0 };
+    settimeofday(&tv, nullptr);
+    _clockChanged = true;
+    LOG_I("Timer: Uhr von Hand gestellt (Tag %d, %02d:%02d)", weekday, hour, minute);
+}
+
+// =========================================================
+// Kommandos und NVS
+// =========================================================
+
+bool TimerVentilationController::handleCommand(const char* json, MaxError& error) {
+    // Billiger Vorfilter: normale Lüfter-Kommandos gehen unverändert an MaxFanState
+    if (!strstr(json, "\"schedule\"") && !strstr(json, "\"clock\"")) return false;
+
+    StaticJsonDocument<384> doc;
+    if (deserializeJson(doc, json)) {
+        error = MaxError::BLE_PARSE_ERROR;
+        return true;
+    }
+    error = MaxError::NONE;
+
+    if (doc.containsKey("clock")) {
+        time_t utc = doc["clock"] | (time_t)0;
+        if (utc <= CLOCK_VALID_AFTER) {
+            error = MaxError::BLE_INVALID_CLOCK;
+            return true;
+        }
+        struct timeval tv = { utc, 0 };
+        settimeofday(&tv, nullptr);
+        _clockChanged = true;
+        LOG_I("Timer: Uhr per Kommando gestellt");
+    }
+
+    if (doc.containsKey("schedule")) {
+        const char* text = doc["schedule"] | "";
+        uint8_t blob[ScheduleEngine::MAX_BLOB];
+        size_t length = 0;
+        if (mbedtls_base64_decode(blob, sizeof(blob), &length, (const unsigned char*)text, strlen(text)) != 0 ||
+            !storeSchedule(blob, length)) {
+            error = MaxError::BLE_INVALID_SCHEDULE;
+            return true;
+        }
+        LOG_I("Timer: neuer Plan mit %u Einträgen", (unsigned)_schedule.count());
+        // Laufenden Zyklus bzw. Eintrag neu bewerten
+        _activeSlot = -2;
+        _due = _started;
+    }
+    return true;
+}
+
+void TimerVentilationController::loadSchedule() {
+    Preferences prefs;
+    prefs.begin("schedule", true);
+    uint8_t blob[ScheduleEngine::MAX_BLOB];
+    size_t length = prefs.getBytes("blob", blob, sizeof(blob));
+    prefs.end();
+
+    if (length > 0 && !_schedule.decode(blob, length)) {
+        LOG_W("Timer: gespeicherter Plan ungültig");
+        _schedule.clear();
+    }
+}
+
+bool TimerVentilationController::storeSchedule(const uint8_t* blob, size_t length) {
+    Preferences prefs;
+    prefs.begin("schedule", false);
+    bool ok = true;
+    if (length == 0) {
+        _schedule.clear();
+        prefs.remove("blob");
+    } else {
+        ok = _schedule.decode(blob, length) && prefs.putBytes("blob", blob, length) == length;
     }
+    prefs.end();
+    return ok;
 }
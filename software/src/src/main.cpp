@@ -7,13 +7,23 @@
 #include <MaxReceiver.h>
 #include <MaxFanBLE.h>
 #include <MaxFanMQTT.h>
+#include <MaxFanHTTP.h>
+#include <MaxFanSerial.h>
 #include <TimerVentilationController.h>
 #include <MaxFanState.h>
 #include <MaxFanDisplay.h> // Deine alte Display Klasse (für Standard Mode)
 #include <MaxErrors.h>
 #include "MaxFanConfig.h"
 #include "FanController.h"
-#include "NilController.h"
+#include "CompositeController.h"
+#include "MaxFanWiFi.h"
+#include "OtaHealth.h"
+#include "HeapGuard.h"
+#include "StaticSlot.h"
+#include "Log.h"
+#include "DisplayFlush.h"
+#include <esp_timer.h>
+#include <new>
 
 // --- Input & Grafik ---
 #include "Encoder.h"
@@ -38,12 +48,14 @@ MaxFanState maxFanState;
 BleController fanBLE;
 MqttController fanMQTT;
 TimerVentilationController timerController;
+HttpController fanHTTP;
+SerialController fanSerial(Serial);
 MaxRemote fanRemote(2);
 MaxReceiver fanIrReceiver(3);
 
 
 // 2. Inputs
-ChordInput buttons({ENCODER_BUTTON, MODE_BUTTON, COVER_BUTTON});
+ChordInput<ENCODER_BUTTON, MODE_BUTTON, COVER_BUTTON> buttons;
 Encoder encoder(4, 5);
 
 // 3. Displays
@@ -57,19 +69,29 @@ U8G2_SSD1306_128X64_NONAME_F_HW_I2C u8g2(U8G2_R0, /* reset=*/ U8X8_PIN_NONE);
 
 
 // --- State Machine Variablen ---
+// Die Modi brauchen Konstruktor-Argumente, werden also erst in setup() gebaut: in festem Speicher, nicht im Heap.
+// Ausnahme: das Config-Menü (siehe openConfig()).
+StaticSlot<ModeStandard> modeStandardSlot;
+StaticSlot<ModeScreenDark> modeScreenDarkSlot;
 AppMode* currentMode = nullptr;
 ModeStandard* modeStandard = nullptr;
-ModeConfig* modeConfig = nullptr;
+ModeConfig* modeConfig = nullptr;     // nur solange das Menü offen ist
 ModeScreenDark* modeScreenDark = nullptr;
-FanController* activeController = nullptr;
-NilController nilController;
+CompositeController controllers;
+
+// Ticks, die jeder loop()-Durchlauf am Ende abgibt (siehe dort)
+static constexpr TickType_t LOOP_YIELD_TICKS = 1;
 
 
 // --- Callbacks ---
 
-// BLE Callback muss global oder statisch bleiben
-void onBLECommand(const String& json) {
-  MaxError error = maxFanState.SetJson(json);
+// Kommandos aller Controller nach der Arbitrierung im CompositeController; läuft im Loop
+// (BLE und HTTP stellen ihre Kommandos dafür in eine Warteschlange)
+void onBLECommand(const char* json) {
+  MaxError error;
+  // Zeitplan und Uhr gehören dem Timer-Controller, alles andere ist Lüfterzustand
+  if (!timerController.handleCommand(json, error))
+    error = maxFanState.SetJson(json);
   if (error != MaxError::NONE)
     fanDisplay.showError(error);
 }
@@ -82,41 +104,76 @@ void switchMode(AppMode* newMode) {
   }
 }
 
+// Das Config-Menü (Seiten, Items, Jobs samt TLS-Client und Download-Puffer) wird etwa einmal im Monat
+// geöffnet: erst dann bauen und beim Verlassen wieder freigeben. Es ist Wartung (WLAN-Tests, TLS,
+// Updates), dort darf der Loop den Heap benutzen. "Save" und Updates enden mit einem Neustart.
+void openConfig() {
+  HeapGuard::suspend();
+  uint32_t freeBefore = ESP.getFreeHeap();
+  int64_t start = esp_timer_get_time();
+
+  modeConfig = new (std::nothrow) ModeConfig(
+      &u8g2,
+      &encoder,
+      &buttons,
+      maxFanState,
+      fanRemote,
+      fanIrReceiver,
+      controllers,
+      fanMQTT
+  );
+  if (!modeConfig) {
+    LOG_E("Config: out of memory (%u bytes needed, %lu free, largest block %lu)",
+          (unsigned)sizeof(ModeConfig), (unsigned long)freeBefore, (unsigned long)ESP.getMaxAllocHeap());
+    HeapGuard::resume();
+    return;
+  }
+  int64_t built = esp_timer_get_time();
+  switchMode(modeConfig);
+  int64_t shown = esp_timer_get_time();
+
+  LOG_I("Config: menu after %lu ms (build %lu us, first frame %lu us), %lu bytes heap (object %u)",
+        (unsigned long)((shown - start) / 1000), (unsigned long)(built - start), (unsigned long)(shown - built),
+        (unsigned long)(freeBefore - ESP.getFreeHeap()), (unsigned)sizeof(ModeConfig));
+}
+
+void closeConfig() {
+  switchMode(modeStandard);
+  if (!modeConfig) return;
+  uint32_t freeBefore = ESP.getFreeHeap();
+  delete modeConfig;
+  modeConfig = nullptr;
+  LOG_I("Config: released, %lu bytes back, free %lu, largest block %lu",
+        (unsigned long)(ESP.getFreeHeap() - freeBefore), (unsigned long)ESP.getFreeHeap(),
+        (unsigned long)ESP.getMaxAllocHeap());
+  HeapGuard::resume();
+}
+
 void setup() {
   Serial.begin(115200);
+  Log::begin();
   delay(2000); 
 
   ConfigManager::load();
 
-  // If MQTT is selected, try to connect to WiFi using stored credentials
-  if (GlobalConfig.connection == 2) {
-    Serial.print("Attempting WiFi connect to: ");
-    Serial.println(GlobalConfig.wifiSSID);
+  // If MQTT is selected, try to connect to WiFi using stored credentials.
+  // Timer: WLAN nur, um die Uhr per SNTP zu stellen (danach wieder aus).
+  if (GlobalConfig.controllerMqtt || GlobalConfig.controllerTimer || GlobalConfig.controllerHttp) {
+    LOG_I("Attempting WiFi connect to: %s", GlobalConfig.wifiSSID);
     if (strlen(GlobalConfig.wifiSSID) > 0) {
-      WiFi.begin(GlobalConfig.wifiSSID, GlobalConfig.wifiPassword);
-      unsigned long start = millis();
-      while (WiFi.status() != WL_CONNECTED && millis() - start < 10000) {
-        delay(500);
-        Serial.print('.');
-      }
-      Serial.println();
-      if (WiFi.status() == WL_CONNECTED) {
-        Serial.print("WiFi connected, IP: ");
-        Serial.println(WiFi.localIP());
-      } else {
-        Serial.println("WiFi connect failed");
+      if (!WiFiConnector::connect(GlobalConfig.wifiSSID, GlobalConfig.wifiPassword, 10000)) {
+        LOG_W("WiFi connect failed");
       }
     }
   }
 
-  Serial.print("Booting Version: ");
-  Serial.println(APP_VERSION);
+  LOG_I("Booting Version: %s", APP_VERSION);
 
   // 1. Hardware Initialisierung
   // Wire Clock erst setzen, nachdem Displays ggf. initiiert wurden
   // (Je nachdem wie fanDisplay.begin implementiert ist)
   if (!fanDisplay.begin()) { 
-    Serial.println(F("SSD1306 allocation failed (Standard Lib)"));
+    LOG_E("SSD1306 allocation failed (Standard Lib)");
     for (;;); 
   }
   
@@ -124,40 +181,57 @@ void setup() {
   
   Wire.setClock(400000); 
 
+  // Ab hier schickt ein eigener Task die Bilder, der Loop wartet nicht mehr auf I2C
+  DisplayFlush::begin(u8g2);
+
   encoder.begin();
   encoder.reset();
+
+  buttons.begin();
+  // MODE + COVER öffnet das Menü: deren Einzeldruck erst beim Loslassen, damit er nicht vor dem Chord kommt
+  buttons.addChord(MODE_BUTTON, COVER_BUTTON);
   
   fanIrReceiver.begin();
   fanRemote.begin();
   
-    fanBLE.setCommandCallback(onBLECommand);
-    fanBLE.begin();
-
-    fanMQTT.setCommandCallback(onBLECommand);
-    fanMQTT.begin();
-
-    timerController.setCommandCallback(onBLECommand);
-    timerController.begin();
-
-    // Select active remote based on config
-    if (GlobalConfig.connection == 2) {
-      activeController = &fanMQTT;
-      Serial.println("Using MQTT Controller");
-    } else if (GlobalConfig.connection == 3) {
-      activeController = &timerController;
-      Serial.println("Using TIMER Controller");
-    } else if (GlobalConfig.connection == 1) {
-      activeController = &fanBLE;
-      Serial.println("Using BLE Controller");
-    } else {
-      activeController = &nilController;
-      Serial.println("Using NilController (no controller)");
+    // Alle aktivierten Controller laufen gleichzeitig; der CompositeController verteilt den Status
+    // und arbitriert ihre Kommandos (Reihenfolge = Priorität, Timer immer zuletzt)
+    if (GlobalConfig.controllerBle) {
+      fanBLE.begin();
+    }
+
+    // Ohne MQTT-Controller startet erst das MQTT-Update im Menü den Client
+    if (GlobalConfig.controllerMqtt) {
+      fanMQTT.begin();
     }
 
+    if (GlobalConfig.controllerTimer) {
+      timerController.begin();
+    }
+
+    if (GlobalConfig.controllerHttp) {
+      fanHTTP.begin();
+    }
+
+    if (GlobalConfig.controllerSerial) {
+      fanSerial.begin();
+    }
+
+    bool mqttFirst = (GlobalConfig.controllerPriority == 1);
+    if (GlobalConfig.controllerMqtt && mqttFirst) controllers.add(fanMQTT, 0);
+    if (GlobalConfig.controllerBle) controllers.add(fanBLE, 1);
+    if (GlobalConfig.controllerMqtt && !mqttFirst) controllers.add(fanMQTT, 2);
+    if (GlobalConfig.controllerHttp) controllers.add(fanHTTP, 2);
+    if (GlobalConfig.controllerSerial) controllers.add(fanSerial, 2);
+    if (GlobalConfig.controllerTimer) controllers.add(timerController, 3);
+    controllers.setHoldMs((uint32_t)GlobalConfig.controllerHoldSeconds * 1000);
+    controllers.setCommandCallback(onBLECommand);
+    controllers.begin();
+
   // 2. Modi Instanziieren (Dependency Injection)
   // Wir übergeben alle Hardware-Objekte, die der jeweilige Mode braucht.
   
-    modeStandard = new ModeStandard(
+    modeStandard = &modeStandardSlot.emplace(
       u8g2,          
       encoder, 
       buttons,
@@ -165,40 +239,39 @@ void setup() {
       fanDisplay,     
       fanRemote, 
       fanIrReceiver, 
-      (activeController ? *activeController : fanBLE)
+      controllers
     );
 
-  modeConfig = new ModeConfig(
-      &u8g2,           
-      &encoder, 
-      &buttons
-      
-  );
-
-    modeScreenDark = new ModeScreenDark(
+    modeScreenDark = &modeScreenDarkSlot.emplace(
       u8g2,
       encoder,
       buttons,
       maxFanState,
       fanRemote,
       fanIrReceiver,
-      (activeController ? *activeController : fanBLE)
+      controllers
     );
 
   // 3. Start-Modus setzen
   switchMode(modeStandard);
+
+  LOG_I("Heap after boot: free %lu, min. free %lu bytes, sketch %lu bytes (BLE: %s)",
+        (unsigned long)ESP.getFreeHeap(), (unsigned long)ESP.getMinFreeHeap(),
+        (unsigned long)ESP.getSketchSize(), BleTransport::backendName());
+
+  // Nach einem Update: erst nach erfolgreicher Laufzeit als gültig markieren
+  OtaHealth::begin();
+
+  // Ab hier keine Allokationen mehr im Loop
+  HeapGuard::bootComplete();
 }
 
 void loop() {
   
   // --- A. Globale Input Pflege ---
-  // Das muss hier passieren, damit das Entprellen (Debounce) 
-  // unabhängig von der Ausführungszeit des aktuellen Modes funktioniert.
-  static unsigned long lastButtonCheck = 0;
-  if (millis() - lastButtonCheck >= 20) {
-      buttons.tick(); 
-      lastButtonCheck = millis();
-  }
+  // Die Tasten melden Flanken per Interrupt mit Zeitstempel; hier werden sie
+  // entprellt und zu Events. Auch nach einem blockierten Loop geht nichts verloren.
+  buttons.tick(); 
 
   // --- B. Aktuellen Modus ausführen ---
   if (currentMode) {
@@ -208,17 +281,17 @@ void loop() {
       // 2. Prüfen, ob der Modus wechseln will
       switch (action) {
           case ModeAction::SWITCH_TO_CONFIG:
-              Serial.println(F("Main: Switching to Config"));
-              switchMode(modeConfig);
+              LOG_I("Main: Switching to Config");
+              if (!modeConfig) openConfig();
               break;
               
           case ModeAction::SWITCH_TO_STANDARD:
-              Serial.println(F("Main: Switching to Standard"));
-              switchMode(modeStandard);
+              LOG_I("Main: Switching to Standard");
+              closeConfig();
               break;
               
           case ModeAction::SWITCH_TO_SCREEN_DARK:
-              Serial.println(F("Main: Switching to Screen Dark"));
+              LOG_I("Main: Switching to Screen Dark");
               switchMode(modeScreenDark);
               break;
               
@@ -228,8 +301,14 @@ void loop() {
       }
   }
 
-  // Ensure the active remote can service its background tasks (MQTT loop, reconnection)
-  if (activeController) {
-      activeController->loop();
-  }
+  // Ensure the active controllers can service their background tasks (MQTT loop, reconnection)
+  controllers.loop();
+
+  OtaHealth::loop(modeConfig != nullptr);
+  HeapGuard::loop();
+
+  // Der Loop blockiert sonst nirgends (Display, Log und BLE laufen in eigenen Tasks). Jeder Durchlauf
+  // gibt deshalb fest einen Tick ab: darin laufen Log-Task und Idle-Task (Task-Watchdog), unabhängig
+  // davon, ob etwas geloggt wurde. Bei 1000 Hz Tick kostet das 1 ms pro Durchlauf.
+  vTaskDelay(LOOP_YIELD_TICKS);
 }
\ No newline at end of file
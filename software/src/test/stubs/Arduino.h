@@ -0,0 +1,22 @@
+#ifndef TEST_STUB_ARDUINO_H
+#define TEST_STUB_ARDUINO_H
+
+// Host-Tests: nur was die getesteten Module aus Arduino.h brauchen. Die Zeit kommt aus der
+// Test-Uhr in esp_timer.h, Pins und Interrupts sind ohne Wirkung.
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "esp_timer.h"
+
+#define IRAM_ATTR
+#define INPUT_PULLUP 0x05
+#define CHANGE 0x03
+
+inline uint32_t micros() { return (uint32_t)esp_timer_get_time(); }
+inline uint32_t millis() { return (uint32_t)(esp_timer_get_time() / 1000); }
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline int digitalPinToInterrupt(uint8_t pin) { return pin; }
+inline void attachInterruptArg(uint8_t, void (*)(void*), void*, int) {}
+
+#endif
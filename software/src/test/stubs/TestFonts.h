@@ -0,0 +1,291 @@
+// Erzeugt von make_test_fonts.py, nicht von Hand ändern.
+// Nur in EINER Übersetzungseinheit pro Test einbinden (definiert die Font-Daten).
+#ifndef TEST_FONTS_H
+#define TEST_FONTS_H
+
+#include <stdint.h>
+
+extern const uint8_t u8g2_font_helvB18_tf[];
+const uint8_t u8g2_font_helvB18_tf[4819] = {
+    191,0,4,4,5,5,3,5,6,17,22,0,252,18,252,18,252,3,69,6,134,18,184,32,
+    5,0,16,150,33,22,170,17,174,15,88,12,9,49,36,196,136,17,35,70,60,120,240,224,
+    65,0,34,25,240,17,198,68,152,48,97,194,233,210,145,41,91,30,60,112,194,228,193,131,
+    7,3,0,35,28,108,18,182,15,30,60,200,145,35,130,40,81,162,110,228,200,145,227,193,
+    131,7,19,54,108,16,0,36,31,112,18,198,15,30,60,120,240,224,193,3,92,181,106,61,
+    120,144,109,218,180,32,76,42,24,169,96,164,66,1,37,32,81,18,202,112,78,157,58,69,
+    99,14,141,57,52,124,248,80,210,164,137,14,31,62,200,208,32,67,131,212,169,51,38,25,
+    105,18,170,15,30,40,41,82,228,193,131,7,69,98,4,137,49,34,198,136,7,13,0,39,
+    20,142,209,189,15,30,104,232,240,224,193,3,66,182,170,196,120,160,0,40,26,108,18,182,
+    15,18,17,34,117,229,10,25,51,102,204,152,201,241,224,193,131,7,15,2,0,41,26,205,
+    17,186,43,86,172,88,49,163,196,140,18,51,74,204,208,161,227,193,14,29,58,8,0,42,
+    21,175,17,194,15,118,240,224,193,67,92,56,28,60,120,240,224,241,128,0,43,32,143,242,
+    193,55,120,240,224,193,131,7,143,7,15,30,60,216,241,224,193,131,7,15,70,208,48,65,
+    195,4,141,4,44,27,107,18,178,84,172,88,121,240,64,68,10,28,56,112,224,64,114,228,
+    200,145,20,41,82,164,0,45,8,103,212,166,240,192,0,46,27,172,18,182,15,30,60,120,
+    128,97,86,172,88,53,114,228,200,145,227,193,131,7,15,30,56,0,47,27,105,18,170,15,
+    30,156,56,209,226,196,137,19,39,78,156,32,17,130,68,136,19,39,138,20,1,48,31,77,
+    18,186,131,10,21,146,129,5,11,150,66,133,70,76,25,49,101,196,160,66,85,176,96,65,
+    49,168,144,0,49,27,77,18,186,38,86,172,192,130,5,203,138,21,43,86,172,88,177,98,
+    197,138,21,136,10,9,0,50,27,77,18,186,131,10,21,146,129,5,11,138,21,43,112,232,
+    208,129,98,5,14,29,58,238,193,2,51,27,77,18,186,240,224,65,194,161,67,7,138,21,
+    61,116,232,104,177,5,11,22,20,131,10,9,0,52,32,77,18,186,56,116,232,192,130,5,
+    75,13,25,53,100,200,168,33,163,134,140,26,242,96,225,208,161,67,135,14,1,53,26,77,
+    18,186,240,224,1,211,161,67,151,172,22,43,86,172,216,130,5,11,138,65,133,4,0,54,
+    28,77,18,186,86,176,96,169,161,67,199,13,29,186,100,201,146,129,5,11,22,44,40,6,
+    21,18,0,55,27,77,18,186,240,224,65,90,177,98,5,14,29,40,86,172,192,161,67,135,
+    14,29,58,116,28,0,56,29,77,18,186,131,10,21,146,129,5,11,22,44,40,6,21,42,
+    36,3,11,22,44,88,80,12,42,36,0,57,28,77,18,186,131,10,21,146,129,5,11,22,
+    44,40,70,141,26,181,98,5,14,29,58,170,96,41,0,58,25,44,18,182,95,174,60,152,
+    145,35,71,142,28,57,114,228,200,145,35,135,10,21,7,0,59,25,138,18,174,15,30,124,
+    200,144,225,193,3,19,72,140,24,49,98,196,144,32,65,10,0,60,22,176,17,198,15,30,
+    60,120,194,132,137,139,33,39,134,156,112,225,194,133,11,61,22,236,17,182,15,30,60,8,
+    161,226,193,131,7,55,114,228,200,66,198,76,1,62,26,109,18,186,15,30,144,88,177,226,
+    193,131,7,15,30,60,224,130,5,203,131,35,133,10,1,63,27,141,18,186,15,30,60,120,
+    240,224,193,131,7,122,236,152,57,163,67,135,14,29,60,30,12,0,64,26,75,18,178,144,
+    36,73,18,145,34,69,10,18,35,72,60,248,98,197,202,131,7,15,22,0,65,26,169,18,
+    170,15,30,60,120,144,226,196,9,20,39,78,88,192,128,129,10,21,42,15,10,0,66,22,
+    136,18,166,15,86,152,120,240,64,8,17,49,34,76,152,48,241,224,129,3,67,28,77,18,
+    186,131,10,21,146,129,5,11,22,29,58,116,232,208,161,67,7,22,44,40,6,21,18,0,
+    68,26,77,178,185,15,158,36,73,242,224,193,131,7,15,102,60,120,240,160,134,14,29,58,
+    2,0,69,21,9,18,170,15,30,60,120,192,226,196,145,18,17,80,156,56,113,130,0,70,
+    26,75,18,178,240,224,129,193,129,3,7,14,76,146,36,201,192,129,3,7,14,28,56,16,
+    0,71,28,140,18,182,55,114,228,120,240,224,193,131,7,15,76,168,144,81,66,148,40,81,
+    42,30,60,48,0,72,31,111,18,194,52,88,149,178,244,224,193,131,7,15,30,60,120,240,
+    160,72,140,35,49,142,196,224,193,131,199,0,73,22,237,17,186,15,76,172,208,161,67,135,
+    14,29,58,120,232,120,192,67,135,2,74,25,76,18,182,15,30,60,120,144,35,71,142,64,
+    132,8,61,200,113,229,202,149,28,12,0,75,30,143,210,193,15,100,240,224,241,224,1,138,
+    22,45,90,180,104,209,162,69,139,22,90,180,104,217,224,97,0,76,19,170,17,174,38,80,
+    60,120,32,196,200,131,7,18,50,60,64,0,77,32,176,18,198,15,228,197,139,247,224,193,
+    131,7,104,52,133,160,20,2,203,131,7,15,30,60,120,240,224,193,3,6,78,31,176,18,
+    198,15,30,60,32,194,132,17,34,68,15,30,60,120,240,224,193,131,7,15,30,44,97,34,
+    132,9,3,79,28,78,18,190,147,42,85,146,145,37,75,150,44,89,178,100,201,146,37,75,
+    150,44,41,38,85,18,0,80,22,238,17,190,52,118,60,81,242,224,74,150,7,15,30,60,
+    120,240,224,129,2,81,31,207,146,193,15,30,60,120,240,224,129,6,15,30,114,240,224,193,
+    131,7,15,30,105,120,240,224,193,131,199,1,82,28,111,18,194,32,90,116,225,193,131,7,
+    15,30,60,120,240,224,193,201,146,37,27,60,30,60,80,0,83,28,105,18,170,41,78,144,
+    8,65,34,4,137,16,84,168,80,33,17,162,196,131,7,15,30,60,48,0,84,22,104,18,
+    166,15,30,60,120,240,32,132,13,34,68,136,148,48,49,226,129,1,85,32,201,18,170,45,
+    78,156,56,113,226,196,8,17,35,78,156,56,33,98,132,136,17,34,70,136,56,241,224,193,
+    3,6,86,22,238,17,190,26,58,60,120,192,99,199,142,53,104,208,220,217,177,227,129,2,
+    87,23,208,17,198,15,214,168,81,194,132,9,19,38,76,152,60,40,68,66,208,131,3,88,
+    23,13,18,186,15,30,60,120,16,67,201,138,7,15,30,104,26,53,230,193,131,0,89,31,
+    138,18,174,15,82,160,64,129,2,5,10,17,36,68,144,16,65,2,137,17,35,38,80,148,
+    64,129,2,197,1,90,25,170,18,174,15,238,12,18,100,4,5,10,20,40,80,60,120,240,
+    224,193,131,7,10,0,91,27,74,18,174,39,80,144,16,49,67,196,140,27,40,80,160,64,
+    129,226,193,131,7,93,170,8,0,92,18,141,17,186,15,112,232,248,130,229,65,143,120,176,
+    30,44,0,93,36,174,18,190,15,30,216,120,224,130,5,139,7,15,30,60,136,17,227,70,
+    140,27,49,110,196,184,17,227,198,142,29,59,118,24,0,94,23,201,17,170,22,48,12,41,
+    242,0,197,137,17,34,70,136,24,113,226,196,3,2,95,26,72,18,166,15,66,152,48,97,
+    194,132,9,19,38,108,212,152,50,132,12,17,34,38,8,0,96,21,168,17,166,32,34,144,
+    136,64,194,9,17,34,38,76,152,48,241,160,0,97,27,202,18,174,15,30,60,120,97,196,
+    136,145,7,42,80,160,64,129,2,69,164,72,113,30,32,0,98,21,8,18,166,51,106,60,
+    120,240,160,132,132,17,18,76,152,120,240,160,0,99,21,200,17,166,15,30,180,8,49,34,
+    196,16,34,68,136,152,48,97,34,0,100,22,238,17,190,15,68,145,106,241,224,193,131,38,
+    74,30,60,120,112,99,71,2,101,22,12,146,181,15,184,92,121,240,224,129,34,66,55,114,
+    228,64,130,4,7,1,102,20,9,18,170,15,30,60,112,113,226,132,160,64,38,110,152,48,
+    193,0,103,29,173,18,186,15,30,60,120,240,192,18,37,74,97,206,156,121,48,98,197,138,
+    7,15,30,60,24,209,0,104,32,143,18,194,15,30,60,104,33,104,132,160,17,130,70,180,
+    104,209,162,69,139,7,15,100,240,120,240,64,147,37,3,105,28,104,18,166,15,78,152,48,
+    97,130,8,9,19,34,68,136,16,67,132,8,17,18,38,76,60,8,0,106,35,143,18,194,
+    15,58,120,208,17,65,7,15,30,60,14,89,178,100,99,134,141,25,54,102,216,152,193,227,
+    193,131,7,15,6,0,107,23,138,18,174,54,110,220,120,240,64,74,149,42,15,30,60,120,
+    241,32,197,131,5,108,31,206,18,190,43,88,100,201,177,99,199,142,29,59,118,236,216,177,
+    99,199,142,29,91,178,100,201,177,227,129,0,109,28,168,18,166,46,76,152,160,16,130,66,
+    8,34,68,136,152,48,97,226,193,3,19,38,76,60,24,0,110,21,235,17,178,15,30,60,
+    120,240,96,146,164,18,41,92,164,40,114,68,0,111,22,11,18,178,36,114,164,184,98,229,
+    193,131,7,45,82,164,72,145,226,65,1,112,30,206,18,190,15,30,60,120,240,224,193,140,
+    29,91,118,236,216,177,99,135,18,37,74,118,236,216,241,160,1,113,25,240,17,198,15,30,
+    116,248,240,224,193,131,7,248,224,193,131,240,224,193,131,7,6,0,114,30,73,18,170,34,
+    30,60,72,113,226,196,137,19,39,78,156,8,65,34,4,137,16,36,78,68,40,17,161,4,
+    115,25,45,18,186,15,30,60,120,240,224,193,131,22,43,164,216,49,115,67,135,14,29,7,
+    0,116,23,42,18,174,15,80,160,64,98,196,136,9,20,40,80,60,120,32,227,134,17,35,
+    117,23,144,17,198,15,148,176,81,163,132,73,136,36,33,146,48,97,18,225,195,3,1,118,
+    22,44,18,182,15,88,168,120,64,35,71,62,96,57,114,100,154,244,224,65,2,119,22,139,
+    17,178,15,70,36,57,242,160,68,138,20,41,68,148,16,81,66,68,9,120,28,205,18,186,
+    15,30,60,120,240,224,193,131,7,15,182,96,193,242,192,197,138,21,43,114,232,112,0,121,
+    32,201,18,170,15,66,156,56,113,226,196,137,19,39,78,144,8,65,34,4,137,16,39,30,
+    60,48,113,226,196,137,3,122,20,174,17,190,15,196,160,121,128,200,208,9,22,15,30,60,
+    240,241,0,123,17,200,17,166,15,30,60,120,97,194,132,17,19,98,196,0,124,30,77,242,
+    185,15,30,156,88,177,34,73,146,36,73,146,228,8,51,35,204,140,48,51,104,204,208,161,
+    195,1,125,19,172,17,182,44,116,77,90,161,2,9,18,21,42,84,60,72,0,126,25,8,
+    18,166,15,30,172,8,49,34,196,136,24,34,98,80,153,66,194,132,9,19,10,0,160,18,
+    201,17,170,69,138,60,120,112,195,198,155,49,39,30,20,0,161,28,110,178,189,15,110,220,
+    185,115,103,199,142,29,15,76,176,96,97,161,67,135,7,15,30,60,88,0,162,21,40,18,
+    166,27,46,60,120,224,66,132,8,17,47,76,152,48,97,34,1,163,26,46,18,190,15,98,
+    205,122,240,160,206,157,22,44,30,60,120,240,224,193,3,25,59,6,0,164,23,175,145,193,
+    15,30,196,162,245,32,130,135,7,49,120,240,224,193,35,146,37,1,165,27,106,18,174,15,
+    66,160,64,241,224,193,131,7,15,176,132,144,18,66,74,136,22,40,30,4,0,166,22,176,
+    17,198,15,30,148,112,241,160,78,158,60,15,138,48,121,240,224,193,2,167,21,172,17,182,
+    15,30,60,160,145,35,71,142,28,57,98,164,49,146,99,0,168,29,111,18,194,15,30,60,
+    216,129,35,6,30,28,60,120,240,224,193,227,193,131,7,15,122,60,120,64,0,169,29,140,
+    18,182,15,30,60,120,208,66,197,137,16,39,84,168,136,97,66,5,18,36,56,30,60,120,
+    64,0,170,23,139,18,178,15,30,60,120,208,65,201,17,124,240,192,120,208,160,225,193,3,
+    5,171,32,142,18,190,15,30,60,120,240,160,136,146,26,66,106,236,88,131,6,199,142,29,
+    59,118,8,169,33,164,134,16,7,172,26,41,18,170,35,78,156,56,113,226,196,137,27,54,
+    108,216,176,97,195,134,137,19,39,8,0,173,25,13,18,186,128,10,61,8,177,98,197,131,
+    7,15,30,224,208,161,67,135,14,25,15,0,174,27,45,18,186,15,104,36,73,146,36,73,
+    146,36,73,116,232,208,241,224,193,10,27,34,108,16,0,175,23,15,242,193,15,30,60,120,
+    240,96,7,143,7,15,30,60,120,160,131,7,27,45,176,18,231,116,163,19,106,140,8,17,
+    98,68,136,16,51,42,12,0,177,29,143,18,194,56,120,240,232,162,69,203,131,7,55,120,
+    240,224,162,69,7,15,30,60,120,60,120,96,0,178,28,112,18,198,118,242,144,19,39,238,
+    129,145,45,76,152,48,97,194,132,9,19,38,76,152,60,72,0,179,21,136,17,166,20,76,
+    152,48,66,132,8,17,34,68,76,72,24,33,193,0,180,21,73,210,169,15,112,20,41,82,
+    228,65,6,27,24,30,60,120,240,192,0,181,22,206,177,189,56,118,236,216,145,168,82,141,
+    29,59,118,224,120,240,224,129,1,182,19,202,17,174,15,30,60,88,129,2,5,138,78,145,
+    74,132,64,1,183,20,139,209,177,15,30,60,112,145,2,71,137,16,38,66,152,120,80,0,
+    184,31,205,18,186,15,40,112,224,16,67,135,14,29,58,116,232,208,161,67,135,14,29,58,
+    116,104,57,115,230,76,3,185,31,141,210,185,15,30,200,208,161,227,193,131,7,56,100,212,
+    144,81,67,70,13,45,88,86,60,120,240,224,193,0,186,25,174,17,190,15,116,236,216,145,
+    33,70,134,24,59,118,236,32,50,131,200,131,17,44,0,187,31,203,18,178,16,46,72,184,
+    32,225,194,131,7,15,30,180,72,145,34,69,138,20,41,82,60,8,241,224,193,2,188,23,
+    238,17,190,15,34,85,194,177,35,75,150,44,89,178,40,81,178,99,199,14,3,189,20,205,
+    17,186,58,116,60,120,240,224,193,131,7,15,6,21,186,242,0,190,20,141,17,186,15,30,
+    60,120,240,224,1,11,25,83,112,228,120,16,0,191,32,200,18,166,34,76,136,16,33,66,
+    140,16,34,68,136,16,33,66,132,8,17,34,68,136,16,33,98,194,132,9,5,192,19,169,
+    17,170,36,78,156,176,66,69,10,149,19,39,78,60,120,0,193,28,137,18,170,15,156,20,
+    41,242,224,193,136,18,33,72,132,32,17,130,196,137,19,39,78,156,120,0,194,28,172,18,
+    182,15,108,228,200,145,35,71,142,28,57,174,92,49,99,198,204,131,7,15,30,60,72,0,
+    195,35,176,18,198,15,30,36,97,194,132,201,131,7,15,30,60,120,16,194,132,9,19,38,
+    76,60,120,240,224,193,131,38,76,8,0,196,23,107,18,178,15,30,60,112,83,166,204,131,
+    7,45,86,164,72,145,73,146,36,1,197,22,236,17,182,50,114,252,200,97,198,140,25,51,
+    102,204,228,200,145,35,9,3,198,27,137,18,170,15,30,168,56,81,164,196,137,19,39,78,
+    156,56,113,226,196,137,34,42,78,8,0,199,23,168,18,166,16,46,92,120,208,163,70,141,
+    14,23,46,60,120,240,194,132,137,5,200,30,175,18,194,15,30,60,120,240,160,131,7,15,
+    15,30,224,224,177,100,201,146,37,75,150,48,89,194,131,0,201,27,207,17,194,15,30,60,
+    120,240,160,69,139,22,38,74,16,41,65,164,4,13,19,52,76,180,0,202,22,8,18,166,
+    89,166,80,153,50,194,4,17,34,38,76,152,48,97,226,65,1,203,28,110,18,190,15,116,
+    236,216,177,99,199,142,29,15,170,100,201,242,224,193,3,43,59,118,236,24,0,204,29,143,
+    18,194,15,30,60,120,80,38,77,154,7,15,30,60,72,85,170,84,145,37,75,150,44,225,
+    97,0,205,38,205,18,186,15,100,232,176,17,195,70,12,27,49,116,232,208,33,194,134,8,
+    27,34,108,232,208,161,67,135,14,29,58,116,60,120,32,0,206,29,80,18,198,15,30,252,
+    40,97,163,132,157,16,73,152,48,97,194,132,201,19,38,76,152,48,97,146,0,207,23,173,
+    17,186,15,30,152,88,161,67,135,14,29,53,100,212,144,81,67,198,3,6,208,30,110,18,
+    190,15,30,60,120,240,64,198,142,7,47,88,200,56,33,227,132,140,29,59,246,220,81,242,
+    128,0,209,21,9,178,169,37,78,60,120,240,224,193,138,19,39,108,216,176,97,35,0,210,
+    22,238,17,190,15,116,236,200,146,229,193,131,7,15,54,85,218,177,99,7,1,211,21,144,
+    17,198,15,204,168,121,240,224,193,131,7,97,76,25,97,194,36,1,212,25,74,18,174,15,
+    30,60,120,240,160,66,134,12,15,86,160,152,64,98,66,6,26,55,0,213,17,136,17,166,
+    112,226,132,48,67,228,70,141,7,15,20,0,214,34,45,18,186,15,100,232,208,97,35,134,
+    141,24,54,98,216,136,17,129,70,140,8,52,30,60,120,240,96,198,131,7,5,0,215,20,
+    203,17,178,32,82,60,120,240,64,76,25,23,41,146,28,57,242,0,216,26,15,18,194,54,
+    120,240,224,193,131,199,38,75,87,180,104,209,162,69,77,14,9,15,6,0,217,20,141,17,
+    186,15,30,60,168,192,225,193,131,7,62,104,140,57,19,0,218,20,204,17,182,144,38,61,
+    120,240,224,65,11,21,87,174,168,80,193,0,219,20,232,17,166,81,166,152,24,17,98,68,
+    8,19,15,30,60,120,224,0,220,19,138,17,174,15,38,100,24,129,226,65,149,50,40,80,
+    160,64,1,221,25,208,17,198,15,30,60,120,240,224,193,131,32,76,30,60,88,178,197,72,
+    148,7,6,0,222,20,173,17,186,85,176,60,48,115,230,134,14,29,58,212,60,120,176,0,
+    223,26,40,18,166,15,30,168,8,49,34,196,8,19,38,76,152,48,33,66,132,8,57,113,
+    18,0,224,25,138,18,174,23,50,100,168,113,227,198,131,7,41,80,60,88,129,2,197,131,
+    7,15,0,225,21,40,18,166,15,30,60,160,17,66,70,8,19,38,76,60,216,81,131,1,
+    226,31,140,18,182,15,30,60,120,240,224,193,131,67,132,8,69,64,17,1,69,4,20,42,
+    84,200,40,33,163,132,10,227,29,104,18,166,15,30,156,48,241,192,71,141,16,50,66,200,
+    8,33,66,132,8,17,34,68,136,16,225,0,228,25,75,18,178,71,142,28,57,145,34,69,
+    138,20,15,30,88,146,36,233,1,139,20,5,0,229,26,240,17,198,15,30,60,120,240,224,
+    193,131,7,93,16,225,121,240,224,73,144,35,65,2,0,230,23,236,17,182,15,30,60,120,
+    96,35,71,142,28,51,114,60,32,81,67,196,131,4,231,19,142,17,190,15,122,236,216,177,
+    99,199,142,29,123,42,149,96,1,232,21,175,17,194,15,234,224,225,241,224,193,7,15,15,
+    30,60,208,241,128,0,233,25,72,18,166,15,30,24,33,66,132,132,9,19,38,76,152,48,
+    65,101,202,148,10,3,0,234,22,142,17,190,27,108,80,176,241,224,193,131,7,52,140,196,
+    48,242,224,1,3,235,22,45,18,186,178,100,29,121,240,96,151,172,7,15,30,244,120,240,
+    224,65,3,236,22,144,17,198,89,182,32,97,194,132,137,26,53,36,200,144,48,242,224,1,
+    2,237,25,238,17,190,15,104,236,216,177,195,214,184,26,66,106,236,216,177,99,207,157,27,
+    6,0,238,22,8,18,166,33,38,136,152,32,226,193,131,7,15,88,152,48,98,194,68,0,
+    239,19,170,17,174,46,80,160,64,129,2,133,25,50,86,34,197,105,0,240,26,237,17,186,
+    15,30,60,120,160,129,67,139,21,55,116,232,168,33,163,134,140,26,50,16,0,241,25,200,
+    18,166,43,76,152,120,240,224,193,131,18,38,76,88,160,50,101,202,131,7,2,0,242,20,
+    201,17,170,15,30,236,176,209,226,132,13,27,54,66,204,176,65,0,243,28,15,146,193,15,
+    30,60,104,209,194,146,165,26,37,106,148,104,209,162,69,16,20,65,80,60,120,0,244,26,
+    174,17,190,15,114,236,216,33,195,134,12,27,50,108,200,176,17,45,212,131,7,15,2,0,
+    245,26,41,18,170,15,30,60,80,17,99,68,140,17,39,78,156,56,113,226,198,136,24,35,
+    78,0,246,25,240,209,197,15,30,116,248,240,224,193,131,7,15,30,220,232,241,224,129,60,
+    120,32,0,247,21,139,17,178,15,30,100,208,32,34,140,136,48,15,80,164,72,145,34,0,
+    248,27,11,18,178,15,30,60,120,112,34,69,138,20,41,70,144,136,50,34,202,8,18,41,
+    82,8,0,249,19,138,17,174,19,50,60,120,32,2,5,10,20,40,92,60,8,0,250,20,
+    139,17,178,15,38,104,120,96,3,199,3,9,26,30,164,72,17,0,251,27,79,178,193,15,
+    30,60,120,240,128,71,6,25,105,114,240,120,240,32,147,37,75,15,30,60,0,252,21,143,
+    17,194,54,120,60,160,224,225,193,131,7,15,30,60,8,243,32,1,253,31,208,18,198,15,
+    144,48,49,39,78,28,18,38,76,152,48,97,194,132,9,19,38,76,152,60,120,224,8,81,
+    0,254,28,9,18,170,34,78,156,136,49,34,198,136,19,34,70,136,24,33,98,72,145,19,
+    39,78,60,120,0,255,32,15,18,194,15,30,216,224,49,195,198,12,27,51,108,204,176,49,
+    195,198,140,49,51,198,204,224,193,131,7,15,30,0,0,0,0,0,0,
+};
+
+extern const uint8_t u8g2_font_5x7_tf[];
+const uint8_t u8g2_font_5x7_tf[1761] = {
+    191,0,3,3,3,4,3,3,4,5,8,0,255,6,255,7,255,1,62,2,93,6,198,32,
+    5,0,178,1,33,10,52,178,21,146,197,98,81,0,34,11,52,178,25,137,196,98,177,24,
+    0,35,8,52,178,21,7,19,1,36,9,52,178,37,135,198,98,0,37,12,60,178,33,146,
+    196,66,161,88,68,20,38,12,52,178,17,137,68,34,145,88,44,10,39,9,52,178,15,146,
+    199,34,0,40,10,52,178,29,18,137,68,18,0,41,9,52,178,65,135,208,33,0,42,7,
+    52,178,15,175,2,43,10,52,178,15,147,196,98,33,0,44,10,60,174,21,143,197,98,81,
+    0,45,10,52,178,19,139,197,226,48,0,46,10,52,178,27,155,196,98,33,0,47,10,52,
+    178,17,139,197,98,113,0,48,11,60,178,67,11,73,34,162,224,0,49,11,60,178,21,146,
+    197,98,177,208,0,50,10,60,178,67,135,133,66,33,2,51,10,60,178,65,11,5,131,193,
+    1,52,11,60,178,23,146,68,68,181,88,0,53,9,60,178,81,163,67,130,3,54,10,60,
+    178,37,9,197,106,193,1,55,11,60,178,65,15,133,98,177,16,0,56,9,60,178,67,11,
+    210,130,3,57,10,60,178,67,11,206,35,18,0,58,9,52,178,19,135,131,132,0,59,9,
+    60,174,15,7,198,162,0,60,8,52,178,15,141,3,1,61,10,52,178,17,139,197,98,113,
+    0,62,9,52,178,15,15,137,36,0,63,11,52,178,17,139,197,68,162,24,0,64,8,52,
+    178,29,139,131,1,65,8,52,178,51,148,195,1,66,8,52,178,73,135,131,0,67,10,60,
+    178,67,139,197,98,193,1,68,9,52,178,15,137,204,226,0,69,8,52,178,19,150,195,1,
+    70,10,60,178,81,139,213,98,49,0,71,11,52,178,21,139,197,98,177,8,0,72,10,52,
+    178,19,139,133,228,48,0,73,9,52,178,21,161,195,65,0,74,9,52,178,17,7,203,33,
+    0,75,10,52,178,17,139,200,225,32,0,76,8,52,178,49,7,79,1,77,10,52,178,37,
+    135,197,98,17,0,78,8,52,178,41,135,197,1,79,10,60,178,67,139,197,98,193,1,80,
+    9,52,178,25,139,69,133,0,81,8,52,178,15,157,16,1,82,9,52,178,15,143,197,34,
+    0,83,9,52,178,15,141,201,66,0,84,9,52,178,25,139,197,129,0,85,8,52,178,15,
+    149,195,0,86,9,52,178,15,10,137,196,0,87,9,52,178,15,15,141,34,0,88,9,52,
+    178,33,135,195,33,0,89,9,52,178,15,146,199,34,0,90,9,52,178,49,137,195,161,0,
+    91,9,52,178,17,135,131,164,0,92,8,52,178,19,135,139,1,93,9,52,178,45,138,197,
+    162,0,94,9,52,178,19,148,195,65,0,95,8,52,178,15,165,72,1,96,9,52,178,19,
+    139,197,225,0,97,10,52,178,15,139,197,98,17,0,98,9,52,178,35,138,195,129,0,99,
+    8,52,178,27,147,131,1,100,9,52,178,35,137,195,161,0,101,10,52,178,25,139,197,98,
+    49,0,102,8,52,178,59,135,131,0,103,9,60,174,15,7,70,136,0,104,8,52,178,29,
+    139,131,1,105,9,52,178,21,7,197,129,0,106,10,60,174,15,138,197,66,113,0,107,8,
+    52,178,73,156,131,0,108,10,52,178,29,18,201,98,17,0,109,9,52,178,15,157,196,98,
+    0,110,8,52,178,45,149,131,0,111,8,52,178,15,161,67,1,112,10,60,174,17,135,196,
+    225,64,0,113,10,60,174,15,11,137,228,32,0,114,9,52,178,15,138,137,194,0,115,10,
+    52,178,35,137,197,226,64,0,116,10,52,178,15,10,137,68,49,0,117,8,52,178,15,11,
+    75,1,118,8,52,178,51,135,71,1,119,9,52,178,15,19,201,33,0,120,9,52,178,29,
+    18,137,164,0,121,9,60,174,25,163,195,65,0,122,9,52,178,15,142,197,66,0,123,10,
+    52,178,25,155,196,98,49,0,124,8,52,178,15,165,67,0,125,9,52,178,15,138,197,164,
+    0,126,10,52,178,19,135,197,98,49,0,160,8,52,178,15,151,132,1,161,8,52,178,41,
+    142,3,1,162,8,52,178,41,140,131,1,163,10,52,178,19,140,197,226,32,0,164,10,52,
+    178,21,11,137,100,81,0,165,8,52,178,15,139,138,1,166,10,52,178,15,138,137,68,33,
+    0,167,10,52,178,15,137,201,98,33,0,168,9,52,178,15,17,197,129,0,169,9,52,178,
+    29,141,197,98,0,170,8,52,178,45,164,67,0,171,9,52,178,21,139,131,226,0,172,10,
+    52,178,17,139,69,99,81,0,173,9,52,178,19,139,199,97,0,174,11,52,178,15,137,69,
+    98,177,8,0,175,9,52,178,49,7,198,162,0,176,9,52,178,37,142,197,162,0,177,9,
+    52,178,21,11,201,193,0,178,9,52,178,27,11,202,33,0,179,10,52,178,15,11,137,98,
+    33,0,180,9,52,178,37,135,196,129,0,181,9,52,178,25,139,197,226,0,182,8,52,178,
+    15,15,13,1,183,10,52,178,21,11,137,98,97,0,184,10,52,178,25,137,196,225,16,0,
+    185,9,52,178,17,135,67,196,0,186,9,52,178,17,7,206,65,0,187,8,52,178,29,157,
+    131,0,188,8,52,178,27,135,197,1,189,9,52,178,15,138,133,196,0,190,8,52,178,15,
+    13,134,1,191,8,52,178,35,150,131,1,192,9,52,178,27,139,137,194,0,193,8,52,178,
+    15,157,196,1,194,9,52,178,81,139,197,226,0,195,9,52,178,15,7,69,162,0,196,8,
+    52,178,43,157,131,0,197,8,52,178,73,142,131,0,198,9,52,178,43,146,197,65,0,199,
+    9,52,178,21,137,195,161,0,200,9,52,178,15,135,77,66,0,201,9,52,178,15,14,137,
+    98,0,202,11,52,178,25,139,69,34,145,40,0,203,8,52,178,49,135,135,1,204,8,52,
+    178,15,7,197,1,205,9,52,178,15,138,197,194,0,206,9,52,178,59,138,197,65,0,207,
+    8,52,178,75,135,67,0,208,9,52,178,43,137,195,33,0,209,9,52,178,15,15,137,66,
+    0,210,9,52,178,15,153,200,97,0,211,9,52,178,15,11,199,66,0,212,10,52,178,35,
+    138,197,226,48,0,213,8,52,178,15,138,135,1,214,9,52,178,25,7,197,65,0,215,8,
+    52,178,15,33,78,1,216,11,52,178,17,139,197,34,113,16,0,217,10,52,178,17,141,197,
+    98,81,0,218,9,52,178,15,137,131,132,0,219,8,52,178,15,165,67,0,220,8,52,178,
+    27,140,131,1,221,10,52,178,17,139,131,228,16,0,222,9,52,178,25,19,201,97,0,223,
+    9,52,178,21,135,67,132,0,224,9,52,178,21,139,131,226,0,225,8,52,178,49,135,195,
+    1,226,11,52,178,21,139,197,98,177,8,0,227,12,52,178,17,139,197,34,145,88,12,0,
+    228,9,52,178,29,139,197,65,0,229,8,52,178,35,157,131,1,230,8,52,178,21,165,67,
+    1,231,10,52,178,17,139,196,225,48,0,232,10,52,178,35,7,197,98,49,0,233,9,52,
+    178,65,140,197,129,0,234,11,52,178,19,11,201,98,177,16,0,235,7,52,178,93,7,3,
+    236,8,52,178,45,135,196,1,237,9,52,178,29,139,208,33,0,238,9,52,178,29,139,197,
+    162,0,239,10,52,178,15,137,196,226,32,0,240,9,52,178,73,137,197,194,0,241,8,52,
+    178,51,135,131,1,242,9,52,178,27,162,196,97,0,243,8,52,178,15,135,13,1,244,8,
+    52,178,15,157,131,0,245,9,52,178,29,139,69,136,0,246,10,52,178,49,137,197,98,113,
+    0,247,8,52,178,45,7,133,1,248,8,52,178,27,155,67,1,249,8,52,178,15,14,197,
+    1,250,9,52,178,15,138,77,194,0,251,8,52,178,73,141,195,0,252,7,52,178,109,135,
+    2,253,7,52,178,109,135,2,254,10,52,178,15,138,197,98,33,0,255,9,52,178,27,19,
+    197,194,0,0,0,0,0,0,0,
+};
+
+#endif
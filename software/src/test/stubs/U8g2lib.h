@@ -0,0 +1,185 @@
+#ifndef U8G2LIB_H
+#define U8G2LIB_H
+
+// Host-Modell von U8G2 für einen 128x64 Full-Buffer-Treiber (SSD1306-Layout: Pages zu 8 Zeilen,
+// ein Byte pro Spalte, Bit 0 oben). Zeichnet wie u8g2: Fonts im U8g2-Format mit Glyphensuche,
+// Bitfeld-RLE und hline in den Puffer, Clip-Fenster, DrawColor 0/1/2 (XOR), FontMode 0/1.
+// Gesendet wird nichts; sendBuffer() zählt nur. Fonts liefert TestFonts.h.
+#include <stdint.h>
+#include <string.h>
+
+extern const uint8_t u8g2_font_helvB18_tf[];
+extern const uint8_t u8g2_font_5x7_tf[];
+
+class U8G2 {
+public:
+    static constexpr int WIDTH = 128;
+    static constexpr int HEIGHT = 64;
+
+    // Wie beim echten Treiber ist der Puffer statisch: Kopien von U8G2 zeichnen in denselben
+    uint8_t* getBufferPtr() { return frameBuffer(); }
+    uint8_t getBufferTileWidth() { return WIDTH / 8; }
+    uint8_t getBufferTileHeight() { return HEIGHT / 8; }
+    int getDisplayWidth() { return WIDTH; }
+    int getDisplayHeight() { return HEIGHT; }
+
+    void clearBuffer() { memset(frameBuffer(), 0, WIDTH * HEIGHT / 8); }
+    void sendBuffer() { sends++; }
+    void setPowerSave(uint8_t) {}
+
+    void setFont(const uint8_t* f) { _font = f; }
+    void setFontMode(uint8_t mode) { _transparent = mode != 0; }
+    void setDrawColor(uint8_t color) { _color = color; }
+    void setClipWindow(int x0, int y0, int x1, int y1) {
+        _clipX0 = x0; _clipY0 = y0; _clipX1 = x1; _clipY1 = y1;
+    }
+    void setMaxClipWindow() { setClipWindow(0, 0, WIDTH, HEIGHT); }
+
+    // u8g2_DrawHVLine (waagrecht) mit Clipping -> u8g2_ll_hvline_vertical_top_lsb
+    void drawHLine(int x, int y, int length) { drawHLine(x, y, length, _color); }
+    void drawBox(int x, int y, int w, int h) {
+        for (int row = 0; row < h; row++) drawHLine(x, y + row, w);
+    }
+
+    int drawGlyph(int x, int y, uint16_t code) {
+        const uint8_t* data = glyphData(code);
+        if (!data) return 0;
+        Decode d = { data, 0, 0, 0, x, y, 0, 0 };
+        d.w = getUnsigned(d, _font[4]);
+        d.h = getUnsigned(d, _font[5]);
+        int8_t gx = getSigned(d, _font[6]);
+        int8_t gy = getSigned(d, _font[7]);
+        int8_t dx = getSigned(d, _font[8]);
+        if (d.w > 0) {
+            d.tx += gx;
+            d.ty -= d.h + gy;
+            for (;;) {
+                uint8_t zeros = getUnsigned(d, _font[2]);
+                uint8_t ones = getUnsigned(d, _font[3]);
+                do {
+                    decodeRun(d, zeros, false);
+                    decodeRun(d, ones, true);
+                } while (getUnsigned(d, 1) != 0);
+                if (d.y >= d.h) break;
+            }
+        }
+        return dx;
+    }
+    int drawStr(int x, int y, const char* s) {
+        int start = x;
+        while (*s) x += drawGlyph(x, y, (uint8_t)*s++);
+        return x - start;
+    }
+    int drawUTF8(int x, int y, const char* s) {
+        int start = x;
+        while (*s) {
+            uint16_t c = (uint8_t)*s++;
+            if (c >= 0xC0 && *s) c = ((c & 0x1F) << 6) | (*s++ & 0x3F);
+            x += drawGlyph(x, y, c);
+        }
+        return x - start;
+    }
+
+    // u8g2_GetStrWidth: Summe der Vorschübe, beim letzten Zeichen die Breite samt x-Offset
+    int getStrWidth(const char* s) {
+        int width = 0, dx = 0, lastWidth = 0, lastOffset = 0;
+        for (; *s; s++) {
+            const uint8_t* data = glyphData((uint8_t)*s);
+            if (!data) continue;
+            Decode d = { data, 0, 0, 0, 0, 0, 0, 0 };
+            lastWidth = getUnsigned(d, _font[4]);
+            getUnsigned(d, _font[5]);
+            lastOffset = getSigned(d, _font[6]);
+            getSigned(d, _font[7]);
+            dx = getSigned(d, _font[8]);
+            width += dx;
+        }
+        if (lastWidth != 0) width += lastWidth + lastOffset - dx;
+        return width;
+    }
+    int getMaxCharWidth() { return _font[9]; }
+
+    int sends = 0;
+
+private:
+    struct Decode {
+        const uint8_t* ptr;
+        uint8_t bitPos;
+        int8_t w, h;
+        int tx, ty;
+        int x, y;
+    };
+
+    static uint8_t* frameBuffer() {
+        static uint8_t buffer[WIDTH * HEIGHT / 8];
+        return buffer;
+    }
+
+    const uint8_t* _font = nullptr;
+    uint8_t _color = 1;
+    bool _transparent = false;
+    int _clipX0 = 0, _clipY0 = 0, _clipX1 = WIDTH, _clipY1 = HEIGHT;
+    // Rest von u8g2_t (Callbacks, Display-Info, Font-Decoder), damit eine Kopie so viel kostet wie im Gerät
+    uint8_t _state[100] = {};
+
+    void drawHLine(int x, int y, int length, uint8_t color) {
+        if (y < _clipY0 || y >= _clipY1) return;
+        if (x < _clipX0) { length -= _clipX0 - x; x = _clipX0; }
+        if (x + length > _clipX1) length = _clipX1 - x;
+        if (length <= 0) return;
+        uint8_t mask = 1 << (y & 7);
+        uint8_t* p = frameBuffer() + (y >> 3) * WIDTH + x;
+        do {
+            if (color == 2) *p ^= mask;
+            else if (color) *p |= mask;
+            else *p &= ~mask;
+            p++;
+        } while (--length);
+    }
+
+    uint8_t getUnsigned(Decode& d, uint8_t count) {
+        uint8_t value = *d.ptr >> d.bitPos;
+        uint8_t end = d.bitPos + count;
+        if (end >= 8) {
+            d.ptr++;
+            value |= *d.ptr << (8 - d.bitPos);
+            end -= 8;
+        }
+        d.bitPos = end;
+        return value & ((1U << count) - 1);
+    }
+    int8_t getSigned(Decode& d, uint8_t count) {
+        return (int8_t)getUnsigned(d, count) - (1 << (count - 1));
+    }
+
+    // u8g2_font_decode_len: Lauf über Zeilengrenzen, Hintergrund nur bei FontMode 0
+    void decodeRun(Decode& d, uint8_t length, bool foreground) {
+        uint8_t count = length;
+        for (;;) {
+            uint8_t rest = d.w - d.x;
+            uint8_t current = count < rest ? count : rest;
+            if (foreground) drawHLine(d.tx + d.x, d.ty + d.y, current, _color);
+            else if (!_transparent) drawHLine(d.tx + d.x, d.ty + d.y, current, _color == 0 ? 1 : 0);
+            if (count < rest) break;
+            count -= rest;
+            d.x = 0;
+            d.y++;
+        }
+        d.x += count;
+    }
+
+    // u8g2_font_get_glyph_data: Sprung zu 'A'/'a', dann linear bis zum Zeichen (nur bis 0xFF)
+    const uint8_t* glyphData(uint16_t code) {
+        if (!_font || code > 0xFF) return nullptr;
+        const uint8_t* p = _font + 23;
+        if (code >= 'a') p += (_font[19] << 8) | _font[20];
+        else if (code >= 'A') p += (_font[17] << 8) | _font[18];
+        for (;;) {
+            if (p[1] == 0) return nullptr;
+            if (p[0] == code) return p + 2;
+            p += p[1];
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef TEST_STUB_ESP_TIMER_H
+#define TEST_STUB_ESP_TIMER_H
+
+// Host-Tests: Uhr, die der Test selbst stellt (fakeTimeUs() = ...), statt des Hardware-Timers
+#include <stdint.h>
+
+inline int64_t& fakeTimeUs() {
+    static int64_t now = 0;
+    return now;
+}
+
+inline int64_t esp_timer_get_time() { return fakeTimeUs(); }
+
+#endif
@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+# Erzeugt TestFonts.h: Fonts im U8g2-Format (Header, Bitfelder, RLE) für die Host-Tests.
+# Keine echten Zeichensätze, aber die gleichen Größen und das gleiche Format wie im Gerät:
+#   u8g2_font_helvB18_tf  große Anzeige (Drehzahl/Temperatur), 191 Zeichen wie das Original
+#   u8g2_font_5x7_tf      Menü, Monospace mit 5 px Vorschub
+# Aufruf: python3 make_test_fonts.py > TestFonts.h
+import random
+
+DIGITS = {  # 5x7-Raster, für beide Fonts
+    '0': ["01110", "10001", "10011", "10101", "11001", "10001", "01110"],
+    '1': ["00100", "01100", "00100", "00100", "00100", "00100", "01110"],
+    '2': ["01110", "10001", "00001", "00010", "00100", "01000", "11111"],
+    '3': ["11111", "00010", "00100", "00010", "00001", "10001", "01110"],
+    '4': ["00010", "00110", "01010", "10010", "11111", "00010", "00010"],
+    '5': ["11111", "10000", "11110", "00001", "00001", "10001", "01110"],
+    '6': ["00110", "01000", "10000", "11110", "10001", "10001", "01110"],
+    '7': ["11111", "00001", "00010", "00100", "01000", "01000", "01000"],
+    '8': ["01110", "10001", "10001", "01110", "10001", "10001", "01110"],
+    '9': ["01110", "10001", "10001", "01111", "00001", "00010", "01100"],
+    '%': ["11001", "11010", "00010", "00100", "01000", "01011", "10011"],
+    'C': ["01110", "10001", "10000", "10000", "10000", "10001", "01110"],
+    'O': ["01110", "10001", "10001", "10001", "10001", "10001", "01110"],
+    'F': ["11111", "10000", "10000", "11110", "10000", "10000", "10000"],
+}
+CODES = list(range(0x20, 0x7f)) + list(range(0xa0, 0x100))
+
+
+def scale(pattern, w, h):
+    return [[int(pattern[r * 7 // h][c * 5 // w]) for c in range(w)] for r in range(h)]
+
+
+def bars(rng, w, h, count):
+    # Ein paar Balken, damit die RLE-Läufe ähnlich lang sind wie bei echten Zeichen
+    bm = [[0] * w for _ in range(h)]
+    for _ in range(count):
+        x0, y0 = rng.randint(0, w - 2), rng.randint(0, h - 2)
+        x1, y1 = rng.randint(x0 + 1, w), rng.randint(y0 + 1, h)
+        if rng.random() < 0.5:
+            x1 = min(w, x0 + max(1, w // 4))
+        else:
+            y1 = min(h, y0 + max(1, h // 6))
+        for r in range(y0, y1):
+            for c in range(x0, x1):
+                bm[r][c] = 1
+    return bm
+
+
+def helv_glyphs():
+    rng = random.Random(18)
+    glyphs = {}
+    for ch, p in DIGITS.items():
+        w = {'%': 17, 'O': 14, 'F': 11}.get(ch, 13)
+        glyphs[ord(ch)] = (scale(p, w, 18), 0, 0, w + 1)
+    glyphs[0xB0] = ([[1 if (abs(r - 3) + abs(c - 3)) in (2, 3) else 0 for c in range(7)] for r in range(7)], 1, 11, 8)
+    glyphs[ord('-')] = ([[1] * 7 for _ in range(3)], 1, 6, 9)
+    glyphs[ord(' ')] = ([], 0, 0, 5)
+    for c in CODES:
+        if c in glyphs:
+            continue
+        w, h = rng.randint(8, 16), rng.randint(12, 22)
+        glyphs[c] = (bars(rng, w, h, 4), 0, -rng.randint(0, 4) if rng.random() < .2 else 0, w + 1)
+    # Kopf: max. Breite/Höhe, x/y-Offset, Ascent A, Descent g, Ascent/Descent für Klammern
+    return glyphs, (4, 4, 5, 5, 3, 5, 6), (17, 22, 0, -4, 18, -4, 18, -4)
+
+
+def small_glyphs():
+    rng = random.Random(7)
+    glyphs = {}
+    for ch, p in DIGITS.items():
+        glyphs[ord(ch)] = (scale(p, 4, 7), 0, 0, 5)
+    glyphs[ord(' ')] = ([], 0, 0, 5)
+    for c in CODES:
+        if c in glyphs:
+            continue
+        descent = -1 if chr(c) in "gjpqy,;" else 0
+        glyphs[c] = (bars(rng, 4, 7 if descent else 6, 2), 0, descent, 5)
+    return glyphs, (3, 3, 3, 4, 3, 3, 4), (5, 8, 0, -1, 6, -1, 7, -1)
+
+
+class Bits:
+    def __init__(self):
+        self.out, self.acc, self.n = [], 0, 0
+
+    def put(self, v, cnt):
+        for i in range(cnt):
+            self.acc |= ((v >> i) & 1) << self.n
+            self.n += 1
+            if self.n == 8:
+                self.out.append(self.acc)
+                self.acc, self.n = 0, 0
+
+    def put_signed(self, v, cnt):
+        self.put(v + (1 << (cnt - 1)), cnt)
+
+    def done(self):
+        if self.n:
+            self.out.append(self.acc)
+        return self.out
+
+
+def encode_glyph(code, glyph, bits):
+    bm, gx, gy, dx = glyph
+    b0, b1, bw, bh, bx, by, bd = bits
+    h = len(bm)
+    w = len(bm[0]) if h else 0
+    b = Bits()
+    b.put(w, bw)
+    b.put(h, bh)
+    b.put_signed(gx, bx)
+    b.put_signed(gy, by)
+    b.put_signed(dx, bd)
+    px = [v for row in bm for v in row]
+    i = 0
+    while i < len(px):
+        zeros = 0
+        while i < len(px) and px[i] == 0 and zeros < (1 << b0) - 1:
+            zeros += 1
+            i += 1
+        ones = 0
+        while i < len(px) and px[i] == 1 and ones < (1 << b1) - 1:
+            ones += 1
+            i += 1
+        b.put(zeros, b0)
+        b.put(ones, b1)
+        b.put(0, 1)   # keine Wiederholung
+    data = b.done()
+    return [code, len(data) + 2] + data
+
+
+def make_font(glyphs, bits, metrics):
+    body, pos_A, pos_a = [], 0, 0
+    for c in CODES:
+        if c == ord('A'):
+            pos_A = len(body)
+        if c == ord('a'):
+            pos_a = len(body)
+        body += encode_glyph(c, glyphs[c], bits)
+    body += [0, 0]
+    unicode_table = len(body)
+    body += [0, 0, 0, 0]
+    header = [len(CODES), 0, *bits, *[m & 0xff for m in metrics],
+              pos_A >> 8, pos_A & 255, pos_a >> 8, pos_a & 255, unicode_table >> 8, unicode_table & 255]
+    assert len(header) == 23
+    return header + body
+
+
+def emit(name, font):
+    print("extern const uint8_t %s[];" % name)
+    print("const uint8_t %s[%d] = {" % (name, len(font)))
+    for i in range(0, len(font), 24):
+        print("    " + ",".join(str(v) for v in font[i:i + 24]) + ",")
+    print("};")
+
+
+print("// Erzeugt von make_test_fonts.py, nicht von Hand ändern.")
+print("// Nur in EINER Übersetzungseinheit pro Test einbinden (definiert die Font-Daten).")
+print("#ifndef TEST_FONTS_H")
+print("#define TEST_FONTS_H")
+print()
+print("#include <stdint.h>")
+print()
+emit("u8g2_font_helvB18_tf", make_font(*helv_glyphs()))
+print()
+emit("u8g2_font_5x7_tf", make_font(*small_glyphs()))
+print()
+print("#endif")
@@ -0,0 +1,15 @@
+#ifndef TEST_STUB_GPIO_STRUCT_H
+#define TEST_STUB_GPIO_STRUCT_H
+
+// Host-Tests: GPIO.in als normale Variable (nur für ChordInput<Pins...>::readHardware)
+#include <stdint.h>
+
+struct gpio_dev_t {
+    union {
+        uint32_t val;
+    } in;
+};
+
+inline volatile gpio_dev_t GPIO = {};
+
+#endif
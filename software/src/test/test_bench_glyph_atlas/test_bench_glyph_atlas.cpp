@@ -0,0 +1,175 @@
+// Benchmark: große Anzeige (helvB18) über den U8g2-Font-Decoder (alte Version) gegen den GlyphAtlas.
+// Prüft, dass beide pixelgleich zeichnen, auch an den Rändern, und gibt die Zeiten pro Frame aus.
+// U8G2 und die Fonts sind die Host-Modelle aus test/stubs (Decoder wie in u8g2, helvB18-Metriken).
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include "GlyphAtlas.h"
+#include "TestFonts.h"
+
+static constexpr int ITERATIONS = 200000;
+static constexpr size_t FRAME_BYTES = 1024;
+
+// --- Alte Version (MaxFanDisplay vor dem Atlas) ---
+
+// arduino-esp32 2.x: String mit SSO, die kurzen Anzeigetexte liegen nicht im Heap.
+// Nachgebildet als Formatieren und Kopieren.
+struct LegacyString {
+    char buffer[16];
+    size_t length = 0;
+
+    LegacyString() { buffer[0] = '\0'; }
+    explicit LegacyString(int value) { length = snprintf(buffer, sizeof(buffer), "%d", value); }
+    LegacyString operator+(const char* text) const {
+        LegacyString result(*this);
+        size_t n = strlen(text);
+        memcpy(result.buffer + result.length, text, n + 1);
+        result.length += n;
+        return result;
+    }
+    const char* c_str() const { return buffer; }
+};
+
+// U8G2 als Wert wie früher: jede Anzeige kopiert das Objekt
+__attribute__((noinline)) static void legacyDrawManual(int speed, U8G2 u8g2) {
+    u8g2.setDrawColor(1);
+    u8g2.setFont(u8g2_font_helvB18_tf);
+    LegacyString s;
+    s = LegacyString(speed) + " %";
+    u8g2.drawStr(35, 42, s.c_str());
+}
+
+__attribute__((noinline)) static void legacyDrawAuto(int temp, U8G2 u8g2) {
+    u8g2.setDrawColor(1);
+    u8g2.setFont(u8g2_font_helvB18_tf);
+    LegacyString s;
+    s = LegacyString(temp) + " \xC2\xB0" "C";
+    u8g2.drawUTF8(35, 42, s.c_str());
+}
+
+// --- Neue Version (MaxFanDisplay::drawReadout) ---
+
+static const uint16_t READOUT_GLYPHS[] = {
+    '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', ' ', '-', '%', 0xB0, 'C', 'O', 'F'
+};
+
+static U8G2 display;
+static GlyphAtlas atlas;
+
+__attribute__((noinline)) static void drawReadout(int value, const char* unit) {
+    display.setDrawColor(1);
+    int x = atlas.drawNumber(display, 35, 42, value);
+    atlas.drawStr(display, x, 42, unit);
+}
+
+// --- Hilfen ---
+
+static uint8_t reference[FRAME_BYTES];
+
+static bool hasInk() {
+    const uint8_t* frame = display.getBufferPtr();
+    for (size_t i = 0; i < FRAME_BYTES; i++) {
+        if (frame[i]) return true;
+    }
+    return false;
+}
+
+static void keepFrame() {
+    memcpy(reference, display.getBufferPtr(), FRAME_BYTES);
+    display.clearBuffer();
+}
+
+static void assertSameFrame(const char* what, int value) {
+    if (memcmp(reference, display.getBufferPtr(), FRAME_BYTES) == 0) return;
+    char message[80];
+    snprintf(message, sizeof(message), "%s %d: Atlas weicht vom Decoder ab", what, value);
+    TEST_FAIL_MESSAGE(message);
+}
+
+template <typename F>
+static double nsPerFrame(F&& draw) {
+    volatile uint8_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) {
+        draw(i % 101);
+        sink = sink + display.getBufferPtr()[5 * 128 + 40];
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+static void report(const char* what, double before, double after) {
+    char line[120];
+    snprintf(line, sizeof(line), "%s: %.1f ns -> %.1f ns pro Frame (%.1fx)", what, before, after,
+             after > 0 ? before / after : 0.0);
+    TEST_MESSAGE(line);
+}
+
+void setUp() {
+    display.setMaxClipWindow();
+    display.clearBuffer();
+}
+
+void tearDown() {}
+
+void test_atlas_fits() {
+    TEST_ASSERT_TRUE(atlas.build(display, u8g2_font_helvB18_tf, READOUT_GLYPHS,
+                                 sizeof(READOUT_GLYPHS) / sizeof(READOUT_GLYPHS[0])));
+    TEST_ASSERT_TRUE(atlas.ready());
+    TEST_ASSERT_TRUE(atlas.bytesUsed() <= GlyphAtlas::MAX_BYTES);
+    char line[100];
+    snprintf(line, sizeof(line), "Atlas: %u von %u Bytes, GlyphAtlas %u Bytes RAM",
+             (unsigned)atlas.bytesUsed(), (unsigned)GlyphAtlas::MAX_BYTES, (unsigned)sizeof(GlyphAtlas));
+    TEST_MESSAGE(line);
+}
+
+void test_readouts_match_decoder() {
+    for (int value = -40; value <= 120; value++) {
+        legacyDrawManual(value, display);
+        TEST_ASSERT_TRUE(hasInk());
+        keepFrame();
+        drawReadout(value, " %");
+        assertSameFrame("Manuell", value);
+        display.clearBuffer();
+
+        legacyDrawAuto(value, display);
+        keepFrame();
+        drawReadout(value, " \xB0" "C");
+        assertSameFrame("Auto", value);
+        display.clearBuffer();
+    }
+}
+
+void test_clipped_positions_match_decoder() {
+    // Teils außerhalb des Bildschirms, links/rechts und oben/unten
+    static const char TEXT[] = "-8% OFF\xB0";
+    for (int y = -5; y < 80; y += 3) {
+        for (int x = -20; x < 130; x += 7) {
+            display.setFont(u8g2_font_helvB18_tf);
+            display.drawStr(x, y, TEXT);
+            keepFrame();
+            atlas.drawStr(display, x, y, TEXT);
+            assertSameFrame("Position", y * 1000 + x);
+            display.clearBuffer();
+        }
+    }
+}
+
+void test_readout_is_timed() {
+    double before = nsPerFrame([](int v) { legacyDrawManual(v, display); });
+    double after = nsPerFrame([](int v) { drawReadout(v, " %"); });
+    report("Manuell", before, after);
+    double autoBefore = nsPerFrame([](int v) { legacyDrawAuto(v - 30, display); });
+    double autoAfter = nsPerFrame([](int v) { drawReadout(v - 30, " \xB0" "C"); });
+    report("Auto", autoBefore, autoAfter);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_atlas_fits);
+    RUN_TEST(test_readouts_match_decoder);
+    RUN_TEST(test_clipped_positions_match_decoder);
+    RUN_TEST(test_readout_is_timed);
+    return UNITY_END();
+}
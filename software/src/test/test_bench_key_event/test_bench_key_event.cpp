@@ -0,0 +1,139 @@
+// Micro-Benchmark: KeyEvent mit Laufzeit-Pin-Map (alte Version) gegen die Compile-Zeit-Masken,
+// und das Lesen der Tasten mit digitalRead() pro Pin gegen einen Zugriff auf GPIO.in.
+// Prüft, dass beide Varianten dasselbe liefern, und gibt die Zeiten pro Aufruf aus.
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <vector>
+#include "ChordInput.h"
+#include "MaxFanConstants.h"
+
+static constexpr int ITERATIONS = 2000000;
+
+// --- Alte Version (vor ChordInput<Pins...>) ---
+
+struct LegacyKeyEvent {
+    uint16_t mask;
+    const std::vector<int>* pinMap;
+
+    int getBitIndex(int pinId) const {
+        if (!pinMap) return -1;
+        for (size_t i = 0; i < pinMap->size(); ++i) {
+            if ((*pinMap)[i] == pinId) return (int)i;
+        }
+        return -1;
+    }
+    bool IsSingle(int pinId) const {
+        int idx = getBitIndex(pinId);
+        if (idx < 0) return false;
+        return mask == (uint16_t)(1 << idx);
+    }
+    bool IsChord(int pinIdA, int pinIdB) const {
+        int idxA = getBitIndex(pinIdA);
+        int idxB = getBitIndex(pinIdB);
+        if (idxA < 0 || idxB < 0) return false;
+        return mask == (uint16_t)((1 << idxA) | (1 << idxB));
+    }
+};
+
+// digitalRead() ist auf dem ESP32 ein Funktionsaufruf mit Registerzugriff
+static volatile int pinLevel[32];
+__attribute__((noinline)) static int legacyDigitalRead(int pin) { return pinLevel[pin]; }
+
+static const std::vector<int> legacyPins = { ENCODER_BUTTON, MODE_BUTTON, COVER_BUTTON };
+
+static uint16_t legacyReadHardware() {
+    uint16_t inputMask = 0;
+    for (size_t i = 0; i < legacyPins.size(); ++i) {
+        if (legacyDigitalRead(legacyPins[i]) == 0) inputMask |= (1 << i);
+    }
+    return inputMask;
+}
+
+// --- Neue Version ---
+
+using Buttons = ChordInput<ENCODER_BUTTON, MODE_BUTTON, COVER_BUTTON>;
+
+// --- Hilfen ---
+
+// Dispatch wie in ModeStandard::loop()
+template <typename Event>
+static int dispatch(const Event& e) {
+    if (e.IsSingle(ENCODER_BUTTON)) return 1;
+    if (e.IsSingle(COVER_BUTTON)) return 2;
+    if (e.IsSingle(MODE_BUTTON)) return 3;
+    if (e.IsChord(MODE_BUTTON, COVER_BUTTON)) return 4;
+    return 0;
+}
+
+// Alle Tastenkombinationen in beiden Darstellungen
+static constexpr int COMBINATIONS = 8;
+static LegacyKeyEvent legacyEvents[COMBINATIONS];
+static KeyEvent events[COMBINATIONS];
+
+static void buildEvents() {
+    for (int m = 0; m < COMBINATIONS; m++) {
+        uint32_t gpioMask = 0;
+        for (int i = 0; i < 3; i++) {
+            if (m & (1 << i)) gpioMask |= KeyEvent::pinBit(legacyPins[i]);
+        }
+        legacyEvents[m] = LegacyKeyEvent{ (uint16_t)m, &legacyPins };
+        events[m] = KeyEvent(gpioMask);
+    }
+}
+
+template <typename F>
+static double nsPerCall(F&& body) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++) body(i);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / ITERATIONS;
+}
+
+static void report(const char* what, double before, double after) {
+    char line[120];
+    snprintf(line, sizeof(line), "%s: %.2f ns -> %.2f ns pro Aufruf (%.1fx)", what, before, after,
+             after > 0 ? before / after : 0.0);
+    TEST_MESSAGE(line);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_dispatch_matches_legacy_and_is_timed() {
+    buildEvents();
+    for (int m = 0; m < COMBINATIONS; m++) {
+        TEST_ASSERT_EQUAL_INT(dispatch(legacyEvents[m]), dispatch(events[m]));
+    }
+
+    volatile int sink = 0;
+    double before = nsPerCall([&](int i) { sink = sink + dispatch(legacyEvents[i & (COMBINATIONS - 1)]); });
+    double after = nsPerCall([&](int i) { sink = sink + dispatch(events[i & (COMBINATIONS - 1)]); });
+    report("Dispatch (ModeStandard)", before, after);
+}
+
+void test_read_hardware_matches_legacy_and_is_timed() {
+    for (int m = 0; m < COMBINATIONS; m++) {
+        uint32_t gpio = 0xFFFFFFFFu;
+        for (int i = 0; i < 3; i++) {
+            bool pressed = m & (1 << i);
+            pinLevel[legacyPins[i]] = pressed ? 0 : 1;
+            if (pressed) gpio &= ~KeyEvent::pinBit(legacyPins[i]);
+        }
+        GPIO.in.val = gpio;
+        TEST_ASSERT_EQUAL_INT(dispatch(LegacyKeyEvent{ legacyReadHardware(), &legacyPins }),
+                              dispatch(KeyEvent(Buttons::readHardware())));
+    }
+
+    volatile uint32_t sink = 0;
+    double before = nsPerCall([&](int) { sink = sink + legacyReadHardware(); });
+    double after = nsPerCall([&](int) { sink = sink + Buttons::readHardware(); });
+    report("readHardware", before, after);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_dispatch_matches_legacy_and_is_timed);
+    RUN_TEST(test_read_hardware_matches_legacy_and_is_timed);
+    return UNITY_END();
+}
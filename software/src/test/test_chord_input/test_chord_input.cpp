@@ -0,0 +1,275 @@
+// Flankenfolgen gegen eine Test-Uhr: EdgeDebouncer allein und ChordRecognizer wie aus der ISR gefüttert
+#include <unity.h>
+#include "ChordInput.h"
+
+static constexpr uint32_t A = KeyEvent::pinBit(8);
+static constexpr uint32_t B = KeyEvent::pinBit(9);
+
+// ChordRecognizer ohne Hardware: edge() entspricht einem Interrupt, pins dem Pegel an den Pins
+class FakeButtons : public ChordRecognizer {
+public:
+    uint32_t pins = 0;
+
+    void begin(uint32_t mask) {
+        pins = mask;
+        start(mask);
+    }
+    void edge(uint32_t mask) {
+        pins = mask;
+        onEdge(mask);
+    }
+
+protected:
+    uint32_t readPins() const override { return pins; }
+};
+
+static FakeButtons* buttons;
+
+static void at(int64_t us) { fakeTimeUs() = us; }
+static void edgeAt(int64_t us, uint32_t mask) {
+    at(us);
+    buttons->edge(mask);
+}
+static void tickAt(int64_t us) {
+    at(us);
+    buttons->tick();
+}
+
+static KeyEvent nextEvent() {
+    TEST_ASSERT_TRUE(buttons->hasEvent());
+    return buttons->popEvent();
+}
+
+void setUp() {
+    at(0);
+    buttons = new FakeButtons();
+    buttons->begin(0);
+}
+
+void tearDown() {
+    delete buttons;
+}
+
+// --- EdgeDebouncer ---
+
+void test_debouncer_ignores_bounce_shorter_than_window() {
+    EdgeDebouncer d(10000);
+    uint32_t stable, atUs;
+    d.reset(0, 0);
+    TEST_ASSERT_FALSE(d.feed(1000, 1, stable, atUs));
+    TEST_ASSERT_FALSE(d.feed(1500, 0, stable, atUs));
+    TEST_ASSERT_FALSE(d.feed(2000, 1, stable, atUs));
+    TEST_ASSERT_FALSE(d.poll(11999, stable, atUs));
+    TEST_ASSERT_TRUE(d.poll(12000, stable, atUs));
+    TEST_ASSERT_EQUAL_UINT32(1, stable);
+    TEST_ASSERT_EQUAL_UINT32(2000, atUs);
+    TEST_ASSERT_EQUAL_UINT32(1, d.stableMask());
+}
+
+void test_debouncer_commits_on_next_edge_without_poll() {
+    EdgeDebouncer d(10000);
+    uint32_t stable, atUs;
+    d.reset(0, 0);
+    d.feed(1000, 1, stable, atUs);
+    // Nächste Flanke nach 30 ms: der vorherige Zustand wird mit dem Zeitstempel seiner Flanke stabil
+    TEST_ASSERT_TRUE(d.feed(31000, 0, stable, atUs));
+    TEST_ASSERT_EQUAL_UINT32(1, stable);
+    TEST_ASSERT_EQUAL_UINT32(1000, atUs);
+    TEST_ASSERT_TRUE(d.poll(41000, stable, atUs));
+    TEST_ASSERT_EQUAL_UINT32(0, stable);
+}
+
+void test_debouncer_handles_timer_wrap() {
+    EdgeDebouncer d(10000);
+    uint32_t stable, atUs;
+    d.reset(0, 0xFFFFF000u);
+    d.feed(0xFFFFFF00u, 1, stable, atUs);
+    TEST_ASSERT_FALSE(d.poll(0x00001000u, stable, atUs));
+    TEST_ASSERT_TRUE(d.poll(0x00002800u, stable, atUs));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFF00u, atUs);
+}
+
+// --- ChordRecognizer ---
+
+void test_press_survives_busy_loop() {
+    // 50 ms Druck, der Loop tickt erst eine halbe Sekunde später
+    edgeAt(1000, A);
+    edgeAt(51000, 0);
+    tickAt(500000);
+    KeyEvent e = nextEvent();
+    TEST_ASSERT_TRUE(e.type == KeyEventType::PRESS);
+    TEST_ASSERT_EQUAL_HEX32(A, e.mask);
+    TEST_ASSERT_EQUAL_UINT32(1000, e.pressTimeUs);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+}
+
+void test_bouncing_press_gives_one_event() {
+    edgeAt(1000, A);
+    edgeAt(1300, 0);
+    edgeAt(1700, A);
+    edgeAt(2100, 0);
+    edgeAt(2400, A);
+    tickAt(5000);
+    TEST_ASSERT_FALSE(buttons->IsKeyDown(8));
+    tickAt(12400);
+    TEST_ASSERT_TRUE(buttons->IsKeyDown(8));
+    edgeAt(90000, 0);
+    edgeAt(90200, A);
+    edgeAt(90500, 0);
+    tickAt(200000);
+    TEST_ASSERT_EQUAL_HEX32(A, nextEvent().mask);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+}
+
+void test_short_tap_inside_chord_window() {
+    edgeAt(1000, A);
+    edgeAt(30000, 0);
+    tickAt(45000);
+    KeyEvent e = nextEvent();
+    TEST_ASSERT_TRUE(e.IsSingle(8));
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+}
+
+void test_chord_of_two_keys() {
+    edgeAt(1000, A);
+    tickAt(15000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+    edgeAt(30000, A | B);
+    tickAt(45000);
+    KeyEvent e = nextEvent();
+    TEST_ASSERT_TRUE(e.IsChord(8, 9));
+    edgeAt(100000, 0);
+    tickAt(150000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+}
+
+void test_long_press_and_repeat() {
+    edgeAt(1000, A);
+    tickAt(100000);
+    TEST_ASSERT_TRUE(nextEvent().IsSingle(8));
+    tickAt(601000);
+    TEST_ASSERT_TRUE(nextEvent().IsLongPress(8));
+    tickAt(700000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+    tickAt(801000);
+    TEST_ASSERT_TRUE(nextEvent().IsRepeat(8));
+    edgeAt(850000, 0);
+    tickAt(900000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+}
+
+void test_cancelled_chord_emits_nothing_until_release() {
+    edgeAt(1000, A);
+    tickAt(15000);
+    buttons->CancelCurrentChord();
+    tickAt(700000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+    edgeAt(800000, 0);
+    tickAt(900000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+}
+
+void test_chord_key_press_held_back_until_release() {
+    buttons->addChord(8, 9);
+    // A etwas vor B: kein Einzel-PRESS für A, obwohl das Chord-Fenster abgelaufen ist
+    edgeAt(1000, A);
+    tickAt(150000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+    edgeAt(160000, A | B);
+    tickAt(200000);
+    TEST_ASSERT_TRUE(nextEvent().IsChord(8, 9));
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+    edgeAt(300000, 0);
+    tickAt(400000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+
+    // Allein gedrückt und losgelassen: der Chord ist ausgeschlossen, jetzt kommt der PRESS
+    edgeAt(1000000, A);
+    tickAt(1150000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+    edgeAt(1200000, 0);
+    tickAt(1250000);
+    KeyEvent e = nextEvent();
+    TEST_ASSERT_TRUE(e.IsSingle(8));
+    TEST_ASSERT_EQUAL_UINT32(1000000, e.pressTimeUs);
+}
+
+void test_chord_key_long_press_replaces_press() {
+    buttons->addChord(8, 9);
+    edgeAt(1000, A);
+    tickAt(601000);
+    TEST_ASSERT_TRUE(nextEvent().IsLongPress(8));
+    edgeAt(700000, 0);
+    tickAt(750000);
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+}
+
+void test_other_keys_keep_chord_window_latency() {
+    buttons->addChord(8, 9);
+    edgeAt(1000, KeyEvent::pinBit(10));
+    tickAt(70000);
+    TEST_ASSERT_TRUE(nextEvent().IsSingle(10));
+}
+
+void test_double_press_replaces_second_press() {
+    buttons->setDoublePress(8, true);
+    edgeAt(1000, A);
+    edgeAt(40000, 0);
+    tickAt(60000);
+    TEST_ASSERT_TRUE(nextEvent().IsSingle(8));
+    edgeAt(200000, A);
+    edgeAt(240000, 0);
+    tickAt(260000);
+    TEST_ASSERT_TRUE(nextEvent().IsDoublePress(8));
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+
+    // Zu spät für einen Doppelklick: normaler PRESS
+    edgeAt(900000, A);
+    edgeAt(940000, 0);
+    tickAt(960000);
+    TEST_ASSERT_TRUE(nextEvent().IsSingle(8));
+}
+
+void test_without_double_press_two_presses() {
+    edgeAt(1000, A);
+    edgeAt(40000, 0);
+    edgeAt(200000, A);
+    edgeAt(240000, 0);
+    tickAt(300000);
+    TEST_ASSERT_TRUE(nextEvent().IsSingle(8));
+    TEST_ASSERT_TRUE(nextEvent().IsSingle(8));
+    TEST_ASSERT_FALSE(buttons->hasEvent());
+}
+
+void test_edge_overflow_resyncs_from_pins() {
+    // Mehr Flanken als der Puffer fasst, ohne tick(): die letzten gehen verloren,
+    // tick() liest danach den echten Pegel
+    for (int i = 0; i < 80; i++) {
+        edgeAt(1000 + i * 100, (i & 1) ? 0 : A);
+    }
+    buttons->pins = A;
+    tickAt(20000);
+    TEST_ASSERT_GREATER_THAN(0, buttons->getDroppedEdges());
+    tickAt(40000);
+    TEST_ASSERT_TRUE(buttons->IsKeyDown(8));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_debouncer_ignores_bounce_shorter_than_window);
+    RUN_TEST(test_debouncer_commits_on_next_edge_without_poll);
+    RUN_TEST(test_debouncer_handles_timer_wrap);
+    RUN_TEST(test_press_survives_busy_loop);
+    RUN_TEST(test_bouncing_press_gives_one_event);
+    RUN_TEST(test_short_tap_inside_chord_window);
+    RUN_TEST(test_chord_of_two_keys);
+    RUN_TEST(test_long_press_and_repeat);
+    RUN_TEST(test_cancelled_chord_emits_nothing_until_release);
+    RUN_TEST(test_chord_key_press_held_back_until_release);
+    RUN_TEST(test_chord_key_long_press_replaces_press);
+    RUN_TEST(test_other_keys_keep_chord_window_latency);
+    RUN_TEST(test_double_press_replaces_second_press);
+    RUN_TEST(test_without_double_press_two_presses);
+    RUN_TEST(test_edge_overflow_resyncs_from_pins);
+    return UNITY_END();
+}
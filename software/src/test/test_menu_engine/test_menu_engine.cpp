@@ -0,0 +1,368 @@
+// Menü auf dem Host: Tasten -> Editor -> Übernehmen ins Modell, und wie viel pro Taste neu
+// gezeichnet und gesendet wird. Display ist das U8G2-Modell aus test/stubs, DisplayFlush ein
+// Ersatz, der wie der Display-Task nur geänderte Tiles zählt.
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include "MenuEngine.h"
+#include "DisplayFlush.h"
+#include "TestFonts.h"
+
+// --- DisplayFlush-Ersatz ---
+
+static uint8_t shownFrame[DisplayFlush::FRAME_BYTES];
+static int submits = 0;
+static int tilesSent = 0;
+
+void DisplayFlush::submit(U8G2& display) {
+    // Wie sendChanged(): pro Page vom ersten bis zum letzten geänderten Tile
+    const uint8_t* frame = display.getBufferPtr();
+    int width = display.getBufferTileWidth();
+    for (int page = 0; page < display.getBufferTileHeight(); page++) {
+        int first = -1, last = -1;
+        for (int tile = 0; tile < width; tile++) {
+            size_t at = (page * width + tile) * 8;
+            if (memcmp(frame + at, shownFrame + at, 8) == 0) continue;
+            if (first < 0) first = tile;
+            last = tile;
+        }
+        if (first >= 0) tilesSent += last - first + 1;
+    }
+    memcpy(shownFrame, frame, sizeof(shownFrame));
+    submits++;
+}
+
+// --- Modell und Tabellen wie in ModeConfig ---
+
+struct Model {
+    bool ble;
+    int pin;
+    int port;
+    char name[12];
+    int hold;
+    char airflow[4];
+    int actions;
+};
+
+static int listPicked = -1;
+static Model* current = nullptr;
+
+static void onAction() { current->actions++; }
+static void onList(uint8_t index) { listPicked = index; }
+
+#define FIELD(field) MENU_FIELD(Model, field)
+
+enum : uint8_t { PAGE_MAIN, PAGE_SUB, PAGE_COUNT };
+
+static constexpr MenuOption HOLD_OPTIONS[] = { {"Off", 0}, {"1min", 60}, {"10min", 600} };
+static constexpr MenuSelect HOLD = menuOptions(HOLD_OPTIONS);
+static constexpr MenuOption AIRFLOW_OPTIONS[] = { {"In", "IN"}, {"Out", "OUT"} };
+static constexpr MenuSelect AIRFLOW = menuOptions(AIRFLOW_OPTIONS, true);
+
+static constexpr MenuItem MAIN_ITEMS[] = {
+    MenuItem::link("More", PAGE_SUB),                     // 0
+    menuToggle<FIELD(ble)>("BLE"),                        // 1
+    menuPin<FIELD(pin)>("PIN"),                           // 2
+    menuNumber<FIELD(port)>("Port", 5, 1, 65535),         // 3
+    menuText<FIELD(name)>("Name"),                        // 4
+    menuSelect<FIELD(hold)>("Hold", HOLD),                // 5
+    menuSelect<FIELD(airflow)>("Air", AIRFLOW),           // 6
+    MenuItem::button("Run", onAction),                    // 7, erst nach dem Scrollen sichtbar
+    MenuItem::info("Ver", "1.0"),                         // 8
+};
+static constexpr MenuItem SUB_ITEMS[] = {
+    MenuItem::info("Info", "x"),
+    MenuItem::back(),
+};
+static constexpr MenuPage PAGES[] = {
+    menuPage("Main", MAIN_ITEMS, MenuEngine::NO_PAGE),
+    menuPage("Sub", SUB_ITEMS, PAGE_MAIN),
+};
+static_assert(sizeof(PAGES) / sizeof(PAGES[0]) == PAGE_COUNT, "Seitentabelle");
+// Die Tabellen sind Konstanten: im Gerät .rodata (Flash), nicht RAM
+static_assert(PAGES[PAGE_MAIN].items[3].max == 65535, "Tabellen zur Übersetzungszeit");
+
+using Key = MenuEngine::Key;
+
+static U8G2 display;
+static Model model;
+static MenuEngine* menu;
+
+void setUp() {
+    memset(&model, 0, sizeof(model));
+    model.pin = 1234;           // zu kurz für 6 Stellen
+    model.port = 1883;
+    strcpy(model.name, "van");
+    model.hold = 60;
+    strcpy(model.airflow, "IN");
+    current = &model;
+    listPicked = -1;
+    display.setMaxClipWindow();
+    memset(shownFrame, 0, sizeof(shownFrame));
+    menu = new MenuEngine(display, PAGES, PAGE_COUNT, &model);
+    menu->setPage(PAGE_MAIN, 0);
+    menu->draw();
+    submits = 0;
+    tilesSent = 0;
+}
+
+void tearDown() {
+    delete menu;
+}
+
+static void goTo(uint8_t index) {
+    while (menu->cursor() != index) menu->press(Key::DOWN);
+    menu->render();
+    tilesSent = 0;
+}
+
+// --- Editoren ---
+
+void test_toggle_flips_and_redraws_one_row() {
+    goTo(1);
+    menu->press(Key::OK);
+    TEST_ASSERT_TRUE(model.ble);
+    TEST_ASSERT_FALSE(menu->editing());
+    TEST_ASSERT_EQUAL_UINT8(1, menu->render());
+    menu->press(Key::OK);
+    TEST_ASSERT_FALSE(model.ble);
+}
+
+void test_pin_clamps_and_keeps_six_digits() {
+    goTo(2);
+    menu->press(Key::OK);
+    TEST_ASSERT_TRUE(menu->editing());
+    // 1234 liegt unter 100000: der Editor beginnt bei 100000
+    menu->press(Key::DOWN);                 // erste Ziffer 1 -> 9 (läuft 1..9)
+    menu->press(Key::RIGHT);
+    menu->press(Key::UP);                   // 0 -> 1
+    menu->press(Key::OK);
+    TEST_ASSERT_FALSE(menu->editing());
+    TEST_ASSERT_EQUAL_INT(910000, model.pin);
+
+    // Erste Ziffer nie 0: von 9 weiter über 1
+    menu->press(Key::OK);
+    for (int i = 0; i < 8; i++) menu->press(Key::UP);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_INT(810000, model.pin);
+}
+
+void test_number_clamps_on_commit() {
+    goTo(3);
+    menu->press(Key::OK);
+    // 01883 -> 91883 liegt über 65535
+    for (int i = 0; i < 9; i++) menu->press(Key::UP);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_INT(65535, model.port);
+
+    // 00000 liegt unter 1
+    model.port = 1;
+    menu->press(Key::OK);
+    for (int i = 0; i < 4; i++) menu->press(Key::RIGHT);
+    menu->press(Key::DOWN);                 // 00001 -> 00000
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_INT(1, model.port);
+}
+
+void test_text_edit_trims_trailing_spaces() {
+    goTo(4);
+    menu->press(Key::OK);
+    // "van" + 8 Leerzeichen: vierte Stelle ' ' -> 'a', fünfte bleibt leer
+    for (int i = 0; i < 3; i++) menu->press(Key::RIGHT);
+    menu->press(Key::UP);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_STRING("vana", model.name);
+
+    // Letztes Zeichen zurück auf ' ': wird abgeschnitten
+    menu->press(Key::OK);
+    for (int i = 0; i < 3; i++) menu->press(Key::RIGHT);
+    menu->press(Key::DOWN);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_STRING("van", model.name);
+}
+
+void test_text_cursor_stays_inside_field() {
+    goTo(4);
+    menu->press(Key::OK);
+    for (int i = 0; i < 40; i++) menu->press(Key::RIGHT);
+    menu->press(Key::UP);
+    menu->press(Key::OK);
+    // sizeof(name) - 1 = 11 Stellen, die letzte ist geändert
+    TEST_ASSERT_EQUAL_STRING("van       a", model.name);
+    TEST_ASSERT_EQUAL(11, strlen(model.name));
+}
+
+void test_select_int_stops_at_ends() {
+    goTo(5);
+    menu->press(Key::OK);
+    menu->press(Key::UP);
+    menu->press(Key::UP);
+    menu->press(Key::UP);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_INT(600, model.hold);
+    menu->press(Key::OK);
+    for (int i = 0; i < 5; i++) menu->press(Key::DOWN);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_INT(0, model.hold);
+}
+
+void test_select_text_loops() {
+    goTo(6);
+    menu->press(Key::OK);
+    menu->press(Key::UP);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_STRING("OUT", model.airflow);
+    menu->press(Key::OK);
+    menu->press(Key::UP);                   // nach der letzten wieder die erste
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_STRING("IN", model.airflow);
+}
+
+void test_cancel_discards_edit() {
+    goTo(3);
+    menu->press(Key::OK);
+    menu->press(Key::UP);
+    menu->press(Key::CANCEL);
+    TEST_ASSERT_FALSE(menu->editing());
+    TEST_ASSERT_EQUAL_INT(1883, model.port);
+    TEST_ASSERT_EQUAL_UINT8(PAGE_MAIN, menu->page());
+}
+
+// --- Navigation ---
+
+void test_link_back_and_cancel() {
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_UINT8(PAGE_SUB, menu->page());
+    menu->press(Key::DOWN);
+    menu->press(Key::OK);                   // Back
+    TEST_ASSERT_EQUAL_UINT8(PAGE_MAIN, menu->page());
+    TEST_ASSERT_EQUAL_UINT8(0, menu->cursor());
+    menu->press(Key::OK);
+    menu->press(Key::CANCEL);
+    TEST_ASSERT_EQUAL_UINT8(PAGE_MAIN, menu->page());
+    menu->press(Key::CANCEL);               // Hauptseite hat keine übergeordnete
+    TEST_ASSERT_EQUAL_UINT8(PAGE_MAIN, menu->page());
+}
+
+void test_action_and_list_entries() {
+    goTo(7);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_INT(1, model.actions);
+
+    static const char* const labels[] = { "v1.2", "v1.1" };
+    menu->setList(PAGE_MAIN, "Versions", labels, 2, onList);
+    menu->setPage(PAGE_MAIN, 1);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_INT(1, listPicked);
+    // Die festen Items liegen dahinter
+    menu->setPage(PAGE_MAIN, 3);
+    menu->press(Key::OK);
+    TEST_ASSERT_TRUE(model.ble);
+    menu->clearList();
+}
+
+// --- Neu zeichnen ---
+
+void test_redraw_rows_per_key() {
+    // Nichts geändert: nichts zeichnen, nichts senden
+    TEST_ASSERT_EQUAL_UINT8(0, menu->render());
+    TEST_ASSERT_EQUAL_INT(0, submits);
+
+    menu->press(Key::DOWN);
+    TEST_ASSERT_EQUAL_UINT8(2, menu->render());     // alte und neue Cursorzeile
+    int moveTiles = tilesSent;
+
+    goTo(3);
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_UINT8(1, menu->render());     // Editor öffnen
+    menu->press(Key::UP);
+    TEST_ASSERT_EQUAL_UINT8(1, menu->render());     // Ziffer ändern
+    menu->press(Key::OK);
+    TEST_ASSERT_EQUAL_UINT8(1, menu->render());
+
+    // Scrollen und Seitenwechsel: ganzer Puffer
+    goTo(6);
+    menu->press(Key::DOWN);
+    TEST_ASSERT_EQUAL_UINT8(MenuEngine::VISIBLE_ROWS + 1, menu->render());
+    menu->setPage(PAGE_SUB);
+    TEST_ASSERT_EQUAL_UINT8(MenuEngine::VISIBLE_ROWS + 1, menu->render());
+
+    // Cursor bewegen ändert nur zwei Pages: höchstens 2 x 16 Tiles statt 128
+    TEST_ASSERT_GREATER_THAN(0, moveTiles);
+    TEST_ASSERT_TRUE(moveTiles <= 2 * 16);
+    char message[120];
+    snprintf(message, sizeof(message), "Cursor: %d von 128 Tiles gesendet", moveTiles);
+    TEST_MESSAGE(message);
+}
+
+void test_edit_redraw_matches_full_draw() {
+    // Teilweises Neuzeichnen muss dasselbe Bild ergeben wie ein kompletter Aufbau
+    goTo(4);
+    menu->press(Key::OK);
+    menu->press(Key::RIGHT);
+    menu->press(Key::UP);
+    menu->render();
+    uint8_t partial[DisplayFlush::FRAME_BYTES];
+    memcpy(partial, display.getBufferPtr(), sizeof(partial));
+    menu->draw();
+    TEST_ASSERT_EQUAL_MEMORY(partial, display.getBufferPtr(), sizeof(partial));
+}
+
+// Zeit pro Taste: nur die geänderte Zeile gegen den kompletten Aufbau, wie ihn GEM mit drawMenu() macht
+void test_redraw_time_row_vs_full() {
+    constexpr int ROUNDS = 2000;
+    goTo(3);
+    menu->press(Key::OK);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++) {
+        menu->press(Key::UP);
+        menu->render();
+    }
+    auto row = std::chrono::steady_clock::now() - start;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ROUNDS; i++) {
+        menu->press(Key::UP);
+        menu->draw();
+    }
+    auto full = std::chrono::steady_clock::now() - start;
+    menu->press(Key::CANCEL);
+
+    long rowNs = (long)(std::chrono::duration_cast<std::chrono::nanoseconds>(row).count() / ROUNDS);
+    long fullNs = (long)(std::chrono::duration_cast<std::chrono::nanoseconds>(full).count() / ROUNDS);
+    char message[120];
+    snprintf(message, sizeof(message), "Ziffer ändern: Zeile %ld ns, ganzes Menü %ld ns pro Taste", rowNs, fullNs);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(rowNs < fullNs);
+}
+
+void test_ram_and_table_sizes() {
+    char message[160];
+    snprintf(message, sizeof(message),
+             "RAM: MenuEngine %u Bytes; Flash-Tabellen: MenuItem %u, %u Items + %u Seiten = %u Bytes",
+             (unsigned)sizeof(MenuEngine), (unsigned)sizeof(MenuItem),
+             (unsigned)(sizeof(MAIN_ITEMS) / sizeof(MenuItem) + sizeof(SUB_ITEMS) / sizeof(MenuItem)),
+             (unsigned)PAGE_COUNT, (unsigned)(sizeof(MAIN_ITEMS) + sizeof(SUB_ITEMS) + sizeof(PAGES)));
+    TEST_MESSAGE(message);
+    // Zustand pro Seite und ein Editierpuffer, keine Kopie der Items
+    TEST_ASSERT_TRUE(sizeof(MenuEngine) < 2 * MenuEngine::MAX_PAGES + MenuEngine::MAX_TEXT + 96);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_toggle_flips_and_redraws_one_row);
+    RUN_TEST(test_pin_clamps_and_keeps_six_digits);
+    RUN_TEST(test_number_clamps_on_commit);
+    RUN_TEST(test_text_edit_trims_trailing_spaces);
+    RUN_TEST(test_text_cursor_stays_inside_field);
+    RUN_TEST(test_select_int_stops_at_ends);
+    RUN_TEST(test_select_text_loops);
+    RUN_TEST(test_cancel_discards_edit);
+    RUN_TEST(test_link_back_and_cancel);
+    RUN_TEST(test_action_and_list_entries);
+    RUN_TEST(test_redraw_rows_per_key);
+    RUN_TEST(test_edit_redraw_matches_full_draw);
+    RUN_TEST(test_redraw_time_row_vs_full);
+    RUN_TEST(test_ram_and_table_sizes);
+    return UNITY_END();
+}
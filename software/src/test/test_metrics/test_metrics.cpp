@@ -0,0 +1,109 @@
+// Kennzahlen-Registry auf dem Host: Registrierung, Snapshot-Format, zu kleiner Puffer, Überlauf
+#include <unity.h>
+#include <string.h>
+#include <thread>
+#include "Metrics.h"
+
+static int32_t readRssi() { return -67; }
+
+// Wie im Gerät statisch definiert, registrieren sich also vor main()
+static Gauge uptime("up");
+static Gauge rssi("rssi", readRssi);
+static Counter irSent("irTx");
+static Counter bleConnects("bleConn");
+
+void setUp() {}
+void tearDown() {}
+
+void test_registration_order() {
+    TEST_ASSERT_EQUAL(4, Metrics::count());
+    const Metric* m = Metric::first();
+    TEST_ASSERT_EQUAL_STRING("up", m->name());
+    TEST_ASSERT_TRUE(m->kind() == Metric::GAUGE);
+    m = m->next();
+    TEST_ASSERT_EQUAL_STRING("rssi", m->name());
+    m = m->next();
+    TEST_ASSERT_EQUAL_STRING("irTx", m->name());
+    TEST_ASSERT_TRUE(m->kind() == Metric::COUNTER);
+    m = m->next();
+    TEST_ASSERT_EQUAL_STRING("bleConn", m->name());
+    TEST_ASSERT_NULL(m->next());
+}
+
+void test_snapshot_format() {
+    uptime.set(86400);
+    uint32_t sent = irSent.value();
+    irSent.inc(3);
+    TEST_ASSERT_EQUAL_UINT32(sent + 3, irSent.value());
+
+    char expected[128];
+    snprintf(expected, sizeof(expected), "{\"up\":86400,\"rssi\":-67,\"irTx\":%lu,\"bleConn\":%lu}",
+             (unsigned long)irSent.value(), (unsigned long)bleConnects.value());
+    char out[128];
+    size_t n = Metrics::snapshot(out, sizeof(out));
+    TEST_ASSERT_EQUAL(strlen(expected), n);
+    TEST_ASSERT_EQUAL_STRING(expected, out);
+}
+
+void test_gauge_keeps_sign() {
+    uptime.set(-5);
+    TEST_ASSERT_EQUAL_INT32(-5, uptime.value());
+    char out[128];
+    TEST_ASSERT_GREATER_THAN(0, Metrics::snapshot(out, sizeof(out)));
+    TEST_ASSERT_TRUE(strstr(out, "\"up\":-5,") != nullptr);
+    uptime.set(0);
+}
+
+void test_buffer_too_small_returns_zero() {
+    char full[128];
+    size_t n = Metrics::snapshot(full, sizeof(full));
+    TEST_ASSERT_GREATER_THAN(0, n);
+    // Jede Größe bis n (kein Platz für '\0') liefert 0, ab n + 1 genau denselben Text
+    for (size_t size = 0; size <= n + 1; size++) {
+        char out[128];
+        memset(out, 'x', sizeof(out));
+        size_t m = Metrics::snapshot(out, size);
+        if (size <= n) {
+            TEST_ASSERT_EQUAL(0, m);
+        } else {
+            TEST_ASSERT_EQUAL(n, m);
+            TEST_ASSERT_EQUAL_STRING(full, out);
+        }
+        // Nie über den Puffer hinaus geschrieben
+        TEST_ASSERT_EQUAL_HEX8('x', out[size]);
+    }
+}
+
+void test_counter_wraps_modulo_2_32() {
+    uint32_t before = bleConnects.value();
+    bleConnects.inc(0xFFFFFFFFu);
+    bleConnects.inc(2);
+    TEST_ASSERT_EQUAL_UINT32(before + 1, bleConnects.value());
+    bleConnects.inc(0xFFFFFFFFu - bleConnects.value());
+    char out[128];
+    TEST_ASSERT_GREATER_THAN(0, Metrics::snapshot(out, sizeof(out)));
+    TEST_ASSERT_TRUE(strstr(out, "\"bleConn\":4294967295}") != nullptr);
+}
+
+void test_inc_from_several_threads() {
+    uint32_t before = irSent.value();
+    std::thread workers[4];
+    for (std::thread& t : workers) {
+        t = std::thread([] {
+            for (int i = 0; i < 100000; i++) irSent.inc();
+        });
+    }
+    for (std::thread& t : workers) t.join();
+    TEST_ASSERT_EQUAL_UINT32(before + 400000, irSent.value());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_registration_order);
+    RUN_TEST(test_snapshot_format);
+    RUN_TEST(test_gauge_keeps_sign);
+    RUN_TEST(test_buffer_too_small_returns_zero);
+    RUN_TEST(test_counter_wraps_modulo_2_32);
+    RUN_TEST(test_inc_from_several_threads);
+    return UNITY_END();
+}
@@ -0,0 +1,122 @@
+// QuadratureDecoder mit synthetischen, prellenden Flankenfolgen
+#include <unity.h>
+#include "QuadratureDecoder.h"
+#include <stdio.h>
+
+// Eine Rastung im Uhrzeigersinn: 00 -> 01 -> 11 -> 10 -> 00 (Zustand = (A << 1) | B)
+static const uint8_t CW[4] = { 0b01, 0b11, 0b10, 0b00 };
+
+// Reproduzierbarer Zufall für die Prellfolgen
+static uint32_t seed;
+static uint32_t nextRandom() {
+    seed = seed * 1664525u + 1013904223u;
+    return seed >> 8;
+}
+
+// Wechsel nach target über einen prellenden Kontakt: das geänderte Bit springt ein paar Mal hin und her
+static int feedBouncy(QuadratureDecoder& q, uint8_t target, int maxBounces) {
+    int position = 0;
+    uint8_t from = q.state();
+    int bounces = nextRandom() % (maxBounces + 1);
+    for (int i = 0; i < bounces; i++) {
+        position += q.step(target);
+        position += q.step(from);
+    }
+    position += q.step(target);
+    return position;
+}
+
+void setUp() {
+    seed = 12345;
+}
+void tearDown() {}
+
+void test_packed_table_matches_steps() {
+    for (int i = 0; i < 16; i++) {
+        QuadratureDecoder q;
+        q.reset(i >> 2);
+        int8_t expected = QuadratureTable::STEPS[i];
+        int8_t step = q.step(i & 3);
+        if (expected == QuadratureTable::INVALID) {
+            TEST_ASSERT_EQUAL_INT(0, step);
+            TEST_ASSERT_EQUAL_UINT32(1, q.invalidTransitions());
+        } else {
+            TEST_ASSERT_EQUAL_INT(expected, step);
+            TEST_ASSERT_EQUAL_UINT32(0, q.invalidTransitions());
+        }
+        TEST_ASSERT_EQUAL_UINT8(i & 3, q.state());
+    }
+}
+
+void test_clean_detents_count_four_steps() {
+    QuadratureDecoder q;
+    int position = 0;
+    for (int d = 0; d < 10; d++) {
+        for (uint8_t s : CW) position += q.step(s);
+    }
+    TEST_ASSERT_EQUAL_INT(40, position);
+    for (int d = 0; d < 3; d++) {
+        for (int i = 3; i >= 0; i--) position += q.step(CW[(i + 3) % 4]);
+    }
+    TEST_ASSERT_EQUAL_INT(28, position);
+    TEST_ASSERT_EQUAL_UINT32(0, q.invalidTransitions());
+}
+
+void test_single_track_bounce_cancels_out() {
+    // Prellen auf einer Spur sind gültige Hin-und-her-Schritte: netto nichts, nichts verworfen
+    QuadratureDecoder q;
+    int position = 0;
+    for (int d = 0; d < 500; d++) {
+        for (uint8_t s : CW) position += feedBouncy(q, s, 5);
+    }
+    TEST_ASSERT_EQUAL_INT(500 * 4, position);
+    TEST_ASSERT_EQUAL_UINT32(0, q.invalidTransitions());
+}
+
+void test_missed_edges_are_rejected_and_counted() {
+    // Ab und zu fehlt ein Zwischenzustand (beide Bits ändern sich): der Schritt wird verworfen,
+    // der Decoder übernimmt den Zustand und zählt danach normal weiter
+    QuadratureDecoder q;
+    int position = 0;
+    int skipped = 0;
+    for (int d = 0; d < 500; d++) {
+        for (int i = 0; i < 4; i++) {
+            if (i == 1 && nextRandom() % 4 == 0) {
+                // 11 fehlt: 01 -> 10 direkt
+                skipped++;
+                position += q.step(CW[++i]);
+                continue;
+            }
+            position += feedBouncy(q, CW[i], 3);
+        }
+    }
+    char line[80];
+    snprintf(line, sizeof(line), "500 Rastungen, %d fehlende Flanken, %lu verworfen", skipped,
+             (unsigned long)q.invalidTransitions());
+    TEST_MESSAGE(line);
+    TEST_ASSERT_GREATER_THAN(50, skipped);
+    TEST_ASSERT_EQUAL_UINT32(skipped, q.invalidTransitions());
+    // Jeder verworfene Doppelschritt fehlt mit 2 Viertelschritten, die Richtung stimmt trotzdem
+    TEST_ASSERT_EQUAL_INT(500 * 4 - 2 * skipped, position);
+}
+
+void test_reversal_mid_detent() {
+    QuadratureDecoder q;
+    int position = 0;
+    position += q.step(0b01);
+    position += q.step(0b11);
+    position += q.step(0b01);
+    position += q.step(0b00);
+    TEST_ASSERT_EQUAL_INT(0, position);
+    TEST_ASSERT_EQUAL_UINT32(0, q.invalidTransitions());
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_packed_table_matches_steps);
+    RUN_TEST(test_clean_detents_count_four_steps);
+    RUN_TEST(test_single_track_bounce_cancels_out);
+    RUN_TEST(test_missed_edges_are_rejected_and_counted);
+    RUN_TEST(test_reversal_mid_detent);
+    return UNITY_END();
+}
@@ -0,0 +1,144 @@
+// Wochenplan gegen eine virtuelle Uhr: Sekunde der Woche statt RTC
+#include <unity.h>
+#include <string.h>
+#include "ScheduleEngine.h"
+
+static ScheduleEngine engine;
+
+// Mo-Fr 07:00 MANUAL 60 OUT offen, täglich 07:30 OFF, Sa+So 10:00 AUTO
+static void addWeekPlan(ScheduleEngine& e) {
+    TEST_ASSERT_TRUE(e.add({0x1F, 7 * 60, 2, 60, 1, 1}));
+    TEST_ASSERT_TRUE(e.add({0x7F, 7 * 60 + 30, 0, 0, 0, 0}));
+    TEST_ASSERT_TRUE(e.add({0x60, 10 * 60, 1, 0, 0, 1}));
+}
+
+void setUp() {
+    engine.clear();
+}
+
+void tearDown() {}
+
+void test_empty_plan() {
+    TEST_ASSERT_EQUAL_INT(-1, engine.activeIndex(0));
+    TEST_ASSERT_EQUAL_UINT32(0, engine.secondsUntilNext(5));
+}
+
+void test_add_rejects_invalid_slots() {
+    TEST_ASSERT_FALSE(engine.add({0x00, 60, 0, 0, 0, 0}));     // kein Tag
+    TEST_ASSERT_FALSE(engine.add({0x80, 60, 0, 0, 0, 0}));     // Bit 7
+    TEST_ASSERT_FALSE(engine.add({0x01, 1440, 0, 0, 0, 0}));   // 24:00
+    TEST_ASSERT_FALSE(engine.add({0x01, 60, 3, 0, 0, 0}));
+    TEST_ASSERT_FALSE(engine.add({0x01, 60, 2, 101, 0, 0}));
+    TEST_ASSERT_EQUAL(0, engine.count());
+}
+
+void test_active_index_within_week() {
+    addWeekPlan(engine);
+    TEST_ASSERT_EQUAL_INT(0, engine.activeIndex(ScheduleEngine::weekSecond(0, 7, 0, 0)));
+    TEST_ASSERT_EQUAL_INT(0, engine.activeIndex(ScheduleEngine::weekSecond(0, 7, 29, 59)));
+    TEST_ASSERT_EQUAL_INT(1, engine.activeIndex(ScheduleEngine::weekSecond(0, 7, 30, 0)));
+    TEST_ASSERT_EQUAL_INT(1, engine.activeIndex(ScheduleEngine::weekSecond(5, 8, 0, 0)));
+    TEST_ASSERT_EQUAL_INT(2, engine.activeIndex(ScheduleEngine::weekSecond(5, 10, 0, 0)));
+}
+
+void test_active_index_wraps_to_previous_week() {
+    addWeekPlan(engine);
+    // Montag 00:00: es gilt noch der Sonntag 10:00 aus der Vorwoche
+    TEST_ASSERT_EQUAL_INT(2, engine.activeIndex(0));
+    TEST_ASSERT_EQUAL_INT(2, engine.activeIndex(ScheduleEngine::weekSecond(0, 6, 59, 59)));
+    TEST_ASSERT_EQUAL_INT(2, engine.activeIndex(ScheduleEngine::SECONDS_PER_WEEK - 1));
+}
+
+void test_seconds_until_next_wraps_week() {
+    addWeekPlan(engine);
+    TEST_ASSERT_EQUAL_UINT32(1800, engine.secondsUntilNext(ScheduleEngine::weekSecond(0, 7, 0, 0)));
+    TEST_ASSERT_EQUAL_UINT32(7200, engine.secondsUntilNext(ScheduleEngine::weekSecond(5, 8, 0, 0)));
+    // Sonntag 10:00 -> Montag 07:00
+    TEST_ASSERT_EQUAL_UINT32(21 * 3600, engine.secondsUntilNext(ScheduleEngine::weekSecond(6, 10, 0, 0)));
+    TEST_ASSERT_EQUAL_UINT32(7 * 3600 + 1, engine.secondsUntilNext(ScheduleEngine::SECONDS_PER_WEEK - 1));
+}
+
+void test_single_slot_next_is_one_week() {
+    TEST_ASSERT_TRUE(engine.add({0x01, 0, 1, 0, 0, 0}));
+    TEST_ASSERT_EQUAL_UINT32(ScheduleEngine::SECONDS_PER_WEEK, engine.secondsUntilNext(0));
+    TEST_ASSERT_EQUAL_INT(0, engine.activeIndex(ScheduleEngine::weekSecond(3, 12, 0, 0)));
+}
+
+void test_virtual_clock_walks_one_week() {
+    addWeekPlan(engine);
+    // Von Wechsel zu Wechsel springen: 5x 07:00, 7x 07:30, 2x 10:00
+    uint32_t t = 0;
+    int changes = 0;
+    for (;;) {
+        uint32_t step = engine.secondsUntilNext(t);
+        TEST_ASSERT_GREATER_THAN(0, step);
+        t += step;
+        if (t >= ScheduleEngine::SECONDS_PER_WEEK) break;
+        int before = engine.activeIndex(t - 1);
+        int after = engine.activeIndex(t);
+        TEST_ASSERT_TRUE(before != after || before == 1);
+        changes++;
+    }
+    TEST_ASSERT_EQUAL_INT(5 + 7 + 2, changes);
+}
+
+void test_blob_round_trip() {
+    addWeekPlan(engine);
+    uint8_t blob[ScheduleEngine::MAX_BLOB];
+    size_t n = engine.encode(blob, sizeof(blob));
+    TEST_ASSERT_EQUAL(ScheduleEngine::BLOB_HEADER + 3 * ScheduleEngine::BLOB_SLOT, n);
+
+    ScheduleEngine decoded;
+    TEST_ASSERT_TRUE(decoded.decode(blob, n));
+    TEST_ASSERT_EQUAL(3, decoded.count());
+    for (size_t i = 0; i < decoded.count(); i++) {
+        TEST_ASSERT_EQUAL_UINT8(engine.slot(i).weekdays, decoded.slot(i).weekdays);
+        TEST_ASSERT_EQUAL_UINT16(engine.slot(i).minuteOfDay, decoded.slot(i).minuteOfDay);
+        TEST_ASSERT_EQUAL_UINT8(engine.slot(i).mode, decoded.slot(i).mode);
+        TEST_ASSERT_EQUAL_UINT8(engine.slot(i).speed, decoded.slot(i).speed);
+        TEST_ASSERT_EQUAL_UINT8(engine.slot(i).airflow, decoded.slot(i).airflow);
+        TEST_ASSERT_EQUAL_UINT8(engine.slot(i).cover, decoded.slot(i).cover);
+    }
+    TEST_ASSERT_EQUAL(0, engine.encode(blob, n - 1));
+}
+
+void test_decode_rejects_and_keeps_plan() {
+    addWeekPlan(engine);
+    uint8_t blob[ScheduleEngine::MAX_BLOB];
+    size_t n = engine.encode(blob, sizeof(blob));
+
+    ScheduleEngine decoded;
+    TEST_ASSERT_TRUE(decoded.decode(blob, n));
+
+    uint8_t bad[ScheduleEngine::MAX_BLOB];
+    memcpy(bad, blob, n);
+    bad[0] = ScheduleEngine::BLOB_FORMAT + 1;                    // unbekanntes Format
+    TEST_ASSERT_FALSE(decoded.decode(bad, n));
+    TEST_ASSERT_FALSE(decoded.decode(blob, n - 1));             // Länge passt nicht zur Anzahl
+    TEST_ASSERT_FALSE(decoded.decode(blob, 1));
+    TEST_ASSERT_FALSE(decoded.decode(nullptr, n));
+    memcpy(bad, blob, n);
+    bad[3] = 0xFF;                                               // Geschwindigkeit > 100
+    TEST_ASSERT_FALSE(decoded.decode(bad, n));
+    memcpy(bad, blob, n);
+    bad[1] = ScheduleEngine::MAX_SLOTS + 1;
+    TEST_ASSERT_FALSE(decoded.decode(bad, n));
+
+    // Der vorige Plan gilt weiter
+    TEST_ASSERT_EQUAL(3, decoded.count());
+    TEST_ASSERT_EQUAL_UINT16(7 * 60, decoded.slot(0).minuteOfDay);
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_empty_plan);
+    RUN_TEST(test_add_rejects_invalid_slots);
+    RUN_TEST(test_active_index_within_week);
+    RUN_TEST(test_active_index_wraps_to_previous_week);
+    RUN_TEST(test_seconds_until_next_wraps_week);
+    RUN_TEST(test_single_slot_next_is_one_week);
+    RUN_TEST(test_virtual_clock_walks_one_week);
+    RUN_TEST(test_blob_round_trip);
+    RUN_TEST(test_decode_rejects_and_keeps_plan);
+    return UNITY_END();
+}
@@ -0,0 +1,141 @@
+// Rahmen der USB-Steuerung: COBS, CRC und Prüfung beim Empfang
+#include <unity.h>
+#include <string.h>
+#include "SerialFrame.h"
+
+void setUp() {}
+void tearDown() {}
+
+// Empfangsseite wie SerialController::receive(): Inhalt zwischen den Trennern
+static bool decodeWire(uint8_t* wire, size_t n, SerialFrame::Frame& frame) {
+    TEST_ASSERT_GREATER_THAN(2, n);
+    TEST_ASSERT_EQUAL_HEX8(0x00, wire[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, wire[n - 1]);
+    for (size_t i = 1; i < n - 1; i++) TEST_ASSERT_TRUE(wire[i] != 0);
+    return SerialFrame::decode(wire + 1, n - 2, frame);
+}
+
+void test_crc16_ccitt_false_check_value() {
+    TEST_ASSERT_EQUAL_HEX16(0x29B1, SerialFrame::crc16((const uint8_t*)"123456789", 9));
+    TEST_ASSERT_EQUAL_HEX16(0xFFFF, SerialFrame::crc16(nullptr, 0));
+}
+
+void test_cobs_reference_vectors() {
+    struct Vector {
+        uint8_t in[4];
+        size_t inLength;
+        uint8_t out[6];
+        size_t outLength;
+    };
+    static const Vector vectors[] = {
+        { {0x00}, 1, {0x01, 0x01}, 2 },
+        { {0x00, 0x00}, 2, {0x01, 0x01, 0x01}, 3 },
+        { {0x11, 0x22, 0x00, 0x33}, 4, {0x03, 0x11, 0x22, 0x02, 0x33}, 5 },
+        { {0x11, 0x00, 0x00, 0x00}, 4, {0x02, 0x11, 0x01, 0x01, 0x01}, 5 },
+    };
+    for (const Vector& v : vectors) {
+        uint8_t out[8];
+        TEST_ASSERT_EQUAL(v.outLength, SerialFrame::cobsEncode(v.in, v.inLength, out));
+        TEST_ASSERT_EQUAL_MEMORY(v.out, out, v.outLength);
+        uint8_t back[8];
+        TEST_ASSERT_EQUAL(v.inLength, SerialFrame::cobsDecode(out, v.outLength, back));
+        TEST_ASSERT_EQUAL_MEMORY(v.in, back, v.inLength);
+    }
+}
+
+void test_cobs_long_runs_without_zero() {
+    // 254 Bytes ohne Null passen in einen Block, ab 255 beginnt ein zweiter
+    uint8_t in[300];
+    for (size_t i = 0; i < sizeof(in); i++) in[i] = (uint8_t)(i % 255 + 1);
+    uint8_t out[310];
+    uint8_t back[310];
+    static const size_t lengths[] = {253, 254, 255, 300};
+    for (size_t length : lengths) {
+        size_t n = SerialFrame::cobsEncode(in, length, out);
+        TEST_ASSERT_EQUAL(length + length / 254 + 1, n);
+        if (length >= 254) TEST_ASSERT_EQUAL_HEX8(0xFF, out[0]);
+        TEST_ASSERT_EQUAL(length, SerialFrame::cobsDecode(out, n, back));
+        TEST_ASSERT_EQUAL_MEMORY(in, back, length);
+    }
+}
+
+void test_cobs_decode_in_place() {
+    uint8_t buffer[] = {0x03, 0x11, 0x22, 0x02, 0x33};
+    const uint8_t expected[] = {0x11, 0x22, 0x00, 0x33};
+    TEST_ASSERT_EQUAL(4, SerialFrame::cobsDecode(buffer, sizeof(buffer), buffer));
+    TEST_ASSERT_EQUAL_MEMORY(expected, buffer, 4);
+}
+
+void test_frame_round_trip_all_sizes() {
+    uint8_t data[SerialFrame::MAX_DATA];
+    for (size_t i = 0; i < sizeof(data); i++) data[i] = (uint8_t)(i * 7);   // mit Nullen
+    uint8_t wire[SerialFrame::MAX_ENCODED];
+    for (size_t length = 0; length <= SerialFrame::MAX_DATA; length++) {
+        SerialFrame::Frame out = { SerialFrame::CHANNEL_CONTROL, SerialFrame::TYPE_COMMAND, (uint8_t)length,
+                                   (uint8_t)length, data };
+        size_t n = SerialFrame::encode(out, wire, sizeof(wire));
+        TEST_ASSERT_GREATER_THAN(0, n);
+        TEST_ASSERT_TRUE(n <= SerialFrame::MAX_ENCODED);
+
+        SerialFrame::Frame in;
+        TEST_ASSERT_TRUE(decodeWire(wire, n, in));
+        TEST_ASSERT_EQUAL_UINT8(out.channel, in.channel);
+        TEST_ASSERT_EQUAL_UINT8(out.type, in.type);
+        TEST_ASSERT_EQUAL_UINT8(out.seq, in.seq);
+        TEST_ASSERT_EQUAL_UINT8(out.length, in.length);
+        if (length > 0) TEST_ASSERT_EQUAL_MEMORY(data, in.data, length);
+    }
+}
+
+void test_encode_rejects_oversize_and_small_buffer() {
+    uint8_t data[SerialFrame::MAX_DATA + 1] = {};
+    uint8_t wire[SerialFrame::MAX_ENCODED + 8];
+    SerialFrame::Frame big = { SerialFrame::CHANNEL_LOG, SerialFrame::TYPE_LOG_TEXT, 0,
+                               (uint8_t)(SerialFrame::MAX_DATA + 1), data };
+    TEST_ASSERT_EQUAL(0, SerialFrame::encode(big, wire, sizeof(wire)));
+
+    SerialFrame::Frame small = { SerialFrame::CHANNEL_LOG, SerialFrame::TYPE_LOG_TEXT, 0, 10, data };
+    size_t n = SerialFrame::encode(small, wire, sizeof(wire));
+    TEST_ASSERT_EQUAL(0, SerialFrame::encode(small, wire, n - 1));
+}
+
+void test_corrupted_frames_are_rejected() {
+    const char* json = "{\"speed\":50}";
+    SerialFrame::Frame out = { SerialFrame::CHANNEL_CONTROL, SerialFrame::TYPE_COMMAND, 7,
+                               (uint8_t)strlen(json), (const uint8_t*)json };
+    uint8_t wire[SerialFrame::MAX_ENCODED];
+    size_t n = SerialFrame::encode(out, wire, sizeof(wire));
+    SerialFrame::Frame in;
+
+    // Jedes einzelne Bit im Inhalt kippen: CRC oder COBS muss es merken
+    for (size_t i = 1; i < n - 1; i++) {
+        for (int bit = 0; bit < 8; bit++) {
+            uint8_t copy[SerialFrame::MAX_ENCODED];
+            memcpy(copy, wire, n);
+            copy[i] ^= (uint8_t)(1 << bit);
+            if (copy[i] == 0) continue;   // wäre auf der Leitung ein Trenner
+            TEST_ASSERT_FALSE(SerialFrame::decode(copy + 1, n - 2, in));
+        }
+    }
+
+    // Abgeschnitten
+    uint8_t copy[SerialFrame::MAX_ENCODED];
+    memcpy(copy, wire, n);
+    TEST_ASSERT_FALSE(SerialFrame::decode(copy + 1, n - 3, in));
+    // Unformatierte Debug-Ausgabe vor dem ersten Trenner
+    uint8_t text[] = "boot text";
+    TEST_ASSERT_FALSE(SerialFrame::decode(text, sizeof(text) - 1, in));
+    TEST_ASSERT_FALSE(SerialFrame::decode(copy, 0, in));
+}
+
+int main(int, char**) {
+    UNITY_BEGIN();
+    RUN_TEST(test_crc16_ccitt_false_check_value);
+    RUN_TEST(test_cobs_reference_vectors);
+    RUN_TEST(test_cobs_long_runs_without_zero);
+    RUN_TEST(test_cobs_decode_in_place);
+    RUN_TEST(test_frame_round_trip_all_sizes);
+    RUN_TEST(test_encode_rejects_oversize_and_small_buffer);
+    RUN_TEST(test_corrupted_frames_are_rejected);
+    return UNITY_END();
+}
@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""Testclient für die lokale HTTP/WebSocket-API (siehe HTTP_API.md).
+
+Nur Standardbibliothek (WebSocket-Handshake und Frames von Hand), läuft also
+auf jedem Linux-Rechner im selben Netz.
+
+    python3 http_api_client.py <host> state
+    python3 http_api_client.py <host> command '{"mode":"manual","speed":70}'
+    python3 http_api_client.py <host> watch
+    python3 http_api_client.py <host> latency --count 20
+
+"latency" wechselt die Geschwindigkeit per POST /command zwischen zwei Werten und
+misst die Zeit bis zum passenden Status auf dem WebSocket.
+"""
+
+import argparse
+import base64
+import json
+import os
+import socket
+import statistics
+import struct
+import sys
+import time
+import urllib.error
+import urllib.request
+
+
+def http(host, port, method, path, body=None):
+    req = urllib.request.Request(f"http://{host}:{port}{path}", method=method, data=body)
+    if body is not None:
+        req.add_header("Content-Type", "application/json")
+    try:
+        with urllib.request.urlopen(req, timeout=5) as resp:
+            return resp.status, resp.read().decode()
+    except urllib.error.HTTPError as e:
+        return e.code, e.read().decode()
+
+
+class WebSocket:
+    def __init__(self, host, port, path="/ws", timeout=10):
+        self.sock = socket.create_connection((host, port), timeout=timeout)
+        key = base64.b64encode(os.urandom(16)).decode()
+        self.sock.sendall((
+            f"GET {path} HTTP/1.1\r\nHost: {host}:{port}\r\n"
+            "Upgrade: websocket\r\nConnection: Upgrade\r\n"
+            f"Sec-WebSocket-Key: {key}\r\nSec-WebSocket-Version: 13\r\n\r\n").encode())
+        header = b""
+        while b"\r\n\r\n" not in header:
+            chunk = self.sock.recv(1)
+            if not chunk:
+                raise ConnectionError("Verbindung beim Handshake geschlossen")
+            header += chunk
+        status = header.split(b"\r\n", 1)[0]
+        if b" 101 " not in status:
+            raise ConnectionError(f"Handshake fehlgeschlagen: {status.decode()}")
+
+    def _read(self, n):
+        data = b""
+        while len(data) < n:
+            chunk = self.sock.recv(n - len(data))
+            if not chunk:
+                raise ConnectionError("Verbindung geschlossen")
+            data += chunk
+        return data
+
+    def recv(self):
+        """Nächste Textnachricht; None bei Close-Frame."""
+        while True:
+            b0, b1 = self._read(2)
+            opcode = b0 & 0x0F
+            length = b1 & 0x7F
+            if length == 126:
+                length = struct.unpack(">H", self._read(2))[0]
+            elif length == 127:
+                length = struct.unpack(">Q", self._read(8))[0]
+            payload = self._read(length)
+            if opcode == 0x1:
+                return payload.decode()
+            if opcode == 0x8:
+                code = struct.unpack(">H", payload[:2])[0] if len(payload) >= 2 else 0
+                print(f"WebSocket geschlossen (Code {code})", file=sys.stderr)
+                return None
+            if opcode == 0x9:
+                self._send(0xA, payload)
+
+    def _send(self, opcode, payload):
+        mask = os.urandom(4)
+        header = bytes([0x80 | opcode])
+        if len(payload) < 126:
+            header += bytes([0x80 | len(payload)])
+        else:
+            header += bytes([0x80 | 126]) + struct.pack(">H", len(payload))
+        masked = bytes(b ^ mask[i % 4] for i, b in enumerate(payload))
+        self.sock.sendall(header + mask + masked)
+
+    def send(self, text):
+        self._send(0x1, text.encode())
+
+
+def cmd_state(args):
+    status, body = http(args.host, args.port, "GET", "/state")
+    print(status, body)
+
+
+def cmd_command(args):
+    status, body = http(args.host, args.port, "POST", "/command", args.json.encode())
+    print(status, body)
+
+
+def cmd_watch(args):
+    ws = WebSocket(args.host, args.port)
+    while True:
+        msg = ws.recv()
+        if msg is None:
+            break
+        print(time.strftime("%H:%M:%S"), msg)
+
+
+def cmd_latency(args):
+    ws = WebSocket(args.host, args.port)
+    first = ws.recv()
+    if first is None:
+        return
+    print("Start:", first)
+    samples = []
+    speeds = (args.speed_a, args.speed_b)
+    for i in range(args.count):
+        speed = speeds[i % 2]
+        start = time.perf_counter()
+        status, body = http(args.host, args.port, "POST", "/command",
+                            json.dumps({"mode": "manual", "speed": speed}).encode())
+        if status != 202:
+            print(f"{i}: POST {status} {body}")
+            time.sleep(0.5)
+            continue
+        while True:
+            msg = ws.recv()
+            if msg is None:
+                return
+            state = json.loads(msg)
+            if state.get("speed") == speed and state.get("mode") == "manual":
+                break
+        ms = (time.perf_counter() - start) * 1000
+        samples.append(ms)
+        print(f"{i}: speed {speed} -> Push nach {ms:.1f} ms")
+        time.sleep(args.pause)
+    if samples:
+        samples.sort()
+        p95 = samples[min(len(samples) - 1, int(len(samples) * 0.95))]
+        print(f"n={len(samples)} median {statistics.median(samples):.1f} ms, "
+              f"p95 {p95:.1f} ms, max {samples[-1]:.1f} ms")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=80)
+    sub = parser.add_subparsers(dest="action", required=True)
+    sub.add_parser("state").set_defaults(func=cmd_state)
+    p = sub.add_parser("command")
+    p.add_argument("json")
+    p.set_defaults(func=cmd_command)
+    sub.add_parser("watch").set_defaults(func=cmd_watch)
+    p = sub.add_parser("latency")
+    p.add_argument("--count", type=int, default=10)
+    p.add_argument("--pause", type=float, default=0.5, help="Sekunden zwischen den Kommandos")
+    p.add_argument("--speed-a", type=int, default=50)
+    p.add_argument("--speed-b", type=int, default=60)
+    p.set_defaults(func=cmd_latency)
+    args = parser.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
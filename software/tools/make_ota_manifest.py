@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+"""Erzeugt die OTA-Dateien für ein Release: komprimiertes Image und manifest.json.
+
+    python3 make_ota_manifest.py firmware.bin v1.2.3 out/
+
+Ergebnis in out/:
+    firmware_v1.2.3.bin.gz   gzip (ohne Dateiname/Zeitstempel, reproduzierbar)
+    manifest.json            Version, Dateien, Größe und SHA-256 des entpackten Images
+
+Die Firmware lädt das Manifest, prüft die Version gegen den Release-Tag, entpackt das
+Image beim Schreiben und vergleicht den SHA-256. Die rohe .bin bleibt als Fallback im
+Release ("raw"), falls der Heap zum Entpacken nicht reicht.
+"""
+
+import argparse
+import gzip
+import hashlib
+import json
+import os
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("firmware", help="firmware.bin aus dem PlatformIO-Build")
+    parser.add_argument("version", help="Release-Tag, z.B. v1.2.3")
+    parser.add_argument("outdir")
+    args = parser.parse_args()
+
+    with open(args.firmware, "rb") as f:
+        image = f.read()
+
+    raw_name = f"firmware_{args.version}.bin"
+    gz_name = raw_name + ".gz"
+    compressed = gzip.compress(image, compresslevel=9, mtime=0)
+
+    os.makedirs(args.outdir, exist_ok=True)
+    with open(os.path.join(args.outdir, gz_name), "wb") as f:
+        f.write(compressed)
+
+    manifest = {
+        "version": args.version,
+        "file": gz_name,
+        "compression": "gzip",
+        "raw": raw_name,
+        "size": len(image),
+        "compressedSize": len(compressed),
+        "sha256": hashlib.sha256(image).hexdigest(),
+    }
+    with open(os.path.join(args.outdir, "manifest.json"), "w") as f:
+        json.dump(manifest, f, indent=2)
+
+    print(f"{raw_name}: {len(image)} bytes -> {gz_name}: {len(compressed)} bytes "
+          f"({100 * len(compressed) / len(image):.0f} %)")
+
+
+if __name__ == "__main__":
+    main()
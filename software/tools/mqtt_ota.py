@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""Firmware per MQTT an einen MaxFan schicken (ohne Internet, z.B. mosquitto im LAN).
+
+Am Gerät vorher Settings > Version > "MQTT Update" öffnen, erst dann nimmt es an.
+
+    python3 make_ota_manifest.py firmware.bin v1.2.3 out/
+    python3 mqtt_ota.py --host 192.168.1.5 out/manifest.json
+
+Topics wie in der Firmware konfiguriert (Standard FanState/set und FanState/status):
+    <cmd>/ota/ctl    begin/abort (JSON)
+    <cmd>/ota/data   Sequenznummer (uint32 LE) + Chunk
+    <state>/ota      ready/ack/done/error vom Gerät
+
+Es sind höchstens --window Chunks unbestätigt unterwegs. Kommt kein Ack, wird ab dem
+letzten bestätigten Chunk neu gesendet (Go-Back-N). Mit --raw wird die unkomprimierte
+Datei aus dem Manifest geschickt (falls das Gerät zum Entpacken zu wenig Heap hat).
+
+Lokale HTTP-Quelle (Settings > Version > "Local URL"/"Local Update"): das Verzeichnis mit
+manifest.json einfach ausliefern, z.B. "python3 -m http.server 8000 -d out/", und am Gerät
+http://<pc-ip>:8000/manifest.json eintragen.
+"""
+
+import argparse
+import json
+import os
+import queue
+import struct
+import sys
+import time
+
+import paho.mqtt.client as mqtt
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("manifest", help="manifest.json von make_ota_manifest.py")
+    parser.add_argument("--host", default="localhost")
+    parser.add_argument("--port", type=int, default=1883)
+    parser.add_argument("--user")
+    parser.add_argument("--password")
+    parser.add_argument("--cmd-topic", default="FanState/set")
+    parser.add_argument("--state-topic", default="FanState/status")
+    parser.add_argument("--chunk", type=int, default=1024)
+    parser.add_argument("--window", type=int, default=8, help="höchstens so viele, das Gerät meldet sein Maximum")
+    parser.add_argument("--timeout", type=float, default=3.0, help="Sekunden ohne Ack bis zur Wiederholung")
+    parser.add_argument("--raw", action="store_true", help="unkomprimierte Datei senden")
+    args = parser.parse_args()
+
+    with open(args.manifest) as f:
+        manifest = json.load(f)
+    base = os.path.dirname(os.path.abspath(args.manifest))
+    if args.raw:
+        manifest["file"] = manifest["raw"]
+        manifest["compression"] = "none"
+    with open(os.path.join(base, manifest["file"]), "rb") as f:
+        image = f.read()
+
+    ctl_topic = args.cmd_topic + "/ota/ctl"
+    data_topic = args.cmd_topic + "/ota/data"
+    reply_topic = args.state_topic + "/ota"
+    replies = queue.Queue()
+
+    client = mqtt.Client()
+    if args.user:
+        client.username_pw_set(args.user, args.password)
+    client.on_message = lambda c, u, msg: replies.put(json.loads(msg.payload))
+    client.connect(args.host, args.port)
+    client.subscribe(reply_topic)
+    client.loop_start()
+    time.sleep(0.5)
+
+    begin = {key: manifest[key] for key in ("version", "file", "compression", "size", "sha256")}
+    begin.update(op="begin", length=len(image), chunk=args.chunk)
+    client.publish(ctl_topic, json.dumps(begin))
+
+    try:
+        reply = replies.get(timeout=10)
+    except queue.Empty:
+        sys.exit("No answer. Is 'MQTT Update' open on the device?")
+    if reply.get("op") != "ready":
+        sys.exit(f"Device: {reply}")
+
+    chunk = min(args.chunk, reply["chunk"])
+    window = min(args.window, reply["window"])
+    chunks = [image[i:i + chunk] for i in range(0, len(image), chunk)]
+    print(f"Sending {manifest['file']}: {len(image)} bytes, {len(chunks)} chunks, window {window}")
+
+    start = time.time()
+    acked = -1          # höchste bestätigte Sequenznummer
+    next_seq = 0
+    retries = 0
+    last_progress = time.time()
+
+    while acked < len(chunks) - 1:
+        while next_seq < len(chunks) and next_seq - acked <= window:
+            client.publish(data_topic, struct.pack("<I", next_seq) + chunks[next_seq])
+            next_seq += 1
+        try:
+            reply = replies.get(timeout=args.timeout)
+        except queue.Empty:
+            # Go-Back-N: ab dem ersten unbestätigten Chunk neu
+            retries += 1
+            next_seq = acked + 1
+            continue
+        if reply.get("op") == "ack":
+            if reply["seq"] > acked:
+                acked = reply["seq"]
+                last_progress = time.time()
+            elif next_seq > acked + 1:
+                # Doppeltes Ack: Lücke beim Gerät, ab dort wiederholen
+                next_seq = acked + 1
+                retries += 1
+        elif reply.get("op") == "error":
+            sys.exit(f"Device: {reply.get('msg')}")
+        if time.time() - last_progress > 30:
+            sys.exit("Transfer stalled")
+        print(f"\r{100 * (acked + 1) // len(chunks)} %", end="", flush=True)
+
+    try:
+        reply = replies.get(timeout=15)
+        while reply.get("op") == "ack":
+            reply = replies.get(timeout=15)
+    except queue.Empty:
+        sys.exit("\nNo final answer from device")
+    elapsed = time.time() - start
+    print(f"\n{reply}: {len(image)} bytes in {elapsed:.1f} s "
+          f"({len(image) / elapsed / 1024:.1f} kB/s), {retries} retries")
+    client.loop_stop()
+
+
+if __name__ == "__main__":
+    main()
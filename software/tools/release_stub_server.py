@@ -0,0 +1,108 @@
+#!/usr/bin/env python3
+"""Lokaler Ersatz für die GitHub-Releases-API zum Testen des Release-Parsers.
+
+Liefert beliebig viele Releases im GitHub-Format, mit großem "body" und vielen
+Assets, damit die Antwort deutlich größer ist als der Speicher des ESP32.
+Unterstützt per_page und page wie die echte API, dazu ETag/If-None-Match (304).
+Mit --bump-after N kommt nach N Anfragen ein neues Release dazu (ETag ändert sich).
+
+Firmware dagegen bauen:
+    build_flags = ... -DMAXFAN_RELEASES_URL=\\"http://<pc-ip>:8000/releases\\"
+
+Start:
+    python3 release_stub_server.py --releases 200 --body-kb 8
+Der Heap-Verbrauch steht danach im seriellen Log ("Releases: ..., Heap frei: ...").
+"""
+
+import argparse
+import hashlib
+import json
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlparse
+
+
+def make_release(index, body_kb, assets):
+    tag = f"v1.{index // 10}.{index % 10}"
+    asset_list = []
+    for a in range(assets):
+        name = f"firmware-{tag}.bin" if a == assets - 1 else f"extra-{a}.zip"
+        asset_list.append({
+            "url": f"https://api.github.com/repos/x/y/releases/assets/{index}{a}",
+            "id": index * 100 + a,
+            "name": name,
+            "label": "",
+            "uploader": {"login": "stub", "id": 1, "type": "User", "site_admin": False},
+            "content_type": "application/octet-stream",
+            "size": 1234567,
+            "browser_download_url": f"https://github.com/x/y/releases/download/{tag}/{name}",
+        })
+    return {
+        "url": f"https://api.github.com/repos/x/y/releases/{index}",
+        "id": index,
+        "tag_name": tag,
+        "name": f"Release {tag}",
+        "draft": False,
+        "prerelease": False,
+        "author": {"login": "stub", "id": 1, "type": "User", "site_admin": False},
+        "assets": asset_list,
+        "body": ("Changelog line. " * 64 * body_kb)[: body_kb * 1024],
+    }
+
+
+class Handler(BaseHTTPRequestHandler):
+    # HTTP/1.0 wie vom ESP32 angefragt: kein Chunked-Encoding
+    protocol_version = "HTTP/1.0"
+
+    def do_GET(self):
+        url = urlparse(self.path)
+        if url.path != "/releases":
+            self.send_error(404)
+            return
+        query = parse_qs(url.query)
+        per_page = int(query.get("per_page", ["30"])[0])
+        page = int(query.get("page", ["1"])[0])
+
+        cfg = self.server.cfg
+        self.server.requests += 1
+        if cfg.bump_after and self.server.requests % cfg.bump_after == 0:
+            cfg.releases += 1
+            print(f"New release, now {cfg.releases}")
+
+        first = (page - 1) * per_page
+        last = min(first + per_page, cfg.releases)
+        items = [make_release(cfg.releases - i, cfg.body_kb, cfg.assets) for i in range(first, last)]
+        payload = json.dumps(items, indent=1).encode()
+        etag = 'W/"%s"' % hashlib.sha1(payload).hexdigest()
+
+        if self.headers.get("If-None-Match") == etag:
+            self.send_response(304)
+            self.send_header("ETag", etag)
+            self.end_headers()
+            return
+
+        self.send_response(200)
+        self.send_header("ETag", etag)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(payload)))
+        self.end_headers()
+        self.wfile.write(payload)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--port", type=int, default=8000)
+    parser.add_argument("--releases", type=int, default=100, help="Anzahl Releases gesamt")
+    parser.add_argument("--body-kb", type=int, default=4, help="Größe des Changelogs je Release")
+    parser.add_argument("--assets", type=int, default=4, help="Assets je Release (das letzte ist die .bin)")
+    parser.add_argument("--bump-after", type=int, default=0, help="Nach N Anfragen ein neues Release (0 = nie)")
+    cfg = parser.parse_args()
+
+    server = ThreadingHTTPServer(("0.0.0.0", cfg.port), Handler)
+    server.cfg = cfg
+    server.requests = 0
+    print(f"Serving {cfg.releases} releases on http://0.0.0.0:{cfg.port}/releases")
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
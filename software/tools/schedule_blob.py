@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+"""Baut das Zeitplan-Kommando für den Timer-Controller (Blob-Format siehe ScheduleEngine.h).
+
+Ein Eintrag je Argument:  TAGE HH:MM MODE [SPEED] [IN|OUT] [OPEN|CLOSED]
+    TAGE   Mo,Tu,We,Th,Fr,Sa,Su, Bereiche wie Mo-Fr, oder "daily"
+    MODE   OFF, AUTO, MANUAL
+
+    python3 schedule_blob.py "Mo-Fr 07:00 MANUAL 60 OUT OPEN" "daily 07:30 OFF"
+    python3 schedule_blob.py --clock --mqtt-host 192.168.1.5 "Sa,Su 10:00 AUTO"
+    python3 schedule_blob.py --clear
+
+Das Ergebnis ({"schedule":"<Base64>"}, mit --clock auch {"clock":<Unix-Zeit>}) geht per BLE
+auf die Command-Characteristic oder per MQTT auf das Cmd-Topic. Es wird im NVS gespeichert
+und gilt, sobald der Controller "TIMER" ist und die Uhr gestellt wurde.
+"""
+
+import argparse
+import base64
+import json
+import struct
+import sys
+import time
+
+DAYS = ["mo", "tu", "we", "th", "fr", "sa", "su"]
+MODES = {"off": 0, "auto": 1, "manual": 2}
+MAX_SLOTS = 16
+
+
+def parse_days(text):
+    if text.lower() == "daily":
+        return 0x7F
+    mask = 0
+    for part in text.lower().split(","):
+        if "-" in part:
+            first, last = (DAYS.index(d[:2]) for d in part.split("-"))
+            for day in range(first, last + 1):
+                mask |= 1 << day
+        else:
+            mask |= 1 << DAYS.index(part[:2])
+    return mask
+
+
+def parse_slot(text):
+    fields = text.split()
+    if len(fields) < 3:
+        raise ValueError(f"too few fields: {text!r}")
+    days = parse_days(fields[0])
+    hour, minute = (int(v) for v in fields[1].split(":"))
+    mode = MODES[fields[2].lower()]
+    speed, airflow, cover = 0, 0, 1 if mode else 0
+    for extra in fields[3:]:
+        upper = extra.upper()
+        if upper.isdigit():
+            speed = int(upper)
+        elif upper in ("IN", "OUT"):
+            airflow = 1 if upper == "OUT" else 0
+        elif upper in ("OPEN", "CLOSED"):
+            cover = 1 if upper == "OPEN" else 0
+        else:
+            raise ValueError(f"unknown field {extra!r} in {text!r}")
+    if not (0 <= hour < 24 and 0 <= minute < 60 and 0 <= speed <= 100):
+        raise ValueError(f"out of range: {text!r}")
+    packed = (hour * 60 + minute) | (mode << 11) | (airflow << 13) | (cover << 14)
+    return struct.pack("<BBH", days, speed, packed)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("slots", nargs="*", help="Einträge, siehe oben")
+    parser.add_argument("--clear", action="store_true", help="Plan löschen (zurück zum Lauf/Pause-Zyklus)")
+    parser.add_argument("--clock", action="store_true", help="Uhr des Geräts auf die PC-Zeit stellen")
+    parser.add_argument("--mqtt-host", help="direkt per MQTT senden")
+    parser.add_argument("--mqtt-port", type=int, default=1883)
+    parser.add_argument("--cmd-topic", default="FanState/set")
+    args = parser.parse_args()
+
+    if len(args.slots) > MAX_SLOTS:
+        sys.exit(f"at most {MAX_SLOTS} entries")
+
+    command = {}
+    if args.slots or args.clear:
+        blob = b"" if args.clear else bytes([1, len(args.slots)]) + b"".join(parse_slot(s) for s in args.slots)
+        command["schedule"] = base64.b64encode(blob).decode()
+    if args.clock:
+        command["clock"] = int(time.time())
+    if not command:
+        parser.error("nothing to send")
+
+    payload = json.dumps(command, separators=(",", ":"))
+    print(payload)
+
+    if args.mqtt_host:
+        import paho.mqtt.publish as publish
+        publish.single(args.cmd_topic, payload, hostname=args.mqtt_host, port=args.mqtt_port)
+        print(f"sent to {args.cmd_topic}")
+
+
+if __name__ == "__main__":
+    main()
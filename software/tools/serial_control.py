@@ -0,0 +1,297 @@
+#!/usr/bin/env python3
+"""Host-Werkzeug für die USB-Serial-Steuerung (siehe SERIAL_PROTOCOL.md).
+
+Nur Standardbibliothek (termios), für Linux, z.B. einen Raspberry Pi im Fahrzeug.
+Der Controller "USB" muss im Menü aktiviert sein.
+
+    python3 serial_control.py /dev/ttyACM0 status
+    python3 serial_control.py /dev/ttyACM0 command '{"mode":"manual","speed":70}'
+    python3 serial_control.py /dev/ttyACM0 diag
+    python3 serial_control.py /dev/ttyACM0 monitor          # Status- und Log-Rahmen
+    python3 serial_control.py /dev/ttyACM0 bench --count 500 --window 8
+    python3 serial_control.py - selftest                    # Kodierung ohne Gerät prüfen
+
+"bench" misst die Ping-Umlaufzeit (einzeln) und den Kommandodurchsatz mit
+mehreren Kommandos unterwegs (--window), danach die Zähler des Geräts.
+Log-Zeilen ohne Rahmen (vor dem Start des Controllers) werden als "[raw]" angezeigt.
+"""
+
+import argparse
+import json
+import os
+import select
+import statistics
+import struct
+import sys
+import termios
+import time
+import tty
+
+CHANNEL_CONTROL = 0
+CHANNEL_LOG = 1
+
+TYPE_COMMAND = 0x01
+TYPE_GET_STATUS = 0x02
+TYPE_GET_DIAG = 0x03
+TYPE_PING = 0x04
+TYPE_ACK = 0x80
+TYPE_STATUS = 0x81
+TYPE_DIAG = 0x82
+TYPE_PONG = 0x83
+TYPE_LOG_TEXT = 0x01
+
+ACK_NAMES = {0: "ok", 1: "unknown type", 2: "invalid"}
+MAX_DATA = 240
+
+
+def crc16(data, crc=0xFFFF):
+    for b in data:
+        crc ^= b << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def cobs_encode(data):
+    out = bytearray([0])
+    code_index = 0
+    code = 1
+    for b in data:
+        if b == 0:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+            continue
+        out.append(b)
+        code += 1
+        if code == 0xFF:
+            out[code_index] = code
+            code_index = len(out)
+            out.append(0)
+            code = 1
+    out[code_index] = code
+    return bytes(out)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        i += 1
+        if code == 0 or i + code - 1 > len(data):
+            return None
+        block = data[i:i + code - 1]
+        if 0 in block:
+            return None
+        out += block
+        i += code - 1
+        if code != 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def encode_frame(channel, ftype, seq, data=b""):
+    if len(data) > MAX_DATA:
+        raise ValueError("zu viele Daten")
+    packet = bytes([channel, ftype, seq & 0xFF, len(data)]) + data
+    packet += struct.pack("<H", crc16(packet))
+    return b"\x00" + cobs_encode(packet) + b"\x00"
+
+
+def decode_frame(chunk):
+    """(channel, type, seq, data) oder None."""
+    packet = cobs_decode(chunk)
+    if packet is None or len(packet) < 6 or len(packet) != 6 + packet[3]:
+        return None
+    if crc16(packet[:-2]) != struct.unpack("<H", packet[-2:])[0]:
+        return None
+    return packet[0], packet[1], packet[2], packet[4:-2]
+
+
+class Link:
+    def __init__(self, path):
+        self.fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+        tty.setraw(self.fd)
+        attrs = termios.tcgetattr(self.fd)
+        attrs[4] = attrs[5] = termios.B115200  # bei USB-CDC ohne Bedeutung
+        termios.tcsetattr(self.fd, termios.TCSANOW, attrs)
+        termios.tcflush(self.fd, termios.TCIFLUSH)
+        self.buffer = bytearray()
+        self.seq = 0
+        self.crc_errors = 0
+
+    def send(self, channel, ftype, data=b"", seq=None):
+        if seq is None:
+            seq = self.seq
+            self.seq = (self.seq + 1) & 0xFF
+        os.write(self.fd, encode_frame(channel, ftype, seq, data))
+        return seq
+
+    def frames(self, timeout):
+        """Liefert Rahmen bis timeout (Sekunden) ohne Daten verstrichen ist."""
+        while True:
+            while 0 in self.buffer:
+                end = self.buffer.index(0)
+                chunk = bytes(self.buffer[:end])
+                del self.buffer[:end + 1]
+                if not chunk:
+                    continue
+                frame = decode_frame(chunk)
+                if frame is not None:
+                    yield frame
+                elif all(32 <= b < 127 or b in (9, 10, 13) for b in chunk):
+                    yield (None, None, None, chunk)
+                else:
+                    self.crc_errors += 1
+            ready, _, _ = select.select([self.fd], [], [], timeout)
+            if not ready:
+                return
+            self.buffer += os.read(self.fd, 4096)
+
+    def wait_for(self, ftype, seq, timeout=2.0, show_other=False):
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            for channel, t, s, data in self.frames(max(0.0, deadline - time.monotonic())):
+                if channel == CHANNEL_CONTROL and t in (ftype, TYPE_ACK) and s == seq:
+                    return t, data
+                if show_other:
+                    print_frame(channel, t, s, data)
+        raise TimeoutError(f"keine Antwort auf seq {seq}")
+
+
+def print_frame(channel, ftype, seq, data):
+    stamp = time.strftime("%H:%M:%S")
+    if channel is None:
+        for line in data.decode(errors="replace").splitlines():
+            if line.strip():
+                print(f"{stamp} [raw] {line}")
+    elif channel == CHANNEL_LOG:
+        print(f"{stamp} [log] {data.decode(errors='replace')}")
+    elif ftype == TYPE_STATUS:
+        print(f"{stamp} [status] {data.decode()}")
+    elif ftype == TYPE_ACK:
+        print(f"{stamp} [ack {seq}] {ACK_NAMES.get(data[0], data[0]) if data else '?'}")
+    else:
+        print(f"{stamp} [{channel}/{ftype:#04x} {seq}] {data!r}")
+
+
+def request(link, ftype, reply, data=b""):
+    seq = link.send(CHANNEL_CONTROL, ftype, data)
+    t, payload = link.wait_for(reply, seq)
+    if t == TYPE_ACK and reply != TYPE_ACK:
+        raise RuntimeError(f"Gerät lehnt ab: {ACK_NAMES.get(payload[0], payload[0])}")
+    return payload
+
+
+def cmd_status(link, args):
+    print(request(link, TYPE_GET_STATUS, TYPE_STATUS).decode())
+
+
+def cmd_command(link, args):
+    ack = request(link, TYPE_COMMAND, TYPE_ACK, args.json.encode())
+    print("ack:", ACK_NAMES.get(ack[0], ack[0]))
+
+
+def cmd_diag(link, args):
+    print(json.dumps(json.loads(request(link, TYPE_GET_DIAG, TYPE_DIAG)), indent=2))
+
+
+def cmd_monitor(link, args):
+    while True:
+        for frame in link.frames(1.0):
+            print_frame(*frame)
+
+
+def cmd_bench(link, args):
+    # 1. Umlaufzeit: ein Ping nach dem anderen
+    rtts = []
+    payload = bytes(range(32))
+    for _ in range(args.count):
+        start = time.perf_counter()
+        data = request(link, TYPE_PING, TYPE_PONG, payload)
+        rtts.append((time.perf_counter() - start) * 1000)
+        if data != payload:
+            print("PONG mit falschen Daten")
+    rtts.sort()
+    print(f"Ping ({len(payload)} B): median {statistics.median(rtts):.2f} ms, "
+          f"p99 {rtts[min(len(rtts) - 1, int(len(rtts) * 0.99))]:.2f} ms, max {rtts[-1]:.2f} ms")
+
+    # 2. Durchsatz: bis zu window Kommandos unterwegs, abwechselnd zwei Geschwindigkeiten
+    pending = {}
+    sent = acked = rejected = 0
+    start = time.perf_counter()
+    deadline = start + 30
+    while acked + rejected < args.count and time.perf_counter() < deadline:
+        while len(pending) < args.window and sent < args.count:
+            body = json.dumps({"mode": "manual", "speed": 50 + 10 * (sent % 2)}).encode()
+            seq = link.send(CHANNEL_CONTROL, TYPE_COMMAND, body)
+            pending[seq] = time.perf_counter()
+            sent += 1
+        for channel, t, s, data in link.frames(0.5):
+            if channel == CHANNEL_CONTROL and t == TYPE_ACK and s in pending:
+                del pending[s]
+                if data and data[0] == 0:
+                    acked += 1
+                else:
+                    rejected += 1
+            if len(pending) < args.window:
+                break
+        else:
+            if pending:
+                print(f"Zeitüberschreitung, {len(pending)} ohne Antwort")
+                break
+    elapsed = time.perf_counter() - start
+    print(f"Kommandos: {acked} ok, {rejected} abgelehnt in {elapsed:.2f} s "
+          f"= {acked / elapsed:.0f} /s (Fenster {args.window})")
+    print(f"Host: {link.crc_errors} ungültige Rahmen")
+    time.sleep(0.2)
+    print("Gerät:", request(link, TYPE_GET_DIAG, TYPE_DIAG).decode())
+
+
+def selftest():
+    import random
+    rng = random.Random(1)
+    for length in list(range(0, 300)) + [253, 254, 255, 508, 509]:
+        data = bytes(rng.choice([0, 0, 1, 0xFF, rng.randrange(256)]) for _ in range(length))
+        enc = cobs_encode(data)
+        assert 0 not in enc and cobs_decode(enc) == data, length
+    assert crc16(b"123456789") == 0x29B1
+    frame = encode_frame(CHANNEL_CONTROL, TYPE_COMMAND, 7, b'{"speed":50}')
+    assert decode_frame(frame[1:-1]) == (0, 1, 7, b'{"speed":50}')
+    broken = bytearray(frame[1:-1])
+    broken[3] ^= 0x01
+    assert decode_frame(bytes(broken)) is None
+    print("selftest ok:", frame.hex())
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="z.B. /dev/ttyACM0, '-' für selftest")
+    sub = parser.add_subparsers(dest="action", required=True)
+    sub.add_parser("status")
+    p = sub.add_parser("command")
+    p.add_argument("json")
+    sub.add_parser("diag")
+    sub.add_parser("monitor")
+    p = sub.add_parser("bench")
+    p.add_argument("--count", type=int, default=200)
+    p.add_argument("--window", type=int, default=4)
+    sub.add_parser("selftest")
+    args = parser.parse_args()
+
+    if args.action == "selftest":
+        selftest()
+        return
+    link = Link(args.port)
+    actions = {"status": cmd_status, "command": cmd_command, "diag": cmd_diag,
+               "monitor": cmd_monitor, "bench": cmd_bench}
+    try:
+        actions[args.action](link, args)
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()